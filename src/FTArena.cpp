@@ -0,0 +1,119 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <new>
+
+#include "FTArena.h"
+
+
+// Alignment of every allocation, and the size of each block header
+static const size_t ARENA_ALIGN = 16;
+
+
+static inline size_t RoundUp(size_t size)
+{
+    return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+
+FTArena::FTArena(size_t size)
+:   blocks(0),
+    cursor(0),
+    limit(0),
+    blockSize(RoundUp(size)),
+    capacity(0)
+{}
+
+
+FTArena::~FTArena()
+{
+    while(blocks)
+    {
+        Block *next = blocks->next;
+        ::operator delete(blocks);
+        blocks = next;
+    }
+}
+
+
+void* FTArena::Allocate(size_t size)
+{
+    size = RoundUp(size);
+
+    if(size > static_cast<size_t>(limit - cursor))
+    {
+        // Large requests get a block of their own, so the current block
+        // keeps its free space for the small ones that follow.
+        if(size > blockSize / 4)
+        {
+            return NewBlock(size);
+        }
+
+        cursor = NewBlock(blockSize);
+        limit = cursor + blockSize;
+    }
+
+    void *memory = cursor;
+    cursor += size;
+    return memory;
+}
+
+
+void FTArena::Lend(FT_GlyphSlot slot)
+{
+    slot->generic.data = this;
+    slot->generic.finalizer = Tag;
+}
+
+
+FTArena* FTArena::Borrowed(FT_GlyphSlot slot)
+{
+    if(!slot || slot->generic.finalizer != Tag)
+    {
+        return NULL;
+    }
+
+    return static_cast<FTArena*>(slot->generic.data);
+}
+
+
+char* FTArena::NewBlock(size_t size)
+{
+    char *memory = static_cast<char*>(::operator new(ARENA_ALIGN + size));
+
+    Block *block = reinterpret_cast<Block*>(memory);
+    block->next = blocks;
+    blocks = block;
+
+    capacity += size;
+
+    return memory + ARENA_ALIGN;
+}
+
+
+void FTArena::Tag(void *object)
+{
+    (void)object;
+}
@@ -0,0 +1,118 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTArena__
+#define     __FTArena__
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <stddef.h>
+
+
+/**
+ * FTArena hands out memory from a few large blocks and releases all of it
+ * at once when it is destroyed. Each glyph container owns one, so the
+ * glyphs of a font and their bitmaps are packed together rather than
+ * scattered over thousands of small heap allocations.
+ *
+ * Memory from an arena is never freed on its own. Whatever lives in it
+ * must not outlive the arena.
+ */
+class FTArena
+{
+    public:
+        /**
+         * Constructor
+         *
+         * @param blockSize  The size of the blocks memory is taken from.
+         */
+        FTArena(size_t blockSize = 65536);
+
+        /**
+         * Destructor. Releases every block.
+         */
+        ~FTArena();
+
+        /**
+         * Allocate memory that lives as long as the arena. The memory is
+         * aligned to 16 bytes within its block.
+         *
+         * @param size  The number of bytes wanted.
+         * @return  The memory.
+         */
+        void* Allocate(size_t size);
+
+        /**
+         * The total size of the blocks held by the arena.
+         *
+         * @return  The number of bytes.
+         */
+        size_t Capacity() const { return capacity; }
+
+        /**
+         * Lend this arena to a glyph slot, so that the glyph made from
+         * the slot keeps its data here. The caller saves and restores
+         * <code>slot->generic</code> around the loan.
+         *
+         * @param slot  The slot a glyph is about to be made from.
+         */
+        void Lend(FT_GlyphSlot slot);
+
+        /**
+         * Find the arena lent to a glyph slot.
+         *
+         * @param slot  A glyph slot, or <code>NULL</code>.
+         * @return  The arena, or <code>NULL</code> if none is lent.
+         */
+        static FTArena* Borrowed(FT_GlyphSlot slot);
+
+    private:
+        /**
+         * Take a new block of at least <code>size</code> bytes from the
+         * heap and link it into the block list.
+         */
+        char* NewBlock(size_t size);
+
+        /**
+         * Marks a slot's generic data as an arena on loan.
+         */
+        static void Tag(void *object);
+
+        struct Block
+        {
+            Block *next;
+        };
+
+        Block *blocks;
+        char *cursor;
+        char *limit;
+        size_t blockSize;
+        size_t capacity;
+
+        /* Disallow copies */
+        FTArena(const FTArena&);
+        FTArena& operator=(const FTArena&);
+};
+
+#endif  //  __FTArena__
@@ -0,0 +1,88 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTBBoxf__
+#define     __FTBBoxf__
+
+#include "FTGL/ftgl.h"
+
+#include "FTPointf.h"
+
+
+/**
+ * FTBBoxf is a single precision bounding box, for the bounds FTGL keeps
+ * per character and merges while measuring text. It takes 32 bytes where
+ * an FTBBox takes 48, and converts to FTBBox for the public interfaces.
+ */
+class FTBBoxf
+{
+    public:
+        FTBBoxf()
+        {}
+
+        FTBBoxf(const FTPointf& l, const FTPointf& u)
+        :   lower(l),
+            upper(u)
+        {}
+
+        explicit FTBBoxf(const FTBBox& bbox)
+        :   lower(bbox.Lower()),
+            upper(bbox.Upper())
+        {}
+
+        operator FTBBox() const
+        {
+            return FTBBox(lower, upper);
+        }
+
+        FTBBoxf& operator += (const FTPointf& vector)
+        {
+            lower += vector;
+            upper += vector;
+
+            return *this;
+        }
+
+        FTBBoxf& operator |= (const FTBBoxf& bbox)
+        {
+            // No early outs, so the loops can run on all lanes at once
+            for(int i = 0; i < 4; i++)
+            {
+                lower.values[i] = bbox.lower.values[i] < lower.values[i]
+                                   ? bbox.lower.values[i] : lower.values[i];
+                upper.values[i] = bbox.upper.values[i] > upper.values[i]
+                                   ? bbox.upper.values[i] : upper.values[i];
+            }
+
+            return *this;
+        }
+
+        const FTPointf& Lower() const { return lower; }
+        const FTPointf& Upper() const { return upper; }
+
+    private:
+        FTPointf lower, upper;
+};
+
+#endif  //  __FTBBoxf__
+
@@ -0,0 +1,1197 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include "FTBidi.h"
+#include "FTVector.h"
+
+
+/* The bidirectional types, as a sorted list of ranges. Each entry holds
+ * the first code point of a range shifted left by 5 bits and the type of
+ * the range in the low bits; a range ends where the next one starts.
+ * Generated from the Bidi_Class property of Unicode 14.0, with the
+ * documented defaults for unassigned code points. */
+static const unsigned int classRanges[] =
+{
+    0x9, 0x12b, 0x14a, 0x16b, 0x18c, 0x1aa,
+    0x1c9, 0x38a, 0x3eb, 0x40c, 0x42d, 0x465,
+    0x4cd, 0x564, 0x587, 0x5a4, 0x5c7, 0x603,
+    0x747, 0x76d, 0x820, 0xb6d, 0xc20, 0xf6d,
+    0xfe9, 0x10aa, 0x10c9, 0x1407, 0x142d, 0x1445,
+    0x14cd, 0x1540, 0x156d, 0x15a9, 0x15cd, 0x1605,
+    0x1643, 0x168d, 0x16a0, 0x16cd, 0x1723, 0x1740,
+    0x176d, 0x1800, 0x1aed, 0x1b00, 0x1eed, 0x1f00,
+    0x572d, 0x5760, 0x584d, 0x5a00, 0x5a4d, 0x5c00,
+    0x5cad, 0x5dc0, 0x5ded, 0x6008, 0x6e00, 0x6e8d,
+    0x6ec0, 0x6fcd, 0x6fe0, 0x708d, 0x70c0, 0x70ed,
+    0x7100, 0x7ecd, 0x7ee0, 0x9068, 0x9140, 0xb14d,
+    0xb160, 0xb1ad, 0xb1e5, 0xb201, 0xb228, 0xb7c1,
+    0xb7e8, 0xb801, 0xb828, 0xb861, 0xb888, 0xb8c1,
+    0xb8e8, 0xb901, 0xc006, 0xc0cd, 0xc102, 0xc125,
+    0xc162, 0xc187, 0xc1a2, 0xc1cd, 0xc208, 0xc362,
+    0xc968, 0xcc06, 0xcd45, 0xcd66, 0xcda2, 0xce08,
+    0xce22, 0xdac8, 0xdba6, 0xdbcd, 0xdbe8, 0xdca2,
+    0xdce8, 0xdd2d, 0xdd48, 0xddc2, 0xde03, 0xdf42,
+    0xe228, 0xe242, 0xe608, 0xe962, 0xf4c8, 0xf622,
+    0xf801, 0xfd68, 0xfe81, 0xfecd, 0xff41, 0xffa8,
+    0xffc1, 0x102c8, 0x10341, 0x10368, 0x10481, 0x104a8,
+    0x10501, 0x10528, 0x105c1, 0x10b28, 0x10b81, 0x10c02,
+    0x11206, 0x11242, 0x11308, 0x11402, 0x11948, 0x11c46,
+    0x11c68, 0x12060, 0x12748, 0x12760, 0x12788, 0x127a0,
+    0x12828, 0x12920, 0x129a8, 0x129c0, 0x12a28, 0x12b00,
+    0x12c48, 0x12c80, 0x13028, 0x13040, 0x13788, 0x137a0,
+    0x13828, 0x138a0, 0x139a8, 0x139c0, 0x13c48, 0x13c80,
+    0x13e45, 0x13e80, 0x13f65, 0x13f80, 0x13fc8, 0x13fe0,
+    0x14028, 0x14060, 0x14788, 0x147a0, 0x14828, 0x14860,
+    0x148e8, 0x14920, 0x14968, 0x149c0, 0x14a28, 0x14a40,
+    0x14e08, 0x14e40, 0x14ea8, 0x14ec0, 0x15028, 0x15060,
+    0x15788, 0x157a0, 0x15828, 0x158c0, 0x158e8, 0x15920,
+    0x159a8, 0x159c0, 0x15c48, 0x15c80, 0x15e25, 0x15e40,
+    0x15f48, 0x16000, 0x16028, 0x16040, 0x16788, 0x167a0,
+    0x167e8, 0x16800, 0x16828, 0x168a0, 0x169a8, 0x169c0,
+    0x16aa8, 0x16ae0, 0x16c48, 0x16c80, 0x17048, 0x17060,
+    0x17808, 0x17820, 0x179a8, 0x179c0, 0x17e6d, 0x17f25,
+    0x17f4d, 0x17f60, 0x18008, 0x18020, 0x18088, 0x180a0,
+    0x18788, 0x187a0, 0x187c8, 0x18820, 0x188c8, 0x18920,
+    0x18948, 0x189c0, 0x18aa8, 0x18ae0, 0x18c48, 0x18c80,
+    0x18f0d, 0x18fe0, 0x19028, 0x19040, 0x19788, 0x197a0,
+    0x19988, 0x199c0, 0x19c48, 0x19c80, 0x1a008, 0x1a040,
+    0x1a768, 0x1a7a0, 0x1a828, 0x1a8a0, 0x1a9a8, 0x1a9c0,
+    0x1ac48, 0x1ac80, 0x1b028, 0x1b040, 0x1b948, 0x1b960,
+    0x1ba48, 0x1baa0, 0x1bac8, 0x1bae0, 0x1c628, 0x1c640,
+    0x1c688, 0x1c760, 0x1c7e5, 0x1c800, 0x1c8e8, 0x1c9e0,
+    0x1d628, 0x1d640, 0x1d688, 0x1d7a0, 0x1d908, 0x1d9c0,
+    0x1e308, 0x1e340, 0x1e6a8, 0x1e6c0, 0x1e6e8, 0x1e700,
+    0x1e728, 0x1e74d, 0x1e7c0, 0x1ee28, 0x1efe0, 0x1f008,
+    0x1f0a0, 0x1f0c8, 0x1f100, 0x1f1a8, 0x1f300, 0x1f328,
+    0x1f7a0, 0x1f8c8, 0x1f8e0, 0x205a8, 0x20620, 0x20648,
+    0x20700, 0x20728, 0x20760, 0x207a8, 0x207e0, 0x20b08,
+    0x20b40, 0x20bc8, 0x20c20, 0x20e28, 0x20ea0, 0x21048,
+    0x21060, 0x210a8, 0x210e0, 0x211a8, 0x211c0, 0x213a8,
+    0x213c0, 0x26ba8, 0x26c00, 0x2720d, 0x27340, 0x2800d,
+    0x28020, 0x2d00c, 0x2d020, 0x2d36d, 0x2d3a0, 0x2e248,
+    0x2e2a0, 0x2e648, 0x2e680, 0x2ea48, 0x2ea80, 0x2ee48,
+    0x2ee80, 0x2f688, 0x2f6c0, 0x2f6e8, 0x2f7c0, 0x2f8c8,
+    0x2f8e0, 0x2f928, 0x2fa80, 0x2fb65, 0x2fb80, 0x2fba8,
+    0x2fbc0, 0x2fe0d, 0x2ff40, 0x3000d, 0x30168, 0x301c9,
+    0x301e8, 0x30200, 0x310a8, 0x310e0, 0x31528, 0x31540,
+    0x32408, 0x32460, 0x324e8, 0x32520, 0x32648, 0x32660,
+    0x32728, 0x32780, 0x3280d, 0x32820, 0x3288d, 0x328c0,
+    0x33bcd, 0x34000, 0x342e8, 0x34320, 0x34368, 0x34380,
+    0x34ac8, 0x34ae0, 0x34b08, 0x34be0, 0x34c08, 0x34c20,
+    0x34c48, 0x34c60, 0x34ca8, 0x34da0, 0x34e68, 0x34fa0,
+    0x34fe8, 0x35000, 0x35608, 0x359e0, 0x36008, 0x36080,
+    0x36688, 0x366a0, 0x366c8, 0x36760, 0x36788, 0x367a0,
+    0x36848, 0x36860, 0x36d68, 0x36e80, 0x37008, 0x37040,
+    0x37448, 0x374c0, 0x37508, 0x37540, 0x37568, 0x375c0,
+    0x37cc8, 0x37ce0, 0x37d08, 0x37d40, 0x37da8, 0x37dc0,
+    0x37de8, 0x37e40, 0x38588, 0x38680, 0x386c8, 0x38700,
+    0x39a08, 0x39a60, 0x39a88, 0x39c20, 0x39c48, 0x39d20,
+    0x39da8, 0x39dc0, 0x39e88, 0x39ea0, 0x39f08, 0x39f40,
+    0x3b808, 0x3c000, 0x3f7ad, 0x3f7c0, 0x3f7ed, 0x3f840,
+    0x3f9ad, 0x3fa00, 0x3fbad, 0x3fc00, 0x3fdad, 0x3fe00,
+    0x3ffad, 0x3ffe0, 0x4000c, 0x40169, 0x401c0, 0x401e1,
+    0x4020d, 0x4050c, 0x4052a, 0x4054e, 0x40570, 0x40592,
+    0x405af, 0x405d1, 0x405e7, 0x40605, 0x406ad, 0x40887,
+    0x408ad, 0x40bec, 0x40c09, 0x40cd3, 0x40cf4, 0x40d15,
+    0x40d36, 0x40d49, 0x40e03, 0x40e20, 0x40e83, 0x40f44,
+    0x40f8d, 0x40fe0, 0x41003, 0x41144, 0x4118d, 0x411e0,
+    0x41405, 0x41a08, 0x41e20, 0x4200d, 0x42040, 0x4206d,
+    0x420e0, 0x4210d, 0x42140, 0x4228d, 0x422a0, 0x422cd,
+    0x42320, 0x423cd, 0x42480, 0x424ad, 0x424c0, 0x424ed,
+    0x42500, 0x4252d, 0x42540, 0x425c5, 0x425e0, 0x4274d,
+    0x42780, 0x4280d, 0x428a0, 0x4294d, 0x429c0, 0x42a0d,
+    0x42c00, 0x4312d, 0x43180, 0x4320d, 0x44244, 0x44265,
+    0x4428d, 0x466c0, 0x46f6d, 0x472a0, 0x472cd, 0x484e0,
+    0x4880d, 0x48960, 0x48c0d, 0x49103, 0x49380, 0x49d4d,
+    0x4d580, 0x4d5ad, 0x50000, 0x5200d, 0x56e80, 0x56ecd,
+    0x572c0, 0x572ed, 0x58000, 0x59cad, 0x59d60, 0x59de8,
+    0x59e40, 0x59f2d, 0x5a000, 0x5afe8, 0x5b000, 0x5bc08,
+    0x5c00d, 0x5cbc0, 0x5d00d, 0x5d340, 0x5d36d, 0x5de80,
+    0x5e00d, 0x5fac0, 0x5fe0d, 0x5ff80, 0x6000c, 0x6002d,
+    0x600a0, 0x6010d, 0x60420, 0x60548, 0x605c0, 0x6060d,
+    0x60620, 0x606cd, 0x60700, 0x607ad, 0x60800, 0x61328,
+    0x6136d, 0x613a0, 0x6140d, 0x61420, 0x61f6d, 0x61f80,
+    0x6380d, 0x63c80, 0x643ad, 0x643e0, 0x64a0d, 0x64c00,
+    0x64f8d, 0x64fe0, 0x6562d, 0x65800, 0x6598d, 0x65a00,
+    0x66eed, 0x66f60, 0x67bcd, 0x67c00, 0x67fed, 0x68000,
+    0x9b80d, 0x9c000, 0x14920d, 0x1498e0, 0x14c1ad, 0x14c200,
+    0x14cde8, 0x14ce6d, 0x14ce88, 0x14cfcd, 0x14d000, 0x14d3c8,
+    0x14d400, 0x14de08, 0x14de40, 0x14e00d, 0x14e440, 0x14f10d,
+    0x14f120, 0x150048, 0x150060, 0x1500c8, 0x1500e0, 0x150168,
+    0x150180, 0x1504a8, 0x1504e0, 0x15050d, 0x150588, 0x1505a0,
+    0x150705, 0x150740, 0x150e8d, 0x150f00, 0x151888, 0x1518c0,
+    0x151c08, 0x151e40, 0x151fe8, 0x152000, 0x1524c8, 0x1525c0,
+    0x1528e8, 0x152a40, 0x153008, 0x153060, 0x153668, 0x153680,
+    0x1536c8, 0x153740, 0x153788, 0x1537c0, 0x153ca8, 0x153cc0,
+    0x154528, 0x1545e0, 0x154628, 0x154660, 0x1546a8, 0x1546e0,
+    0x154868, 0x154880, 0x154988, 0x1549a0, 0x154f88, 0x154fa0,
+    0x155608, 0x155620, 0x155648, 0x1556a0, 0x1556e8, 0x155720,
+    0x1557c8, 0x155800, 0x155828, 0x155840, 0x155d88, 0x155dc0,
+    0x155ec8, 0x155ee0, 0x156d4d, 0x156d80, 0x157ca8, 0x157cc0,
+    0x157d08, 0x157d20, 0x157da8, 0x157dc0, 0x1f63a1, 0x1f63c8,
+    0x1f63e1, 0x1f6524, 0x1f6541, 0x1f6a02, 0x1fa7cd, 0x1faa02,
+    0x1fb9ed, 0x1fba09, 0x1fbe02, 0x1fbfad, 0x1fc008, 0x1fc20d,
+    0x1fc340, 0x1fc408, 0x1fc60d, 0x1fca07, 0x1fca2d, 0x1fca47,
+    0x1fca60, 0x1fca8d, 0x1fcaa7, 0x1fcacd, 0x1fcbe5, 0x1fcc0d,
+    0x1fcc44, 0x1fcc8d, 0x1fcce0, 0x1fcd0d, 0x1fcd25, 0x1fcd6d,
+    0x1fcd80, 0x1fce02, 0x1fdfe9, 0x1fe000, 0x1fe02d, 0x1fe065,
+    0x1fe0cd, 0x1fe164, 0x1fe187, 0x1fe1a4, 0x1fe1c7, 0x1fe203,
+    0x1fe347, 0x1fe36d, 0x1fe420, 0x1fe76d, 0x1fe820, 0x1feb6d,
+    0x1fecc0, 0x1ffc05, 0x1ffc4d, 0x1ffca5, 0x1ffce0, 0x1ffd0d,
+    0x1ffde0, 0x1ffe09, 0x1fff2d, 0x1fffc9, 0x200000, 0x20202d,
+    0x202040, 0x20280d, 0x2031a0, 0x20320d, 0x2033a0, 0x20340d,
+    0x203420, 0x203fa8, 0x203fc0, 0x205c08, 0x205c23, 0x205f80,
+    0x206ec8, 0x206f60, 0x210001, 0x2123ed, 0x212401, 0x214028,
+    0x214081, 0x2140a8, 0x2140e1, 0x214188, 0x214201, 0x214708,
+    0x214761, 0x2147e8, 0x214801, 0x215ca8, 0x215ce1, 0x21672d,
+    0x216801, 0x21a002, 0x21a488, 0x21a502, 0x21a606, 0x21a742,
+    0x21a801, 0x21cc06, 0x21cfe1, 0x21d568, 0x21d5a1, 0x21d802,
+    0x21e001, 0x21e602, 0x21e8c8, 0x21ea22, 0x21ee01, 0x21f048,
+    0x21f0c1, 0x220000, 0x220028, 0x220040, 0x220708, 0x2208e0,
+    0x220a4d, 0x220cc0, 0x220e08, 0x220e20, 0x220e68, 0x220ea0,
+    0x220fe8, 0x221040, 0x221668, 0x2216e0, 0x221728, 0x221760,
+    0x221848, 0x221860, 0x222008, 0x222060, 0x2224e8, 0x222580,
+    0x2225a8, 0x2226a0, 0x222e68, 0x222e80, 0x223008, 0x223040,
+    0x2236c8, 0x2237e0, 0x223928, 0x2239a0, 0x2239e8, 0x223a00,
+    0x2245e8, 0x224640, 0x224688, 0x2246a0, 0x2246c8, 0x224700,
+    0x2247c8, 0x2247e0, 0x225be8, 0x225c00, 0x225c68, 0x225d60,
+    0x226008, 0x226040, 0x226768, 0x2267a0, 0x226808, 0x226820,
+    0x226cc8, 0x226da0, 0x226e08, 0x226ea0, 0x228708, 0x228800,
+    0x228848, 0x2288a0, 0x2288c8, 0x2288e0, 0x228bc8, 0x228be0,
+    0x229668, 0x229720, 0x229748, 0x229760, 0x2297e8, 0x229820,
+    0x229848, 0x229880, 0x22b648, 0x22b6c0, 0x22b788, 0x22b7c0,
+    0x22b7e8, 0x22b820, 0x22bb88, 0x22bbc0, 0x22c668, 0x22c760,
+    0x22c7a8, 0x22c7c0, 0x22c7e8, 0x22c820, 0x22cc0d, 0x22cda0,
+    0x22d568, 0x22d580, 0x22d5a8, 0x22d5c0, 0x22d608, 0x22d6c0,
+    0x22d6e8, 0x22d700, 0x22e3a8, 0x22e400, 0x22e448, 0x22e4c0,
+    0x22e4e8, 0x22e580, 0x2305e8, 0x230700, 0x230728, 0x230760,
+    0x232768, 0x2327a0, 0x2327c8, 0x2327e0, 0x232868, 0x232880,
+    0x233a88, 0x233b00, 0x233b48, 0x233b80, 0x233c08, 0x233c20,
+    0x234028, 0x2340e0, 0x234128, 0x234160, 0x234668, 0x234720,
+    0x234768, 0x2347e0, 0x2348e8, 0x234900, 0x234a28, 0x234ae0,
+    0x234b28, 0x234b80, 0x235148, 0x2352e0, 0x235308, 0x235340,
+    0x238608, 0x2386e0, 0x238708, 0x2387c0, 0x239248, 0x239500,
+    0x239548, 0x239620, 0x239648, 0x239680, 0x2396a8, 0x2396e0,
+    0x23a628, 0x23a6e0, 0x23a748, 0x23a760, 0x23a788, 0x23a7c0,
+    0x23a7e8, 0x23a8c0, 0x23a8e8, 0x23a900, 0x23b208, 0x23b240,
+    0x23b2a8, 0x23b2c0, 0x23b2e8, 0x23b300, 0x23de68, 0x23dea0,
+    0x23faad, 0x23fba5, 0x23fc2d, 0x23fe40, 0x2d5e08, 0x2d5ea0,
+    0x2d6608, 0x2d66e0, 0x2de9e8, 0x2dea00, 0x2df1e8, 0x2df260,
+    0x2dfc4d, 0x2dfc60, 0x2dfc88, 0x2dfca0, 0x3793a8, 0x3793e0,
+    0x379409, 0x379480, 0x39e008, 0x39e5c0, 0x39e608, 0x39e8e0,
+    0x3a2ce8, 0x3a2d40, 0x3a2e69, 0x3a2f68, 0x3a3060, 0x3a30a8,
+    0x3a3180, 0x3a3548, 0x3a35c0, 0x3a3d2d, 0x3a3d60, 0x3a400d,
+    0x3a4848, 0x3a48ad, 0x3a48c0, 0x3a600d, 0x3a6ae0, 0x3adb6d,
+    0x3adb80, 0x3ae2ad, 0x3ae2c0, 0x3ae9ed, 0x3aea00, 0x3af12d,
+    0x3af140, 0x3af86d, 0x3af880, 0x3af9c3, 0x3b0000, 0x3b4008,
+    0x3b46e0, 0x3b4768, 0x3b4da0, 0x3b4ea8, 0x3b4ec0, 0x3b5088,
+    0x3b50a0, 0x3b5368, 0x3b5400, 0x3b5428, 0x3b5600, 0x3c0008,
+    0x3c00e0, 0x3c0108, 0x3c0320, 0x3c0368, 0x3c0440, 0x3c0468,
+    0x3c04a0, 0x3c04c8, 0x3c0560, 0x3c2608, 0x3c26e0, 0x3c55c8,
+    0x3c55e0, 0x3c5d88, 0x3c5e00, 0x3c5fe5, 0x3c6000, 0x3d0001,
+    0x3d1a08, 0x3d1ae1, 0x3d2888, 0x3d2961, 0x3d8e02, 0x3d9801,
+    0x3da002, 0x3daa01, 0x3dc002, 0x3dde0d, 0x3dde42, 0x3de001,
+    0x3e000d, 0x3e0580, 0x3e060d, 0x3e1280, 0x3e140d, 0x3e15e0,
+    0x3e162d, 0x3e1800, 0x3e182d, 0x3e1a00, 0x3e1a2d, 0x3e1ec0,
+    0x3e2003, 0x3e216d, 0x3e2200, 0x3e25ed, 0x3e2600, 0x3e2d4d,
+    0x3e2e00, 0x3e35ad, 0x3e35c0, 0x3e4c0d, 0x3e4cc0, 0x3e600d,
+    0x3edb00, 0x3edbad, 0x3edda0, 0x3ede0d, 0x3edfa0, 0x3ee00d,
+    0x3eee80, 0x3ef00d, 0x3efb20, 0x3efc0d, 0x3efd80, 0x3efe0d,
+    0x3efe20, 0x3f000d, 0x3f0180, 0x3f020d, 0x3f0900, 0x3f0a0d,
+    0x3f0b40, 0x3f0c0d, 0x3f1100, 0x3f120d, 0x3f15c0, 0x3f160d,
+    0x3f1640, 0x3f200d, 0x3f4a80, 0x3f4c0d, 0x3f4dc0, 0x3f4e0d,
+    0x3f4ea0, 0x3f4f0d, 0x3f4fa0, 0x3f500d, 0x3f50e0, 0x3f520d,
+    0x3f55a0, 0x3f560d, 0x3f5760, 0x3f580d, 0x3f58c0, 0x3f5a0d,
+    0x3f5b40, 0x3f5c0d, 0x3f5d00, 0x3f5e0d, 0x3f5ee0, 0x3f600d,
+    0x3f7260, 0x3f728d, 0x3f7960, 0x3f7e03, 0x3f7f40, 0x3fffc9,
+    0x400000, 0x5fffc9, 0x600000, 0x7fffc9, 0x800000, 0x9fffc9,
+    0xa00000, 0xbfffc9, 0xc00000, 0xdfffc9, 0xe00000, 0xffffc9,
+    0x1000000, 0x11fffc9, 0x1200000, 0x13fffc9, 0x1400000, 0x15fffc9,
+    0x1600000, 0x17fffc9, 0x1800000, 0x19fffc9, 0x1a00000, 0x1bfffc9,
+    0x1c02008, 0x1c03e09, 0x1c20000, 0x1dfffc9, 0x1e00000, 0x1ffffc9,
+    0x2000000, 0x21fffc9
+};
+
+
+/* Pairs of characters that are mirror images of each other, sorted by the
+ * first character of the pair. */
+static const unsigned int mirrorPairs[][2] =
+{
+    { 0x0028, 0x0029 }, { 0x003c, 0x003e }, { 0x005b, 0x005d },
+    { 0x007b, 0x007d }, { 0x00ab, 0x00bb }, { 0x2039, 0x203a },
+    { 0x2045, 0x2046 }, { 0x207d, 0x207e }, { 0x208d, 0x208e },
+    { 0x2208, 0x220b }, { 0x2209, 0x220c }, { 0x220a, 0x220d },
+    { 0x2215, 0x29f5 }, { 0x2264, 0x2265 }, { 0x2266, 0x2267 },
+    { 0x226a, 0x226b }, { 0x2282, 0x2283 }, { 0x2286, 0x2287 },
+    { 0x2308, 0x2309 }, { 0x230a, 0x230b }, { 0x2329, 0x232a },
+    { 0x27e6, 0x27e7 }, { 0x27e8, 0x27e9 }, { 0x27ea, 0x27eb },
+    { 0x2983, 0x2984 }, { 0x3008, 0x3009 }, { 0x300a, 0x300b },
+    { 0x300c, 0x300d }, { 0x300e, 0x300f }, { 0x3010, 0x3011 },
+    { 0x3014, 0x3015 }, { 0x3016, 0x3017 }, { 0x3018, 0x3019 },
+    { 0x301a, 0x301b }, { 0xff08, 0xff09 }, { 0xff1c, 0xff1e },
+    { 0xff3b, 0xff3d }, { 0xff5b, 0xff5d }, { 0xff5f, 0xff60 },
+    { 0xff62, 0xff63 }
+};
+
+
+/* Paired brackets as opening and closing character, sorted by the opening
+ * bracket (Bidi_Paired_Bracket, Unicode 14.0).  U+2329 and U+232A are
+ * canonically equivalent to U+3008 and U+3009 and are matched as those. */
+static const unsigned int bracketPairs[][2] =
+{
+    { 0x0028, 0x0029 }, { 0x005b, 0x005d }, { 0x007b, 0x007d },
+    { 0x0f3a, 0x0f3b }, { 0x0f3c, 0x0f3d }, { 0x169b, 0x169c },
+    { 0x2045, 0x2046 }, { 0x207d, 0x207e }, { 0x208d, 0x208e },
+    { 0x2308, 0x2309 }, { 0x230a, 0x230b }, { 0x2768, 0x2769 },
+    { 0x276a, 0x276b }, { 0x276c, 0x276d }, { 0x276e, 0x276f },
+    { 0x2770, 0x2771 }, { 0x2772, 0x2773 }, { 0x2774, 0x2775 },
+    { 0x27c5, 0x27c6 }, { 0x27e6, 0x27e7 }, { 0x27e8, 0x27e9 },
+    { 0x27ea, 0x27eb }, { 0x27ec, 0x27ed }, { 0x27ee, 0x27ef },
+    { 0x2983, 0x2984 }, { 0x2985, 0x2986 }, { 0x2987, 0x2988 },
+    { 0x2989, 0x298a }, { 0x298b, 0x298c }, { 0x298d, 0x2990 },
+    { 0x298f, 0x298e }, { 0x2991, 0x2992 }, { 0x2993, 0x2994 },
+    { 0x2995, 0x2996 }, { 0x2997, 0x2998 }, { 0x29d8, 0x29d9 },
+    { 0x29da, 0x29db }, { 0x29fc, 0x29fd }, { 0x2e22, 0x2e23 },
+    { 0x2e24, 0x2e25 }, { 0x2e26, 0x2e27 }, { 0x2e28, 0x2e29 },
+    { 0x2e55, 0x2e56 }, { 0x2e57, 0x2e58 }, { 0x2e59, 0x2e5a },
+    { 0x2e5b, 0x2e5c }, { 0x3008, 0x3009 }, { 0x300a, 0x300b },
+    { 0x300c, 0x300d }, { 0x300e, 0x300f }, { 0x3010, 0x3011 },
+    { 0x3014, 0x3015 }, { 0x3016, 0x3017 }, { 0x3018, 0x3019 },
+    { 0x301a, 0x301b }, { 0xfe59, 0xfe5a }, { 0xfe5b, 0xfe5c },
+    { 0xfe5d, 0xfe5e }, { 0xff08, 0xff09 }, { 0xff3b, 0xff3d },
+    { 0xff5b, 0xff5d }, { 0xff5f, 0xff60 }, { 0xff62, 0xff63 }
+};
+
+
+/* The deepest explicit embedding level (BD2). */
+static const int MAX_DEPTH = 125;
+
+
+/* The most brackets that may be open at once in a sequence (BD16). */
+static const int MAX_BRACKETS = 63;
+
+
+FTBidi::BidiClass FTBidi::Classify(const unsigned int c)
+{
+    // Find the last range starting at or before the character
+    int low = 0;
+    int high = sizeof(classRanges) / sizeof(classRanges[0]) - 1;
+
+    while(low < high)
+    {
+        int middle = (low + high + 1) / 2;
+
+        if((classRanges[middle] >> 5) <= c)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return (BidiClass)(classRanges[low] & 0x1f);
+}
+
+
+bool FTBidi::IsMixed(const unsigned int *text, const int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        // Nothing before the Hebrew block needs analysis
+        if(text[i] < 0x590)
+        {
+            continue;
+        }
+
+        switch(Classify(text[i]))
+        {
+            case R: case AL: case AN:
+            case LRE: case LRO: case RLE: case RLO: case PDF:
+            case LRI: case RLI: case FSI: case PDI:
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+
+/* Find the level given by the first strong character of a string, skipping
+ * isolates (P2, P3). The search stops at a paragraph separator, and at an
+ * unmatched PDI when resolving the direction of an FSI. */
+static int FirstStrongLevel(const unsigned int *text, const int count,
+                            const bool isolate)
+{
+    int depth = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        switch(FTBidi::Classify(text[i]))
+        {
+            case FTBidi::L:
+                if(!depth)
+                {
+                    return 0;
+                }
+                break;
+            case FTBidi::R:
+            case FTBidi::AL:
+                if(!depth)
+                {
+                    return 1;
+                }
+                break;
+            case FTBidi::LRI:
+            case FTBidi::RLI:
+            case FTBidi::FSI:
+                depth++;
+                break;
+            case FTBidi::PDI:
+                if(depth)
+                {
+                    depth--;
+                }
+                else if(isolate)
+                {
+                    return 0;
+                }
+                break;
+            case FTBidi::B:
+                return 0;
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+
+int FTBidi::ParagraphLevel(const unsigned int *text, const int count)
+{
+    return FirstStrongLevel(text, count, false);
+}
+
+
+/* Whether a type is removed from the weak and neutral rules by X9. */
+static inline bool IsRemoved(const FTBidi::BidiClass type)
+{
+    switch(type)
+    {
+        case FTBidi::LRE: case FTBidi::LRO: case FTBidi::RLE:
+        case FTBidi::RLO: case FTBidi::PDF: case FTBidi::BN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+static inline bool IsIsolateInitiator(const FTBidi::BidiClass type)
+{
+    return type == FTBidi::LRI || type == FTBidi::RLI || type == FTBidi::FSI;
+}
+
+
+/* Whether a type is a neutral or isolate formatting character (NI). */
+static inline bool IsNeutral(const FTBidi::BidiClass type)
+{
+    switch(type)
+    {
+        case FTBidi::B: case FTBidi::S: case FTBidi::WS: case FTBidi::ON:
+        case FTBidi::LRI: case FTBidi::RLI: case FTBidi::FSI:
+        case FTBidi::PDI:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+/* The strong direction a type counts as for the neutral rules, with
+ * numbers counting as right to left (N1). */
+static inline FTBidi::BidiClass StrongDirection(const FTBidi::BidiClass type)
+{
+    return type == FTBidi::L ? FTBidi::L : FTBidi::R;
+}
+
+
+/* The opening bracket of the pair a character belongs to, or zero if it
+ * is not a paired bracket (BD14, BD15). */
+static unsigned int PairedBracket(const unsigned int c, bool &opening)
+{
+    const int count = sizeof(bracketPairs) / sizeof(bracketPairs[0]);
+    const unsigned int canonical = (c == 0x2329) ? 0x3008
+                                 : (c == 0x232a) ? 0x3009 : c;
+
+    for(int i = 0; i < count; i++)
+    {
+        if(bracketPairs[i][0] == canonical)
+        {
+            opening = true;
+            return canonical;
+        }
+
+        if(bracketPairs[i][1] == canonical)
+        {
+            opening = false;
+            return bracketPairs[i][0];
+        }
+    }
+
+    return 0;
+}
+
+
+/* Resolve the paired brackets of an isolating run sequence (BD16, N0). */
+static void ResolveBrackets(const unsigned int *text, const int *sequence,
+                            const int length, FTBidi::BidiClass sos,
+                            FTBidi::BidiClass *types,
+                            const unsigned char *levels)
+{
+    // BD16: match each closing bracket with the nearest open bracket of
+    // the same pair, remembering the closer for each opener
+    FTVector<int> closers;
+    unsigned int stackBracket[MAX_BRACKETS];
+    int stackIndex[MAX_BRACKETS];
+    int depth = 0;
+
+    for(int k = 0; k < length; k++)
+    {
+        if(types[sequence[k]] != FTBidi::ON)
+        {
+            continue;
+        }
+
+        bool opening = false;
+        unsigned int bracket = PairedBracket(text[sequence[k]], opening);
+
+        if(!bracket)
+        {
+            continue;
+        }
+
+        if(opening)
+        {
+            // Too many open brackets: stop looking for pairs
+            if(depth == MAX_BRACKETS)
+            {
+                break;
+            }
+
+            stackBracket[depth] = bracket;
+            stackIndex[depth] = k;
+            depth++;
+            continue;
+        }
+
+        for(int d = depth - 1; d >= 0; d--)
+        {
+            if(stackBracket[d] == bracket)
+            {
+                if(!closers.size())
+                {
+                    closers.resize(length, -1);
+                }
+
+                closers[stackIndex[d]] = k;
+                depth = d;
+                break;
+            }
+        }
+    }
+
+    if(!closers.size())
+    {
+        return;
+    }
+
+    // N0: take pairs in the order of their opening brackets
+    FTBidi::BidiClass embedding = (levels[sequence[0]] & 1) ? FTBidi::R
+                                                             : FTBidi::L;
+
+    for(int k = 0; k < length; k++)
+    {
+        int close = closers[k];
+
+        if(close < 0)
+        {
+            continue;
+        }
+
+        // Strong types inside the brackets, numbers counting as right to
+        // left, preferring the embedding direction
+        FTBidi::BidiClass inside = FTBidi::ON;
+
+        for(int j = k + 1; j < close; j++)
+        {
+            FTBidi::BidiClass type = types[sequence[j]];
+
+            if(type == FTBidi::L || type == FTBidi::R
+               || type == FTBidi::EN || type == FTBidi::AN)
+            {
+                inside = StrongDirection(type);
+                if(inside == embedding)
+                {
+                    break;
+                }
+            }
+        }
+
+        if(inside == FTBidi::ON)
+        {
+            continue;
+        }
+
+        // Only the opposite direction inside: follow the text before the
+        // brackets if it agrees, otherwise use the embedding direction
+        if(inside != embedding)
+        {
+            FTBidi::BidiClass context = sos;
+
+            for(int j = k - 1; j >= 0; j--)
+            {
+                FTBidi::BidiClass type = types[sequence[j]];
+
+                if(type == FTBidi::L || type == FTBidi::R
+                   || type == FTBidi::EN || type == FTBidi::AN)
+                {
+                    context = StrongDirection(type);
+                    break;
+                }
+            }
+
+            if(context != inside)
+            {
+                inside = embedding;
+            }
+        }
+
+        // The brackets, and non-spacing marks that follow them, take the
+        // resolved direction
+        const int ends[2] = { k, close };
+
+        for(int e = 0; e < 2; e++)
+        {
+            types[sequence[ends[e]]] = inside;
+
+            for(int j = ends[e] + 1; j < length
+                && FTBidi::Classify(text[sequence[j]]) == FTBidi::NSM; j++)
+            {
+                types[sequence[j]] = inside;
+            }
+        }
+    }
+}
+
+
+/* Resolve the weak types, neutrals and implicit levels of one isolating
+ * run sequence (W1 to W7, N0 to N2, I1 and I2). */
+static void ResolveSequence(const unsigned int *text, const int *sequence,
+                            const int length,
+                            FTBidi::BidiClass sos, FTBidi::BidiClass eos,
+                            FTBidi::BidiClass *types, unsigned char *levels)
+{
+    // W1: non-spacing marks take the type of what they follow
+    for(int k = 0; k < length; k++)
+    {
+        FTBidi::BidiClass &type = types[sequence[k]];
+
+        if(type == FTBidi::NSM)
+        {
+            if(!k)
+            {
+                type = sos;
+            }
+            else
+            {
+                FTBidi::BidiClass previous = types[sequence[k - 1]];
+                type = (IsIsolateInitiator(previous) || previous == FTBidi::PDI)
+                       ? FTBidi::ON : previous;
+            }
+        }
+    }
+
+    // W2, W3: European numbers after Arabic letters are Arabic numbers,
+    // and Arabic letters are right to left
+    FTBidi::BidiClass strong = sos;
+
+    for(int k = 0; k < length; k++)
+    {
+        FTBidi::BidiClass &type = types[sequence[k]];
+
+        if(type == FTBidi::L || type == FTBidi::R || type == FTBidi::AL)
+        {
+            strong = type;
+        }
+
+        if(type == FTBidi::EN && strong == FTBidi::AL)
+        {
+            type = FTBidi::AN;
+        }
+        else if(type == FTBidi::AL)
+        {
+            type = FTBidi::R;
+        }
+    }
+
+    // W4: a single separator between two numbers of the same kind
+    for(int k = 1; k < length - 1; k++)
+    {
+        FTBidi::BidiClass &type = types[sequence[k]];
+        FTBidi::BidiClass before = types[sequence[k - 1]];
+        FTBidi::BidiClass after = types[sequence[k + 1]];
+
+        if(before != after)
+        {
+            continue;
+        }
+
+        if((type == FTBidi::ES || type == FTBidi::CS) && before == FTBidi::EN)
+        {
+            type = FTBidi::EN;
+        }
+        else if(type == FTBidi::CS && before == FTBidi::AN)
+        {
+            type = FTBidi::AN;
+        }
+    }
+
+    // W5: terminators next to European numbers
+    for(int k = 0; k < length; k++)
+    {
+        if(types[sequence[k]] != FTBidi::ET)
+        {
+            continue;
+        }
+
+        int end = k;
+        while(end < length && types[sequence[end]] == FTBidi::ET)
+        {
+            end++;
+        }
+
+        bool number = (k > 0 && types[sequence[k - 1]] == FTBidi::EN)
+                       || (end < length && types[sequence[end]] == FTBidi::EN);
+
+        for(; k < end; k++)
+        {
+            if(number)
+            {
+                types[sequence[k]] = FTBidi::EN;
+            }
+        }
+        k--;
+    }
+
+    // W6, W7: remaining separators are neutral, and European numbers after
+    // left to right text are left to right
+    strong = sos;
+
+    for(int k = 0; k < length; k++)
+    {
+        FTBidi::BidiClass &type = types[sequence[k]];
+
+        if(type == FTBidi::ES || type == FTBidi::ET || type == FTBidi::CS)
+        {
+            type = FTBidi::ON;
+        }
+        else if(type == FTBidi::L || type == FTBidi::R)
+        {
+            strong = type;
+        }
+        else if(type == FTBidi::EN && strong == FTBidi::L)
+        {
+            type = FTBidi::L;
+        }
+    }
+
+    ResolveBrackets(text, sequence, length, sos, types, levels);
+
+    // N1, N2: neutrals between text of the same direction take that
+    // direction, others the direction of the embedding
+    for(int k = 0; k < length; k++)
+    {
+        if(!IsNeutral(types[sequence[k]]))
+        {
+            continue;
+        }
+
+        int end = k;
+        while(end < length && IsNeutral(types[sequence[end]]))
+        {
+            end++;
+        }
+
+        FTBidi::BidiClass before = k ? StrongDirection(types[sequence[k - 1]])
+                                     : sos;
+        FTBidi::BidiClass after = (end < length)
+                                  ? StrongDirection(types[sequence[end]])
+                                  : eos;
+
+        for(; k < end; k++)
+        {
+            FTBidi::BidiClass embedding = (levels[sequence[k]] & 1)
+                                          ? FTBidi::R : FTBidi::L;
+            types[sequence[k]] = (before == after) ? before : embedding;
+        }
+        k--;
+    }
+
+    // I1, I2: implicit levels
+    for(int k = 0; k < length; k++)
+    {
+        FTBidi::BidiClass type = types[sequence[k]];
+        unsigned char &level = levels[sequence[k]];
+
+        if(level & 1)
+        {
+            if(type == FTBidi::L || type == FTBidi::EN || type == FTBidi::AN)
+            {
+                level++;
+            }
+        }
+        else if(type == FTBidi::R)
+        {
+            level++;
+        }
+        else if(type == FTBidi::AN || type == FTBidi::EN)
+        {
+            level += 2;
+        }
+    }
+}
+
+
+/* Resolve the levels of a single paragraph. */
+static void ResolveParagraph(const unsigned int *text, const int count,
+                             const int paragraphLevel, unsigned char *levels)
+{
+    FTVector<FTBidi::BidiClass> original;
+    FTVector<FTBidi::BidiClass> types;
+    FTVector<int> matching;
+
+    original.resize(count, FTBidi::L);
+    types.resize(count, FTBidi::L);
+    matching.resize(count, -1);
+
+    // Find the PDI matching each isolate initiator (BD9)
+    FTVector<int> open;
+
+    for(int i = 0; i < count; i++)
+    {
+        original[i] = types[i] = FTBidi::Classify(text[i]);
+
+        if(IsIsolateInitiator(original[i]))
+        {
+            open.push_back(i);
+        }
+        else if(original[i] == FTBidi::PDI && open.size())
+        {
+            matching[open[open.size() - 1]] = i;
+            matching[i] = open[open.size() - 1];
+            open.resize(open.size() - 1, 0);
+        }
+    }
+
+    // X1 to X8: explicit levels and directions
+    struct Status
+    {
+        unsigned char level;
+        FTBidi::BidiClass override;
+        bool isolate;
+    } stack[MAX_DEPTH + 2];
+
+    int depth = 0;
+    int overflowIsolates = 0;
+    int overflowEmbeddings = 0;
+    int validIsolates = 0;
+
+    stack[0].level = paragraphLevel;
+    stack[0].override = FTBidi::ON;
+    stack[0].isolate = false;
+
+    for(int i = 0; i < count; i++)
+    {
+        FTBidi::BidiClass type = original[i];
+        const Status &top = stack[depth];
+
+        switch(type)
+        {
+            case FTBidi::RLE: case FTBidi::LRE:
+            case FTBidi::RLO: case FTBidi::LRO:
+            {
+                bool rtl = (type == FTBidi::RLE || type == FTBidi::RLO);
+                int level = rtl ? (top.level + 1) | 1 : (top.level + 2) & ~1;
+
+                levels[i] = top.level;
+
+                if(level <= MAX_DEPTH && !overflowIsolates
+                   && !overflowEmbeddings)
+                {
+                    depth++;
+                    stack[depth].level = level;
+                    stack[depth].override = (type == FTBidi::RLO) ? FTBidi::R
+                                          : (type == FTBidi::LRO) ? FTBidi::L
+                                          : FTBidi::ON;
+                    stack[depth].isolate = false;
+                }
+                else if(!overflowIsolates)
+                {
+                    overflowEmbeddings++;
+                }
+                break;
+            }
+
+            case FTBidi::RLI: case FTBidi::LRI: case FTBidi::FSI:
+            {
+                bool rtl = (type == FTBidi::RLI);
+
+                if(type == FTBidi::FSI)
+                {
+                    int end = (matching[i] < 0) ? count : matching[i];
+                    rtl = FirstStrongLevel(text + i + 1, end - i - 1, true);
+                }
+
+                int level = rtl ? (top.level + 1) | 1 : (top.level + 2) & ~1;
+
+                levels[i] = top.level;
+                if(top.override != FTBidi::ON)
+                {
+                    types[i] = top.override;
+                }
+
+                if(level <= MAX_DEPTH && !overflowIsolates
+                   && !overflowEmbeddings)
+                {
+                    validIsolates++;
+                    depth++;
+                    stack[depth].level = level;
+                    stack[depth].override = FTBidi::ON;
+                    stack[depth].isolate = true;
+                }
+                else
+                {
+                    overflowIsolates++;
+                }
+                break;
+            }
+
+            case FTBidi::PDI:
+                if(overflowIsolates)
+                {
+                    overflowIsolates--;
+                }
+                else if(validIsolates)
+                {
+                    overflowEmbeddings = 0;
+                    while(!stack[depth].isolate)
+                    {
+                        depth--;
+                    }
+                    depth--;
+                    validIsolates--;
+                }
+
+                levels[i] = stack[depth].level;
+                if(stack[depth].override != FTBidi::ON)
+                {
+                    types[i] = stack[depth].override;
+                }
+                break;
+
+            case FTBidi::PDF:
+                if(overflowIsolates)
+                {
+                    // Nothing to do
+                }
+                else if(overflowEmbeddings)
+                {
+                    overflowEmbeddings--;
+                }
+                else if(!top.isolate && depth)
+                {
+                    depth--;
+                }
+
+                levels[i] = stack[depth].level;
+                break;
+
+            case FTBidi::B:
+                levels[i] = paragraphLevel;
+                break;
+
+            default:
+                levels[i] = top.level;
+                if(top.override != FTBidi::ON && type != FTBidi::BN)
+                {
+                    types[i] = top.override;
+                }
+                break;
+        }
+    }
+
+    // X9, X10: split the remaining characters into level runs, and chain
+    // the runs across isolates into isolating run sequences
+    FTVector<int> kept;
+    FTVector<int> runStarts;
+    FTVector<int> runOf;
+
+    runOf.resize(count, -1);
+
+    for(int i = 0; i < count; i++)
+    {
+        if(IsRemoved(original[i]))
+        {
+            continue;
+        }
+
+        if(!kept.size() || levels[kept[kept.size() - 1]] != levels[i])
+        {
+            runStarts.push_back(kept.size());
+        }
+
+        runOf[i] = runStarts.size() - 1;
+        kept.push_back(i);
+    }
+
+    int runCount = runStarts.size();
+    runStarts.push_back(kept.size());
+
+    FTVector<int> sequence;
+
+    for(int run = 0; run < runCount; run++)
+    {
+        int first = kept[runStarts[run]];
+
+        // Runs starting with a matched PDI continue an earlier sequence
+        if(original[first] == FTBidi::PDI && matching[first] >= 0)
+        {
+            continue;
+        }
+
+        sequence.resize(0, 0);
+
+        for(int current = run; ; )
+        {
+            for(int k = runStarts[current]; k < runStarts[current + 1]; k++)
+            {
+                sequence.push_back(kept[k]);
+            }
+
+            int last = sequence[sequence.size() - 1];
+
+            if(!IsIsolateInitiator(original[last]) || matching[last] < 0
+               || runOf[matching[last]] < 0)
+            {
+                break;
+            }
+
+            current = runOf[matching[last]];
+        }
+
+        int start = sequence[0];
+        int end = sequence[sequence.size() - 1];
+        int level = levels[start];
+
+        // The levels around the sequence give its start and end types
+        int before = paragraphLevel;
+        for(int i = start - 1; i >= 0; i--)
+        {
+            if(!IsRemoved(original[i]))
+            {
+                before = levels[i];
+                break;
+            }
+        }
+
+        int after = paragraphLevel;
+        if(!IsIsolateInitiator(original[end]))
+        {
+            for(int i = end + 1; i < count; i++)
+            {
+                if(!IsRemoved(original[i]))
+                {
+                    after = levels[i];
+                    break;
+                }
+            }
+        }
+
+        int lastLevel = levels[end];
+        FTBidi::BidiClass sos = ((before > level ? before : level) & 1)
+                                ? FTBidi::R : FTBidi::L;
+        FTBidi::BidiClass eos = ((after > lastLevel ? after : lastLevel) & 1)
+                                ? FTBidi::R : FTBidi::L;
+
+        ResolveSequence(text, &sequence[0], sequence.size(), sos, eos,
+                        &types[0], levels);
+    }
+
+    // Removed characters take the level of what they follow
+    for(int i = 0; i < count; i++)
+    {
+        if(IsRemoved(original[i]))
+        {
+            levels[i] = i ? levels[i - 1] : paragraphLevel;
+        }
+    }
+
+    // L1: separators, and whitespace before them or at the end of the
+    // paragraph, are reset to the paragraph level
+    bool trailing = true;
+
+    for(int i = count - 1; i >= 0; i--)
+    {
+        FTBidi::BidiClass type = original[i];
+
+        if(type == FTBidi::B || type == FTBidi::S)
+        {
+            levels[i] = paragraphLevel;
+            trailing = true;
+        }
+        else if(trailing && (type == FTBidi::WS || IsRemoved(type)
+                             || IsIsolateInitiator(type)
+                             || type == FTBidi::PDI))
+        {
+            levels[i] = paragraphLevel;
+        }
+        else
+        {
+            trailing = false;
+        }
+    }
+}
+
+
+void FTBidi::Resolve(const unsigned int *text, const int count,
+                     unsigned char *levels)
+{
+    int start = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        // P1: each paragraph ends with its separator
+        if(i == count - 1 || Classify(text[i]) == B)
+        {
+            ResolveParagraph(text + start, i + 1 - start,
+                             ParagraphLevel(text + start, i + 1 - start),
+                             levels + start);
+            start = i + 1;
+        }
+    }
+}
+
+
+void FTBidi::Reorder(const unsigned int *text, const unsigned char *levels,
+                     const int count, const int paragraphLevel, int *order)
+{
+    FTVector<unsigned char> line;
+    line.resize(count, 0);
+
+    int highest = 0;
+    int lowestOdd = MAX_DEPTH + 2;
+
+    // L1: whitespace at the end of the line is reset to the paragraph level
+    bool trailing = true;
+
+    for(int i = count - 1; i >= 0; i--)
+    {
+        BidiClass type = Classify(text[i]);
+
+        trailing = trailing && (type == WS || IsRemoved(type)
+                                || IsIsolateInitiator(type) || type == PDI);
+        line[i] = trailing ? paragraphLevel : levels[i];
+        order[i] = i;
+
+        if(line[i] > highest)
+        {
+            highest = line[i];
+        }
+
+        if((line[i] & 1) && line[i] < lowestOdd)
+        {
+            lowestOdd = line[i];
+        }
+    }
+
+    // L2: reverse every run at each level, from the highest down to the
+    // lowest odd level
+    for(int level = highest; level >= lowestOdd; level--)
+    {
+        for(int i = 0; i < count; i++)
+        {
+            if(line[i] < level)
+            {
+                continue;
+            }
+
+            int end = i;
+            while(end < count && line[end] >= level)
+            {
+                end++;
+            }
+
+            for(int low = i, high = end - 1; low < high; low++, high--)
+            {
+                int index = order[low];
+                order[low] = order[high];
+                order[high] = index;
+
+                unsigned char swap = line[low];
+                line[low] = line[high];
+                line[high] = swap;
+            }
+
+            i = end;
+        }
+    }
+}
+
+
+unsigned int FTBidi::Mirror(const unsigned int c)
+{
+    const int count = sizeof(mirrorPairs) / sizeof(mirrorPairs[0]);
+
+    for(int i = 0; i < count && mirrorPairs[i][0] <= c; i++)
+    {
+        if(mirrorPairs[i][0] == c)
+        {
+            return mirrorPairs[i][1];
+        }
+
+        if(mirrorPairs[i][1] == c)
+        {
+            return mirrorPairs[i][0];
+        }
+    }
+
+    return c;
+}
+
@@ -0,0 +1,120 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTBidi__
+#define     __FTBidi__
+
+
+/**
+ * FTBidi resolves the embedding levels of a string of unicode characters
+ * and reorders lines for display, following the Unicode bidirectional
+ * algorithm (UAX #9).
+ *
+ * Characters are classified with a compact range table built from the
+ * Unicode 14.0 Bidi_Class property. Explicit embeddings, overrides and
+ * isolates are resolved with the directional status stack, and the weak
+ * and neutral types within each isolating run sequence.
+ *
+ * Paired brackets (N0) are resolved like other neutrals, and only the
+ * common brackets and relational operators are mirrored.
+ */
+class FTBidi
+{
+    public:
+        /**
+         * Bidirectional character types.
+         */
+        enum BidiClass
+        {
+            L, R, AL, EN, ES, ET, AN, CS, NSM, BN, B, S, WS, ON,
+            LRE, LRO, RLE, RLO, PDF, LRI, RLI, FSI, PDI
+        };
+
+        /**
+         * Get the bidirectional type of a character.
+         *
+         * @param c  A unicode code point.
+         * @return  The type of the character.
+         */
+        static BidiClass Classify(const unsigned int c);
+
+        /**
+         * Check whether a string needs to be analysed at all, that is
+         * whether it holds right to left characters or explicit
+         * directional formatting characters.
+         *
+         * @param text  The characters to check.
+         * @param count  The number of characters.
+         * @return  <code>false</code> if the string is plain left to right.
+         */
+        static bool IsMixed(const unsigned int *text, const int count);
+
+        /**
+         * Find the embedding level of the paragraph starting a string, from
+         * its first strong character (rules P2 and P3).
+         *
+         * @param text  The characters of the paragraph.
+         * @param count  The number of characters.
+         * @return  0 for a left to right paragraph, 1 for right to left.
+         */
+        static int ParagraphLevel(const unsigned int *text, const int count);
+
+        /**
+         * Resolve the embedding level of every character of a string. The
+         * string is split into paragraphs at paragraph separators, each
+         * with its own paragraph level.
+         *
+         * @param text  The characters to resolve.
+         * @param count  The number of characters.
+         * @param levels  Receives one level per character.
+         */
+        static void Resolve(const unsigned int *text, const int count,
+                            unsigned char *levels);
+
+        /**
+         * Reorder one line of a paragraph for display (rules L1 and L2).
+         *
+         * @param text  The characters of the line.
+         * @param levels  Their resolved levels.
+         * @param count  The number of characters.
+         * @param paragraphLevel  The level of the paragraph.
+         * @param order  Receives, for each position from left to right, the
+         *               index of the character displayed there.
+         */
+        static void Reorder(const unsigned int *text,
+                            const unsigned char *levels, const int count,
+                            const int paragraphLevel, int *order);
+
+        /**
+         * Get the character to display in place of a character on a right
+         * to left level.
+         *
+         * @param c  A unicode code point.
+         * @return  Its mirror image, or the character itself.
+         */
+        static unsigned int Mirror(const unsigned int c);
+};
+
+
+#endif  //  __FTBidi__
+
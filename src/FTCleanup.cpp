@@ -38,6 +38,8 @@ FTCleanup::FTCleanup()
 
 FTCleanup::~FTCleanup()
 {
+    FTMutexLock lock(mutex);
+
     std::set<FT_Face **>::iterator cleanupItr = cleanupFT_FaceItems.begin();
     FT_Face **cleanupFace = 0;
 
@@ -58,12 +60,14 @@ FTCleanup::~FTCleanup()
 
 void FTCleanup::RegisterObject(FT_Face **obj)
 {
+    FTMutexLock lock(mutex);
     cleanupFT_FaceItems.insert(obj);
 }
 
 
 void FTCleanup::UnregisterObject(FT_Face **obj)
 {
+    FTMutexLock lock(mutex);
     cleanupFT_FaceItems.erase(obj);
 }
 
@@ -30,6 +30,7 @@
 #include <set>
 
 #include "FTFace.h"
+#include "FTMutex.h"
 
 /**
  * A dummy object type for items to be stored in the cleanup list
@@ -39,6 +40,9 @@ typedef void* FTCleanupObject;
 /**
  * FTCleanup is used as a "callback" by FTLibrary to
  * make sure things are cleaned up in the right order
+ *
+ * Faces may be registered and unregistered from any thread. The instance
+ * itself is created by FTLibrary's initialisation, before any face exists.
  */
 class FTCleanup
 {
@@ -98,6 +102,11 @@ class FTCleanup
     private:
 
         std::set<FT_Face **> cleanupFT_FaceItems;
+
+        /**
+         * Protects cleanupFT_FaceItems
+         */
+        FTMutex mutex;
 };
 
 #endif  //  __FTCleanup__
@@ -34,31 +34,23 @@
 static const unsigned int BEZIER_STEPS = 5;
 
 
-void FTContour::AddPoint(FTPoint point)
-{
-    if(pointList.empty() || (point != pointList[pointList.size() - 1]
-                              && point != pointList[0]))
-    {
-        pointList.push_back(point);
-    }
-}
-
-
-void FTContour::AddOutsetPoint(FTPoint point)
-{
-    outsetPointList.push_back(point);
-}
-
-
-void FTContour::AddFrontPoint(FTPoint point)
+size_t FTContour::MaxPointCount(size_t n)
 {
-    frontPointList.push_back(point);
+    // An on point adds one point, a conic off point up to one midpoint
+    // and BEZIER_STEPS - 1 curve points, and a cubic BEZIER_STEPS.
+    return n * BEZIER_STEPS;
 }
 
 
-void FTContour::AddBackPoint(FTPoint point)
+void FTContour::AddPoint(FTPoint point)
 {
-    backPointList.push_back(point);
+    if(!pointCount || (point != points[pointCount - 1]
+                        && point != points[0]))
+    {
+        // The store was reserved up front, so this never reallocates
+        pointStore->push_back(point);
+        ++pointCount;
+    }
 }
 
 
@@ -133,7 +125,6 @@ FTPoint FTContour::ComputeOutsetPoint(FTPoint A, FTPoint B, FTPoint C)
 void FTContour::SetParity(int parity)
 {
     size_t size = PointCount();
-    FTPoint vOutset;
 
     if(((parity & 1) && clockwise) || (!(parity & 1) && !clockwise))
     {
@@ -141,13 +132,33 @@ void FTContour::SetParity(int parity)
         // FIXME: could it be worth writing FTVector::reverse() for this?
         for(size_t i = 0; i < size / 2; i++)
         {
-            FTPoint tmp = pointList[i];
-            pointList[i] = pointList[size - 1 - i];
-            pointList[size - 1 -i] = tmp;
+            FTPoint tmp = points[i];
+            points[i] = points[size - 1 - i];
+            points[size - 1 -i] = tmp;
         }
 
         clockwise = !clockwise;
     }
+}
+
+
+void FTContour::BuildOutsets(PointVector* store)
+{
+    size_t size = PointCount();
+
+    if(outsets)
+    {
+        return;
+    }
+
+    if(!store)
+    {
+        store = &outsetPointList;
+        store->resize(0, FTPoint());
+        store->reserve(size);
+    }
+
+    outsets = store->begin() + store->size();
 
     for(size_t i = 0; i < size; i++)
     {
@@ -157,14 +168,28 @@ void FTContour::SetParity(int parity)
         cur = i;
         next = (i + size + 1) % size;
 
-        vOutset = ComputeOutsetPoint(Point(prev), Point(cur), Point(next));
-        AddOutsetPoint(vOutset);
+        store->push_back(ComputeOutsetPoint(Point(prev), Point(cur),
+                                            Point(next)));
     }
 }
 
 
-FTContour::FTContour(FT_Vector* contour, char* tags, unsigned int n)
+FTContour::FTContour(FT_Vector* contour, char* tags, unsigned int n,
+                     PointVector* store)
+:   pointCount(0),
+    pointStore(store),
+    outsets(0),
+    frontPoints(0),
+    backPoints(0)
 {
+    if(!pointStore)
+    {
+        pointStore = &pointList;
+        pointStore->reserve(MaxPointCount(n));
+    }
+
+    points = pointStore->begin() + pointStore->size();
+
     FTPoint prev, cur(contour[(n - 1) % n]), next(contour[0]);
     FTPoint a, b = next - cur;
     double olddir, dir = atan2((next - cur).Y(), (next - cur).X());
@@ -226,24 +251,58 @@ FTContour::FTContour(FT_Vector* contour, char* tags, unsigned int n)
 }
 
 
-void FTContour::buildFrontOutset(float outset)
+FTPoint* FTContour::BuildOutset(float outset, PointVector& store)
 {
-    frontPointList.clear();
+    BuildOutsets();
+
+    FTPoint* first = store.begin() + store.size();
 
     for(size_t i = 0; i < PointCount(); ++i)
     {
-        AddFrontPoint(Point(i) + Outset(i) * outset);
+        store.push_back(Point(i) + Outset(i) * outset);
     }
+
+    return first;
 }
 
 
-void FTContour::buildBackOutset(float outset)
+void FTContour::buildFrontOutset(float outset, PointVector* store)
 {
-    backPointList.clear();
+    frontPoints = NULL;
 
-    for(size_t i = 0; i < PointCount(); ++i)
+    // A zero outset leaves the points on the outline
+    if(!(outset < 0.0f || outset > 0.0f))
+    {
+        return;
+    }
+
+    if(!store)
     {
-        AddBackPoint(Point(i) + Outset(i) * outset);
+        store = &frontPointList;
+        store->resize(0, FTPoint());
+        store->reserve(PointCount());
     }
+
+    frontPoints = BuildOutset(outset, *store);
 }
 
+
+void FTContour::buildBackOutset(float outset, PointVector* store)
+{
+    backPoints = NULL;
+
+    // A zero outset leaves the points on the outline
+    if(!(outset < 0.0f || outset > 0.0f))
+    {
+        return;
+    }
+
+    if(!store)
+    {
+        store = &backPointList;
+        store->resize(0, FTPoint());
+        store->reserve(PointCount());
+    }
+
+    backPoints = BuildOutset(outset, *store);
+}
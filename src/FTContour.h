@@ -45,14 +45,22 @@
 class FTContour
 {
     public:
+        typedef FTVector<FTPoint> PointVector;
+
         /**
          * Constructor
          *
          * @param contour
          * @param pointTags
          * @param numberOfPoints
+         * @param store  Where to append the points of the contour, or
+         *               <code>NULL</code> to keep them in the contour.
+         *               It must have room for
+         *               <code>MaxPointCount(numberOfPoints)</code> more
+         *               points, as earlier contours point into it.
          */
-        FTContour(FT_Vector* contour, char* pointTags, unsigned int numberOfPoints);
+        FTContour(FT_Vector* contour, char* pointTags, unsigned int numberOfPoints,
+                  PointVector* store = NULL);
 
         /**
          * Destructor
@@ -65,21 +73,31 @@ class FTContour
             backPointList.clear();
         }
 
+        /**
+         * The most points a contour can have once its curves are
+         * evaluated.
+         *
+         * @param numberOfPoints  The number of points in the outline.
+         * @return  The largest possible <code>PointCount()</code>.
+         */
+        static size_t MaxPointCount(size_t numberOfPoints);
+
         /**
          * Return a point at index.
          *
          * @param index of the point in the curve.
          * @return const point reference
          */
-        const FTPoint& Point(size_t index) const { return pointList[index]; }
+        const FTPoint& Point(size_t index) const { return points[index]; }
 
         /**
-         * Return a point at index.
+         * Return a point at index. The outset vectors are only there once
+         * BuildOutsets() has been called.
          *
          * @param index of the point in the outset curve.
          * @return const point reference
          */
-        const FTPoint& Outset(size_t index) const { return outsetPointList[index]; }
+        const FTPoint& Outset(size_t index) const { return outsets[index]; }
 
         /**
          * Return a point at index of the front outset contour.
@@ -89,9 +107,9 @@ class FTContour
          */
         const FTPoint& FrontPoint(size_t index) const
         {
-            if(frontPointList.size() == 0)
+            if(!frontPoints)
                 return Point(index);
-            return frontPointList[index];
+            return frontPoints[index];
         }
 
 
@@ -103,9 +121,9 @@ class FTContour
          */
         const FTPoint& BackPoint(size_t index) const
         {
-            if(backPointList.size() == 0)
+            if(!backPoints)
                 return Point(index);
-             return backPointList[index];
+             return backPoints[index];
         }
 
         /**
@@ -113,45 +131,40 @@ class FTContour
          *
          * @return the number of points in this contour
          */
-        size_t PointCount() const { return pointList.size(); }
+        size_t PointCount() const { return pointCount; }
 
         /**
-         * Make sure the glyph has the proper parity and create the front/back
-         * outset contour.
+         * Make sure the glyph has the proper parity.
          *
          * @param parity  The contour's parity within the glyph.
          */
         void SetParity(int parity);
 
-        // FIXME: this should probably go away.
-        void buildFrontOutset(float outset);
-        void buildBackOutset(float outset);
-
-    private:
         /**
-         * Add a point to this contour. This function tests for duplicate
-         * points.
+         * Compute the outset vectors, unless they are already there.
          *
-         * @param point The point to be added to the contour.
+         * @param store  Where to append the outset vectors, or
+         *               <code>NULL</code> to keep them in the contour. It
+         *               must have room for <code>PointCount()</code> more.
          */
-        inline void AddPoint(FTPoint point);
+        void BuildOutsets(PointVector* store = NULL);
 
         /**
-         * Add a point to this contour. This function tests for duplicate
-         * points.
-         *
-         * @param point The point to be added to the contour.
+         * Create the front/back outset contour. A zero outset needs no
+         * points: FrontPoint() and BackPoint() then return Point().
          */
-        inline void AddOutsetPoint(FTPoint point);
+        // FIXME: this should probably go away.
+        void buildFrontOutset(float outset, PointVector* store = NULL);
+        void buildBackOutset(float outset, PointVector* store = NULL);
 
-        /*
-         * Add a point to this outset contour. This function tests for duplicate
+    private:
+        /**
+         * Add a point to this contour. This function tests for duplicate
          * points.
          *
-         * @param point The point to be added to the contour outset.
+         * @param point The point to be added to the contour.
          */
-        inline void AddFrontPoint(FTPoint point);
-        inline void AddBackPoint(FTPoint point);
+        inline void AddPoint(FTPoint point);
 
         /**
          * De Casteljau (bezier) algorithm contributed by Jed Soane
@@ -191,18 +204,47 @@ class FTContour
         inline FTPoint ComputeOutsetPoint(FTPoint a, FTPoint b, FTPoint c);
 
         /**
-         *  The list of points in this contour
+         * Append the outset points of the contour to a store.
+         *
+         * @return  The first of the new points.
+         */
+        FTPoint* BuildOutset(float outset, PointVector& store);
+
+        /**
+         *  The list of points in this contour, when it keeps its own
          */
-        typedef FTVector<FTPoint> PointVector;
         PointVector pointList;
         PointVector outsetPointList;
         PointVector frontPointList;
         PointVector backPointList;
 
+        /**
+         * The points of this contour, in its own lists or a shared store
+         */
+        FTPoint* points;
+        size_t pointCount;
+
+        /**
+         * The point store being appended to while the contour is built
+         */
+        PointVector* pointStore;
+
+        /**
+         * The outset vectors and the front and back outset points, or
+         * <code>NULL</code> until they are built.
+         */
+        FTPoint* outsets;
+        FTPoint* frontPoints;
+        FTPoint* backPoints;
+
         /**
          *  Is this contour clockwise or anti-clockwise?
          */
         bool clockwise;
+
+        /* Disallow copies: the point lists belong to the contour */
+        FTContour(const FTContour&);
+        FTContour& operator=(const FTContour&);
 };
 
 #endif // __FTContour__
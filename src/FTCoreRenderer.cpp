@@ -0,0 +1,506 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <stddef.h>
+
+#if !defined WIN32 && defined HAVE_DLFCN_H
+#   include <dlfcn.h>
+#endif
+
+#include "FTCoreRenderer.h"
+#include "FTVectoriser.h"
+
+
+/* OpenGL 2.0 to 3.3 names, for headers that stop at OpenGL 1.1 */
+#ifndef GL_ARRAY_BUFFER
+#   define GL_ARRAY_BUFFER 0x8892
+#   define GL_ARRAY_BUFFER_BINDING 0x8894
+#   define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_TEXTURE0
+#   define GL_TEXTURE0 0x84C0
+#   define GL_ACTIVE_TEXTURE 0x84E0
+#endif
+#ifndef GL_VERTEX_SHADER
+#   define GL_FRAGMENT_SHADER 0x8B30
+#   define GL_VERTEX_SHADER 0x8B31
+#   define GL_COMPILE_STATUS 0x8B81
+#   define GL_LINK_STATUS 0x8B82
+#   define GL_INFO_LOG_LENGTH 0x8B84
+#   define GL_CURRENT_PROGRAM 0x8B8D
+#endif
+#ifndef GL_VERTEX_ARRAY_BINDING
+#   define GL_VERTEX_ARRAY_BINDING 0x85B5
+#endif
+
+
+/**
+ * The OpenGL 3.3 functions used by the backend. Operating systems only
+ * export OpenGL 1.1 (Windows) or do not declare the newer functions
+ * without extension headers, so they are looked up once at run time.
+ */
+static struct
+{
+    void (APIENTRY *ActiveTexture)(GLenum);
+    void (APIENTRY *AttachShader)(GLuint, GLuint);
+    void (APIENTRY *BindBuffer)(GLenum, GLuint);
+    void (APIENTRY *BindVertexArray)(GLuint);
+    void (APIENTRY *BufferData)(GLenum, ptrdiff_t, const void *, GLenum);
+    void (APIENTRY *CompileShader)(GLuint);
+    GLuint (APIENTRY *CreateProgram)(void);
+    GLuint (APIENTRY *CreateShader)(GLenum);
+    void (APIENTRY *DeleteBuffers)(GLsizei, const GLuint *);
+    void (APIENTRY *DeleteProgram)(GLuint);
+    void (APIENTRY *DeleteShader)(GLuint);
+    void (APIENTRY *DeleteVertexArrays)(GLsizei, const GLuint *);
+    void (APIENTRY *EnableVertexAttribArray)(GLuint);
+    void (APIENTRY *GenBuffers)(GLsizei, GLuint *);
+    void (APIENTRY *GenVertexArrays)(GLsizei, GLuint *);
+    void (APIENTRY *GetProgramInfoLog)(GLuint, GLsizei, GLsizei *, char *);
+    void (APIENTRY *GetProgramiv)(GLuint, GLenum, GLint *);
+    void (APIENTRY *GetShaderInfoLog)(GLuint, GLsizei, GLsizei *, char *);
+    void (APIENTRY *GetShaderiv)(GLuint, GLenum, GLint *);
+    GLint (APIENTRY *GetUniformLocation)(GLuint, const char *);
+    void (APIENTRY *LinkProgram)(GLuint);
+    void (APIENTRY *ShaderSource)(GLuint, GLsizei, const char *const *,
+                                  const GLint *);
+    void (APIENTRY *Uniform1i)(GLint, GLint);
+    void (APIENTRY *UniformMatrix4fv)(GLint, GLsizei, GLboolean,
+                                      const GLfloat *);
+    void (APIENTRY *UseProgram)(GLuint);
+    void (APIENTRY *VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean,
+                                         GLsizei, const void *);
+} gl;
+
+
+static void *GetFunction(const char *name)
+{
+#if defined WIN32
+    return (void *)wglGetProcAddress(name);
+#elif defined HAVE_DLFCN_H
+    static void *self = dlopen(NULL, RTLD_LAZY);
+    return self ? dlsym(self, name) : NULL;
+#else
+    (void)name;
+    return NULL;
+#endif
+}
+
+
+template <typename T>
+static bool GetFunction(T& function, const char *name)
+{
+    function = reinterpret_cast<T>(GetFunction(name));
+    return function != NULL;
+}
+
+
+static bool LoadFunctions()
+{
+    static int loaded = 0;
+
+    if(!loaded)
+    {
+        bool ok = GetFunction(gl.ActiveTexture, "glActiveTexture")
+            && GetFunction(gl.AttachShader, "glAttachShader")
+            && GetFunction(gl.BindBuffer, "glBindBuffer")
+            && GetFunction(gl.BindVertexArray, "glBindVertexArray")
+            && GetFunction(gl.BufferData, "glBufferData")
+            && GetFunction(gl.CompileShader, "glCompileShader")
+            && GetFunction(gl.CreateProgram, "glCreateProgram")
+            && GetFunction(gl.CreateShader, "glCreateShader")
+            && GetFunction(gl.DeleteBuffers, "glDeleteBuffers")
+            && GetFunction(gl.DeleteProgram, "glDeleteProgram")
+            && GetFunction(gl.DeleteShader, "glDeleteShader")
+            && GetFunction(gl.DeleteVertexArrays, "glDeleteVertexArrays")
+            && GetFunction(gl.EnableVertexAttribArray,
+                           "glEnableVertexAttribArray")
+            && GetFunction(gl.GenBuffers, "glGenBuffers")
+            && GetFunction(gl.GenVertexArrays, "glGenVertexArrays")
+            && GetFunction(gl.GetProgramInfoLog, "glGetProgramInfoLog")
+            && GetFunction(gl.GetProgramiv, "glGetProgramiv")
+            && GetFunction(gl.GetShaderInfoLog, "glGetShaderInfoLog")
+            && GetFunction(gl.GetShaderiv, "glGetShaderiv")
+            && GetFunction(gl.GetUniformLocation, "glGetUniformLocation")
+            && GetFunction(gl.LinkProgram, "glLinkProgram")
+            && GetFunction(gl.ShaderSource, "glShaderSource")
+            && GetFunction(gl.Uniform1i, "glUniform1i")
+            && GetFunction(gl.UniformMatrix4fv, "glUniformMatrix4fv")
+            && GetFunction(gl.UseProgram, "glUseProgram")
+            && GetFunction(gl.VertexAttribPointer, "glVertexAttribPointer");
+
+        loaded = ok ? 1 : -1;
+    }
+
+    return loaded > 0;
+}
+
+
+static const char *vertexSource =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 position;\n"
+    "layout(location = 1) in vec2 texCoord;\n"
+    "layout(location = 2) in vec4 color;\n"
+    "uniform mat4 transform;\n"
+    "out vec2 fragmentTexCoord;\n"
+    "out vec4 fragmentColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragmentTexCoord = texCoord;\n"
+    "    fragmentColor = color;\n"
+    "    gl_Position = transform * vec4(position, 1.0);\n"
+    "}\n";
+
+
+/* The coverage of a texel modulates the alpha of the vertex colour, as
+ * GL_MODULATE does with the GL_ALPHA atlases of the fixed-function path */
+static const char *fragmentSource =
+    "#version 330 core\n"
+    "uniform sampler2D atlas;\n"
+    "uniform bool textured;\n"
+    "in vec2 fragmentTexCoord;\n"
+    "in vec4 fragmentColor;\n"
+    "out vec4 outputColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float coverage = 1.0;\n"
+    "    if(textured)\n"
+    "        coverage = texture(atlas, fragmentTexCoord).r;\n"
+    "    outputColor = vec4(fragmentColor.rgb,\n"
+    "                       fragmentColor.a * coverage);\n"
+    "}\n";
+
+
+/**
+ * Compile a shader, reporting errors on stderr.
+ *
+ * @return  The shader, or zero.
+ */
+static GLuint CompileShader(GLenum type, const char *source)
+{
+    GLuint shader = gl.CreateShader(type);
+    if(!shader)
+    {
+        // No current context
+        return 0;
+    }
+
+    gl.ShaderSource(shader, 1, &source, NULL);
+    gl.CompileShader(shader);
+
+    GLint status = GL_FALSE;
+    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if(status != GL_TRUE)
+    {
+        char log[1024] = "";
+        gl.GetShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "FTGL warning: core profile shader failed: %s\n",
+                log);
+        gl.DeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+
+FTCoreRenderer::FTCoreRenderer()
+:   state(CORE_UNINITIALISED),
+    program(0),
+    vertexArray(0),
+    vertexBuffer(0),
+    transformLocation(-1),
+    texturedLocation(-1),
+    savedProgram(0),
+    savedVertexArray(0),
+    savedBuffer(0),
+    savedActiveTexture(GL_TEXTURE0),
+    savedTexture(0)
+{}
+
+
+FTCoreRenderer::~FTCoreRenderer()
+{
+    if(state == CORE_READY)
+    {
+        gl.DeleteBuffers(1, &vertexBuffer);
+        gl.DeleteVertexArrays(1, &vertexArray);
+        gl.DeleteProgram(program);
+    }
+}
+
+
+bool FTCoreRenderer::Init()
+{
+    if(!LoadFunctions())
+    {
+        return false;
+    }
+
+    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER,
+                                          fragmentSource);
+    if(!vertexShader || !fragmentShader)
+    {
+        if(vertexShader) gl.DeleteShader(vertexShader);
+        if(fragmentShader) gl.DeleteShader(fragmentShader);
+        return false;
+    }
+
+    program = gl.CreateProgram();
+    gl.AttachShader(program, vertexShader);
+    gl.AttachShader(program, fragmentShader);
+    gl.LinkProgram(program);
+
+    // The program keeps the shaders alive as long as it needs them
+    gl.DeleteShader(vertexShader);
+    gl.DeleteShader(fragmentShader);
+
+    GLint status = GL_FALSE;
+    gl.GetProgramiv(program, GL_LINK_STATUS, &status);
+    if(status != GL_TRUE)
+    {
+        char log[1024] = "";
+        gl.GetProgramInfoLog(program, sizeof(log), NULL, log);
+        fprintf(stderr, "FTGL warning: core profile program failed: %s\n",
+                log);
+        gl.DeleteProgram(program);
+        program = 0;
+        return false;
+    }
+
+    transformLocation = gl.GetUniformLocation(program, "transform");
+    texturedLocation = gl.GetUniformLocation(program, "textured");
+
+    gl.UseProgram(program);
+    gl.Uniform1i(gl.GetUniformLocation(program, "atlas"), 0);
+
+    // The vertex array keeps the layout of the buffer, which is refilled
+    // for every string without changing its name.
+    gl.GenVertexArrays(1, &vertexArray);
+    gl.GenBuffers(1, &vertexBuffer);
+    gl.BindVertexArray(vertexArray);
+    gl.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+    const GLsizei stride = sizeof(FTCoreVertex);
+    gl.EnableVertexAttribArray(0);
+    gl.EnableVertexAttribArray(1);
+    gl.EnableVertexAttribArray(2);
+    gl.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+                           (const void *)offsetof(FTCoreVertex, position));
+    gl.VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+                           (const void *)offsetof(FTCoreVertex, texCoord));
+    gl.VertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride,
+                           (const void *)offsetof(FTCoreVertex, color));
+
+    return true;
+}
+
+
+bool FTCoreRenderer::Begin(const FTCoreVertex *vertices, GLsizei count,
+                           const GLfloat *transform)
+{
+    if(state == CORE_UNAVAILABLE || !LoadFunctions())
+    {
+        return false;
+    }
+
+    glGetIntegerv(GL_CURRENT_PROGRAM, &savedProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &savedVertexArray);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &savedBuffer);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &savedActiveTexture);
+
+    if(state == CORE_UNINITIALISED)
+    {
+        state = Init() ? CORE_READY : CORE_UNAVAILABLE;
+
+        if(state == CORE_UNAVAILABLE)
+        {
+            gl.UseProgram(savedProgram);
+            return false;
+        }
+    }
+
+    gl.ActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &savedTexture);
+
+    gl.UseProgram(program);
+    gl.BindVertexArray(vertexArray);
+    gl.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    gl.BufferData(GL_ARRAY_BUFFER, count * sizeof(FTCoreVertex), vertices,
+                  GL_STREAM_DRAW);
+    gl.UniformMatrix4fv(transformLocation, 1, GL_FALSE, transform);
+
+    return true;
+}
+
+
+void FTCoreRenderer::Draw(GLenum mode, GLint first, GLsizei count,
+                          GLuint texture)
+{
+    gl.Uniform1i(texturedLocation, texture ? 1 : 0);
+    if(texture)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    glDrawArrays(mode, first, count);
+}
+
+
+void FTCoreRenderer::End()
+{
+    glBindTexture(GL_TEXTURE_2D, savedTexture);
+    gl.ActiveTexture(savedActiveTexture);
+    gl.BindBuffer(GL_ARRAY_BUFFER, savedBuffer);
+    gl.BindVertexArray(savedVertexArray);
+    gl.UseProgram(savedProgram);
+}
+
+
+FTCoreVertex FTCoreRenderer::Vertex(GLfloat x, GLfloat y, GLfloat z,
+                                    GLfloat s, GLfloat t, GLfloat shade)
+{
+    FTCoreVertex vertex;
+
+    vertex.position[0] = x;
+    vertex.position[1] = y;
+    vertex.position[2] = z;
+    vertex.texCoord[0] = s;
+    vertex.texCoord[1] = t;
+    vertex.color[0] = vertex.color[1] = vertex.color[2] = shade;
+    vertex.color[3] = 1.0f;
+
+    return vertex;
+}
+
+
+void FTCoreRenderer::AppendMesh(FTVector<FTCoreVertex>& vertices,
+                                const FTMesh *mesh, GLfloat z,
+                                GLfloat hscale, GLfloat vscale,
+                                bool mirror)
+{
+    for(unsigned int t = 0; t < mesh->TesselationCount(); ++t)
+    {
+        const FTTesselation* subMesh = mesh->Tesselation(t);
+        GLenum polygonType = subMesh->PolygonType();
+        unsigned int count = subMesh->PointCount();
+
+        for(unsigned int i = 0; i < count; ++i)
+        {
+            // Corners of the triangle ending at point i, keeping the
+            // winding of strips and fans
+            unsigned int corner[3];
+
+            if(polygonType == GL_TRIANGLE_STRIP)
+            {
+                if(i < 2)
+                {
+                    continue;
+                }
+                corner[0] = (i & 1) ? i - 1 : i - 2;
+                corner[1] = (i & 1) ? i - 2 : i - 1;
+                corner[2] = i;
+            }
+            else if(polygonType == GL_TRIANGLE_FAN)
+            {
+                if(i < 2)
+                {
+                    continue;
+                }
+                corner[0] = 0;
+                corner[1] = i - 1;
+                corner[2] = i;
+            }
+            else
+            {
+                // GL_TRIANGLES
+                if(i % 3 != 2)
+                {
+                    continue;
+                }
+                corner[0] = i - 2;
+                corner[1] = i - 1;
+                corner[2] = i;
+            }
+
+            if(mirror)
+            {
+                unsigned int tmp = corner[1];
+                corner[1] = corner[2];
+                corner[2] = tmp;
+            }
+
+            for(int c = 0; c < 3; ++c)
+            {
+                const FTPoint& point = subMesh->Point(corner[c]);
+                vertices.push_back(Vertex(point.Xf() / 64.0f,
+                                          point.Yf() / 64.0f, z,
+                                          point.Xf() / hscale,
+                                          point.Yf() / vscale, 1.0f));
+            }
+        }
+    }
+}
+
+
+void FTCoreRenderer::AppendQuadStrip(FTVector<FTCoreVertex>& vertices,
+                                     const FTCoreVertex *strip,
+                                     size_t count)
+{
+    for(size_t i = 2; i + 1 < count; i += 2)
+    {
+        vertices.push_back(strip[i - 2]);
+        vertices.push_back(strip[i - 1]);
+        vertices.push_back(strip[i + 1]);
+
+        vertices.push_back(strip[i - 2]);
+        vertices.push_back(strip[i + 1]);
+        vertices.push_back(strip[i]);
+    }
+}
+
+
+void FTCoreRenderer::AppendMoved(FTVector<FTCoreVertex>& vertices,
+                                 const FTVector<FTCoreVertex>& glyph,
+                                 const FTPoint& pen, const GLfloat *color)
+{
+    const GLfloat x = pen.Xf(), y = pen.Yf(), z = pen.Zf();
+
+    for(size_t i = 0; i < glyph.size(); ++i)
+    {
+        FTCoreVertex vertex = glyph[i];
+
+        vertex.position[0] += x;
+        vertex.position[1] += y;
+        vertex.position[2] += z;
+        vertex.color[0] *= color[0];
+        vertex.color[1] *= color[1];
+        vertex.color[2] *= color[2];
+        vertex.color[3] *= color[3];
+
+        vertices.push_back(vertex);
+    }
+}
@@ -0,0 +1,206 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTCoreRenderer__
+#define     __FTCoreRenderer__
+
+#include "FTInternals.h"
+#include "FTVector.h"
+
+class FTMesh;
+
+/* OpenGL 3.3 names missing from the OpenGL 1.1 headers of some platforms */
+#ifndef GL_R8
+#   define GL_R8 0x8229
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#   define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+
+/**
+ * A vertex drawn by the core profile backend. The colour of glyph geometry
+ * is multiplied by the font colour when a string is drawn.
+ */
+struct FTCoreVertex
+{
+    GLfloat position[3];
+    GLfloat texCoord[2];
+    GLfloat color[4];
+};
+
+
+/**
+ * FTCoreRenderer draws the text of fonts created with
+ * FTGL::BACKEND_CORE_PROFILE, using only OpenGL 3.3 core profile calls: a
+ * shader program, a vertex array object and a streamed vertex buffer.
+ *
+ * Textured vertices sample the coverage of a glyph atlas from its red
+ * channel, so that atlases can be GL_R8 textures. The OpenGL objects are
+ * created when the first string is drawn, with the context current then,
+ * and the bindings changed while drawing are restored afterwards.
+ */
+class FTCoreRenderer
+{
+    public:
+        /**
+         * Constructor
+         */
+        FTCoreRenderer();
+
+        /**
+         * Destructor. Deletes the OpenGL objects, which needs the context
+         * they were created with to be current.
+         */
+        ~FTCoreRenderer();
+
+        /**
+         * Upload vertices to draw and bind the objects to draw them with.
+         *
+         * @param vertices  The vertices.
+         * @param count  The number of vertices.
+         * @param transform  The column-major matrix taking vertex positions
+         *                   to clip space.
+         * @return  <code>false</code> if the current context cannot run
+         *          the backend, in which case nothing is bound and
+         *          <code>End()</code> must not be called.
+         */
+        bool Begin(const FTCoreVertex *vertices, GLsizei count,
+                   const GLfloat *transform);
+
+        /**
+         * Draw a range of the uploaded vertices.
+         *
+         * @param mode  GL_TRIANGLES or GL_LINES.
+         * @param first  The first vertex.
+         * @param count  The number of vertices.
+         * @param texture  The atlas to sample, or zero for solid geometry.
+         */
+        void Draw(GLenum mode, GLint first, GLsizei count, GLuint texture);
+
+        /**
+         * Restore the bindings changed by <code>Begin()</code>.
+         */
+        void End();
+
+        /**
+         * Make a vertex.
+         *
+         * @param x, y, z  The position.
+         * @param s, t  The texture coordinates.
+         * @param shade  The grey level of the vertex colour.
+         */
+        static FTCoreVertex Vertex(GLfloat x, GLfloat y, GLfloat z,
+                                   GLfloat s, GLfloat t, GLfloat shade);
+
+        /**
+         * Append the tesselations of a glyph mesh as separate triangles,
+         * with positions and texture coordinates computed as the
+         * fixed-function glyphs do.
+         *
+         * @param vertices  The list to append to.
+         * @param mesh  The mesh, in 26.6 fixed point units.
+         * @param z  The depth of the mesh.
+         * @param hscale, vscale  The texture coordinate scales.
+         * @param mirror  Wind the triangles the other way round, for a
+         *                back face made from a front face mesh.
+         */
+        static void AppendMesh(FTVector<FTCoreVertex>& vertices,
+                               const FTMesh *mesh, GLfloat z,
+                               GLfloat hscale, GLfloat vscale,
+                               bool mirror = false);
+
+        /**
+         * Append a quad strip as separate triangles.
+         *
+         * @param vertices  The list to append to.
+         * @param strip  The vertices of the strip, two per step.
+         * @param count  The number of vertices of the strip.
+         */
+        static void AppendQuadStrip(FTVector<FTCoreVertex>& vertices,
+                                    const FTCoreVertex *strip,
+                                    size_t count);
+
+        /**
+         * Append the geometry of a glyph, moved to a pen position and
+         * tinted with a colour.
+         *
+         * @param vertices  The list to append to.
+         * @param glyph  The geometry of the glyph at the origin.
+         * @param pen  The pen position.
+         * @param color  The RGBA colour.
+         */
+        static void AppendMoved(FTVector<FTCoreVertex>& vertices,
+                                const FTVector<FTCoreVertex>& glyph,
+                                const FTPoint& pen, const GLfloat *color);
+
+    private:
+        /**
+         * Disallow copies.
+         */
+        FTCoreRenderer(const FTCoreRenderer&);
+        FTCoreRenderer& operator=(const FTCoreRenderer&);
+
+        /**
+         * Create the program, the vertex array and the vertex buffer.
+         *
+         * @return  <code>false</code> if the context has no OpenGL 3.3
+         *          core functions or the program does not build.
+         */
+        bool Init();
+
+        /**
+         * Whether <code>Init()</code> was tried, and whether it worked.
+         */
+        enum
+        {
+            CORE_UNINITIALISED,
+            CORE_READY,
+            CORE_UNAVAILABLE
+        } state;
+
+        /**
+         * OpenGL objects
+         */
+        GLuint program;
+        GLuint vertexArray;
+        GLuint vertexBuffer;
+
+        /**
+         * Uniform locations
+         */
+        GLint transformLocation;
+        GLint texturedLocation;
+
+        /**
+         * The bindings found by <code>Begin()</code>, put back by
+         * <code>End()</code>.
+         */
+        GLint savedProgram;
+        GLint savedVertexArray;
+        GLint savedBuffer;
+        GLint savedActiveTexture;
+        GLint savedTexture;
+};
+
+#endif  //  __FTCoreRenderer__
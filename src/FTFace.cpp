@@ -29,6 +29,7 @@
 #include "FTFace.h"
 #include "FTCleanup.h"
 #include "FTLibrary.h"
+#include "FTStats.h"
 
 #include FT_TRUETYPE_TABLES_H
 
@@ -36,13 +37,17 @@ FTFace::FTFace(const char* fontFilePath, bool precomputeKerning)
 :   numGlyphs(0),
     fontEncodingList(0),
     kerningCache(0),
+    stats(0),
     err(0)
 {
     const FT_Long DEFAULT_FACE_INDEX = 0;
+    const FTLibrary& library = FTLibrary::Instance();
     ftFace = new FT_Face;
 
-    err = FT_New_Face(*FTLibrary::Instance().GetLibrary(), fontFilePath,
+    library.Mutex().Lock();
+    err = FT_New_Face(*library.GetLibrary(), fontFilePath,
                       DEFAULT_FACE_INDEX, ftFace);
+    library.Mutex().Unlock();
     if(err)
     {
         delete ftFace;
@@ -67,14 +72,18 @@ FTFace::FTFace(const unsigned char *pBufferBytes, size_t bufferSizeInBytes,
 :   numGlyphs(0),
     fontEncodingList(0),
     kerningCache(0),
+    stats(0),
     err(0)
 {
     const FT_Long DEFAULT_FACE_INDEX = 0;
+    const FTLibrary& library = FTLibrary::Instance();
     ftFace = new FT_Face;
 
-    err = FT_New_Memory_Face(*FTLibrary::Instance().GetLibrary(),
+    library.Mutex().Lock();
+    err = FT_New_Memory_Face(*library.GetLibrary(),
                              (FT_Byte const *)pBufferBytes, (FT_Long)bufferSizeInBytes,
                              DEFAULT_FACE_INDEX, ftFace);
+    library.Mutex().Unlock();
     if(err)
     {
         delete ftFace;
@@ -102,6 +111,7 @@ FTFace::~FTFace()
     {
         FTCleanup::Instance()->UnregisterObject(&ftFace);
 
+        FTMutexLock lock(FTLibrary::Instance().Mutex());
         FT_Done_Face(*ftFace);
         delete ftFace;
         ftFace = 0;
@@ -111,6 +121,7 @@ FTFace::~FTFace()
 
 bool FTFace::Attach(const char* fontFilePath)
 {
+    FTMutexLock lock(FTLibrary::Instance().Mutex());
     err = FT_Attach_File(*ftFace, fontFilePath);
     return !err;
 }
@@ -125,6 +136,7 @@ bool FTFace::Attach(const unsigned char *pBufferBytes,
     open.memory_base = (FT_Byte const *)pBufferBytes;
     open.memory_size = (FT_Long)bufferSizeInBytes;
 
+    FTMutexLock lock(FTLibrary::Instance().Mutex());
     err = FT_Attach_Stream(*ftFace, &open);
     return !err;
 }
@@ -172,11 +184,21 @@ FTPoint FTFace::KernAdvance(unsigned int index1, unsigned int index2)
     if(kerningCache && index1 < FTFace::MAX_PRECOMPUTED
         && index2 < FTFace::MAX_PRECOMPUTED)
     {
+        if(stats)
+        {
+            stats->Add(FTGL::STAT_KERNING_CACHED);
+        }
+
         x = kerningCache[2 * (index2 * FTFace::MAX_PRECOMPUTED + index1)];
         y = kerningCache[2 * (index2 * FTFace::MAX_PRECOMPUTED + index1) + 1];
         return FTPoint(x, y);
     }
 
+    if(stats)
+    {
+        stats->Add(FTGL::STAT_KERNING_LOOKUPS);
+    }
+
     FT_Vector kernAdvance;
     kernAdvance.x = kernAdvance.y = 0;
 
@@ -196,6 +218,11 @@ FTPoint FTFace::KernAdvance(unsigned int index1, unsigned int index2)
 
 FT_GlyphSlot FTFace::Glyph(unsigned int index, FT_Int load_flags)
 {
+    if(stats)
+    {
+        stats->Add(FTGL::STAT_GLYPH_LOADS);
+    }
+
     err = FT_Load_Glyph(*ftFace, index, load_flags);
     if(err)
     {
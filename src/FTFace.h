@@ -34,6 +34,8 @@
 
 #include "FTSize.h"
 
+class FTStats;
+
 /**
  * FTFace class provides an abstraction layer for the Freetype Face.
  *
@@ -141,6 +143,14 @@ class FTFace
          */
         FT_Error Error() const { return err; }
 
+        /**
+         * Count the glyph loads and kerning lookups of this face.
+         *
+         * @param s  The statistics of the font using the face, or
+         *           <code>NULL</code> to stop counting.
+         */
+        void Stats(FTStats *s) { stats = s; }
+
     private:
         /**
          * The Freetype face
@@ -171,6 +181,11 @@ class FTFace
         static const unsigned int MAX_PRECOMPUTED = 128;
         FTGL_DOUBLE* kerningCache;
 
+        /**
+         * Statistics to count in, if any.
+         */
+        FTStats* stats;
+
         /**
          * Current error code. Zero means no error.
          */
@@ -98,3 +98,19 @@ FTPoint FTBitmapFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTBitmapFontImpl::Render(const FTGlyphRun *run, const int count,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTBitmapFontImpl::Render(const FTUnicodeText *text, const int len,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
@@ -51,6 +51,14 @@ class FTBitmapFontImpl : public FTFontImpl
                                FTPoint position, FTPoint spacing,
                                int renderMode);
 
+        virtual FTPoint Render(const FTGlyphRun *run, const int count,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
+        virtual FTPoint Render(const FTUnicodeText *text, const int len,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
     private:
         /* Internal generic Render() implementation */
         template <typename T>
@@ -31,6 +31,9 @@
 
 #include "FTInternals.h"
 #include "FTBufferFontImpl.h"
+#include "../FTGlyph/FTBufferGlyphImpl.h"
+#include "FTThreadPool.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -55,11 +58,7 @@ FTBufferFont::~FTBufferFont()
 
 FTGlyph* FTBufferFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 {
-    FTBufferFontImpl *myimpl = dynamic_cast<FTBufferFontImpl *>(impl);
-    if(!myimpl)
-    {
-        return NULL;
-    }
+    FTBufferFontImpl *myimpl = static_cast<FTBufferFontImpl *>(impl);
 
     return myimpl->MakeGlyphImpl(ftGlyph);
 }
@@ -220,10 +219,138 @@ inline wchar_t *StringCopy(wchar_t const *s, int len)
 }
 
 
+/* Glyph runs are not cached: the caller owns the arrays, and rendering
+ * pre-shaped glyphs usually means the text changes from frame to frame. */
+inline int StringCompare(void const *a, FTGlyphRun const *b, int len)
+{
+    (void)a; (void)b; (void)len;
+    return 1;
+}
+
+
+inline void *StringCopy(FTGlyphRun const *s, int len)
+{
+    (void)s; (void)len;
+    return NULL;
+}
+
+
+/* Length-delimited strings are not cached either, as the cached copies
+ * are compared as null-terminated strings. */
+inline int StringCompare(void const *a, FTUnicodeText const *b, int len)
+{
+    (void)a; (void)b; (void)len;
+    return 1;
+}
+
+
+inline void *StringCopy(FTUnicodeText const *s, int len)
+{
+    (void)s; (void)len;
+    return NULL;
+}
+
+
+/* Strings with fewer glyphs than this are blitted in the calling thread. */
+static const unsigned int PARALLEL_BLIT_MIN_GLYPHS = 64;
+
+/* Minimum height of a band of rows handed to a worker thread. */
+static const int PARALLEL_BLIT_MIN_ROWS = 8;
+
+
+struct BlitBands
+{
+    const FTBufferGlyphImpl * const *glyphs;
+    const FTPointf *pens;
+    int count;
+    int bandHeight;
+    int height;
+};
+
+
+static void BlitBand(void *data, int index)
+{
+    const BlitBands *bands = static_cast<const BlitBands *>(data);
+    int top = index * bands->bandHeight;
+    int bottom = top + bands->bandHeight < bands->height
+                  ? top + bands->bandHeight : bands->height;
+
+    // Glyphs are drawn in string order within each band, so overlapping
+    // glyphs end up exactly as in a serial render.
+    for(int i = 0; i < bands->count; i++)
+    {
+        bands->glyphs[i]->RenderRows(bands->pens[i], top, bottom);
+    }
+}
+
+
 template <typename T>
-inline FTPoint FTBufferFontImpl::RenderI(const T* string, const int len,
-                                         FTPoint position, FTPoint spacing,
-                                         int renderMode)
+FTPoint FTBufferFontImpl::BlitI(const T* string, const int len,
+                                FTPoint spacing, int renderMode)
+{
+    placements.resize(0, GlyphPlacement());
+    FTPoint advance = PlaceGlyphs(string, len, FTPoint(), spacing,
+                                  placements, renderMode);
+
+    int count = (int)placements.size();
+    FTVector<const FTBufferGlyphImpl *> glyphs;
+    FTVector<FTPointf> pens;
+    glyphs.reserve(count);
+    pens.reserve(count);
+
+    for(int i = 0; i < count; i++)
+    {
+        const FTGlyphImpl *glyph = placements[i].glyph->impl;
+
+        // A subclass produced its own glyph type: let it draw itself.
+        if(glyph->Kind() != FTGlyphImpl::GLYPH_BUFFER)
+        {
+            return FTFontImpl::Render(string, len, FTPoint(), spacing,
+                                      renderMode);
+        }
+
+        glyphs.push_back(static_cast<const FTBufferGlyphImpl *>(glyph));
+        pens.push_back(placements[i].pen);
+    }
+
+    if(!count)
+    {
+        return advance;
+    }
+
+    FTThreadPool& pool = FTThreadPool::Instance();
+    int numBands = 1;
+
+    if(placements.size() >= PARALLEL_BLIT_MIN_GLYPHS)
+    {
+        numBands = buffer->Height() / PARALLEL_BLIT_MIN_ROWS;
+        if(numBands > pool.ThreadCount())
+        {
+            numBands = pool.ThreadCount();
+        }
+        if(numBands < 1)
+        {
+            numBands = 1;
+        }
+    }
+
+    BlitBands bands;
+    bands.glyphs = &glyphs[0];
+    bands.pens = &pens[0];
+    bands.count = count;
+    bands.height = buffer->Height();
+    bands.bandHeight = (bands.height + numBands - 1) / numBands;
+
+    pool.Run(BlitBand, &bands, numBands);
+
+    return advance;
+}
+
+
+template <typename T>
+FTPoint FTBufferFontImpl::RenderI(const T* string, const int len,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
 {
     const float padding = 3.0f;
     int width, height, texWidth, texHeight;
@@ -252,6 +379,9 @@ inline FTPoint FTBufferFontImpl::RenderI(const T* string, const int len,
         }
     }
 
+    stats.Add(inCache ? FTGL::STAT_BUFFER_CACHE_HITS
+                      : FTGL::STAT_BUFFER_CACHE_MISSES);
+
     // If the string was not found, we need to put it in the cache and compute
     // its new bounding box.
     if(!inCache)
@@ -289,8 +419,9 @@ inline FTPoint FTBufferFontImpl::RenderI(const T* string, const int len,
         buffer->Size(texWidth, texHeight);
         buffer->Pos(FTPoint(padding, padding) - bbox.Lower());
 
-        advanceCache[cacheIndex] =
-              FTFontImpl::Render(string, len, FTPoint(), spacing, renderMode);
+        advanceCache[cacheIndex] = BlitI(string, len, spacing, renderMode);
+
+        FTGL_TRACE_SPAN(FTGL::TRACE_UPLOAD, 0, 0, 0);
 
         glBindTexture(GL_TEXTURE_2D, idCache[cacheIndex]);
 
@@ -346,3 +477,19 @@ FTPoint FTBufferFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTBufferFontImpl::Render(const FTGlyphRun *run, const int count,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTBufferFontImpl::Render(const FTUnicodeText *text, const int len,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
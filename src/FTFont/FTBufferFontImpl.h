@@ -51,6 +51,14 @@ class FTBufferFontImpl : public FTFontImpl
                                FTPoint position, FTPoint spacing,
                                int renderMode);
 
+        virtual FTPoint Render(const FTGlyphRun *run, const int count,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
+        virtual FTPoint Render(const FTUnicodeText *text, const int len,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
         virtual bool FaceSize(const unsigned int size,
                               const unsigned int res);
 
@@ -62,8 +70,18 @@ class FTBufferFontImpl : public FTFontImpl
 
         /* Internal generic Render() implementation */
         template <typename T>
-        inline FTPoint RenderI(const T *s, const int len,
-                               FTPoint position, FTPoint spacing, int mode);
+        FTPoint RenderI(const T *s, const int len,
+                        FTPoint position, FTPoint spacing, int mode);
+
+        /* Draw a string into the pixel buffer. Long strings are split into
+         * bands of rows that are blitted from the shared thread pool. */
+        template <typename T>
+        FTPoint BlitI(const T *s, const int len,
+                      FTPoint spacing, int mode);
+
+        /* Glyph positions of the string being blitted, kept around so that
+         * the storage is reused between strings */
+        FTVector<GlyphPlacement> placements;
 
         /* Pixel buffer */
         FTBuffer *buffer;
@@ -48,17 +48,27 @@ FTExtrudeFont::FTExtrudeFont(const unsigned char *pBufferBytes,
 {}
 
 
+FTExtrudeFont::FTExtrudeFont(char const *fontFilePath,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTExtrudeFontImpl(this, fontFilePath, backend))
+{}
+
+
+FTExtrudeFont::FTExtrudeFont(const unsigned char *pBufferBytes,
+                             size_t bufferSizeInBytes,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTExtrudeFontImpl(this, pBufferBytes, bufferSizeInBytes,
+                                 backend))
+{}
+
+
 FTExtrudeFont::~FTExtrudeFont()
 {}
 
 
 FTGlyph* FTExtrudeFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 {
-    FTExtrudeFontImpl *myimpl = dynamic_cast<FTExtrudeFontImpl *>(impl);
-    if(!myimpl)
-    {
-        return NULL;
-    }
+    FTExtrudeFontImpl *myimpl = static_cast<FTExtrudeFontImpl *>(impl);
 
     return new FTExtrudeGlyph(ftGlyph, myimpl->depth, myimpl->front,
                               myimpl->back, myimpl->useDisplayLists);
@@ -70,20 +80,26 @@ FTGlyph* FTExtrudeFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 //
 
 
-FTExtrudeFontImpl::FTExtrudeFontImpl(FTFont *ftFont, const char* fontFilePath)
+FTExtrudeFontImpl::FTExtrudeFontImpl(FTFont *ftFont, const char* fontFilePath,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, fontFilePath),
   depth(0.0f), front(0.0f), back(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    UseBackend(renderBackend);
 }
 
 
 FTExtrudeFontImpl::FTExtrudeFontImpl(FTFont *ftFont,
                                      const unsigned char *pBufferBytes,
-                                     size_t bufferSizeInBytes)
+                                     size_t bufferSizeInBytes,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, pBufferBytes, bufferSizeInBytes),
   depth(0.0f), front(0.0f), back(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    UseBackend(renderBackend);
 }
 
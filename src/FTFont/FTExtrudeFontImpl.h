@@ -36,17 +36,21 @@ class FTExtrudeFontImpl : public FTFontImpl
     friend class FTExtrudeFont;
 
     protected:
-        FTExtrudeFontImpl(FTFont *ftFont, const char* fontFilePath);
+        FTExtrudeFontImpl(FTFont *ftFont, const char* fontFilePath,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         FTExtrudeFontImpl(FTFont *ftFont, const unsigned char *pBufferBytes,
-                          size_t bufferSizeInBytes);
+                          size_t bufferSizeInBytes,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         /**
          * Set the extrusion distance for the font.
          *
          * @param d  The extrusion distance.
          */
-        virtual void Depth(float d) { depth = d; }
+        virtual void Depth(float d) { depth = d; FlushCompiled(); }
 
         /**
          * Set the outset distance for the font. Only implemented by
@@ -54,7 +58,7 @@ class FTExtrudeFontImpl : public FTFontImpl
          *
          * @param o  The outset distance.
          */
-        virtual void Outset(float o) { front = back = o; }
+        virtual void Outset(float o) { front = back = o; FlushCompiled(); }
 
         /**
          * Set the outset distance for the font. Only implemented by
@@ -63,7 +67,12 @@ class FTExtrudeFontImpl : public FTFontImpl
          * @param f  The front outset distance.
          * @param b  The back outset distance.
          */
-        virtual void Outset(float f, float b) { front = f; back = b; }
+        virtual void Outset(float f, float b)
+        {
+            front = f;
+            back = b;
+            FlushCompiled();
+        }
 
     private:
         /**
@@ -39,8 +39,11 @@
 #include "FTPolygonFontImpl.h"
 #include "FTTextureFontImpl.h"
 
+#include "../FTGlyph/FTGlyphImpl.h"
 #include "FTGlyphContainer.h"
+#include "FTBidi.h"
 #include "FTFace.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -74,18 +77,21 @@ FTFont::~FTFont()
 
 bool FTFont::Attach(const char* fontFilePath)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Attach(fontFilePath);
 }
 
 
 bool FTFont::Attach(const unsigned char *pBufferBytes, size_t bufferSizeInBytes)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Attach(pBufferBytes, bufferSizeInBytes);
 }
 
 
 bool FTFont::FaceSize(const unsigned int size, const unsigned int res)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->FaceSize(size, res);
 }
 
@@ -98,30 +104,35 @@ unsigned int FTFont::FaceSize() const
 
 void FTFont::Depth(float depth)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Depth(depth);
 }
 
 
 void FTFont::Outset(float outset)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Outset(outset);
 }
 
 
 void FTFont::Outset(float front, float back)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Outset(front, back);
 }
 
 
 void FTFont::GlyphLoadFlags(FT_Int flags)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->GlyphLoadFlags(flags);
 }
 
 
 bool FTFont::CharMap(FT_Encoding encoding)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->CharMap(encoding);
 }
 
@@ -134,16 +145,65 @@ unsigned int FTFont::CharMapCount() const
 
 FT_Encoding* FTFont::CharMapList()
 {
+    FTMutexLock lock(impl->mutex);
     return impl->CharMapList();
 }
 
 
+void FTFont::Shaper(FTShaper *shaper)
+{
+    FTMutexLock lock(impl->mutex);
+    impl->Shaper(shaper);
+}
+
+
+FTShaper* FTFont::Shaper() const
+{
+    return impl->Shaper();
+}
+
+
 void FTFont::UseDisplayList(bool useList)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->UseDisplayList(useList);
 }
 
 
+void FTFont::BeginBatch()
+{
+    FTMutexLock lock(impl->mutex);
+    return impl->BeginBatch();
+}
+
+
+void FTFont::EndBatch()
+{
+    FTMutexLock lock(impl->mutex);
+    return impl->EndBatch();
+}
+
+
+FTGL::RenderBackend FTFont::Backend() const
+{
+    return impl->Backend();
+}
+
+
+void FTFont::Transform(const float *matrix)
+{
+    FTMutexLock lock(impl->mutex);
+    return impl->Transform(matrix);
+}
+
+
+void FTFont::Color(float red, float green, float blue, float alpha)
+{
+    FTMutexLock lock(impl->mutex);
+    return impl->Color(red, green, blue, alpha);
+}
+
+
 float FTFont::Ascender() const
 {
     return impl->Ascender();
@@ -165,6 +225,10 @@ float FTFont::LineHeight() const
 FTPoint FTFont::Render(const char * string, const int len,
                        FTPoint position, FTPoint spacing, int renderMode)
 {
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
     return impl->Render(string, len, position, spacing, renderMode);
 }
 
@@ -172,18 +236,24 @@ FTPoint FTFont::Render(const char * string, const int len,
 FTPoint FTFont::Render(const wchar_t * string, const int len,
                        FTPoint position, FTPoint spacing, int renderMode)
 {
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
     return impl->Render(string, len, position, spacing, renderMode);
 }
 
 
 float FTFont::Advance(const char * string, const int len, FTPoint spacing)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Advance(string, len, spacing);
 }
 
 
 float FTFont::Advance(const wchar_t * string, const int len, FTPoint spacing)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->Advance(string, len, spacing);
 }
 
@@ -191,6 +261,7 @@ float FTFont::Advance(const wchar_t * string, const int len, FTPoint spacing)
 FTBBox FTFont::BBox(const char *string, const int len,
                     FTPoint position, FTPoint spacing)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->BBox(string, len, position, spacing);
 }
 
@@ -198,16 +269,178 @@ FTBBox FTFont::BBox(const char *string, const int len,
 FTBBox FTFont::BBox(const wchar_t *string, const int len,
                     FTPoint position, FTPoint spacing)
 {
+    FTMutexLock lock(impl->mutex);
     return impl->BBox(string, len, position, spacing);
 }
 
 
+FTPoint FTFont::RenderGlyphs(const unsigned int *glyphs,
+                             const FTPoint *positions, const int count,
+                             FTPoint position, FTPoint spacing, int renderMode)
+{
+    FTGlyphRun run = { glyphs, positions };
+
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
+    return impl->Render(&run, count, position, spacing, renderMode);
+}
+
+
+float FTFont::AdvanceGlyphs(const unsigned int *glyphs,
+                            const FTPoint *positions, const int count,
+                            FTPoint spacing)
+{
+    FTGlyphRun run = { glyphs, positions };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->Advance(&run, count, spacing);
+}
+
+
+FTBBox FTFont::BBoxGlyphs(const unsigned int *glyphs,
+                          const FTPoint *positions, const int count,
+                          FTPoint position, FTPoint spacing)
+{
+    FTGlyphRun run = { glyphs, positions };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->BBox(&run, count, position, spacing);
+}
+
+
+FTBBox FTFont::BBoxUTF8(const char *string, const int len,
+                        FTPoint position, FTPoint spacing)
+{
+    FTUnicodeText text = { (const unsigned char *)string, NULL, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->BBox(&text, len, position, spacing);
+}
+
+
+FTBBox FTFont::BBoxUTF16(const unsigned short *string, const int len,
+                         FTPoint position, FTPoint spacing)
+{
+    FTUnicodeText text = { NULL, string, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->BBox(&text, len, position, spacing);
+}
+
+
+FTBBox FTFont::BBoxUTF32(const unsigned int *string, const int len,
+                         FTPoint position, FTPoint spacing)
+{
+    FTUnicodeText text = { NULL, NULL, string };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->BBox(&text, len, position, spacing);
+}
+
+
+float FTFont::AdvanceUTF8(const char *string, const int len,
+                          FTPoint spacing)
+{
+    FTUnicodeText text = { (const unsigned char *)string, NULL, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->Advance(&text, len, spacing);
+}
+
+
+float FTFont::AdvanceUTF16(const unsigned short *string, const int len,
+                           FTPoint spacing)
+{
+    FTUnicodeText text = { NULL, string, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->Advance(&text, len, spacing);
+}
+
+
+float FTFont::AdvanceUTF32(const unsigned int *string, const int len,
+                           FTPoint spacing)
+{
+    FTUnicodeText text = { NULL, NULL, string };
+
+    FTMutexLock lock(impl->mutex);
+    return impl->Advance(&text, len, spacing);
+}
+
+
+FTPoint FTFont::RenderUTF8(const char *string, const int len,
+                           FTPoint position, FTPoint spacing, int renderMode)
+{
+    FTUnicodeText text = { (const unsigned char *)string, NULL, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
+    return impl->Render(&text, len, position, spacing, renderMode);
+}
+
+
+FTPoint FTFont::RenderUTF16(const unsigned short *string, const int len,
+                            FTPoint position, FTPoint spacing, int renderMode)
+{
+    FTUnicodeText text = { NULL, string, NULL };
+
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
+    return impl->Render(&text, len, position, spacing, renderMode);
+}
+
+
+FTPoint FTFont::RenderUTF32(const unsigned int *string, const int len,
+                            FTPoint position, FTPoint spacing, int renderMode)
+{
+    FTUnicodeText text = { NULL, NULL, string };
+
+    FTMutexLock lock(impl->mutex);
+    FTStatsTimer timer(impl->stats, FTGL::STAT_RENDER_CALLS,
+                       FTGL::STAT_RENDER_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_RENDER, this, 0, 0);
+    return impl->Render(&text, len, position, spacing, renderMode);
+}
+
+
 FT_Error FTFont::Error() const
 {
     return impl->err;
 }
 
 
+FTGL_UINT64 FTFont::GetStatistic(FTGL::Statistic which) const
+{
+    FTMutexLock lock(impl->mutex);
+    return impl->stats.Get(which);
+}
+
+
+void FTFont::ResetStatistics()
+{
+    FTMutexLock lock(impl->mutex);
+    impl->stats.Reset();
+}
+
+
+FTGL_UINT64 FTFont::GetGlobalStatistic(FTGL::Statistic which)
+{
+    return FTStats::Global(which);
+}
+
+
+void FTFont::ResetGlobalStatistics()
+{
+    FTStats::ResetGlobal();
+}
+
+
 //
 //  FTFontImpl
 //
@@ -217,9 +450,23 @@ FTFontImpl::FTFontImpl(FTFont *ftFont, char const *fontFilePath) :
     face(fontFilePath),
     useDisplayLists(true),
     load_flags(FT_LOAD_DEFAULT),
+    stats(mutex),
+    backend(FTGL::BACKEND_FIXED_FUNCTION),
+    corePrimitive(GL_TRIANGLES),
+    compileStrings(false),
     intf(ftFont),
-    glyphList(0)
+    glyphList(0),
+    lastVisual(0),
+    shaper(0),
+    lastShaped(0),
+    lastCompiled(0),
+    revision(0)
 {
+    Transform(NULL);
+    Color(1.0f, 1.0f, 1.0f, 1.0f);
+
+    face.Stats(&stats);
+
     err = face.Error();
     if(err == 0)
     {
@@ -233,9 +480,23 @@ FTFontImpl::FTFontImpl(FTFont *ftFont, const unsigned char *pBufferBytes,
     face(pBufferBytes, bufferSizeInBytes),
     useDisplayLists(true),
     load_flags(FT_LOAD_DEFAULT),
+    stats(mutex),
+    backend(FTGL::BACKEND_FIXED_FUNCTION),
+    corePrimitive(GL_TRIANGLES),
+    compileStrings(false),
     intf(ftFont),
-    glyphList(0)
+    glyphList(0),
+    lastVisual(0),
+    shaper(0),
+    lastShaped(0),
+    lastCompiled(0),
+    revision(0)
 {
+    Transform(NULL);
+    Color(1.0f, 1.0f, 1.0f, 1.0f);
+
+    face.Stats(&stats);
+
     err = face.Error();
     if(err == 0)
     {
@@ -246,6 +507,8 @@ FTFontImpl::FTFontImpl(FTFont *ftFont, const unsigned char *pBufferBytes,
 
 FTFontImpl::~FTFontImpl()
 {
+    FlushCompiled();
+
     if(glyphList)
     {
         delete glyphList;
@@ -255,6 +518,9 @@ FTFontImpl::~FTFontImpl()
 
 bool FTFontImpl::Attach(const char* fontFilePath)
 {
+    FlushShaped();
+    FlushCompiled();
+
     if(!face.Attach(fontFilePath))
     {
         err = face.Error();
@@ -269,6 +535,9 @@ bool FTFontImpl::Attach(const char* fontFilePath)
 bool FTFontImpl::Attach(const unsigned char *pBufferBytes,
                         size_t bufferSizeInBytes)
 {
+    FlushShaped();
+    FlushCompiled();
+
     if(!face.Attach(pBufferBytes, bufferSizeInBytes))
     {
         err = face.Error();
@@ -282,6 +551,9 @@ bool FTFontImpl::Attach(const unsigned char *pBufferBytes,
 
 bool FTFontImpl::FaceSize(const unsigned int size, const unsigned int res)
 {
+    FlushShaped();
+    FlushCompiled();
+
     if(glyphList != NULL)
     {
         delete glyphList;
@@ -327,12 +599,17 @@ void FTFontImpl::Outset(float front, float back)
 
 void FTFontImpl::GlyphLoadFlags(FT_Int flags)
 {
+    FlushShaped();
+    FlushCompiled();
     load_flags = flags;
 }
 
 
 bool FTFontImpl::CharMap(FT_Encoding encoding)
 {
+    FlushShaped();
+    FlushCompiled();
+
     bool result = glyphList->CharMap(encoding);
     err = glyphList->Error();
     return result;
@@ -351,204 +628,1183 @@ FT_Encoding* FTFontImpl::CharMapList()
 }
 
 
-void FTFontImpl::UseDisplayList(bool useList)
+void FTFontImpl::Shaper(FTShaper *s)
 {
-    useDisplayLists = useList;
+    FlushShaped();
+    FlushCompiled();
+    shaper = s;
 }
 
 
-float FTFontImpl::Ascender() const
+FTShaper* FTFontImpl::Shaper() const
 {
-    return charSize.Ascender();
+    return shaper;
 }
 
 
-float FTFontImpl::Descender() const
+void FTFontImpl::UseDisplayList(bool useList)
 {
-    return charSize.Descender();
+    FlushCompiled();
+    useDisplayLists = useList && backend != FTGL::BACKEND_CORE_PROFILE;
 }
 
 
-float FTFontImpl::LineHeight() const
+void FTFontImpl::BeginBatch()
 {
-    return charSize.Height();
 }
 
 
-template <typename T>
-inline FTBBox FTFontImpl::BBoxI(const T* string, const int len,
-                                FTPoint position, FTPoint spacing)
+void FTFontImpl::EndBatch()
 {
-    FTBBox totalBBox;
+}
 
-    /* Only compute the bounds if string is non-empty. */
-    if(string && ('\0' != string[0]))
+
+FTGL::RenderBackend FTFontImpl::Backend() const
+{
+    return backend;
+}
+
+
+void FTFontImpl::Transform(const float *matrix)
+{
+    for(int i = 0; i < 16; i++)
     {
-        // for multibyte - we can't rely on sizeof(T) == character
-        FTUnicodeStringItr<T> ustr(string);
-        unsigned int thisChar = *ustr++;
-        unsigned int nextChar = *ustr;
+        coreTransform[i] = matrix ? matrix[i] : (i % 5 ? 0.0f : 1.0f);
+    }
+}
 
-        if(CheckGlyph(thisChar))
-        {
-            totalBBox = glyphList->BBox(thisChar);
-            totalBBox += position;
 
-            position += FTPoint(glyphList->Advance(thisChar, nextChar), 0.0);
-        }
+void FTFontImpl::Color(float red, float green, float blue, float alpha)
+{
+    coreColor[0] = red;
+    coreColor[1] = green;
+    coreColor[2] = blue;
+    coreColor[3] = alpha;
+}
 
-        /* Expand totalBox by each glyph in string */
-        for(int i = 1; (len < 0 && *ustr) || (len >= 0 && i < len); i++)
-        {
-            thisChar = *ustr++;
-            nextChar = *ustr;
 
-            if(CheckGlyph(thisChar))
-            {
-                position += spacing;
+void FTFontImpl::UseBackend(FTGL::RenderBackend renderBackend)
+{
+    backend = renderBackend;
 
-                FTBBox tempBBox = glyphList->BBox(thisChar);
-                tempBBox += position;
-                totalBBox |= tempBBox;
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        // Glyphs keep their outlines to build vertex data from
+        useDisplayLists = false;
+        compileStrings = false;
+    }
+}
 
-                position += FTPoint(glyphList->Advance(thisChar, nextChar),
-                                    0.0);
-            }
-        }
+
+void FTFontImpl::DrawCore(int renderMode)
+{
+    coreVertices.resize(0, FTCoreVertex());
+
+    for(size_t i = 0; i < corePlacements.size(); i++)
+    {
+        const GlyphPlacement& placement = corePlacements[i];
+        placement.glyph->impl->AppendCore(coreVertices, placement.pen,
+                                          renderMode, coreColor);
     }
 
-    return totalBBox;
+    GLsizei count = (GLsizei)coreVertices.size();
+    if(count && core.Begin(&coreVertices[0], count, coreTransform))
+    {
+        core.Draw(corePrimitive, 0, count, 0);
+        core.End();
+    }
 }
 
 
-FTBBox FTFontImpl::BBox(const char *string, const int len,
-                        FTPoint position, FTPoint spacing)
+float FTFontImpl::Ascender() const
 {
-    /* The chars need to be unsigned because they are cast to int later */
-    return BBoxI((const unsigned char *)string, len, position, spacing);
+    return charSize.Ascender();
 }
 
 
-FTBBox FTFontImpl::BBox(const wchar_t *string, const int len,
-                        FTPoint position, FTPoint spacing)
+float FTFontImpl::Descender() const
 {
-    return BBoxI(string, len, position, spacing);
+    return charSize.Descender();
 }
 
 
-template <typename T>
-inline float FTFontImpl::AdvanceI(const T* string, const int len,
-                                  FTPoint spacing)
+float FTFontImpl::LineHeight() const
 {
-    float advance = 0.0f;
-    FTUnicodeStringItr<T> ustr(string);
+    return charSize.Height();
+}
+
+
+FTFontImpl::VisualString::~VisualString()
+{
+}
+
+
+const unsigned int *FTFontImpl::VisualI(const unsigned int *chars,
+                                        const int count)
+{
+    // Nothing before the Hebrew block can change the order of a string
+    int first = 0;
+    while(first < count && chars[first] < 0x590)
+    {
+        first++;
+    }
+
+    if(first == count || !FTBidi::IsMixed(chars, count))
+    {
+        return NULL;
+    }
 
-    for(int i = 0; (len < 0 && *ustr) || (len >= 0 && i < len); i++)
+    // Look for the string among the last ones, most recent first
+    for(int n = 0; n < VISUAL_CACHE_SIZE; n++)
     {
-        unsigned int thisChar = *ustr++;
-        unsigned int nextChar = *ustr;
+        VisualString &entry =
+            visualCache[(lastVisual - n + VISUAL_CACHE_SIZE) % VISUAL_CACHE_SIZE];
 
-        if(CheckGlyph(thisChar))
+        if((int)entry.text.size() != count)
         {
-            advance += glyphList->Advance(thisChar, nextChar);
+            continue;
         }
 
-        if(nextChar)
+        int i = 0;
+        while(i < count && entry.text[i] == chars[i])
         {
-            advance += spacing.Xf();
+            i++;
+        }
+
+        if(i == count)
+        {
+            return &entry.visual[0];
         }
     }
 
-    return advance;
-}
+    lastVisual = (lastVisual + 1) % VISUAL_CACHE_SIZE;
+    VisualString &entry = visualCache[lastVisual];
 
+    visualLevels.resize(count, 0);
+    visualOrder.resize(count, 0);
+    FTBidi::Resolve(chars, count, &visualLevels[0]);
+    FTBidi::Reorder(chars, &visualLevels[0], count,
+                    FTBidi::ParagraphLevel(chars, count),
+                    &visualOrder[0]);
 
-float FTFontImpl::Advance(const char* string, const int len, FTPoint spacing)
-{
-    /* The chars need to be unsigned because they are cast to int later */
-    const unsigned char *ustring = (const unsigned char *)string;
-    return AdvanceI(ustring, len, spacing);
+    entry.text.resize(0, 0);
+    entry.visual.resize(0, 0);
+    for(int i = 0; i < count; i++)
+    {
+        int index = visualOrder[i];
+        entry.text.push_back(chars[i]);
+        entry.visual.push_back((visualLevels[index] & 1)
+                                ? FTBidi::Mirror(chars[index])
+                                : chars[index]);
+    }
+    entry.visual.push_back(0);
+
+    return &entry.visual[0];
 }
 
 
-float FTFontImpl::Advance(const wchar_t* string, const int len, FTPoint spacing)
+void FTFontImpl::FlushShaped()
 {
-    return AdvanceI(string, len, spacing);
+    for(int n = 0; n < SHAPED_CACHE_SIZE; n++)
+    {
+        shapedCache[n].text.resize(0, 0);
+    }
 }
 
 
-template <typename T>
-inline FTPoint FTFontImpl::RenderI(const T* string, const int len,
-                                   FTPoint position, FTPoint spacing,
-                                   int renderMode)
+void FTFontImpl::FlushCompiled()
 {
-    // for multibyte - we can't rely on sizeof(T) == character
-    FTUnicodeStringItr<T> ustr(string);
+    ++revision;
 
-    for(int i = 0; (len < 0 && *ustr) || (len >= 0 && i < len); i++)
+    for(int n = 0; n < COMPILED_CACHE_SIZE; n++)
     {
-        unsigned int thisChar = *ustr++;
-        unsigned int nextChar = *ustr;
+        CompiledString &entry = compiledCache[n];
 
-        if(CheckGlyph(thisChar))
+        if(entry.glList)
         {
-            position += glyphList->Render(thisChar, nextChar,
-                                          position, renderMode);
+            glDeleteLists(entry.glList, 1);
+            entry.glList = 0;
         }
 
-        if(nextChar)
-        {
-            position += spacing;
-        }
+        entry.text.resize(0, 0);
     }
-
-    return position;
 }
 
 
-FTPoint FTFontImpl::Render(const char * string, const int len,
-                           FTPoint position, FTPoint spacing, int renderMode)
+bool FTFontImpl::ShapeRun(const unsigned int *chars, const int start,
+                          const int count, const bool rightToLeft,
+                          FTVector<FTShapedGlyph>& glyphs)
 {
-    return RenderI((const unsigned char *)string,
-                   len, position, spacing, renderMode);
+    if((int)shapedRun.size() < count)
+    {
+        shapedRun.resize(count, FTShapedGlyph());
+    }
+
+    int n = shaper->Shape(*face.Face(), chars + start, count,
+                          rightToLeft, &shapedRun[0], shapedRun.size());
+
+    if(n > (int)shapedRun.size())
+    {
+        shapedRun.resize(n, FTShapedGlyph());
+        n = shaper->Shape(*face.Face(), chars + start, count,
+                          rightToLeft, &shapedRun[0], shapedRun.size());
+    }
+
+    if(n < 0 || n > (int)shapedRun.size())
+    {
+        return false;
+    }
+
+    for(int i = 0; i < n; i++)
+    {
+        FTShapedGlyph glyph = shapedRun[i];
+        glyph.cluster += start;
+        glyphs.push_back(glyph);
+    }
+
+    return true;
 }
 
 
-FTPoint FTFontImpl::Render(const wchar_t * string, const int len,
-                           FTPoint position, FTPoint spacing, int renderMode)
+FTFontImpl::ShapedString::~ShapedString()
 {
-    return RenderI(string, len, position, spacing, renderMode);
 }
 
 
-bool FTFontImpl::CheckGlyph(const unsigned int characterCode)
+const FTVector<FTShapedGlyph> *FTFontImpl::ShapeI(const unsigned int *chars,
+                                                  const int count,
+                                                  const int direction)
 {
-    if(glyphList->Glyph(characterCode))
+    if(!shaper || !count)
     {
-        return true;
+        return NULL;
     }
 
-    unsigned int glyphIndex = glyphList->FontIndex(characterCode);
-    FT_GlyphSlot ftSlot = face.Glyph(glyphIndex, load_flags);
-    if(!ftSlot)
+    // Look for the string among the last ones, most recent first
+    for(int n = 0; n < SHAPED_CACHE_SIZE; n++)
     {
-        err = face.Error();
-        return false;
-    }
+        ShapedString &entry =
+            shapedCache[(lastShaped - n + SHAPED_CACHE_SIZE) % SHAPED_CACHE_SIZE];
 
-    FTGlyph* tempGlyph = intf->MakeGlyph(ftSlot);
-    if(!tempGlyph)
-    {
-        if(0 == err)
+        if((int)entry.text.size() != count || entry.direction != direction)
         {
-            err = 0x13;
+            continue;
         }
 
-        return false;
+        int i = 0;
+        while(i < count && entry.text[i] == chars[i])
+        {
+            i++;
+        }
+
+        if(i == count)
+        {
+            return entry.shaped ? &entry.glyphs : NULL;
+        }
     }
 
-    glyphList->Add(tempGlyph, characterCode);
+    lastShaped = (lastShaped + 1) % SHAPED_CACHE_SIZE;
+    ShapedString &entry = shapedCache[lastShaped];
 
-    return true;
-}
+    entry.text.resize(0, 0);
+    for(int i = 0; i < count; i++)
+    {
+        entry.text.push_back(chars[i]);
+    }
+    entry.glyphs.resize(0, FTShapedGlyph());
+    entry.direction = direction;
+    entry.shaped = true;
+
+    if(direction >= 0 || !FTBidi::IsMixed(chars, count))
+    {
+        entry.shaped = ShapeRun(chars, 0, count, direction > 0,
+                                entry.glyphs);
+        return entry.shaped ? &entry.glyphs : NULL;
+    }
 
+    // Shape each run of one direction separately, from left to right
+    visualLevels.resize(count, 0);
+    visualOrder.resize(count, 0);
+    FTBidi::Resolve(chars, count, &visualLevels[0]);
+    FTBidi::Reorder(chars, &visualLevels[0], count,
+                    FTBidi::ParagraphLevel(chars, count),
+                    &visualOrder[0]);
+
+    for(int v = 0; entry.shaped && v < count; )
+    {
+        int rtl = visualLevels[visualOrder[v]] & 1;
+        int step = rtl ? -1 : 1;
+        int w = v + 1;
+
+        while(w < count && visualOrder[w] == visualOrder[w - 1] + step
+               && (visualLevels[visualOrder[w]] & 1) == rtl)
+        {
+            w++;
+        }
+
+        int start = rtl ? visualOrder[w - 1] : visualOrder[v];
+        entry.shaped = ShapeRun(chars, start, w - v, rtl != 0, entry.glyphs);
+        v = w;
+    }
+
+    return entry.shaped ? &entry.glyphs : NULL;
+}
+
+
+bool FTFontImpl::ShapeGlyphs(const unsigned int *chars, const int count,
+                             const bool rightToLeft,
+                             FTVector<FTShapedGlyph>& glyphs)
+{
+    FTMutexLock lock(mutex);
+
+    const FTVector<FTShapedGlyph> *shaped = ShapeI(chars, count,
+                                                   rightToLeft ? 1 : 0);
+    if(!shaped)
+    {
+        return false;
+    }
+
+    for(size_t i = 0; i < shaped->size(); i++)
+    {
+        glyphs.push_back((*shaped)[i]);
+    }
+
+    return true;
+}
+
+
+FTBBox FTFontImpl::BBoxShaped(const FTVector<FTShapedGlyph>& glyphs,
+                              FTPoint position, FTPoint spacing)
+{
+    FTBBox totalBBox;
+    bool empty = true;
+
+    for(size_t i = 0; i < glyphs.size(); i++)
+    {
+        const FTShapedGlyph &glyph = glyphs[i];
+
+        if(CheckIndexedGlyph(glyph.index))
+        {
+            FTBBox tempBBox = glyphList->IndexedBounds(glyph.index);
+            tempBBox += position + glyph.offset;
+
+            if(empty)
+            {
+                totalBBox = tempBBox;
+                empty = false;
+            }
+            else
+            {
+                totalBBox |= tempBBox;
+            }
+        }
+
+        position += glyph.advance;
+
+        if(i + 1 < glyphs.size() && glyphs[i + 1].cluster != glyph.cluster)
+        {
+            position += spacing;
+        }
+    }
+
+    return totalBBox;
+}
+
+
+float FTFontImpl::AdvanceShaped(const FTVector<FTShapedGlyph>& glyphs,
+                                FTPoint spacing)
+{
+    float advance = 0.0f;
+
+    for(size_t i = 0; i < glyphs.size(); i++)
+    {
+        advance += glyphs[i].advance.Xf();
+
+        if(i + 1 < glyphs.size() && glyphs[i + 1].cluster != glyphs[i].cluster)
+        {
+            advance += spacing.Xf();
+        }
+    }
+
+    return advance;
+}
+
+
+FTPoint FTFontImpl::RenderShaped(const FTVector<FTShapedGlyph>& glyphs,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    for(size_t i = 0; i < glyphs.size(); i++)
+    {
+        const FTShapedGlyph &glyph = glyphs[i];
+
+        if(CheckIndexedGlyph(glyph.index))
+        {
+            glyphList->RenderIndexed(glyph.index, 0, position + glyph.offset,
+                                     renderMode);
+        }
+
+        position += glyph.advance;
+
+        if(i + 1 < glyphs.size() && glyphs[i + 1].cluster != glyph.cluster)
+        {
+            position += spacing;
+        }
+    }
+
+    return position;
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphsShaped(const FTVector<FTShapedGlyph>& glyphs,
+                                      FTPoint position, FTPoint spacing,
+                                      FTVector<GlyphPlacement>& placements)
+{
+    for(size_t i = 0; i < glyphs.size(); i++)
+    {
+        const FTShapedGlyph &glyph = glyphs[i];
+
+        if(CheckIndexedGlyph(glyph.index))
+        {
+            GlyphPlacement& placement = placements.emplace_back();
+            placement.glyph = glyphList->IndexedGlyph(glyph.index);
+            placement.pen = FTPointf(position + glyph.offset);
+        }
+
+        position += glyph.advance;
+
+        if(i + 1 < glyphs.size() && glyphs[i + 1].cluster != glyph.cluster)
+        {
+            position += spacing;
+        }
+    }
+
+    return position;
+}
+
+
+FTBBox FTFontImpl::BBoxChars(const unsigned int *chars, const int count,
+                             FTPoint position, FTPoint spacing)
+{
+    FTBBoxf totalBBox;
+
+    /* Only compute the bounds if string is non-empty. */
+    if(count && chars[0])
+    {
+        FTPointf cursor(position);
+        FTPointf step(spacing);
+
+        unsigned int thisChar = chars[0];
+        unsigned int nextChar = chars[1];
+
+        if(CheckGlyph(thisChar))
+        {
+            totalBBox = glyphList->Bounds(thisChar);
+            totalBBox += cursor;
+
+            cursor += FTPointf(glyphList->Advance(thisChar, nextChar), 0.0f);
+        }
+
+        /* Expand totalBox by each glyph in string */
+        for(int i = 1; i < count; i++)
+        {
+            thisChar = chars[i];
+            nextChar = chars[i + 1];
+
+            if(CheckGlyph(thisChar))
+            {
+                cursor += step;
+
+                FTBBoxf tempBBox(glyphList->Bounds(thisChar));
+                tempBBox += cursor;
+                totalBBox |= tempBBox;
+
+                cursor += FTPointf(glyphList->Advance(thisChar, nextChar),
+                                   0.0f);
+            }
+        }
+    }
+
+    return totalBBox;
+}
+
+
+FTBBox FTFontImpl::BBoxI(const unsigned int *chars, const int count,
+                         FTPoint position, FTPoint spacing)
+{
+    const FTVector<FTShapedGlyph> *shaped = ShapeI(chars, count);
+    if(shaped)
+    {
+        return BBoxShaped(*shaped, position, spacing);
+    }
+
+    const unsigned int *visual = VisualI(chars, count);
+
+    return BBoxChars(visual ? visual : chars, count, position, spacing);
+}
+
+
+FTBBox FTFontImpl::BBox(const char *string, const int len,
+                        FTPoint position, FTPoint spacing)
+{
+    /* The chars need to be unsigned because they are cast to int later */
+    int count = decoder.Decode((const unsigned char *)string, len);
+
+    return BBoxI(decoder.Chars(), count, position, spacing);
+}
+
+
+FTBBox FTFontImpl::BBox(const wchar_t *string, const int len,
+                        FTPoint position, FTPoint spacing)
+{
+    int count = decoder.Decode(string, len);
+
+    return BBoxI(decoder.Chars(), count, position, spacing);
+}
+
+
+float FTFontImpl::AdvanceChars(const unsigned int *chars, const int count,
+                               FTPoint spacing)
+{
+    float advance = 0.0f;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisChar = chars[i];
+        unsigned int nextChar = chars[i + 1];
+
+        if(CheckGlyph(thisChar))
+        {
+            advance += glyphList->Advance(thisChar, nextChar);
+        }
+
+        if(nextChar)
+        {
+            advance += spacing.Xf();
+        }
+    }
+
+    return advance;
+}
+
+
+float FTFontImpl::AdvanceI(const unsigned int *chars, const int count,
+                           FTPoint spacing)
+{
+    const FTVector<FTShapedGlyph> *shaped = ShapeI(chars, count);
+    if(shaped)
+    {
+        return AdvanceShaped(*shaped, spacing);
+    }
+
+    const unsigned int *visual = VisualI(chars, count);
+
+    return AdvanceChars(visual ? visual : chars, count, spacing);
+}
+
+
+float FTFontImpl::Advance(const char* string, const int len, FTPoint spacing)
+{
+    /* The chars need to be unsigned because they are cast to int later */
+    int count = decoder.Decode((const unsigned char *)string, len);
+
+    return AdvanceI(decoder.Chars(), count, spacing);
+}
+
+
+float FTFontImpl::Advance(const wchar_t* string, const int len, FTPoint spacing)
+{
+    int count = decoder.Decode(string, len);
+
+    return AdvanceI(decoder.Chars(), count, spacing);
+}
+
+
+FTPoint FTFontImpl::RenderChars(const unsigned int *chars, const int count,
+                                FTPoint position, FTPoint spacing,
+                                int renderMode)
+{
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisChar = chars[i];
+        unsigned int nextChar = chars[i + 1];
+
+        if(CheckGlyph(thisChar))
+        {
+            position += glyphList->Render(thisChar, nextChar,
+                                          position, renderMode);
+        }
+
+        if(nextChar)
+        {
+            position += spacing;
+        }
+    }
+
+    return position;
+}
+
+
+FTPoint FTFontImpl::RenderCompiled(const unsigned int *chars,
+                                   const int count, FTPoint position,
+                                   FTPoint spacing, int renderMode)
+{
+    // Look for the string among the last ones, most recent first
+    for(int n = 0; n < COMPILED_CACHE_SIZE; n++)
+    {
+        int index = (lastCompiled - n + COMPILED_CACHE_SIZE)
+                     % COMPILED_CACHE_SIZE;
+        CompiledString &entry = compiledCache[index];
+
+        if((int)entry.text.size() != count || entry.renderMode != renderMode
+            || !(entry.spacing == spacing))
+        {
+            continue;
+        }
+
+        int i = 0;
+        while(i < count && entry.text[i] == chars[i])
+        {
+            i++;
+        }
+
+        if(i < count)
+        {
+            continue;
+        }
+
+        // Seen once before: its glyphs are loaded, compile it now
+        if(!entry.glList)
+        {
+            entry.glList = glGenLists(1);
+            if(!entry.glList)
+            {
+                return RenderLogical(chars, count, position, spacing,
+                                     renderMode);
+            }
+
+            FTGL_TRACE_SPAN(FTGL::TRACE_COMPILE, intf, 0, 0);
+
+            glNewList(entry.glList, GL_COMPILE);
+            entry.advance = RenderLogical(chars, count, FTPoint(), spacing,
+                                          renderMode);
+            glEndList();
+        }
+
+        glTranslatef(position.Xf(), position.Yf(), position.Zf());
+        glCallList(entry.glList);
+        glTranslatef(-position.Xf(), -position.Yf(), -position.Zf());
+
+        return position + entry.advance;
+    }
+
+    lastCompiled = (lastCompiled + 1) % COMPILED_CACHE_SIZE;
+    CompiledString &entry = compiledCache[lastCompiled];
+
+    if(entry.glList)
+    {
+        glDeleteLists(entry.glList, 1);
+        entry.glList = 0;
+    }
+
+    entry.text.resize(0, 0);
+    for(int i = 0; i < count; i++)
+    {
+        entry.text.push_back(chars[i]);
+    }
+    entry.spacing = spacing;
+    entry.renderMode = renderMode;
+
+    return RenderLogical(chars, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTFontImpl::RenderI(const unsigned int *chars, const int count,
+                            FTPoint position, FTPoint spacing, int renderMode)
+{
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        corePlacements.resize(0, GlyphPlacement());
+        FTPoint end = PlaceGlyphsI(chars, count, position, spacing,
+                                   corePlacements, renderMode);
+        DrawCore(renderMode);
+        return end;
+    }
+
+    if(compileStrings && useDisplayLists && count)
+    {
+        // Lists cannot be compiled while the caller is compiling one
+        GLint compiling = 0;
+        glGetIntegerv(GL_LIST_INDEX, &compiling);
+
+        if(!compiling)
+        {
+            return RenderCompiled(chars, count, position, spacing,
+                                  renderMode);
+        }
+    }
+
+    return RenderLogical(chars, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTFontImpl::RenderLogical(const unsigned int *chars, const int count,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    if(renderMode & FTGL::RENDER_VISUAL_ORDER)
+    {
+        return RenderChars(chars, count, position, spacing, renderMode);
+    }
+
+    const FTVector<FTShapedGlyph> *shaped = ShapeI(chars, count);
+    if(shaped)
+    {
+        return RenderShaped(*shaped, position, spacing, renderMode);
+    }
+
+    const unsigned int *visual = VisualI(chars, count);
+
+    return RenderChars(visual ? visual : chars, count, position, spacing,
+                       renderMode);
+}
+
+
+FTPoint FTFontImpl::Render(const char * string, const int len,
+                           FTPoint position, FTPoint spacing, int renderMode)
+{
+    /* The chars need to be unsigned because they are cast to int later */
+    int count = decoder.Decode((const unsigned char *)string, len);
+
+    return RenderI(decoder.Chars(), count, position, spacing, renderMode);
+}
+
+
+FTPoint FTFontImpl::Render(const wchar_t * string, const int len,
+                           FTPoint position, FTPoint spacing, int renderMode)
+{
+    int count = decoder.Decode(string, len);
+
+    return RenderI(decoder.Chars(), count, position, spacing, renderMode);
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphsChars(const unsigned int *chars,
+                                     const int count, FTPoint position,
+                                     FTPoint spacing,
+                                     FTVector<GlyphPlacement>& placements)
+{
+    FTPointf cursor(position);
+    FTPointf step(spacing);
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisChar = chars[i];
+        unsigned int nextChar = chars[i + 1];
+
+        if(CheckGlyph(thisChar))
+        {
+            GlyphPlacement& placement = placements.emplace_back();
+            placement.glyph = glyphList->Glyph(thisChar);
+            placement.pen = cursor;
+
+            cursor += FTPointf(glyphList->Advance(thisChar, nextChar), 0.0f);
+        }
+
+        if(nextChar)
+        {
+            cursor += step;
+        }
+    }
+
+    return cursor;
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphsI(const unsigned int *chars, const int count,
+                                 FTPoint position, FTPoint spacing,
+                                 FTVector<GlyphPlacement>& placements,
+                                 int renderMode)
+{
+    if(renderMode & FTGL::RENDER_VISUAL_ORDER)
+    {
+        return PlaceGlyphsChars(chars, count, position, spacing, placements);
+    }
+
+    const FTVector<FTShapedGlyph> *shaped = ShapeI(chars, count);
+    if(shaped)
+    {
+        return PlaceGlyphsShaped(*shaped, position, spacing, placements);
+    }
+
+    const unsigned int *visual = VisualI(chars, count);
+
+    return PlaceGlyphsChars(visual ? visual : chars, count, position,
+                            spacing, placements);
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphs(const char * string, const int len,
+                                FTPoint position, FTPoint spacing,
+                                FTVector<GlyphPlacement>& placements,
+                                int renderMode)
+{
+    /* The chars need to be unsigned because they are cast to int later */
+    int count = decoder.Decode((const unsigned char *)string, len);
+
+    return PlaceGlyphsI(decoder.Chars(), count, position, spacing,
+                        placements, renderMode);
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphs(const wchar_t * string, const int len,
+                                FTPoint position, FTPoint spacing,
+                                FTVector<GlyphPlacement>& placements,
+                                int renderMode)
+{
+    int count = decoder.Decode(string, len);
+
+    return PlaceGlyphsI(decoder.Chars(), count, position, spacing,
+                        placements, renderMode);
+}
+
+
+FTBBox FTFontImpl::BBox(const FTUnicodeText *text, const int len,
+                        FTPoint position, FTPoint spacing)
+{
+    int count = decoder.Decode(text, len);
+
+    return BBoxI(decoder.Chars(), count, position, spacing);
+}
+
+
+float FTFontImpl::Advance(const FTUnicodeText *text, const int len,
+                          FTPoint spacing)
+{
+    int count = decoder.Decode(text, len);
+
+    return AdvanceI(decoder.Chars(), count, spacing);
+}
+
+
+FTPoint FTFontImpl::Render(const FTUnicodeText *text, const int len,
+                           FTPoint position, FTPoint spacing, int renderMode)
+{
+    int count = decoder.Decode(text, len);
+
+    return RenderI(decoder.Chars(), count, position, spacing, renderMode);
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphs(const FTUnicodeText *text, const int len,
+                                FTPoint position, FTPoint spacing,
+                                FTVector<GlyphPlacement>& placements,
+                                int renderMode)
+{
+    int count = decoder.Decode(text, len);
+
+    return PlaceGlyphsI(decoder.Chars(), count, position, spacing,
+                        placements, renderMode);
+}
+
+
+FTBBox FTFontImpl::BBox(const FTGlyphRun *run, const int count,
+                        FTPoint position, FTPoint spacing)
+{
+    FTBBox totalBBox;
+    bool empty = true;
+    FTPoint origin = position;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisGlyph = run->glyphs[i];
+        unsigned int nextGlyph = (!run->positions && i + 1 < count)
+                                  ? run->glyphs[i + 1] : 0;
+
+        if(run->positions)
+        {
+            position = origin + run->positions[i];
+        }
+
+        if(CheckIndexedGlyph(thisGlyph))
+        {
+            FTBBox tempBBox = glyphList->IndexedBounds(thisGlyph);
+            tempBBox += position;
+
+            if(empty)
+            {
+                totalBBox = tempBBox;
+                empty = false;
+            }
+            else
+            {
+                totalBBox |= tempBBox;
+            }
+
+            position += FTPoint(glyphList->IndexedAdvance(thisGlyph,
+                                                          nextGlyph), 0.0);
+        }
+
+        if(!run->positions && i + 1 < count)
+        {
+            position += spacing;
+        }
+    }
+
+    return totalBBox;
+}
+
+
+float FTFontImpl::Advance(const FTGlyphRun *run, const int count,
+                          FTPoint spacing)
+{
+    float advance = 0.0f;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisGlyph = run->glyphs[i];
+        unsigned int nextGlyph = (!run->positions && i + 1 < count)
+                                  ? run->glyphs[i + 1] : 0;
+
+        if(run->positions)
+        {
+            advance = run->positions[i].Xf();
+        }
+
+        if(CheckIndexedGlyph(thisGlyph))
+        {
+            advance += glyphList->IndexedAdvance(thisGlyph, nextGlyph);
+        }
+
+        if(!run->positions && i + 1 < count)
+        {
+            advance += spacing.Xf();
+        }
+    }
+
+    return advance;
+}
+
+
+FTPoint FTFontImpl::Render(const FTGlyphRun *run, const int count,
+                           FTPoint position, FTPoint spacing, int renderMode)
+{
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        corePlacements.resize(0, GlyphPlacement());
+        FTPoint end = PlaceGlyphs(run, count, position, spacing,
+                                  corePlacements, renderMode);
+        DrawCore(renderMode);
+        return end;
+    }
+
+    FTPoint origin = position;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisGlyph = run->glyphs[i];
+        unsigned int nextGlyph = (!run->positions && i + 1 < count)
+                                  ? run->glyphs[i + 1] : 0;
+
+        if(run->positions)
+        {
+            position = origin + run->positions[i];
+        }
+
+        if(CheckIndexedGlyph(thisGlyph))
+        {
+            position += glyphList->RenderIndexed(thisGlyph, nextGlyph,
+                                                 position, renderMode);
+        }
+
+        if(!run->positions && i + 1 < count)
+        {
+            position += spacing;
+        }
+    }
+
+    return position;
+}
+
+
+FTPoint FTFontImpl::PlaceGlyphs(const FTGlyphRun *run, const int count,
+                                FTPoint position, FTPoint spacing,
+                                FTVector<GlyphPlacement>& placements,
+                                int renderMode)
+{
+    // Glyphs are always given in display order
+    (void)renderMode;
+
+    FTPoint origin = position;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisGlyph = run->glyphs[i];
+        unsigned int nextGlyph = (!run->positions && i + 1 < count)
+                                  ? run->glyphs[i + 1] : 0;
+
+        if(run->positions)
+        {
+            position = origin + run->positions[i];
+        }
+
+        if(CheckIndexedGlyph(thisGlyph))
+        {
+            GlyphPlacement& placement = placements.emplace_back();
+            placement.glyph = glyphList->IndexedGlyph(thisGlyph);
+            placement.pen = FTPointf(position);
+
+            position += FTPoint(glyphList->IndexedAdvance(thisGlyph,
+                                                          nextGlyph), 0.0);
+        }
+
+        if(!run->positions && i + 1 < count)
+        {
+            position += spacing;
+        }
+    }
+
+    return position;
+}
+
+
+void FTFontImpl::Metrics(const unsigned int *chars, const int count,
+                         const unsigned int next, float *advances,
+                         FTBBoxf *bounds)
+{
+    FTMutexLock lock(mutex);
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int thisChar = chars[i];
+        unsigned int nextChar = (i + 1 < count) ? chars[i + 1] : next;
+
+        if(CheckGlyph(thisChar))
+        {
+            advances[i] = glyphList->Advance(thisChar, nextChar);
+            bounds[i] = glyphList->Bounds(thisChar);
+        }
+        else
+        {
+            advances[i] = 0.0f;
+            bounds[i] = FTBBoxf();
+        }
+    }
+}
+
+
+bool FTFontImpl::CheckGlyph(const unsigned int characterCode)
+{
+    if(glyphList->Glyph(characterCode))
+    {
+        stats.Add(FTGL::STAT_GLYPH_HITS);
+        return true;
+    }
+
+    if(glyphList->Share(characterCode))
+    {
+        stats.Add(FTGL::STAT_GLYPH_HITS);
+        return true;
+    }
+
+    FTStatsTimer timer(stats, FTGL::STAT_GLYPH_MISSES,
+                       FTGL::STAT_GLYPH_LOAD_TIME);
+
+    unsigned int glyphIndex = glyphList->FontIndex(characterCode);
+    FTGL_TRACE_SPAN(FTGL::TRACE_GLYPH, intf, characterCode, glyphIndex);
+
+    FT_GlyphSlot ftSlot = LoadGlyph(glyphIndex);
+    if(!ftSlot)
+    {
+        err = face.Error();
+        return false;
+    }
+
+    FTGlyph* tempGlyph = NewGlyph(ftSlot);
+    if(!tempGlyph)
+    {
+        if(0 == err)
+        {
+            err = 0x13;
+        }
+
+        return false;
+    }
+
+    glyphList->Add(tempGlyph, characterCode);
+
+    return true;
+}
+
+
+bool FTFontImpl::CheckIndexedGlyph(const unsigned int glyphIndex)
+{
+    if(glyphList->IndexedGlyph(glyphIndex))
+    {
+        stats.Add(FTGL::STAT_GLYPH_HITS);
+        return true;
+    }
+
+    FTStatsTimer timer(stats, FTGL::STAT_GLYPH_MISSES,
+                       FTGL::STAT_GLYPH_LOAD_TIME);
+    FTGL_TRACE_SPAN(FTGL::TRACE_GLYPH, intf, 0, glyphIndex);
+
+    FT_GlyphSlot ftSlot = LoadGlyph(glyphIndex);
+    if(!ftSlot)
+    {
+        err = face.Error();
+        return false;
+    }
+
+    FTGlyph* tempGlyph = NewGlyph(ftSlot);
+    if(!tempGlyph)
+    {
+        if(0 == err)
+        {
+            err = 0x13;
+        }
+
+        return false;
+    }
+
+    glyphList->AddIndexed(tempGlyph, glyphIndex);
+
+    return true;
+}
+
+
+FT_GlyphSlot FTFontImpl::LoadGlyph(unsigned int glyphIndex)
+{
+    FTGL_TRACE_SPAN(FTGL::TRACE_LOAD, 0, 0, glyphIndex);
+
+    return face.Glyph(glyphIndex, load_flags);
+}
+
+
+FTGlyph* FTFontImpl::NewGlyph(FT_GlyphSlot ftSlot)
+{
+    FTGL_TRACE_SPAN(FTGL::TRACE_MAKE_GLYPH, 0, 0, ftSlot->glyph_index);
+
+    // Raster glyphs render the outline while they are made
+    bool outline = ftSlot->format == FT_GLYPH_FORMAT_OUTLINE;
+
+    // Glyphs made from the slot keep their data in the glyph list's arena
+    FT_Generic generic = ftSlot->generic;
+    glyphList->Arena().Lend(ftSlot);
+
+    FTGlyph* glyph = intf->MakeGlyph(ftSlot);
+
+    ftSlot->generic = generic;
+
+    if(outline && ftSlot->format == FT_GLYPH_FORMAT_BITMAP)
+    {
+        stats.Add(FTGL::STAT_GLYPH_RASTERS);
+    }
+
+    if(glyph)
+    {
+        glyph->impl->stats = &stats;
+    }
+
+    return glyph;
+}
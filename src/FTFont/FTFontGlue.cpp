@@ -28,6 +28,7 @@
 #include "config.h"
 
 #include "FTInternals.h"
+#include "FTVector.h"
 
 static const FTPoint static_ftpoint;
 static const FTBBox static_ftbbox;
@@ -66,12 +67,16 @@ C_TOR(ftglCreateExtrudeFont, (const char *fontname),
       FTExtrudeFont, (fontname), FONT_EXTRUDE);
 C_TOR(ftglCreateExtrudeFontFromMem, (const unsigned char *bytes, size_t len),
       FTExtrudeFont, (bytes, len), FONT_EXTRUDE);
+C_TOR(ftglCreateExtrudeFontWithBackend, (const char *fontname, int backend),
+      FTExtrudeFont, (fontname, (RenderBackend)backend), FONT_EXTRUDE);
 
 // FTOutlineFont::FTOutlineFont();
 C_TOR(ftglCreateOutlineFont, (const char *fontname),
       FTOutlineFont, (fontname), FONT_OUTLINE);
 C_TOR(ftglCreateOutlineFontFromMem, (const unsigned char *bytes, size_t len),
       FTOutlineFont, (bytes, len), FONT_OUTLINE);
+C_TOR(ftglCreateOutlineFontWithBackend, (const char *fontname, int backend),
+      FTOutlineFont, (fontname, (RenderBackend)backend), FONT_OUTLINE);
 
 // FTPixmapFont::FTPixmapFont();
 C_TOR(ftglCreatePixmapFont, (const char *fontname),
@@ -84,12 +89,16 @@ C_TOR(ftglCreatePolygonFont, (const char *fontname),
       FTPolygonFont, (fontname), FONT_POLYGON);
 C_TOR(ftglCreatePolygonFontFromMem, (const unsigned char *bytes, size_t len),
       FTPolygonFont, (bytes, len), FONT_POLYGON);
+C_TOR(ftglCreatePolygonFontWithBackend, (const char *fontname, int backend),
+      FTPolygonFont, (fontname, (RenderBackend)backend), FONT_POLYGON);
 
 // FTTextureFont::FTTextureFont();
 C_TOR(ftglCreateTextureFont, (const char *fontname),
       FTTextureFont, (fontname), FONT_TEXTURE);
 C_TOR(ftglCreateTextureFontFromMem, (const unsigned char *bytes, size_t len),
       FTTextureFont, (bytes, len), FONT_TEXTURE);
+C_TOR(ftglCreateTextureFontWithBackend, (const char *fontname, int backend),
+      FTTextureFont, (fontname, (RenderBackend)backend), FONT_TEXTURE);
 
 // FTCustomFont::FTCustomFont();
 class FTCustomFont : public FTFont
@@ -183,6 +192,10 @@ C_FUN(unsigned int, ftglGetFontCharMapCount, (FTGLfont *f),
 C_FUN(FT_Encoding *, ftglGetFontCharMapList, (FTGLfont* f),
       return NULL, CharMapList, ());
 
+// void FTFont::Shaper(FTShaper *shaper);
+C_FUN(void, ftglSetFontShaper, (FTGLfont *f, FTGLshaper *s),
+      return, Shaper, (s ? s->ptr : NULL));
+
 // virtual bool FTFont::FaceSize(const unsigned int size,
 //                               const unsigned int res = 72);
 C_FUN(int, ftglSetFontFaceSize, (FTGLfont *f, unsigned int s, unsigned int r),
@@ -204,6 +217,22 @@ C_FUN(void, ftglSetFontOutset, (FTGLfont *f, float front, float back),
 C_FUN(void, ftglSetFontDisplayList, (FTGLfont *f, int l),
       return, UseDisplayList, (l != 0));
 
+// virtual void FTFont::BeginBatch();
+C_FUN(void, ftglBeginFontBatch, (FTGLfont *f), return, BeginBatch, ());
+
+// virtual void FTFont::EndBatch();
+C_FUN(void, ftglEndFontBatch, (FTGLfont *f), return, EndBatch, ());
+
+// virtual void FTFont::Transform(const float *matrix);
+C_FUN(void, ftglSetFontTransform, (FTGLfont *f, const float *matrix),
+      return, Transform, (matrix));
+
+// virtual void FTFont::Color(float red, float green, float blue,
+//                            float alpha);
+C_FUN(void, ftglSetFontColor, (FTGLfont *f, float r, float g, float b,
+                               float a),
+      return, Color, (r, g, b, a));
+
 // float FTFont::Ascender() const;
 C_FUN(float, ftglGetFontAscender, (FTGLfont *f), return 0.f, Ascender, ());
 
@@ -244,8 +273,103 @@ void ftglRenderFont(FTGLfont *f, const char *s, int mode)
     _ftglRenderFont(f, s, -1, FTPoint(), FTPoint(), mode);
 }
 
+// Glyph positions are passed from C as pairs of floats
+extern "C++" {
+static const FTPoint *GlyphPositions(const float *positions, int count,
+                                     FTVector<FTPoint>& points)
+{
+    if(!positions)
+    {
+        return NULL;
+    }
+
+    points.reserve(count);
+    for(int i = 0; i < count; i++)
+    {
+        points.push_back(FTPoint(positions[2 * i], positions[2 * i + 1]));
+    }
+
+    return count ? &points[0] : NULL;
+}
+}
+
+// FTBBox FTFont::BBoxGlyphs(const unsigned int *glyphs,
+//                           const FTPoint *positions, const int count);
+extern "C++" {
+C_FUN(static FTBBox, _ftglGetFontGlyphsBBox, (FTGLfont *f,
+                                              const unsigned int *g,
+                                              const FTPoint *p, int n),
+      return static_ftbbox, BBoxGlyphs, (g, p, n));
+}
+
+void ftglGetFontGlyphsBBox(FTGLfont *f, const unsigned int *g,
+                           const float *p, int n, float c[6])
+{
+    FTVector<FTPoint> points;
+    FTBBox ret = _ftglGetFontGlyphsBBox(f, g, GlyphPositions(p, n, points), n);
+    FTPoint lower = ret.Lower(), upper = ret.Upper();
+    c[0] = lower.Xf(); c[1] = lower.Yf(); c[2] = lower.Zf();
+    c[3] = upper.Xf(); c[4] = upper.Yf(); c[5] = upper.Zf();
+}
+
+// float FTFont::AdvanceGlyphs(const unsigned int *glyphs,
+//                             const FTPoint *positions, const int count);
+extern "C++" {
+C_FUN(static float, _ftglGetFontGlyphsAdvance, (FTGLfont *f,
+                                                const unsigned int *g,
+                                                const FTPoint *p, int n),
+      return 0.0, AdvanceGlyphs, (g, p, n));
+}
+
+float ftglGetFontGlyphsAdvance(FTGLfont *f, const unsigned int *g,
+                               const float *p, int n)
+{
+    FTVector<FTPoint> points;
+    return _ftglGetFontGlyphsAdvance(f, g, GlyphPositions(p, n, points), n);
+}
+
+// FTPoint FTFont::RenderGlyphs(const unsigned int *glyphs,
+//                              const FTPoint *positions, const int count,
+//                              FTPoint position, FTPoint spacing,
+//                              int renderMode);
+extern "C++" {
+C_FUN(static FTPoint, _ftglRenderFontGlyphs, (FTGLfont *f,
+                                              const unsigned int *g,
+                                              const FTPoint *p, int n,
+                                              int mode),
+      return static_ftpoint, RenderGlyphs,
+      (g, p, n, FTPoint(), FTPoint(), mode));
+}
+
+void ftglRenderFontGlyphs(FTGLfont *f, const unsigned int *g,
+                          const float *p, int n, int mode)
+{
+    FTVector<FTPoint> points;
+    _ftglRenderFontGlyphs(f, g, GlyphPositions(p, n, points), n, mode);
+}
+
 // FT_Error FTFont::Error() const;
 C_FUN(FT_Error, ftglGetFontError, (FTGLfont *f), return -1, Error, ());
 
+// FTGL_UINT64 FTFont::GetStatistic(FTGL::Statistic which) const;
+C_FUN(FTGL_UINT64, ftglGetFontStatistic, (FTGLfont *f, int which),
+      return 0, GetStatistic, (static_cast<FTGL::Statistic>(which)));
+
+// void FTFont::ResetStatistics();
+C_FUN(void, ftglResetFontStatistics, (FTGLfont *f),
+      return, ResetStatistics, ());
+
+// static FTGL_UINT64 FTFont::GetGlobalStatistic(FTGL::Statistic which);
+FTGL_UINT64 ftglGetGlobalStatistic(int which)
+{
+    return FTFont::GetGlobalStatistic(static_cast<FTGL::Statistic>(which));
+}
+
+// static void FTFont::ResetGlobalStatistics();
+void ftglResetGlobalStatistics(void)
+{
+    FTFont::ResetGlobalStatistics();
+}
+
 FTGL_END_C_DECLS
 
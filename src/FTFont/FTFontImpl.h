@@ -29,14 +29,33 @@
 
 #include "FTGL/ftgl.h"
 
+#include "FTBBoxf.h"
+#include "FTCoreRenderer.h"
 #include "FTFace.h"
+#include "FTMutex.h"
+#include "FTStats.h"
+#include "FTUnicode.h"
+#include "FTVector.h"
 
 class FTGlyphContainer;
 class FTGlyph;
 
+/**
+ * Glyphs given by their index in the font, and optionally the pen position
+ * of each of them. The glyph index entry points of FTFont pass it, with the
+ * number of glyphs as the length, wherever a string would go, so that every
+ * font type draws it like text.
+ */
+struct FTGlyphRun
+{
+    const unsigned int *glyphs;
+    const FTPoint *positions;
+};
+
 class FTFontImpl
 {
         friend class FTFont;
+        friend class FTSimpleLayoutImpl;
 
     protected:
         FTFontImpl(FTFont *ftFont, char const *fontFilePath);
@@ -59,8 +78,22 @@ class FTFontImpl
 
         virtual FT_Encoding* CharMapList();
 
+        virtual void Shaper(FTShaper *shaper);
+
+        virtual FTShaper* Shaper() const;
+
         virtual void UseDisplayList(bool useList);
 
+        virtual void BeginBatch();
+
+        virtual void EndBatch();
+
+        FTGL::RenderBackend Backend() const;
+
+        void Transform(const float *matrix);
+
+        void Color(float red, float green, float blue, float alpha);
+
         virtual float Ascender() const;
 
         virtual float Descender() const;
@@ -92,6 +125,24 @@ class FTFontImpl
         virtual FTPoint Render(const wchar_t *s, const int len,
                                FTPoint, FTPoint, int);
 
+        virtual FTBBox BBox(const FTGlyphRun *run, const int count,
+                            FTPoint, FTPoint);
+
+        virtual float Advance(const FTGlyphRun *run, const int count,
+                              FTPoint);
+
+        virtual FTPoint Render(const FTGlyphRun *run, const int count,
+                               FTPoint, FTPoint, int);
+
+        virtual FTBBox BBox(const FTUnicodeText *text, const int len,
+                            FTPoint, FTPoint);
+
+        virtual float Advance(const FTUnicodeText *text, const int len,
+                              FTPoint);
+
+        virtual FTPoint Render(const FTUnicodeText *text, const int len,
+                               FTPoint, FTPoint, int);
+
         /**
          * Current face object
          */
@@ -119,6 +170,151 @@ class FTFontImpl
          */
         FT_Error err;
 
+        /**
+         * Serialises access to the face and the glyph list so that glyphs
+         * can be created and measured from several threads. Taken by every
+         * FTFont entry point that may load a glyph.
+         */
+        FTMutex mutex;
+
+        /**
+         * The statistics of the font, updated under <code>mutex</code>.
+         */
+        FTStats stats;
+
+        /**
+         * A glyph of a string and the pen position it is drawn at.
+         */
+        struct GlyphPlacement
+        {
+            const FTGlyph *glyph;
+            FTPointf pen;
+        };
+
+        /**
+         * The renderer the font draws with, chosen when it is created.
+         * Fonts using the core profile backend never use display lists.
+         */
+        FTGL::RenderBackend backend;
+
+        /**
+         * The matrix and colour of the core profile backend, which has no
+         * matrix stacks or current colour to take them from.
+         */
+        GLfloat coreTransform[16];
+        GLfloat coreColor[4];
+
+        /**
+         * The primitive the glyphs append for the core profile backend:
+         * GL_TRIANGLES, or GL_LINES for outlines.
+         */
+        GLenum corePrimitive;
+
+        /**
+         * Draws the text of the core profile backend.
+         */
+        FTCoreRenderer core;
+
+        /**
+         * Select the renderer of the font. Called by the constructors of
+         * the fonts that have a core profile implementation.
+         */
+        void UseBackend(FTGL::RenderBackend renderBackend);
+
+        /**
+         * Draw the glyphs in <code>corePlacements</code> with the core
+         * profile backend.
+         *
+         * @param renderMode  Render mode to display
+         */
+        void DrawCore(int renderMode);
+
+        /**
+         * Load the glyphs of a string and compute where each of them is
+         * drawn, using the same kerning and spacing rules as
+         * <code>Render()</code>. Characters without a glyph are skipped.
+         *
+         * @param s  String to place.
+         * @param len  The length of the string, or -1 for a null-terminated
+         *             string.
+         * @param position  The pen position of the first character.
+         * @param spacing  A displacement vector to add after each character.
+         * @param placements  Receives one entry per placed glyph.
+         * @param renderMode  The render mode the glyphs are drawn with; only
+         *                    FTGL::RENDER_VISUAL_ORDER is looked at.
+         * @return  The pen position after the last character.
+         */
+        FTPoint PlaceGlyphs(const char *s, const int len, FTPoint position,
+                            FTPoint spacing,
+                            FTVector<GlyphPlacement>& placements,
+                            int renderMode);
+        FTPoint PlaceGlyphs(const wchar_t *s, const int len, FTPoint position,
+                            FTPoint spacing,
+                            FTVector<GlyphPlacement>& placements,
+                            int renderMode);
+        FTPoint PlaceGlyphs(const FTGlyphRun *run, const int count,
+                            FTPoint position, FTPoint spacing,
+                            FTVector<GlyphPlacement>& placements,
+                            int renderMode);
+        FTPoint PlaceGlyphs(const FTUnicodeText *text, const int len,
+                            FTPoint position, FTPoint spacing,
+                            FTVector<GlyphPlacement>& placements,
+                            int renderMode);
+
+        /**
+         * Get the kerned advance and the bounding box of each character of
+         * a decoded string in a single pass, loading the glyphs as needed.
+         * Characters without a glyph get a zero advance and an empty box.
+         *
+         * @param chars  Unicode characters.
+         * @param count  The number of characters.
+         * @param next  The character following the run, used to kern the
+         *              last one, or zero.
+         * @param advances  Receives the kerned advance of each character.
+         * @param bounds  Receives the bounding box of each character,
+         *                relative to its pen position.
+         */
+        void Metrics(const unsigned int *chars, const int count,
+                     const unsigned int next, float *advances,
+                     FTBBoxf *bounds);
+
+        /**
+         * Shape a run of characters that all have the same direction, for
+         * a layout that splits its lines into such runs itself. Runs are
+         * kept with the other shaped strings, so laying out the same text
+         * again does not shape it again.
+         *
+         * @param chars  Unicode characters, in logical order.
+         * @param count  The number of characters.
+         * @param rightToLeft  The direction of the run.
+         * @param glyphs  Receives the glyphs from left to right, with
+         *                clusters counted from <code>chars</code>.
+         * @return  <code>false</code> if there is no shaper or it could not
+         *          shape the run.
+         */
+        bool ShapeGlyphs(const unsigned int *chars, const int count,
+                         const bool rightToLeft,
+                         FTVector<FTShapedGlyph>& glyphs);
+
+        /**
+         * A number that changes whenever the glyphs or their metrics may
+         * have changed, with the same face size or not. Layouts compare
+         * it to know when what they measured is stale.
+         */
+        unsigned int Revision() const { return revision; }
+
+        /**
+         * Whether <code>Render()</code> goes through the compiled strings.
+         * Set by the vector fonts; only used with display lists enabled.
+         */
+        bool compileStrings;
+
+        /**
+         * Delete the compiled strings, when the glyphs they call or the
+         * way they are built changes, and move to a new revision.
+         */
+        void FlushCompiled();
+
     private:
         /**
          * A link back to the interface of which we are the implementation.
@@ -133,6 +329,32 @@ class FTFontImpl
          */
         bool CheckGlyph(const unsigned int chr);
 
+        /**
+         * Check that the glyph with the font index <code>glyphIndex</code>
+         * exist. If not load it.
+         *
+         * @param glyphIndex  glyph index
+         * @return <code>true</code> if the glyph can be created.
+         */
+        bool CheckIndexedGlyph(const unsigned int glyphIndex);
+
+        /**
+         * Load a glyph into the glyph slot of the face.
+         *
+         * @param glyphIndex  The index of the glyph in the font.
+         * @return  The glyph slot, or <code>NULL</code>.
+         */
+        FT_GlyphSlot LoadGlyph(unsigned int glyphIndex);
+
+        /**
+         * Make a glyph from a loaded glyph slot and have it count in the
+         * statistics of this font.
+         *
+         * @param ftSlot  The glyph slot.
+         * @return  The new glyph, or <code>NULL</code>.
+         */
+        FTGlyph* NewGlyph(FT_GlyphSlot ftSlot);
+
         /**
          * An object that holds a list of glyphs
          */
@@ -143,19 +365,179 @@ class FTFontImpl
          */
         FTPoint pen;
 
-        /* Internal generic BBox() implementation */
-        template <typename T>
-        inline FTBBox BBoxI(const T *s, const int len,
-                            FTPoint position, FTPoint spacing);
+        /**
+         * Strings holding right to left text, already put in display order
+         * with FTBidi. Static text is drawn every frame, so the last few
+         * strings are kept rather than analysed again.
+         */
+        static const int VISUAL_CACHE_SIZE = 8;
+        struct VisualString
+        {
+            ~VisualString();
+
+            FTVector<unsigned int> text;
+            FTVector<unsigned int> visual;
+        };
+        VisualString visualCache[VISUAL_CACHE_SIZE];
+        int lastVisual;
+
+        /**
+         * The shaper turning strings into glyphs, or NULL. Not owned.
+         */
+        FTShaper *shaper;
+
+        /**
+         * Strings and the glyphs they were shaped into, from left to right,
+         * with clusters counted in characters from the start of the string.
+         */
+        static const int SHAPED_CACHE_SIZE = 8;
+        struct ShapedString
+        {
+            ~ShapedString();
+
+            FTVector<unsigned int> text;
+            FTVector<FTShapedGlyph> glyphs;
+            int direction;
+            bool shaped;
+        };
+        ShapedString shapedCache[SHAPED_CACHE_SIZE];
+        int lastShaped;
+
+        /* Scratch storage for the glyphs of the run being shaped */
+        FTVector<FTShapedGlyph> shapedRun;
+
+        /* Scratch storage for the string drawn by the core profile
+         * backend */
+        FTVector<GlyphPlacement> corePlacements;
+        FTVector<FTCoreVertex> coreVertices;
+
+        /**
+         * Strings compiled into display lists, drawn from the origin, for
+         * the fonts whose glyphs are geometry. A string is only compiled
+         * the second time it is rendered with the same spacing and render
+         * mode, so that text changing every frame does not pay for lists
+         * that are never called again.
+         */
+        static const int COMPILED_CACHE_SIZE = 16;
+        struct CompiledString
+        {
+            CompiledString() : renderMode(0), glList(0) {}
+
+            FTVector<unsigned int> text;
+            FTPoint spacing;
+            int renderMode;
+            unsigned int glList;
+            FTPoint advance;
+        };
+        CompiledString compiledCache[COMPILED_CACHE_SIZE];
+        int lastCompiled;
+
+        /**
+         * Counts the changes that can affect glyphs or metrics: every
+         * FlushCompiled() is one.
+         */
+        unsigned int revision;
+
+        /**
+         * Forget the shaped strings, when the face, its size or the shaper
+         * changes.
+         */
+        void FlushShaped();
 
-        /* Internal generic Advance() implementation */
-        template <typename T>
-        inline float AdvanceI(const T *s, const int len, FTPoint spacing);
+        /**
+         * Shape a run of characters and append its glyphs to a list.
+         *
+         * @param chars  The characters of the whole string.
+         * @param start  The index of the first character of the run.
+         * @param count  The number of characters.
+         * @param rightToLeft  The direction of the run.
+         * @param glyphs  The list to append to.
+         * @return  <code>false</code> if the shaper rejected the run.
+         */
+        bool ShapeRun(const unsigned int *chars, const int start,
+                      const int count, const bool rightToLeft,
+                      FTVector<FTShapedGlyph>& glyphs);
+
+        /**
+         * Get the glyphs of a string from the shaper, splitting it into
+         * runs of one direction first unless the direction is given.
+         *
+         * @param direction  0 or 1 for a single left to right or right to
+         *                   left run, or -1 to find the runs with the
+         *                   bidirectional algorithm.
+         * @return  The glyphs from left to right, or NULL if there is no
+         *          shaper or it could not shape the string.
+         */
+        const FTVector<FTShapedGlyph> *ShapeI(const unsigned int *chars,
+                                              const int count,
+                                              const int direction = -1);
+
+        /* BBox(), Advance(), Render() and PlaceGlyphs() of shaped glyphs */
+        FTBBox BBoxShaped(const FTVector<FTShapedGlyph>& glyphs,
+                          FTPoint position, FTPoint spacing);
+        float AdvanceShaped(const FTVector<FTShapedGlyph>& glyphs,
+                            FTPoint spacing);
+        FTPoint RenderShaped(const FTVector<FTShapedGlyph>& glyphs,
+                             FTPoint position, FTPoint spacing, int mode);
+        FTPoint PlaceGlyphsShaped(const FTVector<FTShapedGlyph>& glyphs,
+                                  FTPoint position, FTPoint spacing,
+                                  FTVector<GlyphPlacement>& placements);
 
-        /* Internal generic Render() implementation */
-        template <typename T>
-        inline FTPoint RenderI(const T *s, const int len,
+        /**
+         * The code points of the string being drawn or measured. Strings
+         * are decoded once, and then walked as arrays of characters that
+         * are followed by the character to kern the last one with.
+         */
+        FTUnicodeDecoder decoder;
+
+        /* Scratch storage for the string being analysed */
+        FTVector<unsigned char> visualLevels;
+        FTVector<int> visualOrder;
+
+        /**
+         * Get a string in display order, with the characters of right to
+         * left runs reversed and mirrored.
+         *
+         * @return  A null-terminated string of <code>count</code>
+         *          characters, or NULL if the string is plain left to
+         *          right text that is drawn as it is.
+         */
+        const unsigned int *VisualI(const unsigned int *chars,
+                                    const int count);
+
+        /* Internal BBox() implementation, shaping or reordering decoded
+         * characters before measuring them with BBoxChars() */
+        FTBBox BBoxI(const unsigned int *chars, const int count,
+                     FTPoint position, FTPoint spacing);
+        FTBBox BBoxChars(const unsigned int *chars, const int count,
+                         FTPoint position, FTPoint spacing);
+
+        /* Internal Advance() implementation */
+        float AdvanceI(const unsigned int *chars, const int count,
+                       FTPoint spacing);
+        float AdvanceChars(const unsigned int *chars, const int count,
+                           FTPoint spacing);
+
+        /* Internal Render() implementation, drawing compiled strings when
+         * possible and otherwise shaping or reordering decoded characters
+         * in RenderLogical() before drawing them with RenderChars() */
+        FTPoint RenderI(const unsigned int *chars, const int count,
+                        FTPoint position, FTPoint spacing, int mode);
+        FTPoint RenderCompiled(const unsigned int *chars, const int count,
                                FTPoint position, FTPoint spacing, int mode);
+        FTPoint RenderLogical(const unsigned int *chars, const int count,
+                              FTPoint position, FTPoint spacing, int mode);
+        FTPoint RenderChars(const unsigned int *chars, const int count,
+                            FTPoint position, FTPoint spacing, int mode);
+
+        /* Internal PlaceGlyphs() implementation */
+        FTPoint PlaceGlyphsI(const unsigned int *chars, const int count,
+                             FTPoint position, FTPoint spacing,
+                             FTVector<GlyphPlacement>& placements,
+                             int mode);
+        FTPoint PlaceGlyphsChars(const unsigned int *chars, const int count,
+                                 FTPoint position, FTPoint spacing,
+                                 FTVector<GlyphPlacement>& placements);
 };
 
 #endif  //  __FTFontImpl__
@@ -48,17 +48,27 @@ FTOutlineFont::FTOutlineFont(const unsigned char *pBufferBytes,
 {}
 
 
+FTOutlineFont::FTOutlineFont(char const *fontFilePath,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTOutlineFontImpl(this, fontFilePath, backend))
+{}
+
+
+FTOutlineFont::FTOutlineFont(const unsigned char *pBufferBytes,
+                             size_t bufferSizeInBytes,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTOutlineFontImpl(this, pBufferBytes, bufferSizeInBytes,
+                                 backend))
+{}
+
+
 FTOutlineFont::~FTOutlineFont()
 {}
 
 
 FTGlyph* FTOutlineFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 {
-    FTOutlineFontImpl *myimpl = dynamic_cast<FTOutlineFontImpl *>(impl);
-    if(!myimpl)
-    {
-        return NULL;
-    }
+    FTOutlineFontImpl *myimpl = static_cast<FTOutlineFontImpl *>(impl);
 
     return new FTOutlineGlyph(ftGlyph, myimpl->outset,
                               myimpl->useDisplayLists);
@@ -70,21 +80,29 @@ FTGlyph* FTOutlineFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 //
 
 
-FTOutlineFontImpl::FTOutlineFontImpl(FTFont *ftFont, const char* fontFilePath)
+FTOutlineFontImpl::FTOutlineFontImpl(FTFont *ftFont, const char* fontFilePath,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, fontFilePath),
   outset(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    corePrimitive = GL_LINES;
+    UseBackend(renderBackend);
 }
 
 
 FTOutlineFontImpl::FTOutlineFontImpl(FTFont *ftFont,
                                      const unsigned char *pBufferBytes,
-                                     size_t bufferSizeInBytes)
+                                     size_t bufferSizeInBytes,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, pBufferBytes, bufferSizeInBytes),
   outset(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    corePrimitive = GL_LINES;
+    UseBackend(renderBackend);
 }
 
 
@@ -93,6 +111,28 @@ inline FTPoint FTOutlineFontImpl::RenderI(const T* string, const int len,
                                           FTPoint position, FTPoint spacing,
                                           int renderMode)
 {
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        // There is no attribute stack in the core profile
+        GLboolean smooth = glIsEnabled(GL_LINE_SMOOTH);
+        GLint hint = GL_DONT_CARE;
+        glGetIntegerv(GL_LINE_SMOOTH_HINT, &hint);
+
+        glEnable(GL_LINE_SMOOTH);
+        glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
+
+        FTPoint tmp = FTFontImpl::Render(string, len,
+                                         position, spacing, renderMode);
+
+        if(!smooth)
+        {
+            glDisable(GL_LINE_SMOOTH);
+        }
+        glHint(GL_LINE_SMOOTH_HINT, hint);
+
+        return tmp;
+    }
+
     // Protect GL_TEXTURE_2D, glHint() and GL_LINE_SMOOTH
     glPushAttrib(GL_ENABLE_BIT | GL_HINT_BIT | GL_LINE_BIT
                   | GL_COLOR_BUFFER_BIT);
@@ -125,3 +165,19 @@ FTPoint FTOutlineFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTOutlineFontImpl::Render(const FTGlyphRun *run, const int count,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTOutlineFontImpl::Render(const FTUnicodeText *text, const int len,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
@@ -129,3 +129,19 @@ FTPoint FTPixmapFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTPixmapFontImpl::Render(const FTGlyphRun *run, const int count,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTPixmapFontImpl::Render(const FTUnicodeText *text, const int len,
+                                 FTPoint position, FTPoint spacing,
+                                 int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
@@ -48,17 +48,27 @@ FTPolygonFont::FTPolygonFont(const unsigned char *pBufferBytes,
 {}
 
 
+FTPolygonFont::FTPolygonFont(char const *fontFilePath,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTPolygonFontImpl(this, fontFilePath, backend))
+{}
+
+
+FTPolygonFont::FTPolygonFont(const unsigned char *pBufferBytes,
+                             size_t bufferSizeInBytes,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTPolygonFontImpl(this, pBufferBytes, bufferSizeInBytes,
+                                 backend))
+{}
+
+
 FTPolygonFont::~FTPolygonFont()
 {}
 
 
 FTGlyph* FTPolygonFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 {
-    FTPolygonFontImpl *myimpl = dynamic_cast<FTPolygonFontImpl *>(impl);
-    if(!myimpl)
-    {
-        return NULL;
-    }
+    FTPolygonFontImpl *myimpl = static_cast<FTPolygonFontImpl *>(impl);
 
     return new FTPolygonGlyph(ftGlyph, myimpl->outset,
                               myimpl->useDisplayLists);
@@ -70,21 +80,27 @@ FTGlyph* FTPolygonFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 //
 
 
-FTPolygonFontImpl::FTPolygonFontImpl(FTFont *ftFont, const char* fontFilePath)
+FTPolygonFontImpl::FTPolygonFontImpl(FTFont *ftFont, const char* fontFilePath,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, fontFilePath),
   outset(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    UseBackend(renderBackend);
 }
 
 
 FTPolygonFontImpl::FTPolygonFontImpl(FTFont *ftFont,
                                      const unsigned char *pBufferBytes,
-                                     size_t bufferSizeInBytes)
+                                     size_t bufferSizeInBytes,
+                                     FTGL::RenderBackend renderBackend)
 : FTFontImpl(ftFont, pBufferBytes, bufferSizeInBytes),
   outset(0.0f)
 {
     load_flags = FT_LOAD_NO_HINTING;
+    compileStrings = true;
+    UseBackend(renderBackend);
 }
 
 
@@ -93,6 +109,13 @@ inline FTPoint FTPolygonFontImpl::RenderI(const T* string, const int len,
                                           FTPoint position, FTPoint spacing,
                                           int renderMode)
 {
+    // The core profile backend leaves the polygon mode to the caller
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        return FTFontImpl::Render(string, len, position, spacing,
+                                  renderMode);
+    }
+
     // Protect GL_POLYGON
     glPushAttrib(GL_POLYGON_BIT);
 
@@ -124,3 +147,19 @@ FTPoint FTPolygonFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTPolygonFontImpl::Render(const FTGlyphRun *run, const int count,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTPolygonFontImpl::Render(const FTUnicodeText *text, const int len,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
@@ -36,10 +36,14 @@ class FTPolygonFontImpl : public FTFontImpl
     friend class FTPolygonFont;
 
     protected:
-        FTPolygonFontImpl(FTFont *ftFont, const char* fontFilePath);
+        FTPolygonFontImpl(FTFont *ftFont, const char* fontFilePath,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         FTPolygonFontImpl(FTFont *ftFont, const unsigned char *pBufferBytes,
-                          size_t bufferSizeInBytes);
+                          size_t bufferSizeInBytes,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         /**
          * Set the outset distance for the font. Only implemented by
@@ -47,7 +51,7 @@ class FTPolygonFontImpl : public FTFontImpl
          *
          * @param outset  The outset distance.
          */
-        virtual void Outset(float o) { outset = o; }
+        virtual void Outset(float o) { outset = o; FlushCompiled(); }
 
         virtual FTPoint Render(const char *s, const int len,
                                FTPoint position, FTPoint spacing,
@@ -57,6 +61,14 @@ class FTPolygonFontImpl : public FTFontImpl
                                FTPoint position, FTPoint spacing,
                                int renderMode);
 
+        virtual FTPoint Render(const FTGlyphRun *run, const int count,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
+        virtual FTPoint Render(const FTUnicodeText *text, const int len,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
     private:
         /**
          * The outset distance for the font.
@@ -27,6 +27,7 @@
 #include "config.h"
 
 #include <cassert>
+#include <math.h>
 #include <string> // For memset
 
 #include "FTGL/ftgl.h"
@@ -35,6 +36,7 @@
 
 #include "../FTGlyph/FTTextureGlyphImpl.h"
 #include "./FTTextureFontImpl.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -53,17 +55,27 @@ FTTextureFont::FTTextureFont(const unsigned char *pBufferBytes,
 {}
 
 
+FTTextureFont::FTTextureFont(char const *fontFilePath,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTTextureFontImpl(this, fontFilePath, backend))
+{}
+
+
+FTTextureFont::FTTextureFont(const unsigned char *pBufferBytes,
+                             size_t bufferSizeInBytes,
+                             FTGL::RenderBackend backend) :
+    FTFont(new FTTextureFontImpl(this, pBufferBytes, bufferSizeInBytes,
+                                 backend))
+{}
+
+
 FTTextureFont::~FTTextureFont()
 {}
 
 
 FTGlyph* FTTextureFont::MakeGlyph(FT_GlyphSlot ftGlyph)
 {
-    FTTextureFontImpl *myimpl = dynamic_cast<FTTextureFontImpl *>(impl);
-    if(!myimpl)
-    {
-        return NULL;
-    }
+    FTTextureFontImpl *myimpl = static_cast<FTTextureFontImpl *>(impl);
 
     return myimpl->MakeGlyphImpl(ftGlyph);
 }
@@ -90,7 +102,8 @@ static inline GLuint ClampSize(GLuint in, GLuint maxTextureSize)
 }
 
 
-FTTextureFontImpl::FTTextureFontImpl(FTFont *ftFont, const char* fontFilePath)
+FTTextureFontImpl::FTTextureFontImpl(FTFont *ftFont, const char* fontFilePath,
+                                     FTGL::RenderBackend renderBackend)
 :   FTFontImpl(ftFont, fontFilePath),
     maximumGLTextureSize(0),
     textureWidth(0),
@@ -99,16 +112,19 @@ FTTextureFontImpl::FTTextureFontImpl(FTFont *ftFont, const char* fontFilePath)
     glyphWidth(0),
     padding(3),
     xOffset(0),
-    yOffset(0)
+    yOffset(0),
+    batching(false)
 {
     load_flags = FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP;
     remGlyphs = numGlyphs = face.GlyphCount();
+    UseBackend(renderBackend);
 }
 
 
 FTTextureFontImpl::FTTextureFontImpl(FTFont *ftFont,
                                      const unsigned char *pBufferBytes,
-                                     size_t bufferSizeInBytes)
+                                     size_t bufferSizeInBytes,
+                                     FTGL::RenderBackend renderBackend)
 :   FTFontImpl(ftFont, pBufferBytes, bufferSizeInBytes),
     maximumGLTextureSize(0),
     textureWidth(0),
@@ -117,10 +133,12 @@ FTTextureFontImpl::FTTextureFontImpl(FTFont *ftFont,
     glyphWidth(0),
     padding(3),
     xOffset(0),
-    yOffset(0)
+    yOffset(0),
+    batching(false)
 {
     load_flags = FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP;
     remGlyphs = numGlyphs = face.GlyphCount();
+    UseBackend(renderBackend);
 }
 
 
@@ -162,7 +180,11 @@ FTGlyph* FTTextureFontImpl::MakeGlyphImpl(FT_GlyphSlot ftGlyph)
 
     FTTextureGlyph* tempGlyph = new FTTextureGlyph(ftGlyph, textureIDList[textureIDList.size() - 1],
                                                     xOffset, yOffset, textureWidth, textureHeight);
-    xOffset += static_cast<int>(tempGlyph->BBox().Upper().X() - tempGlyph->BBox().Lower().X() + padding + 0.5);
+    int cellWidth = static_cast<int>(tempGlyph->BBox().Upper().X() - tempGlyph->BBox().Lower().X() + padding + 0.5);
+    xOffset += cellWidth;
+
+    stats.Add(FTGL::STAT_ATLAS_TEXELS_USED,
+              (FTGL_UINT64)cellWidth * glyphHeight);
 
     --remGlyphs;
 
@@ -197,6 +219,8 @@ void FTTextureFontImpl::CalculateTextureSize()
 
 GLuint FTTextureFontImpl::CreateTexture()
 {
+    FTGL_TRACE_SPAN(FTGL::TRACE_UPLOAD, 0, 0, 0);
+
     CalculateTextureSize();
 
     int totalMemory = textureWidth * textureHeight;
@@ -206,17 +230,28 @@ GLuint FTTextureFontImpl::CreateTexture()
     GLuint textID;
     glGenTextures(1, (GLuint*)&textID);
 
+    // The core profile has no alpha textures: coverage goes in the red
+    // channel, where FTTextureGlyph finds it from the internal format.
+    const bool coreProfile = backend == FTGL::BACKEND_CORE_PROFILE;
+    const GLint wrap = coreProfile ? GL_CLAMP_TO_EDGE : GL_CLAMP;
+    const GLint format = coreProfile ? GL_R8 : GL_ALPHA;
+
     glBindTexture(GL_TEXTURE_2D, textID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, textureWidth, textureHeight,
-                 0, GL_ALPHA, GL_UNSIGNED_BYTE, textureMemory);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, textureWidth, textureHeight,
+                 0, coreProfile ? GL_RED : GL_ALPHA, GL_UNSIGNED_BYTE,
+                 textureMemory);
 
     delete [] textureMemory;
 
+    stats.Add(FTGL::STAT_ATLAS_TEXTURES);
+    stats.Add(FTGL::STAT_ATLAS_TEXELS,
+              (FTGL_UINT64)textureWidth * textureHeight);
+
     return textID;
 }
 
@@ -225,20 +260,276 @@ bool FTTextureFontImpl::FaceSize(const unsigned int size, const unsigned int res
 {
     if(!textureIDList.empty())
     {
+        // Queued quads refer to the textures that are about to go
+        FlushBatch();
+
         glDeleteTextures((GLsizei)textureIDList.size(), (const GLuint*)&textureIDList[0]);
         textureIDList.clear();
         remGlyphs = numGlyphs = face.GlyphCount();
+
+        stats.Set(FTGL::STAT_ATLAS_TEXTURES, 0);
+        stats.Set(FTGL::STAT_ATLAS_TEXELS, 0);
+        stats.Set(FTGL::STAT_ATLAS_TEXELS_USED, 0);
     }
 
     return FTFontImpl::FaceSize(size, res);
 }
 
 
+void FTTextureFontImpl::BeginBatch()
+{
+    batching = true;
+}
+
+
+void FTTextureFontImpl::EndBatch()
+{
+    FlushBatch();
+    batching = false;
+}
+
+
+template <typename T>
+FTPoint FTTextureFontImpl::QueueI(const T* string, const int len,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode, bool& queued)
+{
+    placements.resize(0, GlyphPlacement());
+    FTPoint end = PlaceGlyphs(string, len, position, spacing, placements,
+                              renderMode);
+
+    int count = (int)placements.size();
+
+    // A subclass produced its own glyph type: let it draw itself.
+    for(int i = 0; i < count; i++)
+    {
+        const FTGlyphImpl *glyph = placements[i].glyph->impl;
+        if(glyph->Kind() != FTGlyphImpl::GLYPH_TEXTURE)
+        {
+            queued = false;
+            return end;
+        }
+    }
+
+    GLfloat color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    if(backend == FTGL::BACKEND_CORE_PROFILE)
+    {
+        color[0] = coreColor[0];
+        color[1] = coreColor[1];
+        color[2] = coreColor[2];
+        color[3] = coreColor[3];
+    }
+    else
+    {
+        glGetFloatv(GL_CURRENT_COLOR, color);
+    }
+
+    int page = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        const FTTextureGlyphImpl *glyph =
+            static_cast<const FTTextureGlyphImpl *>(placements[i].glyph->impl);
+
+        if(!glyph->destWidth || !glyph->destHeight)
+        {
+            continue;
+        }
+
+        // Neighbouring glyphs are usually on the same texture; otherwise
+        // look from the newest one, where glyphs are added.
+        if(textureIDList[page] != (GLuint)glyph->glTextureID)
+        {
+            page = (int)textureIDList.size() - 1;
+            while(page > 0
+                   && textureIDList[page] != (GLuint)glyph->glTextureID)
+            {
+                page--;
+            }
+        }
+
+        // Same corners and texture coordinates as RenderImpl()
+        const FTPointf& origin = placements[i].pen;
+        float dx = floor(origin.Xf() + glyph->corner.Xf());
+        float dy = floor(origin.Yf() + glyph->corner.Yf());
+
+        const GLfloat x[4] = { dx, dx, dx + glyph->destWidth,
+                               dx + glyph->destWidth };
+        const GLfloat y[4] = { dy, dy - glyph->destHeight,
+                               dy - glyph->destHeight, dy };
+        const GLfloat s[4] = { glyph->uv[0].Xf(), glyph->uv[0].Xf(),
+                               glyph->uv[1].Xf(), glyph->uv[1].Xf() };
+        const GLfloat t[4] = { glyph->uv[0].Yf(), glyph->uv[1].Yf(),
+                               glyph->uv[1].Yf(), glyph->uv[0].Yf() };
+
+        BatchQuad& quad = batchQuads.emplace_back();
+        quad.page = page;
+
+        for(int v = 0; v < 4; v++)
+        {
+            FTCoreVertex& vertex = quad.vertex[v];
+            vertex.position[0] = x[v];
+            vertex.position[1] = y[v];
+            vertex.position[2] = origin.Zf();
+            vertex.texCoord[0] = s[v];
+            vertex.texCoord[1] = t[v];
+            vertex.color[0] = color[0];
+            vertex.color[1] = color[1];
+            vertex.color[2] = color[2];
+            vertex.color[3] = color[3];
+        }
+    }
+
+    queued = true;
+    return end;
+}
+
+
+void FTTextureFontImpl::FlushBatch()
+{
+    size_t count = batchQuads.size();
+    if(!count)
+    {
+        return;
+    }
+
+    // The core profile has no quads: each one is two triangles there
+    static const int triangles[6] = { 0, 1, 2, 0, 2, 3 };
+    static const int quads[4] = { 0, 1, 2, 3 };
+
+    const bool coreProfile = backend == FTGL::BACKEND_CORE_PROFILE;
+    const int *corners = coreProfile ? triangles : quads;
+    const int cornerCount = coreProfile ? 6 : 4;
+
+    batchVertices.resize(count * cornerCount, FTCoreVertex());
+
+    // Regroup the quads by texture, keeping their order within each
+    // texture so that overlapping glyphs blend as they did when queued:
+    // count the vertices of each texture, find where each group starts,
+    // then copy every quad to the end of its group.
+    const size_t pages = textureIDList.size();
+    batchCounts.resize(0, 0);
+    batchCounts.resize(pages, 0);
+    batchOffsets.resize(pages, 0);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        batchCounts[batchQuads[i].page] += cornerCount;
+    }
+
+    GLsizei last = 0;
+    for(size_t n = 0; n < pages; n++)
+    {
+        batchOffsets[n] = last;
+        last += batchCounts[n];
+    }
+
+    for(size_t i = 0; i < count; i++)
+    {
+        const BatchQuad& quad = batchQuads[i];
+        GLsizei& offset = batchOffsets[quad.page];
+
+        for(int v = 0; v < cornerCount; v++)
+        {
+            batchVertices[offset++] = quad.vertex[corners[v]];
+        }
+    }
+
+    if(coreProfile)
+    {
+        if(core.Begin(&batchVertices[0], last, coreTransform))
+        {
+            DrawBatch(GL_TRIANGLES);
+            core.End();
+        }
+    }
+    else
+    {
+        glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT
+                      | GL_TEXTURE_ENV_MODE);
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+        glEnable(GL_TEXTURE_2D);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+        const FTCoreVertex *vertices = &batchVertices[0];
+        const GLsizei stride = sizeof(FTCoreVertex);
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, vertices->position);
+        glTexCoordPointer(2, GL_FLOAT, stride, vertices->texCoord);
+        glColorPointer(4, GL_FLOAT, stride, vertices->color);
+
+        DrawBatch(GL_QUADS);
+
+        glPopClientAttrib();
+        glPopAttrib();
+
+        FTTextureGlyphImpl::ResetActiveTexture();
+    }
+
+    batchQuads.resize(0, BatchQuad());
+}
+
+
+void FTTextureFontImpl::DrawBatch(GLenum mode)
+{
+    const bool coreProfile = backend == FTGL::BACKEND_CORE_PROFILE;
+    GLint first = 0;
+
+    for(size_t n = 0; n < batchCounts.size(); n++)
+    {
+        GLsizei count = batchCounts[n];
+
+        if(!count)
+        {
+            continue;
+        }
+
+        stats.Add(FTGL::STAT_TEXTURE_BINDS);
+
+        if(coreProfile)
+        {
+            core.Draw(mode, first, count, textureIDList[n]);
+        }
+        else
+        {
+            glBindTexture(GL_TEXTURE_2D, textureIDList[n]);
+            glDrawArrays(mode, first, count);
+        }
+
+        first += count;
+    }
+}
+
+
 template <typename T>
 inline FTPoint FTTextureFontImpl::RenderI(const T* string, const int len,
                                           FTPoint position, FTPoint spacing,
                                           int renderMode)
 {
+    const bool coreProfile = backend == FTGL::BACKEND_CORE_PROFILE;
+
+    // The core profile backend always goes through the queue, and only
+    // draws texture glyphs.
+    if(batching || coreProfile)
+    {
+        bool queued;
+        FTPoint end = QueueI(string, len, position, spacing, renderMode,
+                             queued);
+        if(coreProfile && !batching)
+        {
+            FlushBatch();
+        }
+        if(queued || coreProfile)
+        {
+            return end;
+        }
+    }
+
     // Protect GL_TEXTURE_2D
     glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_ENV_MODE);
 
@@ -271,3 +562,19 @@ FTPoint FTTextureFontImpl::Render(const wchar_t * string, const int len,
     return RenderI(string, len, position, spacing, renderMode);
 }
 
+
+FTPoint FTTextureFontImpl::Render(const FTGlyphRun *run, const int count,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(run, count, position, spacing, renderMode);
+}
+
+
+FTPoint FTTextureFontImpl::Render(const FTUnicodeText *text, const int len,
+                                  FTPoint position, FTPoint spacing,
+                                  int renderMode)
+{
+    return RenderI(text, len, position, spacing, renderMode);
+}
+
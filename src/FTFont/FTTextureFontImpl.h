@@ -38,10 +38,14 @@ class FTTextureFontImpl : public FTFontImpl
     friend class FTTextureFont;
 
     protected:
-        FTTextureFontImpl(FTFont *ftFont, const char* fontFilePath);
+        FTTextureFontImpl(FTFont *ftFont, const char* fontFilePath,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         FTTextureFontImpl(FTFont *ftFont, const unsigned char *pBufferBytes,
-                          size_t bufferSizeInBytes);
+                          size_t bufferSizeInBytes,
+                          FTGL::RenderBackend renderBackend
+                              = FTGL::BACKEND_FIXED_FUNCTION);
 
         virtual ~FTTextureFontImpl();
 
@@ -55,6 +59,10 @@ class FTTextureFontImpl : public FTFontImpl
         virtual bool FaceSize(const unsigned int size,
                               const unsigned int res = 72);
 
+        virtual void BeginBatch();
+
+        virtual void EndBatch();
+
         virtual FTPoint Render(const char *s, const int len,
                                FTPoint position, FTPoint spacing,
                                int renderMode);
@@ -63,6 +71,14 @@ class FTTextureFontImpl : public FTFontImpl
                                FTPoint position, FTPoint spacing,
                                int renderMode);
 
+        virtual FTPoint Render(const FTGlyphRun *run, const int count,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
+        virtual FTPoint Render(const FTUnicodeText *text, const int len,
+                               FTPoint position, FTPoint spacing,
+                               int renderMode);
+
     private:
         /**
          * Create an FTTextureGlyph object for the base class.
@@ -80,15 +96,41 @@ class FTTextureFontImpl : public FTFontImpl
         /**
          * Creates a 'blank' OpenGL texture object.
          *
-         * The format is GL_ALPHA and the params are
-         * GL_TEXTURE_WRAP_S = GL_CLAMP
-         * GL_TEXTURE_WRAP_T = GL_CLAMP
+         * The format is GL_ALPHA, or GL_R8 for the core profile backend,
+         * and the params are
+         * GL_TEXTURE_WRAP_S = GL_CLAMP (GL_CLAMP_TO_EDGE in core profile)
+         * GL_TEXTURE_WRAP_T = GL_CLAMP (GL_CLAMP_TO_EDGE in core profile)
          * GL_TEXTURE_MAG_FILTER = GL_LINEAR
          * GL_TEXTURE_MIN_FILTER = GL_LINEAR
          * Note that mipmapping is NOT used
          */
         inline GLuint CreateTexture();
 
+        /**
+         * Queue the glyph quads of a string for the current batch.
+         *
+         * @param queued  Set to <code>false</code> if a glyph is not a
+         *                texture glyph, in which case nothing is queued and
+         *                the string has to be drawn immediately.
+         * @return  The pen position after the last character.
+         */
+        template <typename T>
+        FTPoint QueueI(const T *s, const int len, FTPoint position,
+                       FTPoint spacing, int renderMode, bool& queued);
+
+        /**
+         * Draw the queued quads, one draw call per texture, and empty the
+         * queue. Quads are drawn as two triangles each by the core profile
+         * backend.
+         */
+        void FlushBatch();
+
+        /**
+         * Issue the draw calls of <code>FlushBatch()</code>, one per
+         * texture with queued quads.
+         */
+        void DrawBatch(GLenum mode);
+
         /**
          * The maximum texture dimension on this OpenGL implemetation
          */
@@ -142,6 +184,41 @@ class FTTextureFontImpl : public FTFontImpl
          */
         int yOffset;
 
+        /**
+         * A glyph quad waiting to be drawn, with the index in
+         * <code>textureIDList</code> of the texture it samples.
+         */
+        struct BatchQuad
+        {
+            int page;
+            FTCoreVertex vertex[4];
+        };
+
+        /**
+         * Whether <code>Render()</code> queues quads instead of drawing.
+         */
+        bool batching;
+
+        /**
+         * The quads queued since <code>BeginBatch()</code>, in drawing
+         * order.
+         */
+        FTVector<BatchQuad> batchQuads;
+
+        /**
+         * The queued quads regrouped by texture, reused between batches,
+         * the number of vertices using each texture, and where the
+         * vertices of each texture go while they are regrouped.
+         */
+        FTVector<FTCoreVertex> batchVertices;
+        FTVector<GLsizei> batchCounts;
+        FTVector<GLsizei> batchOffsets;
+
+        /**
+         * The glyph placements of the string being queued.
+         */
+        FTVector<GlyphPlacement> placements;
+
         /* Internal generic Render() implementation */
         template <typename T>
         inline FTPoint RenderI(const T *s, const int len,
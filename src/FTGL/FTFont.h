@@ -150,6 +150,25 @@ class FTGL_EXPORT FTFont
          */
         virtual FT_Encoding* CharMapList();
 
+        /**
+         * Set the shaper that turns strings into glyphs, for ligatures,
+         * mark positioning and complex scripts. The font does not take
+         * ownership of the shaper, which must outlive it or be replaced
+         * first. Strings passed with FTGL::RENDER_VISUAL_ORDER are not
+         * shaped; FTSimpleLayout shapes the runs of its lines itself.
+         *
+         * @param shaper  A shaper, or <code>NULL</code> to map each
+         *                character to one glyph.
+         */
+        virtual void Shaper(FTShaper *shaper);
+
+        /**
+         * Get the shaper of the font.
+         *
+         * @return  The current shaper, or <code>NULL</code>.
+         */
+        virtual FTShaper* Shaper() const;
+
         /**
          * Set the char size for the current face.
          *
@@ -200,6 +219,56 @@ class FTGL_EXPORT FTFont
          */
         virtual void UseDisplayList(bool useList);
 
+        /**
+         * Start collecting the strings rendered with this font instead of
+         * drawing them one at a time. Only implemented by FTTextureFont;
+         * other fonts keep drawing immediately.
+         *
+         * Each string is queued with its pen position and the current
+         * OpenGL colour. The queued glyphs are drawn by
+         * <code>EndBatch()</code>, grouped by texture, using the OpenGL
+         * transformation that is current at that point.
+         */
+        virtual void BeginBatch();
+
+        /**
+         * Draw the strings queued since <code>BeginBatch()</code> with a
+         * single OpenGL state setup, and stop collecting.
+         */
+        virtual void EndBatch();
+
+        /**
+         * Get the renderer the font was created with.
+         *
+         * @return  FTGL::BACKEND_FIXED_FUNCTION, or
+         *          FTGL::BACKEND_CORE_PROFILE for fonts drawing with
+         *          shaders and vertex buffers.
+         */
+        virtual FTGL::RenderBackend Backend() const;
+
+        /**
+         * Set the matrix taking text coordinates to clip space, for fonts
+         * using the core profile backend. Fonts using the fixed-function
+         * backend use the OpenGL matrix stacks instead.
+         *
+         * @param matrix  Sixteen values in column-major order, as given to
+         *                glUniformMatrix4fv(), or NULL for the identity.
+         */
+        virtual void Transform(const float *matrix);
+
+        /**
+         * Set the text colour, for fonts using the core profile backend.
+         * Fonts using the fixed-function backend use the current OpenGL
+         * colour instead. The default is opaque white.
+         *
+         * @param red  The red component.
+         * @param green  The green component.
+         * @param blue  The blue component.
+         * @param alpha  The alpha component.
+         */
+        virtual void Color(float red, float green, float blue,
+                           float alpha = 1.0f);
+
         /**
          * Get the global ascender height for the face.
          *
@@ -369,6 +438,305 @@ class FTGL_EXPORT FTFont
                                FTPoint spacing = FTPoint(),
                                int renderMode = FTGL::RENDER_ALL);
 
+        /**
+         * Get the bounding box of glyphs given by their index in the font,
+         * for text that was already mapped to glyphs, by a shaper for
+         * instance. The character map is not used.
+         *
+         * @param glyphs  The glyph indices.
+         * @param positions  The pen position of each glyph, relative to
+         *                   <code>position</code>, or <code>NULL</code> to
+         *                   place each glyph after the previous one with
+         *                   kerning.
+         * @param count  The number of glyphs.
+         * @param position  The pen position of the first glyph (optional).
+         * @param spacing  A displacement vector to add between glyphs when
+         *                 there are no positions (optional).
+         * @return  The corresponding bounding box.
+         */
+        virtual FTBBox BBoxGlyphs(const unsigned int *glyphs,
+                                  const FTPoint *positions, const int count,
+                                  FTPoint position = FTPoint(),
+                                  FTPoint spacing = FTPoint());
+
+        /**
+         * Get the advance of glyphs given by their index in the font.
+         *
+         * @param glyphs  The glyph indices.
+         * @param positions  The pen position of each glyph, or
+         *                   <code>NULL</code> to place each glyph after the
+         *                   previous one with kerning.
+         * @param count  The number of glyphs.
+         * @param spacing  A displacement vector to add between glyphs when
+         *                 there are no positions (optional).
+         * @return  The pen position after the last glyph, along the x axis.
+         */
+        virtual float AdvanceGlyphs(const unsigned int *glyphs,
+                                    const FTPoint *positions, const int count,
+                                    FTPoint spacing = FTPoint());
+
+        /**
+         * Render glyphs given by their index in the font. The character map
+         * is not used, and the glyphs are drawn in the given order.
+         *
+         * @param glyphs  The glyph indices.
+         * @param positions  The pen position of each glyph, relative to
+         *                   <code>position</code>, or <code>NULL</code> to
+         *                   place each glyph after the previous one with
+         *                   kerning.
+         * @param count  The number of glyphs.
+         * @param position  The pen position of the first glyph (optional).
+         * @param spacing  A displacement vector to add between glyphs when
+         *                 there are no positions (optional).
+         * @param renderMode  Render mode to use for display (optional).
+         * @return  The new pen position after the last glyph was output.
+         */
+        virtual FTPoint RenderGlyphs(const unsigned int *glyphs,
+                                     const FTPoint *positions, const int count,
+                                     FTPoint position = FTPoint(),
+                                     FTPoint spacing = FTPoint(),
+                                     int renderMode = FTGL::RENDER_ALL);
+
+        /**
+         * Get the bounding box of a UTF-8 string of a given size in bytes.
+         * Unlike <code>BBox()</code>, nothing past the end of the string
+         * is read.
+         *
+         * @param string  A UTF-8 string.
+         * @param len  The length of the string in bytes. If < 0 then the
+         *             string ends with a null character (optional).
+         * @param position  The pen position of the first character (optional).
+         * @param spacing  A displacement vector to add after each character
+         *                 has been checked (optional).
+         * @return  The corresponding bounding box.
+         */
+        virtual FTBBox BBoxUTF8(const char *string, const int len = -1,
+                                FTPoint position = FTPoint(),
+                                FTPoint spacing = FTPoint());
+
+        /**
+         * Get the bounding box of a UTF-16 string of a given size in
+         * 16 bit code units, in the byte order of the machine.
+         *
+         * @see BBoxUTF8
+         */
+        virtual FTBBox BBoxUTF16(const unsigned short *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint(),
+                                 FTPoint spacing = FTPoint());
+
+        /**
+         * Get the bounding box of a UTF-32 string of a given number of
+         * characters.
+         *
+         * @see BBoxUTF8
+         */
+        virtual FTBBox BBoxUTF32(const unsigned int *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint(),
+                                 FTPoint spacing = FTPoint());
+
+        /**
+         * Get the advance of a UTF-8 string of a given size in bytes.
+         *
+         * @param string  A UTF-8 string.
+         * @param len  The length of the string in bytes. If < 0 then the
+         *             string ends with a null character (optional).
+         * @param spacing  A displacement vector to add after each character
+         *                 has been checked (optional).
+         * @return  The string's advance width.
+         */
+        virtual float AdvanceUTF8(const char *string, const int len = -1,
+                                  FTPoint spacing = FTPoint());
+
+        /**
+         * Get the advance of a UTF-16 string of a given size in 16 bit code
+         * units.
+         *
+         * @see AdvanceUTF8
+         */
+        virtual float AdvanceUTF16(const unsigned short *string,
+                                   const int len = -1,
+                                   FTPoint spacing = FTPoint());
+
+        /**
+         * Get the advance of a UTF-32 string of a given number of
+         * characters.
+         *
+         * @see AdvanceUTF8
+         */
+        virtual float AdvanceUTF32(const unsigned int *string,
+                                   const int len = -1,
+                                   FTPoint spacing = FTPoint());
+
+        /**
+         * Render a UTF-8 string of a given size in bytes.
+         *
+         * @param string  A UTF-8 string.
+         * @param len  The length of the string in bytes. If < 0 then the
+         *             string ends with a null character (optional).
+         * @param position  The pen position of the first character (optional).
+         * @param spacing  A displacement vector to add after each character
+         *                 has been displayed (optional).
+         * @param renderMode  Render mode to use for display (optional).
+         * @return  The new pen position after the last character was output.
+         */
+        virtual FTPoint RenderUTF8(const char *string, const int len = -1,
+                                   FTPoint position = FTPoint(),
+                                   FTPoint spacing = FTPoint(),
+                                   int renderMode = FTGL::RENDER_ALL);
+
+        /**
+         * Render a UTF-16 string of a given size in 16 bit code units.
+         *
+         * @see RenderUTF8
+         */
+        virtual FTPoint RenderUTF16(const unsigned short *string,
+                                    const int len = -1,
+                                    FTPoint position = FTPoint(),
+                                    FTPoint spacing = FTPoint(),
+                                    int renderMode = FTGL::RENDER_ALL);
+
+        /**
+         * Render a UTF-32 string of a given number of characters.
+         *
+         * @see RenderUTF8
+         */
+        virtual FTPoint RenderUTF32(const unsigned int *string,
+                                    const int len = -1,
+                                    FTPoint position = FTPoint(),
+                                    FTPoint spacing = FTPoint(),
+                                    int renderMode = FTGL::RENDER_ALL);
+
+#ifdef FTGL_HAS_UNICODE_CHARS
+        /**
+         * <code>BBox()</code>, <code>Advance()</code> and
+         * <code>Render()</code> for UTF-16 and UTF-32 strings. The length
+         * is given in code units, as with <code>BBoxUTF16()</code> and
+         * <code>BBoxUTF32()</code>.
+         */
+        FTBBox BBox(const char16_t *string, const int len = -1,
+                    FTPoint position = FTPoint(), FTPoint spacing = FTPoint())
+        {
+            return BBoxUTF16(reinterpret_cast<const unsigned short *>(string),
+                             len, position, spacing);
+        }
+
+        FTBBox BBox(const char32_t *string, const int len = -1,
+                    FTPoint position = FTPoint(), FTPoint spacing = FTPoint())
+        {
+            return BBoxUTF32(reinterpret_cast<const unsigned int *>(string),
+                             len, position, spacing);
+        }
+
+        float Advance(const char16_t *string, const int len = -1,
+                      FTPoint spacing = FTPoint())
+        {
+            const unsigned short *units =
+                reinterpret_cast<const unsigned short *>(string);
+            return AdvanceUTF16(units, len, spacing);
+        }
+
+        float Advance(const char32_t *string, const int len = -1,
+                      FTPoint spacing = FTPoint())
+        {
+            return AdvanceUTF32(reinterpret_cast<const unsigned int *>(string),
+                                len, spacing);
+        }
+
+        FTPoint Render(const char16_t *string, const int len = -1,
+                       FTPoint position = FTPoint(),
+                       FTPoint spacing = FTPoint(),
+                       int renderMode = FTGL::RENDER_ALL)
+        {
+            const unsigned short *units =
+                reinterpret_cast<const unsigned short *>(string);
+            return RenderUTF16(units, len, position, spacing, renderMode);
+        }
+
+        FTPoint Render(const char32_t *string, const int len = -1,
+                       FTPoint position = FTPoint(),
+                       FTPoint spacing = FTPoint(),
+                       int renderMode = FTGL::RENDER_ALL)
+        {
+            return RenderUTF32(reinterpret_cast<const unsigned int *>(string),
+                               len, position, spacing, renderMode);
+        }
+#endif
+
+#ifdef FTGL_HAS_STRING_VIEW
+        /**
+         * <code>BBox()</code>, <code>Advance()</code> and
+         * <code>Render()</code> for string views holding UTF-8, UTF-16 or
+         * UTF-32 text. The views need not be null-terminated.
+         */
+        FTBBox BBox(std::string_view string, FTPoint position = FTPoint(),
+                    FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBoxUTF8(string.data(), len, position, spacing);
+        }
+
+        FTBBox BBox(std::u16string_view string, FTPoint position = FTPoint(),
+                    FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBox(string.data(), len, position, spacing);
+        }
+
+        FTBBox BBox(std::u32string_view string, FTPoint position = FTPoint(),
+                    FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBox(string.data(), len, position, spacing);
+        }
+
+        float Advance(std::string_view string, FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return AdvanceUTF8(string.data(), len, spacing);
+        }
+
+        float Advance(std::u16string_view string, FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return Advance(string.data(), len, spacing);
+        }
+
+        float Advance(std::u32string_view string, FTPoint spacing = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return Advance(string.data(), len, spacing);
+        }
+
+        FTPoint Render(std::string_view string, FTPoint position = FTPoint(),
+                       FTPoint spacing = FTPoint(),
+                       int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            return RenderUTF8(string.data(), len, position, spacing,
+                              renderMode);
+        }
+
+        FTPoint Render(std::u16string_view string,
+                       FTPoint position = FTPoint(),
+                       FTPoint spacing = FTPoint(),
+                       int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            return Render(string.data(), len, position, spacing, renderMode);
+        }
+
+        FTPoint Render(std::u32string_view string,
+                       FTPoint position = FTPoint(),
+                       FTPoint spacing = FTPoint(),
+                       int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            return Render(string.data(), len, position, spacing, renderMode);
+        }
+#endif
+
         /**
          * Queries the Font for errors.
          *
@@ -376,10 +744,49 @@ class FTGL_EXPORT FTFont
          */
         virtual FT_Error Error() const;
 
+        /**
+         * Get one of the statistics the font keeps on its caches, the
+         * FreeType calls it makes and the time it spends, to tune cache
+         * sizes and spot regressions.
+         *
+         * @param which  The statistic to get.
+         * @return  The value since the font was created or since the last
+         *          call to ResetStatistics(), or 0 for an unknown
+         *          statistic.
+         */
+        virtual FTGL_UINT64 GetStatistic(FTGL::Statistic which) const;
+
+        /**
+         * Restart the counters and timers of the font from zero. The
+         * atlas figures are not affected.
+         */
+        virtual void ResetStatistics();
+
+        /**
+         * Get one of the statistics summed over all fonts, including the
+         * fonts that have been destroyed.
+         *
+         * @param which  The statistic to get.
+         * @return  The value since the first font was created or since the
+         *          last call to ResetGlobalStatistics(), or 0 for an
+         *          unknown statistic.
+         */
+        static FTGL_UINT64 GetGlobalStatistic(FTGL::Statistic which);
+
+        /**
+         * Restart the global counters and timers from zero. The statistics
+         * of each font are not affected.
+         */
+        static void ResetGlobalStatistics();
+
     protected:
         /* Allow impl to access MakeGlyph */
         friend class FTFontImpl;
 
+        /* Allow FTSimpleLayout to measure text without going through the
+         * per-string API */
+        friend class FTSimpleLayoutImpl;
+
         /**
          * Construct a glyph of the correct type.
          *
@@ -503,6 +910,15 @@ FTGL_EXPORT unsigned int ftglGetFontCharMapCount(FTGLfont* font);
  */
 FTGL_EXPORT FT_Encoding* ftglGetFontCharMapList(FTGLfont* font);
 
+/**
+ * Set the shaper that turns strings into glyphs.
+ *
+ * @param font  An FTGLfont* object.
+ * @param shaper  An FTGLshaper* object, or NULL to map each character to
+ *                one glyph.
+ */
+FTGL_EXPORT void ftglSetFontShaper(FTGLfont* font, FTGLshaper* shaper);
+
 /**
  * Set the char size for the current face.
  *
@@ -552,6 +968,43 @@ FTGL_EXPORT void ftglSetFontOutset(FTGLfont* font, float front, float back);
  */
 FTGL_EXPORT void ftglSetFontDisplayList(FTGLfont* font, int useList);
 
+/**
+ * Start collecting the strings rendered with a font instead of drawing
+ * them one at a time. Only implemented by texture fonts.
+ *
+ * @param font  An FTGLfont* object.
+ */
+FTGL_EXPORT void ftglBeginFontBatch(FTGLfont* font);
+
+/**
+ * Draw the strings queued since ftglBeginFontBatch() and stop collecting.
+ *
+ * @param font  An FTGLfont* object.
+ */
+FTGL_EXPORT void ftglEndFontBatch(FTGLfont* font);
+
+/**
+ * Set the matrix taking text coordinates to clip space, for fonts using
+ * the core profile backend.
+ *
+ * @param font  An FTGLfont* object.
+ * @param matrix  Sixteen values in column-major order, or NULL for the
+ *                identity.
+ */
+FTGL_EXPORT void ftglSetFontTransform(FTGLfont* font, const float *matrix);
+
+/**
+ * Set the text colour, for fonts using the core profile backend.
+ *
+ * @param font  An FTGLfont* object.
+ * @param red  The red component.
+ * @param green  The green component.
+ * @param blue  The blue component.
+ * @param alpha  The alpha component.
+ */
+FTGL_EXPORT void ftglSetFontColor(FTGLfont* font, float red, float green,
+                                  float blue, float alpha);
+
 /**
  * Get the global ascender height for the face.
  *
@@ -607,6 +1060,51 @@ FTGL_EXPORT float ftglGetFontAdvance(FTGLfont* font, const char *string);
  */
 FTGL_EXPORT void ftglRenderFont(FTGLfont* font, const char *string, int mode);
 
+/**
+ * Get the bounding box of glyphs given by their index in the font.
+ *
+ * @param font  An FTGLfont* object.
+ * @param glyphs  The glyph indices.
+ * @param positions  The x and y pen position of each glyph, or NULL to place
+ *                   each glyph after the previous one.
+ * @param count  The number of glyphs.
+ * @param bounds  An array of 6 float values where the bounding box's lower
+ *                left near and upper right far 3D coordinates will be stored.
+ */
+FTGL_EXPORT void ftglGetFontGlyphsBBox(FTGLfont* font,
+                                       const unsigned int *glyphs,
+                                       const float *positions, int count,
+                                       float bounds[6]);
+
+/**
+ * Get the advance width of glyphs given by their index in the font.
+ *
+ * @param font  An FTGLfont* object.
+ * @param glyphs  The glyph indices.
+ * @param positions  The x and y pen position of each glyph, or NULL to place
+ *                   each glyph after the previous one.
+ * @param count  The number of glyphs.
+ * @return  Advance width
+ */
+FTGL_EXPORT float ftglGetFontGlyphsAdvance(FTGLfont* font,
+                                           const unsigned int *glyphs,
+                                           const float *positions, int count);
+
+/**
+ * Render glyphs given by their index in the font.
+ *
+ * @param font  An FTGLfont* object.
+ * @param glyphs  The glyph indices.
+ * @param positions  The x and y pen position of each glyph, or NULL to place
+ *                   each glyph after the previous one.
+ * @param count  The number of glyphs.
+ * @param mode  Render mode to display.
+ */
+FTGL_EXPORT void ftglRenderFontGlyphs(FTGLfont* font,
+                                      const unsigned int *glyphs,
+                                      const float *positions, int count,
+                                      int mode);
+
 /**
  * Query a font for errors.
  *
@@ -615,6 +1113,35 @@ FTGL_EXPORT void ftglRenderFont(FTGLfont* font, const char *string, int mode);
  */
 FTGL_EXPORT FT_Error ftglGetFontError(FTGLfont* font);
 
+/**
+ * Get one of the statistics a font keeps.
+ *
+ * @param font  An FTGLfont* object.
+ * @param which  One of the FTGL_STAT_ values.
+ * @return  The value since the font was created or last reset.
+ */
+FTGL_EXPORT FTGL_UINT64 ftglGetFontStatistic(FTGLfont* font, int which);
+
+/**
+ * Restart the counters and timers of a font from zero.
+ *
+ * @param font  An FTGLfont* object.
+ */
+FTGL_EXPORT void ftglResetFontStatistics(FTGLfont* font);
+
+/**
+ * Get one of the statistics summed over all fonts.
+ *
+ * @param which  One of the FTGL_STAT_ values.
+ * @return  The value since the first font was created or last reset.
+ */
+FTGL_EXPORT FTGL_UINT64 ftglGetGlobalStatistic(int which);
+
+/**
+ * Restart the global counters and timers from zero.
+ */
+FTGL_EXPORT void ftglResetGlobalStatistics(void);
+
 FTGL_END_C_DECLS
 
 #endif  //  __FTFont__
@@ -64,6 +64,29 @@ class FTGL_EXPORT FTExtrudeFont : public FTFont
         FTExtrudeFont(const unsigned char *pBufferBytes,
                       size_t bufferSizeInBytes);
 
+        /**
+         * Open and read a font file, drawing with the given renderer.
+         * Sets Error flag.
+         *
+         * @param fontFilePath  font file path.
+         * @param backend  FTGL::BACKEND_CORE_PROFILE to draw with OpenGL
+         *                 3.3 core profile shaders and vertex buffers, or
+         *                 FTGL::BACKEND_FIXED_FUNCTION.
+         */
+        FTExtrudeFont(const char* fontFilePath, FTGL::RenderBackend backend);
+
+        /**
+         * Open and read a font from a buffer in memory, drawing with the
+         * given renderer. Sets Error flag. The buffer is owned by the
+         * client and is NOT copied by FTGL.
+         *
+         * @param pBufferBytes  the in-memory buffer
+         * @param bufferSizeInBytes  the length of the buffer in bytes
+         * @param backend  The renderer to draw with.
+         */
+        FTExtrudeFont(const unsigned char *pBufferBytes,
+                      size_t bufferSizeInBytes, FTGL::RenderBackend backend);
+
         /**
          * Destructor
          */
@@ -111,6 +134,19 @@ FTGL_EXPORT FTGLfont *ftglCreateExtrudeFont(const char *file);
 FTGL_EXPORT FTGLfont *ftglCreateExtrudeFontFromMem(const unsigned char *bytes,
                                                    size_t len);
 
+/**
+ * Create a specialised FTGLfont object for handling extruded polygon fonts,
+ * drawing with the given renderer.
+ *
+ * @param file  The font file name.
+ * @param backend  FTGL_BACKEND_CORE_PROFILE to draw with OpenGL 3.3 core
+ *                 profile shaders and vertex buffers, or
+ *                 FTGL_BACKEND_FIXED_FUNCTION.
+ * @return  An FTGLfont* object.
+ */
+FTGL_EXPORT FTGLfont *ftglCreateExtrudeFontWithBackend(const char *file,
+                                                       int backend);
+
 FTGL_END_C_DECLS
 
 #endif // __FTExtrudeFont__
@@ -75,6 +75,13 @@ class FTGL_EXPORT FTGlyph
         friend class FTPolygonGlyph;
         friend class FTTextureGlyph;
 
+        /* Allow FTBufferFont to blit glyph bitmaps, FTTextureFont to
+         * batch glyph quads and the core profile backend to collect glyph
+         * geometry without going through Render() */
+        friend class FTBufferFontImpl;
+        friend class FTFontImpl;
+        friend class FTTextureFontImpl;
+
     public:
         /**
           * Destructor
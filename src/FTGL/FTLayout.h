@@ -126,6 +126,155 @@ class FTGL_EXPORT FTLayout
                             FTPoint position = FTPoint(),
                             int renderMode = FTGL::RENDER_ALL) = 0;
 
+        /**
+         * Get the bounding box for a formatted UTF-8 string of a given size
+         * in bytes. Nothing past the end of the string is read.
+         *
+         * @param string  A UTF-8 string.
+         * @param len  The length of the string in bytes. If < 0 then the
+         *             string ends with a null character (optional).
+         * @param position  The pen position of the first character (optional).
+         * @return  The corresponding bounding box.
+         */
+        virtual FTBBox BBoxUTF8(const char *string, const int len = -1,
+                                FTPoint position = FTPoint());
+
+        /**
+         * Get the bounding box for a formatted UTF-16 string of a given
+         * size in 16 bit code units.
+         *
+         * @see BBoxUTF8
+         */
+        virtual FTBBox BBoxUTF16(const unsigned short *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint());
+
+        /**
+         * Get the bounding box for a formatted UTF-32 string of a given
+         * number of characters.
+         *
+         * @see BBoxUTF8
+         */
+        virtual FTBBox BBoxUTF32(const unsigned int *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint());
+
+        /**
+         * Render a UTF-8 string of a given size in bytes.
+         *
+         * @param string  A UTF-8 string.
+         * @param len  The length of the string in bytes. If < 0 then the
+         *             string ends with a null character (optional).
+         * @param position  The pen position of the first character (optional).
+         * @param renderMode  Render mode to display (optional)
+         */
+        virtual void RenderUTF8(const char *string, const int len = -1,
+                                FTPoint position = FTPoint(),
+                                int renderMode = FTGL::RENDER_ALL);
+
+        /**
+         * Render a UTF-16 string of a given size in 16 bit code units.
+         *
+         * @see RenderUTF8
+         */
+        virtual void RenderUTF16(const unsigned short *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint(),
+                                 int renderMode = FTGL::RENDER_ALL);
+
+        /**
+         * Render a UTF-32 string of a given number of characters.
+         *
+         * @see RenderUTF8
+         */
+        virtual void RenderUTF32(const unsigned int *string,
+                                 const int len = -1,
+                                 FTPoint position = FTPoint(),
+                                 int renderMode = FTGL::RENDER_ALL);
+
+#ifdef FTGL_HAS_UNICODE_CHARS
+        /**
+         * <code>BBox()</code> and <code>Render()</code> for UTF-16 and
+         * UTF-32 strings. The length is given in code units, as with
+         * <code>BBoxUTF16()</code> and <code>BBoxUTF32()</code>.
+         */
+        FTBBox BBox(const char16_t *string, const int len = -1,
+                    FTPoint position = FTPoint())
+        {
+            return BBoxUTF16(reinterpret_cast<const unsigned short *>(string),
+                             len, position);
+        }
+
+        FTBBox BBox(const char32_t *string, const int len = -1,
+                    FTPoint position = FTPoint())
+        {
+            return BBoxUTF32(reinterpret_cast<const unsigned int *>(string),
+                             len, position);
+        }
+
+        void Render(const char16_t *string, const int len = -1,
+                    FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL)
+        {
+            RenderUTF16(reinterpret_cast<const unsigned short *>(string),
+                        len, position, renderMode);
+        }
+
+        void Render(const char32_t *string, const int len = -1,
+                    FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL)
+        {
+            RenderUTF32(reinterpret_cast<const unsigned int *>(string),
+                        len, position, renderMode);
+        }
+#endif
+
+#ifdef FTGL_HAS_STRING_VIEW
+        /**
+         * <code>BBox()</code> and <code>Render()</code> for string views
+         * holding UTF-8, UTF-16 or UTF-32 text. The views need not be
+         * null-terminated.
+         */
+        FTBBox BBox(std::string_view string, FTPoint position = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBoxUTF8(string.data(), len, position);
+        }
+
+        FTBBox BBox(std::u16string_view string, FTPoint position = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBox(string.data(), len, position);
+        }
+
+        FTBBox BBox(std::u32string_view string, FTPoint position = FTPoint())
+        {
+            const int len = static_cast<int>(string.size());
+            return BBox(string.data(), len, position);
+        }
+
+        void Render(std::string_view string, FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            RenderUTF8(string.data(), len, position, renderMode);
+        }
+
+        void Render(std::u16string_view string, FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            Render(string.data(), len, position, renderMode);
+        }
+
+        void Render(std::u32string_view string, FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL)
+        {
+            const int len = static_cast<int>(string.size());
+            Render(string.data(), len, position, renderMode);
+        }
+#endif
+
         /**
          * Queries the Layout for errors.
          *
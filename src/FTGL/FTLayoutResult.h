@@ -0,0 +1,182 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __ftgl__
+#   warning Please use <FTGL/ftgl.h> instead of <FTLayoutResult.h>.
+#   include <FTGL/ftgl.h>
+#endif
+
+#ifndef __FTLayoutResult__
+#define __FTLayoutResult__
+
+#ifdef __cplusplus
+
+
+class FTFont;
+class FTLayoutResultImpl;
+
+/**
+ * FTLayoutResult holds a formatted string: its lines, the position of each
+ * of its characters and its bounds.
+ *
+ * A result is produced by FTSimpleLayout::Layout() and never changes
+ * afterwards, so it can be measured once and rendered many times, at
+ * different positions. Copies are cheap and share the same data, and may
+ * be made and destroyed on any thread. The font the string was laid out
+ * with must outlive the result.
+ *
+ * Character indices count unicode characters, not bytes. Positions are
+ * relative to the pen position the result is rendered at.
+ *
+ * @see     FTSimpleLayout
+ */
+class FTGL_EXPORT FTLayoutResult
+{
+    public:
+        /**
+         * Create an empty result, with no lines.
+         */
+        FTLayoutResult();
+
+        /**
+         * Copy constructor. The data is shared, not copied.
+         */
+        FTLayoutResult(const FTLayoutResult& result);
+
+        /**
+         * Assignment operator. The data is shared, not copied.
+         */
+        FTLayoutResult& operator=(const FTLayoutResult& result);
+
+        /**
+         * Destructor
+         */
+        ~FTLayoutResult();
+
+        /**
+         * Render the formatted string.
+         *
+         * @param position  The pen position of the first character
+         *                  (optional).
+         * @param renderMode  Render mode to display (optional)
+         */
+        void Render(FTPoint position = FTPoint(),
+                    int renderMode = FTGL::RENDER_ALL) const;
+
+        /**
+         * Get the bounding box of the formatted string.
+         *
+         * @param position  The pen position of the first character
+         *                  (optional).
+         * @return  The bounding box.
+         */
+        FTBBox BBox(FTPoint position = FTPoint()) const;
+
+        /**
+         * @return  The number of characters of the string.
+         */
+        int CharCount() const;
+
+        /**
+         * @return  The number of lines the string was wrapped into.
+         */
+        int LineCount() const;
+
+        /**
+         * Get the first character of a line.
+         *
+         * @param line  The index of the line.
+         * @return  The index of the character, or -1 if there is no such
+         *          line.
+         */
+        int LineStart(const int line) const;
+
+        /**
+         * Get the end of a line.
+         *
+         * @param line  The index of the line.
+         * @return  One past the last character drawn on the line, or -1 if
+         *          there is no such line. The whitespace the line was
+         *          wrapped at is part of the line, a newline is not.
+         */
+        int LineEnd(const int line) const;
+
+        /**
+         * Get the pen position of the first character of a line.
+         *
+         * @param line  The index of the line.
+         * @return  The pen position, after alignment.
+         */
+        FTPoint LinePosition(const int line) const;
+
+        /**
+         * Get the bounding box of a line.
+         *
+         * @param line  The index of the line.
+         * @return  The bounding box, after alignment.
+         */
+        FTBBox LineBBox(const int line) const;
+
+        /**
+         * Get the pen position of a character, for instance to draw a
+         * cursor.
+         *
+         * @param index  The index of the character. The character count
+         *               gives the position after the last character.
+         * @return  The pen position of the character.
+         */
+        FTPoint CharPosition(const int index) const;
+
+        /**
+         * Find the character closest to a point, for instance to place a
+         * cursor under the mouse.
+         *
+         * @param point  The point to look up.
+         * @return  The index of the character the cursor would be placed
+         *          before, or -1 if the result is empty.
+         */
+        int CharIndex(FTPoint point) const;
+
+    private:
+        /**
+         * Internal FTGL FTLayoutResult constructor. For private use only.
+         *
+         * @param pImpl  Internal implementation object. Shared by all the
+         *               copies of the result.
+         */
+        FTLayoutResult(FTLayoutResultImpl *pImpl);
+
+        /* Allow the layout to create results */
+        friend class FTSimpleLayoutImpl;
+
+        /**
+         * Internal FTGL FTLayoutResult implementation object. For private
+         * use only.
+         */
+        FTLayoutResultImpl *impl;
+};
+
+#endif //__cplusplus
+
+#endif  /* __FTLayoutResult__ */
+
@@ -0,0 +1,193 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __ftgl__
+#   warning Please use <FTGL/ftgl.h> instead of <FTShaper.h>.
+#   include <FTGL/ftgl.h>
+#endif
+
+#ifndef __FTShaper__
+#define __FTShaper__
+
+#ifdef __cplusplus
+
+
+/**
+ * FTShapedGlyph is one glyph of a shaped run of text.
+ */
+struct FTShapedGlyph
+{
+    /**
+     * The index of the glyph in the font, not a character code.
+     */
+    unsigned int index;
+
+    /**
+     * The index, in the run, of the first character the glyph was made
+     * from. Glyphs made from the same characters, such as a base letter
+     * and its marks, share a cluster.
+     */
+    unsigned int cluster;
+
+    /**
+     * How far to move the pen after drawing the glyph, in pixels.
+     */
+    FTPoint advance;
+
+    /**
+     * Where to draw the glyph relative to the pen position, in pixels.
+     */
+    FTPoint offset;
+};
+
+
+/**
+ * FTShaper turns a run of characters into positioned glyphs.
+ *
+ * Without a shaper, a font maps each character to one glyph through the
+ * face's character map and only applies pair kerning. A shaper can form
+ * ligatures, place marks and join the letters of complex scripts such as
+ * Arabic or Devanagari. Set one with FTFont::Shaper(); the font keeps the
+ * shaped glyphs of the last strings it drew, so static text is only shaped
+ * once.
+ *
+ * A shaper may be shared by several fonts, but must not be used from
+ * two threads at the same time.
+ *
+ * @see     FTFont
+ * @see     FTHarfBuzzShaper
+ */
+class FTGL_EXPORT FTShaper
+{
+    public:
+        /**
+         * Destructor
+         */
+        virtual ~FTShaper();
+
+        /**
+         * Shape a run of characters that all have the same direction.
+         *
+         * @param face  The FreeType face, set to the size of the font.
+         * @param text  The unicode characters of the run, in logical order.
+         * @param count  The number of characters.
+         * @param rightToLeft  <code>true</code> for a right to left run.
+         *                     Mirroring its characters is up to the shaper.
+         * @param glyphs  Receives the glyphs from left to right.
+         * @param maxGlyphs  The number of entries in <code>glyphs</code>.
+         * @return  The number of glyphs of the run, which may be more than
+         *          <code>maxGlyphs</code>: call again with a larger array.
+         *          A negative value means the run cannot be shaped, and the
+         *          font falls back to its own character mapping.
+         */
+        virtual int Shape(FT_Face face, const unsigned int *text,
+                          const int count, const bool rightToLeft,
+                          FTShapedGlyph *glyphs, const int maxGlyphs) = 0;
+};
+
+
+class FTHarfBuzzShaperImpl;
+
+/**
+ * FTHarfBuzzShaper shapes text with the OpenType tables of the font, using
+ * the HarfBuzz library.
+ *
+ * HarfBuzz is optional: when FTGL was built without it, Available()
+ * returns <code>false</code> and fonts using this shaper keep mapping one
+ * character to one glyph.
+ *
+ * @see     FTShaper
+ */
+class FTGL_EXPORT FTHarfBuzzShaper : public FTShaper
+{
+    public:
+        /**
+         * Default constructor.
+         */
+        FTHarfBuzzShaper();
+
+        /**
+         * Destructor
+         */
+        virtual ~FTHarfBuzzShaper();
+
+        /**
+         * Tell whether FTGL was built with HarfBuzz.
+         *
+         * @return  <code>true</code> if text can be shaped.
+         */
+        static bool Available();
+
+        /**
+         * Shape a run of characters with HarfBuzz.
+         *
+         * @see FTShaper::Shape
+         */
+        virtual int Shape(FT_Face face, const unsigned int *text,
+                          const int count, const bool rightToLeft,
+                          FTShapedGlyph *glyphs, const int maxGlyphs);
+
+    private:
+        /**
+         * Disable copying: the HarfBuzz objects are not shared.
+         */
+        FTHarfBuzzShaper(const FTHarfBuzzShaper&);
+        FTHarfBuzzShaper& operator=(const FTHarfBuzzShaper&);
+
+        /**
+         * Internal FTGL FTHarfBuzzShaper implementation object. For private
+         * use only.
+         */
+        FTHarfBuzzShaperImpl *impl;
+};
+
+#endif //__cplusplus
+
+FTGL_BEGIN_C_DECLS
+
+/**
+ * FTGLshaper turns runs of characters into positioned glyphs.
+ */
+struct _FTGLshaper;
+typedef struct _FTGLshaper FTGLshaper;
+
+/**
+ * Create a shaper using HarfBuzz.
+ *
+ * @return  An FTGLshaper* object, or NULL if FTGL was built without
+ *          HarfBuzz.
+ */
+FTGL_EXPORT FTGLshaper *ftglCreateHarfBuzzShaper(void);
+
+/**
+ * Destroy an FTGL shaper object. Fonts using it must be given another
+ * shaper, or none, first.
+ *
+ * @param shaper  An FTGLshaper* object.
+ */
+FTGL_EXPORT void ftglDestroyShaper(FTGLshaper* shaper);
+
+FTGL_END_C_DECLS
+
+#endif  /* __FTShaper__ */
+
@@ -114,6 +114,38 @@ class FTGL_EXPORT FTSimpleLayout : public FTLayout
                             FTPoint position = FTPoint(),
                             int renderMode = FTGL::RENDER_ALL);
 
+        /* The overloads for other string types are FTLayout's */
+        using FTLayout::BBox;
+        using FTLayout::Render;
+
+        /**
+         * Lay out a string once, to render or query it later without
+         * wrapping it again.
+         *
+         * The result is not affected by later changes to the layout
+         * settings. Laying out the same string with the same settings
+         * again returns a result sharing the same data.
+         *
+         * @param string  A char string.
+         * @param len  The length of the string. If < 0 then all characters
+         *             will be used until a null character is encountered
+         *             (optional).
+         * @return  The formatted string. It is empty if no font is set.
+         */
+        FTLayoutResult Layout(const char *string, const int len = -1);
+
+        /**
+         * Lay out a string once, to render or query it later without
+         * wrapping it again.
+         *
+         * @param string  A wchar_t string.
+         * @param len  The length of the string. If < 0 then all characters
+         *             will be used until a null character is encountered
+         *             (optional).
+         * @return  The formatted string. It is empty if no font is set.
+         */
+        FTLayoutResult Layout(const wchar_t *string, const int len = -1);
+
         /**
          * Set the font to use for rendering the text.
          *
@@ -153,6 +185,23 @@ class FTGL_EXPORT FTSimpleLayout : public FTLayout
          */
         FTGL::TextAlignment GetAlignment() const;
 
+        /**
+         * The strategy used to choose where lines are broken.
+         *
+         * BREAK_GREEDY, the default, puts as many words as possible on
+         * each line. BREAK_OPTIMAL chooses the breaks of a whole paragraph
+         * at once, so that the space left on its lines is as even as
+         * possible; this gives much better looking justified text.
+         *
+         * @param BreakMode The new line breaking mode.
+         */
+        void SetBreakMode(const FTGL::LineBreakMode BreakMode);
+
+        /**
+         * @return The line breaking mode.
+         */
+        FTGL::LineBreakMode GetBreakMode() const;
+
         /**
          * Sets the line height.
          *
@@ -165,6 +214,115 @@ class FTGL_EXPORT FTSimpleLayout : public FTLayout
          * @return The line spacing.
          */
         float GetLineSpacing() const;
+
+        /**
+         * Get the number of lines a string is wrapped into.
+         *
+         * The line breaks of the last string laid out are cached, so that
+         * calling this after <code>Render</code> or <code>BBox</code> with
+         * the same string is cheap. When the string differs, only the
+         * paragraphs that changed are wrapped again.
+         *
+         * @param string  A char string.
+         * @param len  The length of the string. If < 0 then all characters
+         *             will be checked until a null character is encountered
+         *             (optional).
+         * @return  The number of lines.
+         */
+        int LineCount(const char *string, const int len = -1);
+
+        /**
+         * Get the number of lines a string is wrapped into.
+         *
+         * @param string  A wchar_t string.
+         * @param len  The length of the string. If < 0 then all characters
+         *             will be checked until a null character is encountered
+         *             (optional).
+         * @return  The number of lines.
+         */
+        int LineCount(const wchar_t *string, const int len = -1);
+
+        /**
+         * Get the first character of a line of a formatted string.
+         *
+         * Character indices count unicode characters, not bytes.
+         *
+         * @param string  A char string.
+         * @param len  The length of the string, or -1.
+         * @param line  The index of the line.
+         * @return  The index of the first character of the line, or -1 if
+         *          there is no such line.
+         */
+        int LineStart(const char *string, const int len, const int line);
+
+        /**
+         * Get the first character of a line of a formatted string.
+         *
+         * @param string  A wchar_t string.
+         * @param len  The length of the string, or -1.
+         * @param line  The index of the line.
+         * @return  The index of the first character of the line, or -1 if
+         *          there is no such line.
+         */
+        int LineStart(const wchar_t *string, const int len, const int line);
+
+        /**
+         * Get the pen position of a character of a formatted string, for
+         * instance to draw a cursor.
+         *
+         * @param string  A char string.
+         * @param len  The length of the string, or -1.
+         * @param index  The index of the character. The string length gives
+         *               the position after the last character.
+         * @param position  The pen position the string is rendered at
+         *                  (optional).
+         * @return  The pen position of the character.
+         */
+        FTPoint CharPosition(const char *string, const int len,
+                             const int index, FTPoint position = FTPoint());
+
+        /**
+         * Get the pen position of a character of a formatted string.
+         *
+         * @param string  A wchar_t string.
+         * @param len  The length of the string, or -1.
+         * @param index  The index of the character. The string length gives
+         *               the position after the last character.
+         * @param position  The pen position the string is rendered at
+         *                  (optional).
+         * @return  The pen position of the character.
+         */
+        FTPoint CharPosition(const wchar_t *string, const int len,
+                             const int index, FTPoint position = FTPoint());
+
+        /**
+         * Find the character of a formatted string closest to a point, for
+         * instance to place a cursor under the mouse.
+         *
+         * @param string  A char string.
+         * @param len  The length of the string, or -1.
+         * @param point  The point to look up.
+         * @param position  The pen position the string is rendered at
+         *                  (optional).
+         * @return  The index of the character the cursor would be placed
+         *          before, or -1 if no font is set.
+         */
+        int CharIndex(const char *string, const int len, FTPoint point,
+                      FTPoint position = FTPoint());
+
+        /**
+         * Find the character of a formatted string closest to a point.
+         *
+         * @param string  A wchar_t string.
+         * @param len  The length of the string, or -1.
+         * @param point  The point to look up.
+         * @param position  The pen position the string is rendered at
+         *                  (optional).
+         * @return  The index of the character the cursor would be placed
+         *          before, or -1 if no font is set.
+         */
+        int CharIndex(const wchar_t *string, const int len, FTPoint point,
+                      FTPoint position = FTPoint());
 };
 
 #endif //__cplusplus
@@ -183,6 +341,9 @@ FTGL_EXPORT void ftglSetLayoutAlignment(FTGLlayout *, const int);
 FTGL_EXPORT int ftglGetLayoutAlignment(FTGLlayout *);
 FTGL_EXPORT int ftglGetLayoutAlignement(FTGLlayout *); // old typo
 
+FTGL_EXPORT void ftglSetLayoutBreakMode(FTGLlayout *, const int);
+FTGL_EXPORT int ftglGetLayoutBreakMode(FTGLlayout *);
+
 FTGL_EXPORT void ftglSetLayoutLineSpacing(FTGLlayout *, const float);
 FTGL_EXPORT float ftglGetLayoutLineSpacing(FTGLlayout *);
 
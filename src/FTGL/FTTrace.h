@@ -0,0 +1,210 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __ftgl__
+#   warning Please use <FTGL/ftgl.h> instead of <FTTrace.h>.
+#   include <FTGL/ftgl.h>
+#endif
+
+#ifndef __FTTrace__
+#define __FTTrace__
+
+
+/**
+ * FTTraceEvent describes the start or the end of one step of glyph
+ * creation or rendering.
+ */
+typedef struct FTTraceEvent
+{
+    /**
+     * The step, one of the FTGL::TracePhase values.
+     */
+    int phase;
+
+    /**
+     * Non zero when the step starts, zero when it ends.
+     */
+    int begin;
+
+    /**
+     * The FTFont doing the work.
+     */
+    const void *font;
+
+    /**
+     * The character code of the glyph, or zero if the glyph was asked for
+     * by index or the step is not about one glyph.
+     */
+    unsigned int character;
+
+    /**
+     * The index of the glyph in the font, or zero if the step is not about
+     * one glyph.
+     */
+    unsigned int glyph;
+
+    /**
+     * A small number identifying the calling thread, starting at one.
+     */
+    unsigned int thread;
+
+    /**
+     * A monotonic time stamp in nanoseconds.
+     */
+    FTGL_UINT64 time;
+} FTTraceEvent;
+
+
+/**
+ * The function called at the start and at the end of every traced step.
+ * It is called from the thread doing the work, with the font locked.
+ */
+typedef void (*FTTraceCallback)(const FTTraceEvent *event, void *data);
+
+
+#ifdef __cplusplus
+
+
+/**
+ * FTTrace reports the steps of glyph creation and rendering, such as
+ * loading a glyph, rasterising it or uploading it to a texture, so the
+ * cost of a glyph used for the first time can be found.
+ *
+ * Tracing is only compiled in when FTGL is configured with
+ * --enable-tracing. Otherwise SetCallback() returns <code>false</code>
+ * and the library does no extra work at all.
+ *
+ * @see     FTChromeTrace
+ */
+class FTGL_EXPORT FTTrace
+{
+    public:
+        /**
+         * Tell whether FTGL was built with tracing.
+         *
+         * @return  <code>true</code> if callbacks will be called.
+         */
+        static bool Available();
+
+        /**
+         * Set the function called for every traced step. Only one
+         * function is called. It may be changed while other threads use
+         * FTGL: steps keep reporting to the function they started with,
+         * and this returns once none reports to the previous one, so its
+         * data may then be freed. It must not be called from the callback.
+         *
+         * @param callback  The function, or 0 to stop tracing.
+         * @param data  Passed to the function with every event.
+         * @return  <code>true</code> if FTGL was built with tracing.
+         */
+        static bool SetCallback(FTTraceCallback callback, void *data = 0);
+};
+
+
+class FTChromeTraceImpl;
+
+/**
+ * FTChromeTrace writes the traced steps to a file in the Chrome trace
+ * event format, which can be opened with chrome://tracing or Perfetto
+ * to see the steps on a timeline.
+ *
+ * The trace is taken from construction until Stop() or destruction. It
+ * replaces any callback set with FTTrace::SetCallback(). When FTGL was
+ * built without tracing, no file is written and Error() is not zero.
+ *
+ * @see     FTTrace
+ */
+class FTGL_EXPORT FTChromeTrace
+{
+    public:
+        /**
+         * Start tracing to a file.
+         *
+         * @param fileName  The file to write, replaced if it exists.
+         */
+        FTChromeTrace(const char *fileName);
+
+        /**
+         * Destructor. Stops tracing.
+         */
+        ~FTChromeTrace();
+
+        /**
+         * Stop tracing and finish the file.
+         */
+        void Stop();
+
+        /**
+         * Queries for errors.
+         *
+         * @return  Zero if the file was opened and, when tracing has
+         *          stopped, written completely.
+         */
+        int Error() const;
+
+    private:
+        /**
+         * Disable copying: there is one file.
+         */
+        FTChromeTrace(const FTChromeTrace&);
+        FTChromeTrace& operator=(const FTChromeTrace&);
+
+        /**
+         * Internal FTGL FTChromeTrace implementation object. For private
+         * use only.
+         */
+        FTChromeTraceImpl *impl;
+};
+
+#endif //__cplusplus
+
+FTGL_BEGIN_C_DECLS
+
+/**
+ * Set the function called for every traced step.
+ *
+ * @param callback  The function, or NULL to stop tracing.
+ * @param data  Passed to the function with every event.
+ * @return  1 if FTGL was built with tracing, 0 otherwise.
+ */
+FTGL_EXPORT int ftglSetTraceCallback(FTTraceCallback callback, void *data);
+
+/**
+ * Start writing the traced steps to a file in the Chrome trace event
+ * format, stopping any trace already being written.
+ *
+ * @param fileName  The file to write, replaced if it exists.
+ * @return  1 if the file was opened, 0 if it could not be or FTGL was
+ *          built without tracing.
+ */
+FTGL_EXPORT int ftglStartChromeTrace(const char *fileName);
+
+/**
+ * Stop the trace started with ftglStartChromeTrace() and finish its file.
+ */
+FTGL_EXPORT void ftglStopChromeTrace(void);
+
+FTGL_END_C_DECLS
+
+#endif  /* __FTTrace__ */
+
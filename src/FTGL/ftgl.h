@@ -38,6 +38,13 @@
 typedef double   FTGL_DOUBLE;
 typedef float    FTGL_FLOAT;
 
+/* Integer type of the statistics kept by the fonts */
+#if defined _MSC_VER && _MSC_VER < 1310
+typedef unsigned __int64 FTGL_UINT64;
+#else
+typedef unsigned long long FTGL_UINT64;
+#endif
+
 /* Macros used to declare C-linkage types and symbols */
 #ifdef __cplusplus
 #   define FTGL_BEGIN_C_DECLS extern "C" { namespace FTGL {
@@ -47,6 +54,18 @@ typedef float    FTGL_FLOAT;
 #   define FTGL_END_C_DECLS
 #endif
 
+/* The C++11 character types and the C++17 string views, for the overloads
+ * of the text functions that take them */
+#if defined __cplusplus \
+     && (__cplusplus >= 201103L || (defined _MSVC_LANG && _MSVC_LANG >= 201103L))
+#   define FTGL_HAS_UNICODE_CHARS
+#endif
+#if defined __cplusplus \
+     && (__cplusplus >= 201703L || (defined _MSVC_LANG && _MSVC_LANG >= 201703L))
+#   include <string_view>
+#   define FTGL_HAS_STRING_VIEW
+#endif
+
 #ifdef __cplusplus
 namespace FTGL
 {
@@ -55,7 +74,10 @@ namespace FTGL
         RENDER_FRONT = 0x0001,
         RENDER_BACK  = 0x0002,
         RENDER_SIDE  = 0x0004,
-        RENDER_ALL   = 0xffff
+        RENDER_ALL   = 0xffff,
+        /* The string is already in display order: skip bidirectional
+         * reordering */
+        RENDER_VISUAL_ORDER = 0x10000
     } RenderMode;
 
     typedef enum
@@ -66,6 +88,84 @@ namespace FTGL
         ALIGN_JUSTIFY = 3
     } TextAlignment;
 
+    typedef enum
+    {
+        BREAK_GREEDY  = 0,
+        BREAK_OPTIMAL = 1
+    } LineBreakMode;
+
+    typedef enum
+    {
+        BACKEND_FIXED_FUNCTION = 0,
+        BACKEND_CORE_PROFILE   = 1
+    } RenderBackend;
+
+    /**
+     * The statistics kept by every font, and summed over all fonts. The
+     * counters and timers (in nanoseconds) grow until they are reset; the
+     * atlas figures describe the textures a texture font holds right now.
+     */
+    typedef enum
+    {
+        /* Glyph lookups answered from the glyph cache */
+        STAT_GLYPH_HITS            = 0,
+        /* Glyph lookups that had to create a glyph */
+        STAT_GLYPH_MISSES          = 1,
+        /* Calls to FT_Load_Glyph() */
+        STAT_GLYPH_LOADS           = 2,
+        /* Calls to FT_Render_Glyph() */
+        STAT_GLYPH_RASTERS         = 3,
+        /* Kerning pairs read from the precomputed kerning table */
+        STAT_KERNING_CACHED        = 4,
+        /* Kerning pairs that fell back to FT_Get_Kerning() */
+        STAT_KERNING_LOOKUPS       = 5,
+        /* Calls to glBindTexture() made while drawing glyphs */
+        STAT_TEXTURE_BINDS         = 6,
+        /* Binds skipped because the glyph's texture was already bound */
+        STAT_TEXTURE_BINDS_SKIPPED = 7,
+        /* Strings an FTBufferFont found in its texture cache */
+        STAT_BUFFER_CACHE_HITS     = 8,
+        /* Strings an FTBufferFont had to draw again */
+        STAT_BUFFER_CACHE_MISSES   = 9,
+        /* Calls to the Render() functions */
+        STAT_RENDER_CALLS          = 10,
+        /* Time spent creating glyphs */
+        STAT_GLYPH_LOAD_TIME       = 11,
+        /* Time spent in the Render() functions */
+        STAT_RENDER_TIME           = 12,
+        /* Textures in the glyph atlas */
+        STAT_ATLAS_TEXTURES        = 13,
+        /* Texels in the glyph atlas */
+        STAT_ATLAS_TEXELS          = 14,
+        /* Texels of the glyph atlas taken by glyphs */
+        STAT_ATLAS_TEXELS_USED     = 15
+    } Statistic;
+
+    /**
+     * The steps of glyph creation and rendering reported to a trace
+     * callback. Steps nest: the LOAD and MAKE_GLYPH steps happen inside
+     * GLYPH, and the others inside MAKE_GLYPH or RENDER.
+     */
+    typedef enum
+    {
+        /* Creating a glyph the first time it is used */
+        TRACE_GLYPH      = 0,
+        /* Loading the glyph with FT_Load_Glyph() */
+        TRACE_LOAD       = 1,
+        /* Turning the FreeType glyph into an FTGlyph */
+        TRACE_MAKE_GLYPH = 2,
+        /* Rendering the outline to a bitmap with FT_Render_Glyph() */
+        TRACE_RASTERISE  = 3,
+        /* Decomposing the outline into contours and triangles */
+        TRACE_TESSELLATE = 4,
+        /* Compiling a display list */
+        TRACE_COMPILE    = 5,
+        /* Copying glyph bitmaps to a texture */
+        TRACE_UPLOAD     = 6,
+        /* A call to one of the Render() functions */
+        TRACE_RENDER     = 7
+    } TracePhase;
+
     typedef enum
     {
         CONFIG_VERSION = 1,
@@ -86,12 +186,45 @@ namespace FTGL
 #   define FTGL_RENDER_BACK  0x0002
 #   define FTGL_RENDER_SIDE  0x0004
 #   define FTGL_RENDER_ALL   0xffff
+#   define FTGL_RENDER_VISUAL_ORDER 0x10000
 
 #   define FTGL_ALIGN_LEFT    0
 #   define FTGL_ALIGN_CENTER  1
 #   define FTGL_ALIGN_RIGHT   2
 #   define FTGL_ALIGN_JUSTIFY 3
 
+#   define FTGL_BREAK_GREEDY  0
+#   define FTGL_BREAK_OPTIMAL 1
+
+#   define FTGL_BACKEND_FIXED_FUNCTION 0
+#   define FTGL_BACKEND_CORE_PROFILE   1
+
+#   define FTGL_STAT_GLYPH_HITS            0
+#   define FTGL_STAT_GLYPH_MISSES          1
+#   define FTGL_STAT_GLYPH_LOADS           2
+#   define FTGL_STAT_GLYPH_RASTERS         3
+#   define FTGL_STAT_KERNING_CACHED        4
+#   define FTGL_STAT_KERNING_LOOKUPS       5
+#   define FTGL_STAT_TEXTURE_BINDS         6
+#   define FTGL_STAT_TEXTURE_BINDS_SKIPPED 7
+#   define FTGL_STAT_BUFFER_CACHE_HITS     8
+#   define FTGL_STAT_BUFFER_CACHE_MISSES   9
+#   define FTGL_STAT_RENDER_CALLS          10
+#   define FTGL_STAT_GLYPH_LOAD_TIME       11
+#   define FTGL_STAT_RENDER_TIME           12
+#   define FTGL_STAT_ATLAS_TEXTURES        13
+#   define FTGL_STAT_ATLAS_TEXELS          14
+#   define FTGL_STAT_ATLAS_TEXELS_USED     15
+
+#   define FTGL_TRACE_GLYPH      0
+#   define FTGL_TRACE_LOAD       1
+#   define FTGL_TRACE_MAKE_GLYPH 2
+#   define FTGL_TRACE_RASTERISE  3
+#   define FTGL_TRACE_TESSELLATE 4
+#   define FTGL_TRACE_COMPILE    5
+#   define FTGL_TRACE_UPLOAD     6
+#   define FTGL_TRACE_RENDER     7
+
 #   define FTGL_CONFIG_VERSION 1
 
     /**
@@ -137,6 +270,8 @@ namespace FTGL
 #include <FTGL/FTPoint.h>
 #include <FTGL/FTBBox.h>
 #include <FTGL/FTBuffer.h>
+#include <FTGL/FTShaper.h>
+#include <FTGL/FTTrace.h>
 
 #include <FTGL/FTGlyph.h>
 #include <FTGL/FTBitmapGlyph.h>
@@ -156,6 +291,7 @@ namespace FTGL
 #include <FTGL/FTGLPolygonFont.h>
 #include <FTGL/FTGLTextureFont.h>
 
+#include <FTGL/FTLayoutResult.h>
 #include <FTGL/FTLayout.h>
 #include <FTGL/FTSimpleLayout.h>
 
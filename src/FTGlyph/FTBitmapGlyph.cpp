@@ -32,6 +32,7 @@
 
 #include "FTInternals.h"
 #include "FTBitmapGlyphImpl.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -40,7 +41,7 @@
 
 
 FTBitmapGlyph::FTBitmapGlyph(FT_GlyphSlot glyph) :
-    FTGlyph(new FTBitmapGlyphImpl(glyph))
+    FTGlyph(new(glyph) FTBitmapGlyphImpl(glyph))
 {}
 
 
@@ -50,7 +51,7 @@ FTBitmapGlyph::~FTBitmapGlyph()
 
 const FTPoint& FTBitmapGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTBitmapGlyphImpl *myimpl = dynamic_cast<FTBitmapGlyphImpl *>(impl);
+    FTBitmapGlyphImpl *myimpl = static_cast<FTBitmapGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -61,12 +62,16 @@ const FTPoint& FTBitmapGlyph::Render(const FTPoint& pen, int renderMode)
 
 
 FTBitmapGlyphImpl::FTBitmapGlyphImpl(FT_GlyphSlot glyph)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_BITMAP),
     destWidth(0),
     destHeight(0),
     data(0)
 {
-    err = FT_Render_Glyph(glyph, FT_RENDER_MODE_MONO);
+    {
+        FTGL_TRACE_SPAN(FTGL::TRACE_RASTERISE, 0, 0, glyph->glyph_index);
+        err = FT_Render_Glyph(glyph, FT_RENDER_MODE_MONO);
+    }
+
     if(err || ft_glyph_format_bitmap != glyph->format)
     {
         return;
@@ -84,7 +89,7 @@ FTBitmapGlyphImpl::FTBitmapGlyphImpl(FT_GlyphSlot glyph)
 
     if(destWidth && destHeight)
     {
-        data = new unsigned char[destPitch * destHeight];
+        data = AllocateData(destPitch * destHeight);
         unsigned char* dest = data + ((destHeight - 1) * destPitch);
 
         unsigned char* src = bitmap.buffer;
@@ -103,7 +108,7 @@ FTBitmapGlyphImpl::FTBitmapGlyphImpl(FT_GlyphSlot glyph)
 
 FTBitmapGlyphImpl::~FTBitmapGlyphImpl()
 {
-    delete [] data;
+    FreeData(data);
 }
 
 
@@ -38,7 +38,7 @@ class FTBitmapGlyphImpl : public FTGlyphImpl
 
         virtual ~FTBitmapGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
 
     private:
         /**
@@ -31,6 +31,7 @@
 
 #include "FTInternals.h"
 #include "FTBufferGlyphImpl.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -39,7 +40,7 @@
 
 
 FTBufferGlyph::FTBufferGlyph(FT_GlyphSlot glyph, FTBuffer *buffer) :
-    FTGlyph(new FTBufferGlyphImpl(glyph, buffer))
+    FTGlyph(new(glyph) FTBufferGlyphImpl(glyph, buffer))
 {}
 
 
@@ -49,7 +50,7 @@ FTBufferGlyph::~FTBufferGlyph()
 
 const FTPoint& FTBufferGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTBufferGlyphImpl *myimpl = dynamic_cast<FTBufferGlyphImpl *>(impl);
+    FTBufferGlyphImpl *myimpl = static_cast<FTBufferGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -60,18 +61,23 @@ const FTPoint& FTBufferGlyph::Render(const FTPoint& pen, int renderMode)
 
 
 FTBufferGlyphImpl::FTBufferGlyphImpl(FT_GlyphSlot glyph, FTBuffer *p)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_BUFFER),
     has_bitmap(false),
+    pixels(0),
     buffer(p)
 {
-    err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    {
+        FTGL_TRACE_SPAN(FTGL::TRACE_RASTERISE, 0, 0, glyph->glyph_index);
+        err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    }
+
     if(err || glyph->format != ft_glyph_format_bitmap)
     {
         return;
     }
 
     bitmap = glyph->bitmap;
-    pixels = new unsigned char[bitmap.pitch * bitmap.rows];
+    pixels = AllocateData(bitmap.pitch * bitmap.rows);
     memcpy(pixels, bitmap.buffer, bitmap.pitch * bitmap.rows);
 
     if(bitmap.width && bitmap.rows)
@@ -84,7 +90,7 @@ FTBufferGlyphImpl::FTBufferGlyphImpl(FT_GlyphSlot glyph, FTBuffer *p)
 
 FTBufferGlyphImpl::~FTBufferGlyphImpl()
 {
-    delete[] pixels;
+    FreeData(pixels);
 }
 
 
@@ -92,32 +98,51 @@ const FTPoint& FTBufferGlyphImpl::RenderImpl(const FTPoint& pen, int renderMode)
 {
     (void)renderMode;
 
-    if(has_bitmap)
+    RenderRows(pen, 0, buffer->Height());
+
+    return advance;
+}
+
+
+void FTBufferGlyphImpl::RenderRows(const FTPoint& pen, int top,
+                                   int bottom) const
+{
+    if(!has_bitmap)
     {
-        FTPoint pos(buffer->Pos() + pen + corner);
-        int dx = (int)(pos.Xf() + 0.5f);
-        int dy = buffer->Height() - (int)(pos.Yf() + 0.5f);
-        unsigned char * dest = buffer->Pixels() + dx + dy * buffer->Width();
+        return;
+    }
 
-        for(int y = 0; y < bitmap.rows; y++)
-        {
-            // FIXME: change the loop bounds instead of doing this test
-            if(y + dy < 0 || y + dy >= buffer->Height()) continue;
+    FTPoint pos(buffer->Pos() + pen + corner);
+    int dx = (int)(pos.Xf() + 0.5f);
+    int dy = buffer->Height() - (int)(pos.Yf() + 0.5f);
 
-            for(int x = 0; x < bitmap.width; x++)
-            {
-                if(x + dx < 0 || x + dx >= buffer->Width()) continue;
+    int rows = (int)bitmap.rows;
+    int width = (int)bitmap.width;
+
+    // Clip the bitmap against the requested rows and the buffer width
+    int y0 = top - dy > 0 ? top - dy : 0;
+    int y1 = bottom - dy < rows ? bottom - dy : rows;
+    int x0 = dx < 0 ? -dx : 0;
+    int x1 = buffer->Width() - dx < width ? buffer->Width() - dx : width;
 
-                unsigned char p = pixels[y * bitmap.pitch + x];
+    if(y1 > buffer->Height() - dy)
+    {
+        y1 = buffer->Height() - dy;
+    }
 
-                if(p)
-                {
-                    dest[y * buffer->Width() + x] = p;
-                }
+    for(int y = y0; y < y1; y++)
+    {
+        const unsigned char *src = pixels + y * bitmap.pitch;
+        unsigned char *dest = buffer->Pixels() + dx
+                               + (y + dy) * buffer->Width();
+
+        for(int x = x0; x < x1; x++)
+        {
+            if(src[x])
+            {
+                dest[x] = src[x];
             }
         }
     }
-
-    return advance;
 }
 
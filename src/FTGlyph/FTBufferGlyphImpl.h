@@ -37,7 +37,19 @@ class FTBufferGlyphImpl : public FTGlyphImpl
 
         virtual ~FTBufferGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+
+    public:
+        /**
+         * Blit the part of the glyph bitmap that falls between buffer rows
+         * <code>top</code> (inclusive) and <code>bottom</code> (exclusive).
+         * Disjoint row ranges may be blitted from different threads.
+         *
+         * @param pen  The current pen position.
+         * @param top  The first buffer row to write.
+         * @param bottom  One past the last buffer row to write.
+         */
+        void RenderRows(const FTPoint& pen, int top, int bottom) const;
 
     private:
         bool has_bitmap;
@@ -32,6 +32,7 @@
 
 #include "FTInternals.h"
 #include "FTExtrudeGlyphImpl.h"
+#include "FTTraceSpan.h"
 #include "FTVectoriser.h"
 
 
@@ -43,8 +44,8 @@
 FTExtrudeGlyph::FTExtrudeGlyph(FT_GlyphSlot glyph, float depth,
                                float frontOutset, float backOutset,
                                bool useDisplayList) :
-    FTGlyph(new FTExtrudeGlyphImpl(glyph, depth, frontOutset, backOutset,
-                                   useDisplayList))
+    FTGlyph(new(glyph) FTExtrudeGlyphImpl(glyph, depth, frontOutset,
+                                          backOutset, useDisplayList))
 {}
 
 
@@ -54,7 +55,7 @@ FTExtrudeGlyph::~FTExtrudeGlyph()
 
 const FTPoint& FTExtrudeGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTExtrudeGlyphImpl *myimpl = dynamic_cast<FTExtrudeGlyphImpl *>(impl);
+    FTExtrudeGlyphImpl *myimpl = static_cast<FTExtrudeGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -67,7 +68,7 @@ const FTPoint& FTExtrudeGlyph::Render(const FTPoint& pen, int renderMode)
 FTExtrudeGlyphImpl::FTExtrudeGlyphImpl(FT_GlyphSlot glyph, float _depth,
                                        float _frontOutset, float _backOutset,
                                        bool useDisplayList)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_EXTRUDE),
     vectoriser(0),
     glList(0)
 {
@@ -96,6 +97,8 @@ FTExtrudeGlyphImpl::FTExtrudeGlyphImpl(FT_GlyphSlot glyph, float _depth,
 
     if(useDisplayList)
     {
+        FTGL_TRACE_SPAN(FTGL::TRACE_COMPILE, 0, 0, glyph->glyph_index);
+
         glList = glGenLists(3);
 
         /* Front face */
@@ -190,7 +193,10 @@ void FTExtrudeGlyphImpl::RenderFront()
 
 void FTExtrudeGlyphImpl::RenderBack()
 {
-    vectoriser->MakeMesh(-1.0, 2, backOutset);
+    // Tessellated facing the front, so that with the same outset the
+    // back face shares the front face mesh, and drawn wound the other
+    // way round.
+    vectoriser->MakeMesh(1.0, 2, backOutset);
     glNormal3d(0.0, 0.0, -1.0);
 
     const FTMesh *mesh = vectoriser->GetMesh();
@@ -198,17 +204,32 @@ void FTExtrudeGlyphImpl::RenderBack()
     {
         const FTTesselation* subMesh = mesh->Tesselation(j);
         unsigned int polygonType = subMesh->PolygonType();
+        unsigned int count = subMesh->PointCount();
 
         glBegin(polygonType);
-            for(unsigned int i = 0; i < subMesh->PointCount(); ++i)
+            // Starting a strip with a degenerate triangle flips the
+            // winding of all the others.
+            bool repeat = (polygonType == GL_TRIANGLE_STRIP) && count;
+
+            for(unsigned int i = repeat ? 0 : 1; i <= count; ++i)
             {
-                FTPoint pt = subMesh->Point(i);
+                unsigned int index = i ? i - 1 : 0;
+                if(polygonType == GL_TRIANGLE_FAN)
+                {
+                    index = (index == 0) ? 0 : count - index;
+                }
+                else if(polygonType == GL_TRIANGLES)
+                {
+                    index = count - 1 - index;
+                }
 
-                glTexCoord2f(subMesh->Point(i).Xf() / hscale,
-                             subMesh->Point(i).Yf() / vscale);
+                const FTPoint& pt = subMesh->Point(index);
 
-                glVertex3f(subMesh->Point(i).Xf() / 64.0f,
-                           subMesh->Point(i).Yf() / 64.0f,
+                glTexCoord2f(pt.Xf() / hscale,
+                             pt.Yf() / vscale);
+
+                glVertex3f(pt.Xf() / 64.0f,
+                           pt.Yf() / 64.0f,
                            -depth);
             }
         glEnd();
@@ -220,6 +241,9 @@ void FTExtrudeGlyphImpl::RenderSide()
 {
     int contourFlag = vectoriser->ContourFlag();
 
+    vectoriser->BuildOutset(1, frontOutset);
+    vectoriser->BuildOutset(2, backOutset);
+
     for(size_t c = 0; c < vectoriser->ContourCount(); ++c)
     {
         const FTContour* contour = vectoriser->Contour(c);
@@ -263,3 +287,101 @@ void FTExtrudeGlyphImpl::RenderSide()
     }
 }
 
+
+
+void FTExtrudeGlyphImpl::AppendCore(FTVector<FTCoreVertex>& vertices,
+                                    const FTPoint& pen, int renderMode,
+                                    const float *color)
+{
+    if(!vectoriser)
+    {
+        return;
+    }
+
+    if((renderMode & FTGL::RENDER_FRONT) && coreFront.empty())
+    {
+        vectoriser->MakeMesh(1.0, 1, frontOutset);
+        FTCoreRenderer::AppendMesh(coreFront, vectoriser->GetMesh(), 0.0f,
+                                   hscale, vscale);
+    }
+
+    if((renderMode & FTGL::RENDER_BACK) && coreBack.empty())
+    {
+        // The front face mesh, as in RenderBack()
+        vectoriser->MakeMesh(1.0, 2, backOutset);
+        FTCoreRenderer::AppendMesh(coreBack, vectoriser->GetMesh(), -depth,
+                                   hscale, vscale, true);
+    }
+
+    if((renderMode & FTGL::RENDER_SIDE) && coreSide.empty())
+    {
+        int contourFlag = vectoriser->ContourFlag();
+        FTVector<FTCoreVertex> strip;
+
+        vectoriser->BuildOutset(1, frontOutset);
+        vectoriser->BuildOutset(2, backOutset);
+
+        for(size_t c = 0; c < vectoriser->ContourCount(); ++c)
+        {
+            const FTContour* contour = vectoriser->Contour(c);
+            size_t n = contour->PointCount();
+
+            if(n < 2)
+            {
+                continue;
+            }
+
+            // The same strip as RenderSide(), lit from above
+            strip.resize(0, FTCoreVertex());
+            for(size_t j = 0; j <= n; ++j)
+            {
+                size_t cur = (j == n) ? 0 : j;
+                size_t next = (cur == n - 1) ? 0 : cur + 1;
+
+                FTPoint frontPt = contour->FrontPoint(cur);
+                FTPoint nextPt = contour->FrontPoint(next);
+                FTPoint backPt = contour->BackPoint(cur);
+
+                FTPoint normal = FTPoint(0.f, 0.f, 1.f) ^ (frontPt - nextPt);
+                float shade = 0.7f;
+                if(normal != FTPoint(0.0f, 0.0f, 0.0f))
+                {
+                    shade += 0.3f * normal.Normalise().Yf();
+                }
+
+                float s = frontPt.Xf() / hscale;
+                float t = frontPt.Yf() / vscale;
+                float backZ = -depth, frontZ = 0.0f;
+
+                if(contourFlag & ft_outline_reverse_fill)
+                {
+                    backZ = 0.0f;
+                    frontZ = -depth;
+                }
+
+                strip.push_back(FTCoreRenderer::Vertex(backPt.Xf() / 64.0f,
+                                                       backPt.Yf() / 64.0f,
+                                                       backZ, s, t, shade));
+                strip.push_back(FTCoreRenderer::Vertex(frontPt.Xf() / 64.0f,
+                                                       frontPt.Yf() / 64.0f,
+                                                       frontZ, s, t, shade));
+            }
+
+            FTCoreRenderer::AppendQuadStrip(coreSide, &strip[0],
+                                            strip.size());
+        }
+    }
+
+    if(renderMode & FTGL::RENDER_FRONT)
+    {
+        FTCoreRenderer::AppendMoved(vertices, coreFront, pen, color);
+    }
+    if(renderMode & FTGL::RENDER_BACK)
+    {
+        FTCoreRenderer::AppendMoved(vertices, coreBack, pen, color);
+    }
+    if(renderMode & FTGL::RENDER_SIDE)
+    {
+        FTCoreRenderer::AppendMoved(vertices, coreSide, pen, color);
+    }
+}
@@ -28,6 +28,7 @@
 #define __FTExtrudeGlyphImpl__
 
 #include "FTGlyphImpl.h"
+#include "FTCoreRenderer.h"
 
 class FTVectoriser;
 
@@ -41,7 +42,11 @@ class FTExtrudeGlyphImpl : public FTGlyphImpl
 
         virtual ~FTExtrudeGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+
+        virtual void AppendCore(FTVector<FTCoreVertex>& vertices,
+                                const FTPoint& pen, int renderMode,
+                                const float *color);
 
     private:
         /**
@@ -63,6 +68,16 @@ class FTExtrudeGlyphImpl : public FTGlyphImpl
          * OpenGL display list
          */
         GLuint glList;
+
+        /**
+         * The triangles of the front, back and side faces for the core
+         * profile backend, each built the first time it is drawn. The
+         * backend has no lighting, so the sides are shaded by the
+         * direction they face instead.
+         */
+        FTVector<FTCoreVertex> coreFront;
+        FTVector<FTCoreVertex> coreBack;
+        FTVector<FTCoreVertex> coreSide;
 };
 
 #endif  //  __FTExtrudeGlyphImpl__
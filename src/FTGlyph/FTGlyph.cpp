@@ -30,6 +30,7 @@
 
 #include "FTInternals.h"
 #include "FTGlyphImpl.h"
+#include "FTArena.h"
 
 
 //
@@ -39,7 +40,7 @@
 
 FTGlyph::FTGlyph(FT_GlyphSlot glyph)
 {
-    impl = new FTGlyphImpl(glyph);
+    impl = new(glyph) FTGlyphImpl(glyph);
 }
 
 
@@ -78,7 +79,12 @@ FT_Error FTGlyph::Error() const
 //
 
 
-FTGlyphImpl::FTGlyphImpl(FT_GlyphSlot glyph, bool useList) : err(0)
+FTGlyphImpl::FTGlyphImpl(FT_GlyphSlot glyph, GlyphKind glyphKind,
+                         bool useList)
+:   err(0),
+    kind(glyphKind),
+    arena(FTArena::Borrowed(glyph)),
+    stats(0)
 {
     (void)useList;
 
@@ -112,3 +118,78 @@ FT_Error FTGlyphImpl::Error() const
     return err;
 }
 
+
+// Every implementation is preceded by the arena it lives in, or NULL if
+// it is on the heap. The header keeps the object 16 byte aligned.
+static const size_t IMPL_HEADER = 16;
+
+
+void* FTGlyphImpl::operator new(size_t size)
+{
+    return operator new(size, NULL);
+}
+
+
+void* FTGlyphImpl::operator new(size_t size, FT_GlyphSlot glyph)
+{
+    FTArena *owner = FTArena::Borrowed(glyph);
+    void *memory = owner ? owner->Allocate(IMPL_HEADER + size)
+                         : ::operator new(IMPL_HEADER + size);
+
+    *static_cast<FTArena**>(memory) = owner;
+
+    return static_cast<char*>(memory) + IMPL_HEADER;
+}
+
+
+void FTGlyphImpl::operator delete(void *p)
+{
+    if(!p)
+    {
+        return;
+    }
+
+    void *memory = static_cast<char*>(p) - IMPL_HEADER;
+
+    // Arena memory is released with the arena
+    if(!*static_cast<FTArena**>(memory))
+    {
+        ::operator delete(memory);
+    }
+}
+
+
+void FTGlyphImpl::operator delete(void *p, FT_GlyphSlot glyph)
+{
+    (void)glyph;
+    operator delete(p);
+}
+
+
+unsigned char* FTGlyphImpl::AllocateData(size_t size)
+{
+    if(arena)
+    {
+        return static_cast<unsigned char*>(arena->Allocate(size));
+    }
+
+    return new unsigned char[size];
+}
+
+
+void FTGlyphImpl::FreeData(unsigned char *data)
+{
+    if(!arena)
+    {
+        delete [] data;
+    }
+}
+
+
+
+void FTGlyphImpl::AppendCore(FTVector<FTCoreVertex>& vertices,
+                             const FTPoint& pen, int renderMode,
+                             const float *color)
+{
+    (void)vertices; (void)pen; (void)renderMode; (void)color;
+}
@@ -29,12 +29,49 @@
 
 #include "FTGL/ftgl.h"
 
+#include "FTVector.h"
+
+struct FTCoreVertex;
+class FTArena;
+class FTStats;
+
 class FTGlyphImpl
 {
     friend class FTGlyph;
+    friend class FTFontImpl;
+
+    public:
+        /**
+         * The glyph implementations, so that a font can recognise the
+         * glyphs it made without a dynamic_cast for every glyph drawn.
+         */
+        enum GlyphKind
+        {
+            GLYPH_GENERIC,
+            GLYPH_BITMAP,
+            GLYPH_BUFFER,
+            GLYPH_EXTRUDE,
+            GLYPH_OUTLINE,
+            GLYPH_PIXMAP,
+            GLYPH_POLYGON,
+            GLYPH_TEXTURE
+        };
+
+        GlyphKind Kind() const { return kind; }
+
+        /**
+         * Glyph implementations made from a slot that a font has lent
+         * its arena to live in that arena. The others, and any made
+         * without a slot, live on the heap.
+         */
+        static void* operator new(size_t size);
+        static void* operator new(size_t size, FT_GlyphSlot glyph);
+        static void operator delete(void *p);
+        static void operator delete(void *p, FT_GlyphSlot glyph);
 
     protected:
-        FTGlyphImpl(FT_GlyphSlot glyph, bool useDisplayList = true);
+        FTGlyphImpl(FT_GlyphSlot glyph, GlyphKind kind = GLYPH_GENERIC,
+                    bool useDisplayList = true);
 
         virtual ~FTGlyphImpl();
 
@@ -44,6 +81,36 @@ class FTGlyphImpl
 
         FT_Error Error() const;
 
+        /**
+         * Allocate glyph data in the arena the glyph was made in, or on
+         * the heap if there is none.
+         *
+         * @param size  The number of bytes wanted.
+         * @return  The memory, to be released with <code>FreeData</code>.
+         */
+        unsigned char* AllocateData(size_t size);
+
+        /**
+         * Release glyph data allocated with <code>AllocateData</code>.
+         *
+         * @param data  The memory, or <code>NULL</code>.
+         */
+        void FreeData(unsigned char *data);
+
+        /**
+         * Append the geometry of the glyph for the core profile backend,
+         * as separate triangles or, for outlines, lines. Glyphs without
+         * geometry append nothing.
+         *
+         * @param vertices  The list to append to.
+         * @param pen  The current pen position.
+         * @param renderMode  Render mode to display
+         * @param color  The RGBA colour of the text.
+         */
+        virtual void AppendCore(FTVector<FTCoreVertex>& vertices,
+                                const FTPoint& pen, int renderMode,
+                                const float *color);
+
         /**
          * The advance distance for this glyph
          */
@@ -58,6 +125,22 @@ class FTGlyphImpl
          * Current error code. Zero means no error.
          */
         FT_Error err;
+
+        /**
+         * Which implementation this is.
+         */
+        GlyphKind kind;
+
+        /**
+         * The arena of the font that made the glyph, or <code>NULL</code>.
+         */
+        FTArena *arena;
+
+        /**
+         * The statistics of the font that created the glyph, or
+         * <code>NULL</code>. Set by the font once the glyph is made.
+         */
+        FTStats *stats;
 };
 
 #endif  //  __FTGlyphImpl__
@@ -31,6 +31,7 @@
 
 #include "FTInternals.h"
 #include "FTOutlineGlyphImpl.h"
+#include "FTTraceSpan.h"
 #include "FTVectoriser.h"
 
 
@@ -41,7 +42,7 @@
 
 FTOutlineGlyph::FTOutlineGlyph(FT_GlyphSlot glyph, float outset,
                                bool useDisplayList) :
-    FTGlyph(new FTOutlineGlyphImpl(glyph, outset, useDisplayList))
+    FTGlyph(new(glyph) FTOutlineGlyphImpl(glyph, outset, useDisplayList))
 {}
 
 
@@ -51,7 +52,7 @@ FTOutlineGlyph::~FTOutlineGlyph()
 
 const FTPoint& FTOutlineGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTOutlineGlyphImpl *myimpl = dynamic_cast<FTOutlineGlyphImpl *>(impl);
+    FTOutlineGlyphImpl *myimpl = static_cast<FTOutlineGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -63,7 +64,7 @@ const FTPoint& FTOutlineGlyph::Render(const FTPoint& pen, int renderMode)
 
 FTOutlineGlyphImpl::FTOutlineGlyphImpl(FT_GlyphSlot glyph, float _outset,
                                        bool useDisplayList)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_OUTLINE),
     glList(0)
 {
     if(ft_glyph_format_outline != glyph->format)
@@ -85,6 +86,8 @@ FTOutlineGlyphImpl::FTOutlineGlyphImpl(FT_GlyphSlot glyph, float _outset,
 
     if(useDisplayList)
     {
+        FTGL_TRACE_SPAN(FTGL::TRACE_COMPILE, 0, 0, glyph->glyph_index);
+
         glList = glGenLists(1);
         glNewList(glList, GL_COMPILE);
 
@@ -133,6 +136,8 @@ const FTPoint& FTOutlineGlyphImpl::RenderImpl(const FTPoint& pen,
 
 void FTOutlineGlyphImpl::DoRender()
 {
+    vectoriser->BuildOutset(1, outset);
+
     for(unsigned int c = 0; c < vectoriser->ContourCount(); ++c)
     {
         const FTContour* contour = vectoriser->Contour(c);
@@ -140,12 +145,47 @@ void FTOutlineGlyphImpl::DoRender()
         glBegin(GL_LINE_LOOP);
             for(unsigned int i = 0; i < contour->PointCount(); ++i)
             {
-                FTPoint point = FTPoint(contour->Point(i).X() + contour->Outset(i).X() * outset,
-                                        contour->Point(i).Y() + contour->Outset(i).Y() * outset,
-                                        0);
+                const FTPoint& point = contour->FrontPoint(i);
                 glVertex2f(point.Xf() / 64.0f, point.Yf() / 64.0f);
             }
         glEnd();
     }
 }
 
+
+
+void FTOutlineGlyphImpl::AppendCore(FTVector<FTCoreVertex>& vertices,
+                                    const FTPoint& pen, int renderMode,
+                                    const float *color)
+{
+    (void)renderMode;
+
+    if(coreLines.empty() && vectoriser)
+    {
+        vectoriser->BuildOutset(1, outset);
+
+        // The core profile has no line loops: close each contour with
+        // separate segments.
+        for(unsigned int c = 0; c < vectoriser->ContourCount(); ++c)
+        {
+            const FTContour* contour = vectoriser->Contour(c);
+            unsigned int n = contour->PointCount();
+
+            for(unsigned int i = 0; i < n; ++i)
+            {
+                unsigned int ends[2] = { i, (i + 1 == n) ? 0 : i + 1 };
+
+                for(int e = 0; e < 2; ++e)
+                {
+                    const FTPoint& point = contour->FrontPoint(ends[e]);
+                    coreLines.push_back(
+                        FTCoreRenderer::Vertex(point.Xf() / 64.0f,
+                                               point.Yf() / 64.0f, 0.0f,
+                                               0.0f, 0.0f, 1.0f));
+                }
+            }
+        }
+    }
+
+    FTCoreRenderer::AppendMoved(vertices, coreLines, pen, color);
+}
@@ -28,6 +28,7 @@
 #define __FTOutlineGlyphImpl__
 
 #include "FTGlyphImpl.h"
+#include "FTCoreRenderer.h"
 
 class FTVectoriser;
 
@@ -41,7 +42,11 @@ class FTOutlineGlyphImpl : public FTGlyphImpl
 
         virtual ~FTOutlineGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+
+        virtual void AppendCore(FTVector<FTCoreVertex>& vertices,
+                                const FTPoint& pen, int renderMode,
+                                const float *color);
 
     private:
         /**
@@ -63,6 +68,12 @@ class FTOutlineGlyphImpl : public FTGlyphImpl
          * OpenGL display list
          */
         GLuint glList;
+
+        /**
+         * The contours of the glyph as line segments for the core profile
+         * backend, built the first time it is drawn.
+         */
+        FTVector<FTCoreVertex> coreLines;
 };
 
 #endif  // __FTOutlineGlyphImpl__
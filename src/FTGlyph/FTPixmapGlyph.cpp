@@ -32,6 +32,7 @@
 
 #include "FTInternals.h"
 #include "FTPixmapGlyphImpl.h"
+#include "FTTraceSpan.h"
 
 
 //
@@ -40,7 +41,7 @@
 
 
 FTPixmapGlyph::FTPixmapGlyph(FT_GlyphSlot glyph) :
-    FTGlyph(new FTPixmapGlyphImpl(glyph))
+    FTGlyph(new(glyph) FTPixmapGlyphImpl(glyph))
 {}
 
 
@@ -50,7 +51,7 @@ FTPixmapGlyph::~FTPixmapGlyph()
 
 const FTPoint& FTPixmapGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTPixmapGlyphImpl *myimpl = dynamic_cast<FTPixmapGlyphImpl *>(impl);
+    FTPixmapGlyphImpl *myimpl = static_cast<FTPixmapGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -61,12 +62,16 @@ const FTPoint& FTPixmapGlyph::Render(const FTPoint& pen, int renderMode)
 
 
 FTPixmapGlyphImpl::FTPixmapGlyphImpl(FT_GlyphSlot glyph)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_PIXMAP),
     destWidth(0),
     destHeight(0),
     data(0)
 {
-    err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    {
+        FTGL_TRACE_SPAN(FTGL::TRACE_RASTERISE, 0, 0, glyph->glyph_index);
+        err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    }
+
     if(err || ft_glyph_format_bitmap != glyph->format)
     {
         return;
@@ -85,7 +90,7 @@ FTPixmapGlyphImpl::FTPixmapGlyphImpl(FT_GlyphSlot glyph)
 
     if(destWidth && destHeight)
     {
-        data = new unsigned char[destWidth * destHeight * 2];
+        data = AllocateData(destWidth * destHeight * 2);
         unsigned char* src = bitmap.buffer;
 
         unsigned char* dest = data + ((destHeight - 1) * destWidth * 2);
@@ -129,7 +134,7 @@ FTPixmapGlyphImpl::FTPixmapGlyphImpl(FT_GlyphSlot glyph)
 
 FTPixmapGlyphImpl::~FTPixmapGlyphImpl()
 {
-    delete [] data;
+    FreeData(data);
 }
 
 
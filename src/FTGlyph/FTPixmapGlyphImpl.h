@@ -38,7 +38,7 @@ class FTPixmapGlyphImpl : public FTGlyphImpl
 
         virtual ~FTPixmapGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
 
     private:
         /**
@@ -31,6 +31,7 @@
 
 #include "FTInternals.h"
 #include "FTPolygonGlyphImpl.h"
+#include "FTTraceSpan.h"
 #include "FTVectoriser.h"
 
 
@@ -41,7 +42,7 @@
 
 FTPolygonGlyph::FTPolygonGlyph(FT_GlyphSlot glyph, float outset,
                                bool useDisplayList) :
-    FTGlyph(new FTPolygonGlyphImpl(glyph, outset, useDisplayList))
+    FTGlyph(new(glyph) FTPolygonGlyphImpl(glyph, outset, useDisplayList))
 {}
 
 
@@ -51,7 +52,7 @@ FTPolygonGlyph::~FTPolygonGlyph()
 
 const FTPoint& FTPolygonGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTPolygonGlyphImpl *myimpl = dynamic_cast<FTPolygonGlyphImpl *>(impl);
+    FTPolygonGlyphImpl *myimpl = static_cast<FTPolygonGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -63,7 +64,7 @@ const FTPoint& FTPolygonGlyph::Render(const FTPoint& pen, int renderMode)
 
 FTPolygonGlyphImpl::FTPolygonGlyphImpl(FT_GlyphSlot glyph, float _outset,
                                        bool useDisplayList)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_POLYGON),
     glList(0)
 {
     if(ft_glyph_format_outline != glyph->format)
@@ -88,6 +89,8 @@ FTPolygonGlyphImpl::FTPolygonGlyphImpl(FT_GlyphSlot glyph, float _outset,
 
     if(useDisplayList)
     {
+        FTGL_TRACE_SPAN(FTGL::TRACE_COMPILE, 0, 0, glyph->glyph_index);
+
         glList = glGenLists(1);
         glNewList(glList, GL_COMPILE);
 
@@ -156,3 +159,20 @@ void FTPolygonGlyphImpl::DoRender()
     }
 }
 
+
+
+void FTPolygonGlyphImpl::AppendCore(FTVector<FTCoreVertex>& vertices,
+                                    const FTPoint& pen, int renderMode,
+                                    const float *color)
+{
+    (void)renderMode;
+
+    if(coreMesh.empty() && vectoriser)
+    {
+        vectoriser->MakeMesh(1.0, 1, outset);
+        FTCoreRenderer::AppendMesh(coreMesh, vectoriser->GetMesh(), 0.0f,
+                                   hscale, vscale);
+    }
+
+    FTCoreRenderer::AppendMoved(vertices, coreMesh, pen, color);
+}
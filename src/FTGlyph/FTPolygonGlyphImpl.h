@@ -28,6 +28,7 @@
 #define __FTPolygonGlyphImpl__
 
 #include "FTGlyphImpl.h"
+#include "FTCoreRenderer.h"
 
 class FTVectoriser;
 
@@ -41,7 +42,11 @@ class FTPolygonGlyphImpl : public FTGlyphImpl
 
         virtual ~FTPolygonGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+
+        virtual void AppendCore(FTVector<FTCoreVertex>& vertices,
+                                const FTPoint& pen, int renderMode,
+                                const float *color);
 
     private:
         /**
@@ -60,6 +65,12 @@ class FTPolygonGlyphImpl : public FTGlyphImpl
          * OpenGL display list
          */
         GLuint glList;
+
+        /**
+         * The triangles of the glyph for the core profile backend, built
+         * the first time it is drawn.
+         */
+        FTVector<FTCoreVertex> coreMesh;
 };
 
 #endif  //  __FTPolygonGlyphImpl__
@@ -31,7 +31,10 @@
 #include "FTGL/ftgl.h"
 
 #include "FTInternals.h"
+#include "FTCoreRenderer.h"
+#include "FTStats.h"
 #include "FTTextureGlyphImpl.h"
+#include "FTTraceSpan.h"
 
 #define FTGL_ASSERTS_SHOULD_SOFT_FAIL
 
@@ -60,7 +63,7 @@
 
 FTTextureGlyph::FTTextureGlyph(FT_GlyphSlot glyph, int id, int xOffset,
                                int yOffset, int width, int height) :
-    FTGlyph(new FTTextureGlyphImpl(glyph, id, xOffset, yOffset, width, height))
+    FTGlyph(new(glyph) FTTextureGlyphImpl(glyph, id, xOffset, yOffset, width, height))
 {}
 
 
@@ -70,7 +73,7 @@ FTTextureGlyph::~FTTextureGlyph()
 
 const FTPoint& FTTextureGlyph::Render(const FTPoint& pen, int renderMode)
 {
-    FTTextureGlyphImpl *myimpl = dynamic_cast<FTTextureGlyphImpl *>(impl);
+    FTTextureGlyphImpl *myimpl = static_cast<FTTextureGlyphImpl *>(impl);
     return myimpl->RenderImpl(pen, renderMode);
 }
 
@@ -83,7 +86,7 @@ GLint FTTextureGlyphImpl::activeTextureID = 0;
 
 FTTextureGlyphImpl::FTTextureGlyphImpl(FT_GlyphSlot glyph, int id, int xOffset,
                                        int yOffset, int width, int height)
-:   FTGlyphImpl(glyph),
+:   FTGlyphImpl(glyph, GLYPH_TEXTURE),
     destWidth(0),
     destHeight(0),
     glTextureID(id)
@@ -92,7 +95,11 @@ FTTextureGlyphImpl::FTTextureGlyphImpl(FT_GlyphSlot glyph, int id, int xOffset,
      * here in order to get FT_RENDER_MODE_MONO aliased fonts.
      */
 
-    err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    {
+        FTGL_TRACE_SPAN(FTGL::TRACE_RASTERISE, 0, 0, glyph->glyph_index);
+        err = FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    }
+
     if(err || glyph->format != ft_glyph_format_bitmap)
     {
         return;
@@ -105,17 +112,33 @@ FTTextureGlyphImpl::FTTextureGlyphImpl(FT_GlyphSlot glyph, int id, int xOffset,
 
     if(destWidth && destHeight)
     {
-        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
-
-        glPixelStorei(GL_UNPACK_LSB_FIRST, GL_FALSE);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
         GLint w,h;
+        GLint format = GL_ALPHA;
 
         glBindTexture(GL_TEXTURE_2D, glTextureID);
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0,
+                                 GL_TEXTURE_INTERNAL_FORMAT, &format);
+
+        // Fonts using the core profile backend have GL_R8 textures, and
+        // there is no client attribute stack to save the pixel store with.
+        const bool coreProfile = (format == GL_R8);
+        GLint alignment = 4, rowLength = 0;
+
+        if(coreProfile)
+        {
+            glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+            glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+        }
+        else
+        {
+            glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+            glPixelStorei(GL_UNPACK_LSB_FIRST, GL_FALSE);
+        }
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
         FTASSERT(xOffset >= 0);
         FTASSERT(yOffset >= 0);
@@ -133,12 +156,23 @@ FTTextureGlyphImpl::FTTextureGlyphImpl(FT_GlyphSlot glyph, int id, int xOffset,
         }
         if (destHeight >= 0)
         {
+            FTGL_TRACE_SPAN(FTGL::TRACE_UPLOAD, 0, 0, glyph->glyph_index);
+
             glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset,
-                            destWidth, destHeight, GL_ALPHA, GL_UNSIGNED_BYTE,
-                            bitmap.buffer);
+                            destWidth, destHeight,
+                            coreProfile ? GL_RED : GL_ALPHA,
+                            GL_UNSIGNED_BYTE, bitmap.buffer);
         }
 
-        glPopClientAttrib();
+        if(coreProfile)
+        {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+        }
+        else
+        {
+            glPopClientAttrib();
+        }
     }
 
 //      0
@@ -154,7 +188,7 @@ FTTextureGlyphImpl::FTTextureGlyphImpl(FT_GlyphSlot glyph, int id, int xOffset,
     uv[1].X(static_cast<float>(xOffset + destWidth) / static_cast<float>(width));
     uv[1].Y(static_cast<float>(yOffset + destHeight) / static_cast<float>(height));
 
-    corner = FTPoint(glyph->bitmap_left, glyph->bitmap_top);
+    corner = FTPointf(glyph->bitmap_left, glyph->bitmap_top);
 }
 
 
@@ -171,6 +205,15 @@ const FTPoint& FTTextureGlyphImpl::RenderImpl(const FTPoint& pen,
     {
         glBindTexture(GL_TEXTURE_2D, (GLuint)glTextureID);
         activeTextureID = glTextureID;
+
+        if(stats)
+        {
+            stats->Add(FTGL::STAT_TEXTURE_BINDS);
+        }
+    }
+    else if(stats)
+    {
+        stats->Add(FTGL::STAT_TEXTURE_BINDS_SKIPPED);
     }
 
     dx = floor(pen.Xf() + corner.Xf());
@@ -28,6 +28,7 @@
 #define __FTTextureGlyphImpl__
 
 #include "FTGlyphImpl.h"
+#include "FTPointf.h"
 
 class FTTextureGlyphImpl : public FTGlyphImpl
 {
@@ -40,7 +41,7 @@ class FTTextureGlyphImpl : public FTGlyphImpl
 
         virtual ~FTTextureGlyphImpl();
 
-        virtual const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
+        const FTPoint& RenderImpl(const FTPoint& pen, int renderMode);
 
     private:
         /**
@@ -63,12 +64,12 @@ class FTTextureGlyphImpl : public FTGlyphImpl
         /**
          * Vector from the pen position to the topleft corner of the pixmap
          */
-        FTPoint corner;
+        FTPointf corner;
 
         /**
          * The texture co-ords of this glyph within the texture.
          */
-        FTPoint uv[2];
+        FTPointf uv[2];
 
         /**
          * The texture index that this glyph is contained in.
@@ -38,6 +38,8 @@ FTGlyphContainer::FTGlyphContainer(FTFace* f)
     err(0)
 {
     glyphs.push_back(NULL);
+    advances.push_back(0.0f);
+    bounds.push_back(FTBBoxf());
     charMap = new FTCharmap(face);
 }
 
@@ -51,6 +53,8 @@ FTGlyphContainer::~FTGlyphContainer()
     }
 
     glyphs.clear();
+    advances.clear();
+    bounds.clear();
     delete charMap;
 }
 
@@ -72,7 +76,46 @@ unsigned int FTGlyphContainer::FontIndex(const unsigned int charCode) const
 void FTGlyphContainer::Add(FTGlyph* tempGlyph, const unsigned int charCode)
 {
     charMap->InsertIndex(charCode, glyphs.size());
+    indexMap.insert(charMap->FontIndex(charCode), glyphs.size());
     glyphs.push_back(tempGlyph);
+    AddMetrics(tempGlyph);
+}
+
+
+void FTGlyphContainer::AddIndexed(FTGlyph* tempGlyph,
+                                  const unsigned int glyphIndex)
+{
+    indexMap.insert(glyphIndex, glyphs.size());
+    glyphs.push_back(tempGlyph);
+    AddMetrics(tempGlyph);
+}
+
+
+void FTGlyphContainer::AddMetrics(const FTGlyph* tempGlyph)
+{
+    if(tempGlyph)
+    {
+        advances.push_back(tempGlyph->Advance());
+        bounds.push_back(FTBBoxf(tempGlyph->BBox()));
+    }
+    else
+    {
+        advances.push_back(0.0f);
+        bounds.push_back(FTBBoxf());
+    }
+}
+
+
+bool FTGlyphContainer::Share(const unsigned int charCode)
+{
+    unsigned int index = indexMap.find(charMap->FontIndex(charCode));
+    if(!index)
+    {
+        return false;
+    }
+
+    charMap->InsertIndex(charCode, index);
+    return true;
 }
 
 
@@ -84,23 +127,48 @@ const FTGlyph* const FTGlyphContainer::Glyph(const unsigned int charCode) const
 }
 
 
+const FTGlyph* FTGlyphContainer::IndexedGlyph(const unsigned int glyphIndex)
+{
+    unsigned int index = indexMap.find(glyphIndex);
+
+    return (index < glyphs.size()) ? glyphs[index] : NULL;
+}
+
+
 FTBBox FTGlyphContainer::BBox(const unsigned int charCode) const
 {
-    return Glyph(charCode)->BBox();
+    return Bounds(charCode);
+}
+
+
+const FTBBoxf& FTGlyphContainer::Bounds(const unsigned int charCode) const
+{
+    unsigned int index = charMap->GlyphListIndex(charCode);
+
+    return bounds[(index < bounds.size()) ? index : 0];
+}
+
+
+const FTBBoxf& FTGlyphContainer::IndexedBounds(const unsigned int glyphIndex)
+{
+    unsigned int index = indexMap.find(glyphIndex);
+
+    return bounds[(index < bounds.size()) ? index : 0];
 }
 
 
 float FTGlyphContainer::Advance(const unsigned int charCode,
                                 const unsigned int nextCharCode)
 {
-    unsigned int left = charMap->FontIndex(charCode);
-    unsigned int right = charMap->FontIndex(nextCharCode);
-    const FTGlyph *glyph = Glyph(charCode);
+    unsigned int index = charMap->GlyphListIndex(charCode);
 
-    if (!glyph)
+    if (!index || index >= advances.size())
       return 0.0f;
 
-    return face->KernAdvance(left, right).Xf() + glyph->Advance();
+    unsigned int left = charMap->FontIndex(charCode);
+    unsigned int right = charMap->FontIndex(nextCharCode);
+
+    return face->KernAdvance(left, right).Xf() + advances[index];
 }
 
 
@@ -123,3 +191,29 @@ FTPoint FTGlyphContainer::Render(const unsigned int charCode,
     return kernAdvance;
 }
 
+
+float FTGlyphContainer::IndexedAdvance(const unsigned int glyphIndex,
+                                       const unsigned int nextGlyphIndex)
+{
+    unsigned int index = indexMap.find(glyphIndex);
+
+    if (!index || index >= advances.size())
+      return 0.0f;
+
+    return face->KernAdvance(glyphIndex, nextGlyphIndex).Xf()
+            + advances[index];
+}
+
+
+FTPoint FTGlyphContainer::RenderIndexed(const unsigned int glyphIndex,
+                                        const unsigned int nextGlyphIndex,
+                                        FTPoint penPosition, int renderMode)
+{
+    FTPoint kernAdvance = face->KernAdvance(glyphIndex, nextGlyphIndex);
+    unsigned int index = indexMap.find(glyphIndex);
+
+    if (index && index < glyphs.size())
+        kernAdvance += glyphs[index]->Render(penPosition, renderMode);
+
+    return kernAdvance;
+}
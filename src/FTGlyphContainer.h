@@ -33,6 +33,9 @@
 #include "FTGL/ftgl.h"
 
 #include "FTVector.h"
+#include "FTBBoxf.h"
+#include "FTArena.h"
+#include "FTCharToGlyphIndexMap.h"
 
 class FTFace;
 class FTGlyph;
@@ -41,6 +44,10 @@ class FTCharmap;
 /**
  * FTGlyphContainer holds the post processed FTGlyph objects.
  *
+ * The advance and bounding box of each glyph are also copied into
+ * arrays that run parallel to the glyph list, so measuring text reads
+ * them from contiguous memory rather than from every glyph object.
+ *
  * @see FTGlyph
  */
 class FTGlyphContainer
@@ -94,12 +101,57 @@ class FTGlyphContainer
          */
         const FTGlyph* const Glyph(const unsigned int characterCode) const;
 
+        /**
+         * Get a glyph from the glyph list by its index in the font.
+         *
+         * @param glyphIndex  The glyph index NOT the char code.
+         * @return            An FTGlyph or <code>null</code> is it hasn't been
+         * loaded.
+         */
+        const FTGlyph* IndexedGlyph(const unsigned int glyphIndex);
+
+        /**
+         * Adds a glyph loaded by its index in the font, rather than for a
+         * character, to this glyph list.
+         *
+         * @param glyph       The FTGlyph to be inserted into the container
+         * @param glyphIndex  The glyph index NOT the char code.
+         */
+        void AddIndexed(FTGlyph* glyph, const unsigned int glyphIndex);
+
+        /**
+         * Use an already loaded glyph for a character, if the font maps it
+         * to a glyph that was loaded for another character or by index.
+         *
+         * @param characterCode The char code of the glyph NOT the glyph index
+         * @return              <code>true</code> if the glyph was loaded.
+         */
+        bool Share(const unsigned int characterCode);
+
         /**
          * Get the bounding box for a character.
          * @param characterCode The char code of the glyph NOT the glyph index
          */
         FTBBox BBox(const unsigned int characterCode) const;
 
+        /**
+         * Get the bounding box for a character from the metrics table.
+         *
+         * @param characterCode The char code of the glyph NOT the glyph index
+         * @return              The glyph bounds, or an empty box if the
+         *                      glyph hasn't been loaded.
+         */
+        const FTBBoxf& Bounds(const unsigned int characterCode) const;
+
+        /**
+         * Get the bounding box for a glyph given by its index in the font.
+         *
+         * @param glyphIndex  The glyph index NOT the char code.
+         * @return            The glyph bounds, or an empty box if the
+         *                    glyph hasn't been loaded.
+         */
+        const FTBBoxf& IndexedBounds(const unsigned int glyphIndex);
+
         /**
         * Returns the kerned advance width for a glyph.
         *
@@ -122,6 +174,30 @@ class FTGlyphContainer
                        const unsigned int nextCharacterCode,
                        FTPoint penPosition, int renderMode);
 
+        /**
+         * Returns the kerned advance width for a glyph given by its index
+         * in the font.
+         *
+         * @param glyphIndex      the glyph index NOT the char code
+         * @param nextGlyphIndex  the index of the next glyph, or zero
+         * @return                advance width
+         */
+        float IndexedAdvance(const unsigned int glyphIndex,
+                             const unsigned int nextGlyphIndex);
+
+        /**
+         * Renders a glyph by its index in the font.
+         * @param glyphIndex      the glyph index NOT the char code
+         * @param nextGlyphIndex  the index of the next glyph, used for
+         *                        kerning, or zero
+         * @param penPosition     the position to Render the glyph
+         * @param renderMode      Render mode to display
+         * @return                The distance to advance the pen position after Rendering
+         */
+        FTPoint RenderIndexed(const unsigned int glyphIndex,
+                              const unsigned int nextGlyphIndex,
+                              FTPoint penPosition, int renderMode);
+
         /**
          * Queries the Font for errors.
          *
@@ -129,7 +205,21 @@ class FTGlyphContainer
          */
         FT_Error Error() const { return err; }
 
+        /**
+         * The arena the glyphs of this container and their data are
+         * allocated in. It is released after the glyphs are deleted.
+         */
+        FTArena& Arena() { return arena; }
+
     private:
+        /**
+         * Append the advance and bounding box of a newly added glyph to
+         * the metrics table.
+         *
+         * @param glyph  The glyph just added, or <code>null</code>.
+         */
+        void AddMetrics(const FTGlyph* glyph);
+
         /**
          * The FTGL face
          */
@@ -140,11 +230,32 @@ class FTGlyphContainer
          */
         FTCharmap* charMap;
 
+        /**
+         * The position in the glyph list of each glyph index that was
+         * loaded, whether for a character or by index.
+         */
+        FTCharToGlyphIndexMap indexMap;
+
         /**
          * A structure to hold the glyphs
          */
         GlyphVector glyphs;
 
+        /**
+         * The advance of each glyph, indexed like <code>glyphs</code>.
+         */
+        FTVector<float> advances;
+
+        /**
+         * The bounding box of each glyph, indexed like <code>glyphs</code>.
+         */
+        FTVector<FTBBoxf> bounds;
+
+        /**
+         * Memory for the glyphs made by the font.
+         */
+        FTArena arena;
+
         /**
          * Current error code. Zero means no error.
          */
@@ -123,6 +123,11 @@ struct _FTGLfont
     FTGL::FontType type;
 };
 
+struct _FTGLshaper
+{
+    FTShaper *ptr;
+};
+
 typedef enum
 {
     LAYOUT_SIMPLE,
@@ -55,6 +55,66 @@ FTLayout::~FTLayout()
 }
 
 
+FTBBox FTLayout::BBoxUTF8(const char *string, const int len,
+                          FTPoint position)
+{
+    FTUnicodeText text = { (const unsigned char *)string, NULL, NULL };
+    int count = impl->Widen(&text, len);
+
+    return BBox(&impl->wideText[0], count, position);
+}
+
+
+FTBBox FTLayout::BBoxUTF16(const unsigned short *string, const int len,
+                           FTPoint position)
+{
+    FTUnicodeText text = { NULL, string, NULL };
+    int count = impl->Widen(&text, len);
+
+    return BBox(&impl->wideText[0], count, position);
+}
+
+
+FTBBox FTLayout::BBoxUTF32(const unsigned int *string, const int len,
+                           FTPoint position)
+{
+    FTUnicodeText text = { NULL, NULL, string };
+    int count = impl->Widen(&text, len);
+
+    return BBox(&impl->wideText[0], count, position);
+}
+
+
+void FTLayout::RenderUTF8(const char *string, const int len,
+                          FTPoint position, int renderMode)
+{
+    FTUnicodeText text = { (const unsigned char *)string, NULL, NULL };
+    int count = impl->Widen(&text, len);
+
+    Render(&impl->wideText[0], count, position, renderMode);
+}
+
+
+void FTLayout::RenderUTF16(const unsigned short *string, const int len,
+                           FTPoint position, int renderMode)
+{
+    FTUnicodeText text = { NULL, string, NULL };
+    int count = impl->Widen(&text, len);
+
+    Render(&impl->wideText[0], count, position, renderMode);
+}
+
+
+void FTLayout::RenderUTF32(const unsigned int *string, const int len,
+                           FTPoint position, int renderMode)
+{
+    FTUnicodeText text = { NULL, NULL, string };
+    int count = impl->Widen(&text, len);
+
+    Render(&impl->wideText[0], count, position, renderMode);
+}
+
+
 FT_Error FTLayout::Error() const
 {
     return impl->err;
@@ -78,3 +138,31 @@ FTLayoutImpl::~FTLayoutImpl()
     ;
 }
 
+
+int FTLayoutImpl::Widen(const FTUnicodeText *text, const int len)
+{
+    int count = decoder.Decode(text, len);
+    const unsigned int *chars = decoder.Chars();
+
+    wideText.resize(0, 0);
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int c = chars[i];
+
+        // Characters outside the BMP become surrogate pairs where wchar_t
+        // holds UTF-16
+        if(sizeof(wchar_t) == 2 && c >= 0x10000)
+        {
+            wideText.push_back((wchar_t)(0xD800 + ((c - 0x10000) >> 10)));
+            wideText.push_back((wchar_t)(0xDC00 + ((c - 0x10000) & 0x3FF)));
+        }
+        else
+        {
+            wideText.push_back((wchar_t)c);
+        }
+    }
+    wideText.push_back(0);
+
+    return count;
+}
+
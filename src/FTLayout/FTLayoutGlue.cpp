@@ -107,9 +107,10 @@ void ftglSetLayoutFont(FTGLlayout *l, FTGLfont *font)
     {
         fprintf(stderr, "FTGL warning: %s not implemented for %d\n",
                         __FUNC__, l->type);
+        return;
     }
     l->font = font;
-    return dynamic_cast<FTSimpleLayout*>(l->ptr)->SetFont(font->ptr);
+    return static_cast<FTSimpleLayout*>(l->ptr)->SetFont(font->ptr);
 }
 
 // FTFont *FTSimpleLayout::GetFont()
@@ -144,7 +145,7 @@ FTGLfont *ftglGetLayoutFont(FTGLlayout *l)
                             __FUNC__, l->type); \
             cxxerr; \
         } \
-        return dynamic_cast<FTSimpleLayout*>(l->ptr)->cxxname cxxarg; \
+        return static_cast<FTSimpleLayout*>(l->ptr)->cxxname cxxarg; \
     }
 
 // void FTSimpleLayout::SetLineLength(const float LineLength);
@@ -165,6 +166,14 @@ C_FUN(int, ftglGetLayoutAlignment, (FTGLlayout *l),
 C_FUN(int, ftglGetLayoutAlignement, (FTGLlayout *l),
       return FTGL::ALIGN_LEFT, GetAlignment, ()); // old typo
 
+// void FTSimpleLayout::SetBreakMode(const LineBreakMode BreakMode)
+C_FUN(void, ftglSetLayoutBreakMode, (FTGLlayout *l, const int m),
+      return, SetBreakMode, ((FTGL::LineBreakMode)m));
+
+// LineBreakMode FTSimpleLayout::GetBreakMode() const
+C_FUN(int, ftglGetLayoutBreakMode, (FTGLlayout *l),
+      return FTGL::BREAK_GREEDY, GetBreakMode, ());
+
 // void FTSimpleLayout::SetLineSpacing(const float LineSpacing)
 C_FUN(void, ftglSetLayoutLineSpacing, (FTGLlayout *l, const float f),
       return, SetLineSpacing, (f));
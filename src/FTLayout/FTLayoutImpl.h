@@ -29,6 +29,8 @@
 
 #include "FTSize.h"
 #include "FTGlyphContainer.h"
+#include "FTUnicode.h"
+#include "FTVector.h"
 
 
 class FTLayoutImpl
@@ -50,6 +52,20 @@ class FTLayoutImpl
          * Current error code. Zero means no error.
          */
         FT_Error err;
+
+        /**
+         * Convert a length-delimited string to a wchar_t string, for the
+         * layouts that only handle char and wchar_t strings.
+         *
+         * @param text  The string.
+         * @param len  The length of the string in code units, or -1.
+         * @return  The number of characters, in <code>wideText</code>.
+         */
+        int Widen(const FTUnicodeText *text, const int len);
+
+        /* Scratch storage for Widen(), kept from one string to the next */
+        FTUnicodeDecoder decoder;
+        FTVector<wchar_t> wideText;
 };
 
 #endif  //  __FTLayoutImpl__
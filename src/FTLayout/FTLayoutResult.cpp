@@ -0,0 +1,272 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <wctype.h>
+#include <math.h>
+
+#include "FTInternals.h"
+#include "FTLayoutResultImpl.h"
+#include "FTMutex.h"
+
+
+//
+//  FTLayoutResult
+//
+
+
+FTLayoutResult::FTLayoutResult()
+:   impl(0)
+{}
+
+
+FTLayoutResult::FTLayoutResult(FTLayoutResultImpl *pImpl)
+:   impl(pImpl)
+{
+    FTAtomicIncrement(&impl->refCount);
+}
+
+
+FTLayoutResult::FTLayoutResult(const FTLayoutResult& result)
+:   impl(result.impl)
+{
+    if(impl)
+    {
+        FTAtomicIncrement(&impl->refCount);
+    }
+}
+
+
+FTLayoutResult& FTLayoutResult::operator=(const FTLayoutResult& result)
+{
+    if(result.impl)
+    {
+        FTAtomicIncrement(&result.impl->refCount);
+    }
+
+    if(impl && FTAtomicDecrement(&impl->refCount) == 0)
+    {
+        delete impl;
+    }
+
+    impl = result.impl;
+    return *this;
+}
+
+
+FTLayoutResult::~FTLayoutResult()
+{
+    if(impl && FTAtomicDecrement(&impl->refCount) == 0)
+    {
+        delete impl;
+    }
+}
+
+
+void FTLayoutResult::Render(FTPoint position, int renderMode) const
+{
+    if(!impl)
+    {
+        return;
+    }
+
+    for(unsigned int i = 0; i < impl->runs.size(); i++)
+    {
+        int start = impl->runs[i].start;
+        int end = impl->runs[i].end;
+
+        impl->font->Render(&impl->text[impl->offsets[start]], end - start,
+                           position + impl->positions[impl->logical[start]],
+                           FTPoint(), renderMode | FTGL::RENDER_VISUAL_ORDER);
+    }
+
+    if(impl->glyphs.size())
+    {
+        impl->font->RenderGlyphs(&impl->glyphs[0], &impl->glyphPositions[0],
+                                 impl->glyphs.size(), position, FTPoint(),
+                                 renderMode);
+    }
+}
+
+
+FTBBox FTLayoutResult::BBox(FTPoint position) const
+{
+    if(!impl)
+    {
+        return FTBBox();
+    }
+
+    FTBBox bounds = impl->bbox;
+    bounds += position;
+    return bounds;
+}
+
+
+int FTLayoutResult::CharCount() const
+{
+    return impl ? (int)impl->advances.size() : 0;
+}
+
+
+int FTLayoutResult::LineCount() const
+{
+    return impl ? (int)impl->lines.size() : 0;
+}
+
+
+int FTLayoutResult::LineStart(const int line) const
+{
+    if(line < 0 || line >= LineCount())
+    {
+        return -1;
+    }
+
+    return impl->lines[line].start;
+}
+
+
+int FTLayoutResult::LineEnd(const int line) const
+{
+    if(line < 0 || line >= LineCount())
+    {
+        return -1;
+    }
+
+    return impl->lines[line].end;
+}
+
+
+FTPoint FTLayoutResult::LinePosition(const int line) const
+{
+    if(line < 0 || line >= LineCount())
+    {
+        return FTPoint();
+    }
+
+    return impl->lines[line].pen;
+}
+
+
+FTBBox FTLayoutResult::LineBBox(const int line) const
+{
+    if(line < 0 || line >= LineCount())
+    {
+        return FTBBox();
+    }
+
+    return impl->lines[line].bbox;
+}
+
+
+FTPoint FTLayoutResult::CharPosition(const int index) const
+{
+    if(!impl || !impl->lines.size())
+    {
+        return FTPoint();
+    }
+
+    int count = (int)impl->advances.size();
+    int i = index < 0 ? 0 : (index > count ? count : index);
+
+    return impl->positions[i];
+}
+
+
+int FTLayoutResult::CharIndex(FTPoint point) const
+{
+    if(!impl || !impl->lines.size())
+    {
+        return -1;
+    }
+
+    int numLines = (int)impl->lines.size();
+    int l = 0;
+
+    // Find the line under the point
+    if(impl->lineStep > 0.0f)
+    {
+        float top = impl->font->Ascender();
+        l = (int)floorf((top - point.Yf()) / impl->lineStep);
+    }
+
+    if(l < 0)
+    {
+        l = 0;
+    }
+    else if(l >= numLines)
+    {
+        l = numLines - 1;
+    }
+
+    const FTLayoutResultImpl::Line& line = impl->lines[l];
+
+    // The position after a whitespace the line was wrapped at is the start
+    // of the next line; stop before it.
+    int last = line.end;
+    if(l + 1 < numLines && last > line.start
+        && last == impl->lines[l + 1].start)
+    {
+        int v = line.start;
+        while(impl->logical[v] != last - 1)
+        {
+            v++;
+        }
+
+        if(iswspace(impl->text[impl->offsets[v]]))
+        {
+            last--;
+        }
+    }
+
+    for(int v = line.start; v < line.end; v++)
+    {
+        int n = impl->logical[v];
+
+        // Pick the closest side of the character
+        if(n < last
+            && point.Xf() < impl->positions[n].Xf() + impl->advances[n] / 2)
+        {
+            return n;
+        }
+    }
+
+    return last;
+}
+
+
+//
+//  FTLayoutResultImpl
+//
+
+
+FTLayoutResultImpl::FTLayoutResultImpl()
+:   refCount(0),
+    font(0),
+    lineStep(0.0f)
+{}
+
+
+FTLayoutResultImpl::~FTLayoutResultImpl()
+{}
+
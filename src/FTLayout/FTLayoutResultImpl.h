@@ -0,0 +1,157 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __FTLayoutResultImpl__
+#define __FTLayoutResultImpl__
+
+#include "FTGL/ftgl.h"
+
+#include "FTPointf.h"
+#include "FTVector.h"
+
+
+class FTLayoutResultImpl
+{
+        friend class FTLayoutResult;
+        friend class FTSimpleLayoutImpl;
+
+    protected:
+        FTLayoutResultImpl();
+
+        ~FTLayoutResultImpl();
+
+    private:
+        /**
+         * A line of the formatted string.
+         */
+        struct Line
+        {
+            /**
+             * Index of the first character on the line.
+             */
+            int start;
+
+            /**
+             * One past the last character drawn on the line.
+             */
+            int end;
+
+            /**
+             * The pen position of the first character.
+             */
+            FTPoint pen;
+
+            /**
+             * The bounds of the line, after alignment.
+             */
+            FTBBox bbox;
+        };
+
+        /**
+         * A range of characters that is drawn with a single call to the
+         * font. Lines are split into several runs only when they are
+         * justified. Lines shaped by the font's shaper have no runs, and
+         * are drawn from <code>glyphs</code> instead.
+         */
+        struct Run
+        {
+            /**
+             * Display position of the first character of the run.
+             */
+            int start;
+
+            /**
+             * One past the display position of the last character.
+             */
+            int end;
+        };
+
+        /**
+         * Number of FTLayoutResult objects sharing this data. Copies may
+         * be made and destroyed on different threads, so it only changes
+         * through FTAtomicIncrement() and FTAtomicDecrement().
+         */
+        volatile long refCount;
+
+        /**
+         * The font the string was laid out with.
+         */
+        FTFont *font;
+
+        /**
+         * The distance between the baselines of two lines.
+         */
+        float lineStep;
+
+        /**
+         * The string, in the native wchar_t encoding and null-terminated.
+         * The characters of each line are in display order, with right to
+         * left text reversed and mirrored.
+         */
+        FTVector<wchar_t> text;
+
+        /**
+         * Offset of each display position in <code>text</code>, plus one
+         * for the end of the string.
+         */
+        FTVector<int> offsets;
+
+        /**
+         * Index of the character shown at each display position, plus one
+         * for the end of the string. Display positions and characters only
+         * differ on lines holding right to left text.
+         */
+        FTVector<int> logical;
+
+        /**
+         * Pen position and kerned advance of each character, plus the
+         * position after the last one.
+         */
+        FTVector<FTPointf> positions;
+        FTVector<float> advances;
+
+        /**
+         * The glyphs of the lines shaped by the font's shaper, from left
+         * to right, and the pen position of each of them.
+         */
+        FTVector<unsigned int> glyphs;
+        FTVector<FTPoint> glyphPositions;
+
+        /**
+         * The lines of the string.
+         */
+        FTVector<Line> lines;
+
+        /**
+         * The runs to render.
+         */
+        FTVector<Run> runs;
+
+        /**
+         * The bounds of the whole string.
+         */
+        FTBBox bbox;
+};
+
+#endif  //  __FTLayoutResultImpl__
+
@@ -28,13 +28,18 @@
 #include "config.h"
 
 #include <ctype.h>
+#include <math.h>
 #include <wctype.h>
 
 #include "FTInternals.h"
 #include "FTUnicode.h"
+#include "FTLineBreak.h"
+#include "FTBidi.h"
 
 #include "FTGlyphContainer.h"
+#include "../FTFont/FTFontImpl.h"
 #include "FTSimpleLayoutImpl.h"
+#include "FTLayoutResultImpl.h"
 
 
 //
@@ -53,20 +58,20 @@ FTSimpleLayout::~FTSimpleLayout()
 
 FTBBox FTSimpleLayout::BBox(const char *string, const int len, FTPoint pos)
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->BBox(string, len, pos);
+    return static_cast<FTSimpleLayoutImpl*>(impl)->BBox(string, len, pos);
 }
 
 
 FTBBox FTSimpleLayout::BBox(const wchar_t *string, const int len, FTPoint pos)
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->BBox(string, len, pos);
+    return static_cast<FTSimpleLayoutImpl*>(impl)->BBox(string, len, pos);
 }
 
 
 void FTSimpleLayout::Render(const char *string, const int len, FTPoint pos,
                             int renderMode)
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->Render(string, len, pos,
+    return static_cast<FTSimpleLayoutImpl*>(impl)->Render(string, len, pos,
                                                            renderMode);
 }
 
@@ -74,56 +79,146 @@ void FTSimpleLayout::Render(const char *string, const int len, FTPoint pos,
 void FTSimpleLayout::Render(const wchar_t* string, const int len, FTPoint pos,
                             int renderMode)
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->Render(string, len, pos,
+    return static_cast<FTSimpleLayoutImpl*>(impl)->Render(string, len, pos,
                                                            renderMode);
 }
 
 
+FTLayoutResult FTSimpleLayout::Layout(const char *string, const int len)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->Layout(string, len);
+}
+
+
+FTLayoutResult FTSimpleLayout::Layout(const wchar_t *string, const int len)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->Layout(string, len);
+}
+
+
 void FTSimpleLayout::SetFont(FTFont *fontInit)
 {
-    dynamic_cast<FTSimpleLayoutImpl*>(impl)->currentFont = fontInit;
+    static_cast<FTSimpleLayoutImpl*>(impl)->currentFont = fontInit;
 }
 
 
 FTFont *FTSimpleLayout::GetFont()
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->currentFont;
+    return static_cast<FTSimpleLayoutImpl*>(impl)->currentFont;
 }
 
 
 void FTSimpleLayout::SetLineLength(const float LineLength)
 {
-    dynamic_cast<FTSimpleLayoutImpl*>(impl)->lineLength = LineLength;
+    FTSimpleLayoutImpl *myimpl = static_cast<FTSimpleLayoutImpl*>(impl);
+    myimpl->lineLength = LineLength;
+    myimpl->linesValid = false;
 }
 
 
 float FTSimpleLayout::GetLineLength() const
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->lineLength;
+    return static_cast<FTSimpleLayoutImpl*>(impl)->lineLength;
 }
 
 
 void FTSimpleLayout::SetAlignment(const FTGL::TextAlignment Alignment)
 {
-    dynamic_cast<FTSimpleLayoutImpl*>(impl)->alignment = Alignment;
+    FTSimpleLayoutImpl *myimpl = static_cast<FTSimpleLayoutImpl*>(impl);
+    myimpl->alignment = Alignment;
+    myimpl->resultValid = false;
 }
 
 
 FTGL::TextAlignment FTSimpleLayout::GetAlignment() const
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->alignment;
+    return static_cast<FTSimpleLayoutImpl*>(impl)->alignment;
+}
+
+
+void FTSimpleLayout::SetBreakMode(const FTGL::LineBreakMode BreakMode)
+{
+    static_cast<FTSimpleLayoutImpl*>(impl)->breakMode = BreakMode;
+}
+
+
+FTGL::LineBreakMode FTSimpleLayout::GetBreakMode() const
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->breakMode;
 }
 
 
 void FTSimpleLayout::SetLineSpacing(const float LineSpacing)
 {
-    dynamic_cast<FTSimpleLayoutImpl*>(impl)->lineSpacing = LineSpacing;
+    FTSimpleLayoutImpl *myimpl = static_cast<FTSimpleLayoutImpl*>(impl);
+    myimpl->lineSpacing = LineSpacing;
+    myimpl->resultValid = false;
 }
 
 
 float FTSimpleLayout::GetLineSpacing() const
 {
-    return dynamic_cast<FTSimpleLayoutImpl*>(impl)->lineSpacing;
+    return static_cast<FTSimpleLayoutImpl*>(impl)->lineSpacing;
+}
+
+
+int FTSimpleLayout::LineCount(const char *string, const int len)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->LineCount(string, len);
+}
+
+
+int FTSimpleLayout::LineCount(const wchar_t *string, const int len)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->LineCount(string, len);
+}
+
+
+int FTSimpleLayout::LineStart(const char *string, const int len,
+                              const int line)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->LineStart(string, len,
+                                                              line);
+}
+
+
+int FTSimpleLayout::LineStart(const wchar_t *string, const int len,
+                              const int line)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->LineStart(string, len,
+                                                              line);
+}
+
+
+FTPoint FTSimpleLayout::CharPosition(const char *string, const int len,
+                                     const int index, FTPoint pos)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->CharPosition(string, len,
+                                                                 index, pos);
+}
+
+
+FTPoint FTSimpleLayout::CharPosition(const wchar_t *string, const int len,
+                                     const int index, FTPoint pos)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->CharPosition(string, len,
+                                                                 index, pos);
+}
+
+
+int FTSimpleLayout::CharIndex(const char *string, const int len,
+                              FTPoint point, FTPoint pos)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->CharIndex(string, len,
+                                                              point, pos);
+}
+
+
+int FTSimpleLayout::CharIndex(const wchar_t *string, const int len,
+                              FTPoint point, FTPoint pos)
+{
+    return static_cast<FTSimpleLayoutImpl*>(impl)->CharIndex(string, len,
+                                                              point, pos);
 }
 
 
@@ -137,19 +232,54 @@ FTSimpleLayoutImpl::FTSimpleLayoutImpl()
     currentFont = NULL;
     lineLength = 100.0f;
     alignment = FTGL::ALIGN_LEFT;
+    breakMode = FTGL::BREAK_GREEDY;
     lineSpacing = 1.0f;
+
+    cachedFont = NULL;
+    cachedSize = 0;
+    cachedRevision = 0;
+    cachedCharSize = 0;
+    cachedBreakMode = FTGL::BREAK_GREEDY;
+    linesValid = false;
+
+    resultValid = false;
 }
 
 
 template <typename T>
-inline FTBBox FTSimpleLayoutImpl::BBoxI(const T* string, const int len,
-                                        FTPoint position)
+inline const FTLayoutResult& FTSimpleLayoutImpl::LayoutI(const T *string,
+                                                        const int len)
 {
-    FTBBox tmp;
+    Update(string, len);
 
-    WrapText(string, len, position, 0, &tmp);
+    if(!resultValid)
+    {
+        BuildResult();
+    }
 
-    return tmp;
+    return result;
+}
+
+
+const FTLayoutResult& FTSimpleLayoutImpl::Layout(const char *string,
+                                                 const int len)
+{
+    return LayoutI(string, len);
+}
+
+
+const FTLayoutResult& FTSimpleLayoutImpl::Layout(const wchar_t *string,
+                                                 const int len)
+{
+    return LayoutI(string, len);
+}
+
+
+template <typename T>
+inline FTBBox FTSimpleLayoutImpl::BBoxI(const T* string, const int len,
+                                        FTPoint position)
+{
+    return Layout(string, len).BBox(position);
 }
 
 
@@ -171,8 +301,7 @@ template <typename T>
 inline void FTSimpleLayoutImpl::RenderI(const T *string, const int len,
                                         FTPoint position, int renderMode)
 {
-    pen = FTPoint(0.0f, 0.0f);
-    WrapText(string, len, position, renderMode, NULL);
+    Layout(string, len).Render(position, renderMode);
 }
 
 
@@ -190,274 +319,1123 @@ void FTSimpleLayoutImpl::Render(const wchar_t* string, const int len,
 }
 
 
+int FTSimpleLayoutImpl::LineCount(const char *string, const int len)
+{
+    return Layout(string, len).LineCount();
+}
+
+
+int FTSimpleLayoutImpl::LineCount(const wchar_t *string, const int len)
+{
+    return Layout(string, len).LineCount();
+}
+
+
+int FTSimpleLayoutImpl::LineStart(const char *string, const int len,
+                                  const int line)
+{
+    return Layout(string, len).LineStart(line);
+}
+
+
+int FTSimpleLayoutImpl::LineStart(const wchar_t *string, const int len,
+                                  const int line)
+{
+    return Layout(string, len).LineStart(line);
+}
+
+
+FTPoint FTSimpleLayoutImpl::CharPosition(const char *string, const int len,
+                                         const int index, FTPoint position)
+{
+    return position + Layout(string, len).CharPosition(index);
+}
+
+
+FTPoint FTSimpleLayoutImpl::CharPosition(const wchar_t *string,
+                                         const int len, const int index,
+                                         FTPoint position)
+{
+    return position + Layout(string, len).CharPosition(index);
+}
+
+
+int FTSimpleLayoutImpl::CharIndex(const char *string, const int len,
+                                  FTPoint point, FTPoint position)
+{
+    return Layout(string, len).CharIndex(point - position);
+}
+
+
+int FTSimpleLayoutImpl::CharIndex(const wchar_t *string, const int len,
+                                  FTPoint point, FTPoint position)
+{
+    return Layout(string, len).CharIndex(point - position);
+}
+
+
+/* Move count items of a vector from one index to another, and resize the
+ * vector so that it ends right after them. */
 template <typename T>
-inline void FTSimpleLayoutImpl::WrapTextI(const T *buf, const int len,
-                                          FTPoint position, int renderMode,
-                                          FTBBox *bounds)
+static void MoveTail(FTVector<T>& v, const int from, const int to,
+                     const int count)
 {
-    FTUnicodeStringItr<T> breakItr(buf);          // points to the last break character
-    FTUnicodeStringItr<T> lineStart(buf);         // points to the line start
-    float nextStart = 0.0;     // total width of the current line
-    float breakWidth = 0.0;    // width of the line up to the last word break
-    float currentWidth = 0.0;  // width of all characters on the current line
-    float prevWidth;           // width of all characters but the current glyph
-    float wordLength = 0.0;    // length of the block since the last break char
-    int charCount = 0;         // number of characters so far on the line
-    int breakCharCount = 0;    // number of characters before the breakItr
-    float glyphWidth, advance;
-    FTBBox glyphBounds;
+    if(to > from)
+    {
+        v.resize(to + count, T());
+
+        for(int i = count - 1; i >= 0; i--)
+        {
+            v[to + i] = v[from + i];
+        }
+    }
+    else
+    {
+        for(int i = 0; i < count; i++)
+        {
+            v[to + i] = v[from + i];
+        }
+
+        v.resize(to + count, T());
+    }
+}
 
-    // Reset the pen position
-    pen.Y(0);
 
-    // If we have bounds mark them invalid
-    if(bounds)
+template <typename T>
+void FTSimpleLayoutImpl::UpdateI(const T *string, const int len)
+{
+    // Throw the cache away if anything the line breaks depend on changed
+    if(!currentFont || currentFont != cachedFont
+        || currentFont->FaceSize() != cachedSize
+        || currentFont->impl->Revision() != cachedRevision
+        || !linesValid
+        || (int)sizeof(T) != cachedCharSize
+        || breakMode != cachedBreakMode)
+    {
+        text.resize(0, 0);
+        lines.resize(0, LayoutLine());
+
+        cachedFont = currentFont;
+        cachedSize = currentFont ? currentFont->FaceSize() : 0;
+        cachedRevision = currentFont ? currentFont->impl->Revision() : 0;
+        cachedCharSize = (int)sizeof(T);
+        cachedBreakMode = breakMode;
+        linesValid = true;
+        resultValid = false;
+
+        if(!currentFont)
+        {
+            return;
+        }
+    }
+
+    // Decode the string
+    newText.resize(0, 0);
+    newOffsets.resize(0, 0);
+
+    FTUnicodeStringItr<T> itr(string);
+    for(int i = 0; (len < 0 && *itr) || (len >= 0 && i < len); i++, ++itr)
+    {
+        newText.push_back(*itr);
+        newOffsets.push_back((int)(itr.getBufferFromHere() - string));
+    }
+    newOffsets.push_back((int)(itr.getBufferFromHere() - string));
+
+    int oldSize = (int)text.size();
+    int newSize = (int)newText.size();
+
+    // Find the text shared with the previous layout at both ends
+    int prefix = 0;
+    while(prefix < oldSize && prefix < newSize
+           && text[prefix] == newText[prefix])
+    {
+        prefix++;
+    }
+
+    if(lines.size() && prefix == oldSize && prefix == newSize)
+    {
+        return;
+    }
+
+    resultValid = false;
+
+    int suffix = 0;
+    while(suffix < oldSize - prefix && suffix < newSize - prefix
+           && text[oldSize - 1 - suffix] == newText[newSize - 1 - suffix])
+    {
+        suffix++;
+    }
+
+    // Lines always start over after a newline, so everything before the
+    // paragraph holding the first change stays as it is...
+    int first = prefix;
+    while(first > 0 && newText[first - 1] != '\n')
+    {
+        first--;
+    }
+
+    // ...and so does every paragraph that is entirely unchanged at the end.
+    int delta = newSize - oldSize;
+    int last = newSize - suffix + 1;
+    while(last <= newSize && newText[last - 1] != '\n')
+    {
+        last++;
+    }
+
+    int firstLine = lines.size() ? LineOf(first) : 0;
+    int tailLine = (int)lines.size();
+    bool reuse = false;
+
+    if(suffix && last <= newSize)
     {
-        bounds->Invalidate();
+        tailLine = LineOf(last - delta);
+        reuse = (lines[tailLine].start == last - delta);
     }
 
-    // Scan the input for all characters that need output
-    FTUnicodeStringItr<T> prevItr(buf);
-    for (FTUnicodeStringItr<T> itr(buf); *itr; prevItr = itr++, charCount++)
+    if(!reuse)
     {
-        // Find the width of the current glyph
-        glyphBounds = currentFont->BBox(itr.getBufferFromHere(), 1);
-        glyphWidth = glyphBounds.Upper().Xf() - glyphBounds.Lower().Xf();
+        last = newSize;
+        tailLine = (int)lines.size();
+    }
+
+    text.swap(newText);
+    offsets.swap(newOffsets);
+
+    // Measure the changed characters
+    MoveTail(advances, last - delta, last, newSize - last);
+    MoveTail(bounds, last - delta, last, newSize - last);
+    MoveTail(breaks, last - delta, last, newSize - last);
+    MoveTail(levels, last - delta, last, newSize - last);
+
+    if(last > first)
+    {
+        currentFont->impl->Metrics(&text[first], last - first,
+                                   last < newSize ? text[last] : 0,
+                                   &advances[first], &bounds[first]);
+
+        // The range starts and ends on paragraph boundaries, so its break
+        // opportunities do not depend on the rest of the text
+        FTLineBreak::Find(&text[first], last - first, &breaks[first]);
+
+        // Likewise for the embedding levels, which are all zero unless
+        // there is right to left text
+        if(FTBidi::IsMixed(&text[first], last - first))
+        {
+            FTBidi::Resolve(&text[first], last - first, &levels[first]);
+        }
+        else
+        {
+            for(int i = first; i < last; i++)
+            {
+                levels[i] = 0;
+            }
+        }
+
+        // With a shaper, the characters are measured by the glyphs they
+        // are shaped into, one run of a single direction at a time
+        if(currentFont->Shaper())
+        {
+            for(int start = first; start < last; )
+            {
+                if(FTBidi::Classify(text[start]) == FTBidi::B)
+                {
+                    start++;
+                    continue;
+                }
+
+                int rtl = levels[start] & 1;
+                int end = start + 1;
+
+                while(end < last && (levels[end] & 1) == rtl
+                       && FTBidi::Classify(text[end]) != FTBidi::B)
+                {
+                    end++;
+                }
+
+                MeasureShaped(start, end - start, rtl != 0);
+                start = end;
+            }
+        }
+    }
+
+    // Wrap them and put the new lines in place of the old ones
+    FTVector<LayoutLine> wrapped;
+    Wrap(first, last, !reuse, wrapped);
+
+    int count = (int)wrapped.size();
+    int tail = (int)lines.size() - tailLine;
+
+    MoveTail(lines, tailLine, firstLine + count, tail);
+
+    for(int i = 0; i < tail; i++)
+    {
+        lines[firstLine + count + i].start += delta;
+        lines[firstLine + count + i].end += delta;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        LayoutLine& line = wrapped[i];
+        int visible = line.end - line.start;
+
+        // Each paragraph gets its direction from its first strong character
+        if(i && FTBidi::Classify(text[line.start - 1]) != FTBidi::B)
+        {
+            line.level = wrapped[i - 1].level;
+        }
+        else
+        {
+            line.level = FTBidi::ParagraphLevel(&text[line.start],
+                                                last - line.start);
+        }
+
+        // Leave out the whitespace a line was wrapped at
+        if(visible > 0 && line.end < newSize && iswspace(text[line.end - 1]))
+        {
+            visible--;
+        }
+
+        // Gather the bounds of the glyphs along the line
+        if(visible > 0)
+        {
+            float x = 0.0f;
+
+            line.bbox = bounds[line.start];
+
+            for(int n = line.start + 1; n < line.start + visible; n++)
+            {
+                x += advances[n - 1];
+
+                FTBBoxf glyphBounds = bounds[n];
+                glyphBounds += FTPointf(x, 0.0f);
+                line.bbox |= glyphBounds;
+            }
+        }
+
+        lines[firstLine + i] = line;
+    }
+}
+
+
+void FTSimpleLayoutImpl::MeasureShaped(const int start, const int count,
+                                       const bool rightToLeft)
+{
+    shapedGlyphs.resize(0, FTShapedGlyph());
+
+    if(!currentFont->impl->ShapeGlyphs(&text[start], count, rightToLeft,
+                                       shapedGlyphs))
+    {
+        return;
+    }
+
+    for(int n = start; n < start + count; n++)
+    {
+        advances[n] = 0.0f;
+        bounds[n] = FTBBoxf();
+    }
+
+    // Measure the glyphs of each cluster from the pen position of the
+    // cluster
+    int glyphCount = (int)shapedGlyphs.size();
+
+    for(int i = 0; i < glyphCount; )
+    {
+        unsigned int cluster = shapedGlyphs[i].cluster;
+        float x = 0.0f;
+
+        glyphIndices.resize(0, 0);
+        glyphPens.resize(0, FTPoint());
+
+        for(; i < glyphCount && shapedGlyphs[i].cluster == cluster; i++)
+        {
+            glyphIndices.push_back(shapedGlyphs[i].index);
+            glyphPens.push_back(FTPoint(x, 0.0) + shapedGlyphs[i].offset);
+            x += shapedGlyphs[i].advance.Xf();
+        }
+
+        if(cluster < (unsigned int)count)
+        {
+            advances[start + cluster] += x;
+            bounds[start + cluster] =
+                FTBBoxf(currentFont->BBoxGlyphs(&glyphIndices[0],
+                                                &glyphPens[0],
+                                                glyphIndices.size()));
+        }
+    }
+}
+
+
+bool FTSimpleLayoutImpl::ShapeLine(const LayoutLine& line, const int *order,
+                                   FTVector<FTShapedGlyph>& glyphs)
+{
+    int length = line.end - line.start;
+
+    for(int v = 0; v < length; )
+    {
+        int rtl = levels[line.start + order[v]] & 1;
+        int step = rtl ? -1 : 1;
+        int w = v + 1;
+
+        while(w < length && order[w] == order[w - 1] + step
+               && (levels[line.start + order[w]] & 1) == rtl)
+        {
+            w++;
+        }
+
+        int start = line.start + (rtl ? order[w - 1] : order[v]);
+        int first = (int)glyphs.size();
+
+        if(!currentFont->impl->ShapeGlyphs(&text[start], w - v, rtl != 0,
+                                           glyphs))
+        {
+            return false;
+        }
+
+        for(int i = first; i < (int)glyphs.size(); i++)
+        {
+            glyphs[i].cluster += start;
+        }
+
+        v = w;
+    }
+
+    return true;
+}
+
+
+void FTSimpleLayoutImpl::Update(const char *string, const int len)
+{
+    UpdateI(string, len);
+}
+
+
+void FTSimpleLayoutImpl::Update(const wchar_t *string, const int len)
+{
+    UpdateI(string, len);
+}
+
+
+void FTSimpleLayoutImpl::Wrap(const int first, const int last,
+                              const bool final,
+                              FTVector<LayoutLine>& wrapped) const
+{
+    if(breakMode != FTGL::BREAK_OPTIMAL)
+    {
+        WrapGreedy(first, last, final, wrapped);
+        return;
+    }
+
+    // Optimal breaking works on one paragraph at a time
+    int paragraph = first;
+
+    for(int i = first; i < last; i++)
+    {
+        if(breaks[i] == FTLineBreak::MANDATORY)
+        {
+            WrapOptimal(paragraph, i, wrapped);
+            paragraph = i + 1;
+        }
+    }
+
+    if(final)
+    {
+        WrapOptimal(paragraph, last, wrapped);
+    }
+}
+
+
+void FTSimpleLayoutImpl::WrapGreedy(const int first, const int last,
+                                    const bool final,
+                                    FTVector<LayoutLine>& wrapped) const
+{
+    int lineStart = first;     // index of the first character of the line
+    int breakIndex = first;    // index of the last break opportunity
+    float nextStart = 0.0;     // total width of the current line
+    float breakWidth = 0.0;    // width of the line up to the last break
+    float blockWidth = 0.0;    // width of the line up to the last space block
+    float currentWidth = 0.0;  // width of all characters on the current line
+    float prevWidth = 0.0;     // width of all characters but the current glyph
+    float wordLength = 0.0;    // length of the block since the last break
+
+    for(int i = first; i < last; i++)
+    {
+        unsigned int c = text[i];
+        float advance = advances[i];
+        float glyphWidth = bounds[i].Upper().Xf() - bounds[i].Lower().Xf();
+        bool forced = (breaks[i] == FTLineBreak::MANDATORY);
+
+        // See if the line may be broken before this character
+        if(i > lineStart && breaks[i - 1] == FTLineBreak::ALLOWED)
+        {
+            breakIndex = i;
+            // Whitespace at the end of a line does not count towards its
+            // width
+            breakWidth = iswspace(text[i - 1]) ? blockWidth : currentWidth;
+            wordLength = 0;
+        }
 
-        advance = currentFont->Advance(itr.getBufferFromHere(), 1);
         prevWidth = currentWidth;
-        // Compute the width of all glyphs up to the end of buf[i]
+        // Compute the width of all glyphs up to the end of this one
         currentWidth = nextStart + glyphWidth;
         // Compute the position of the next glyph
         nextStart += advance;
 
-        // See if the current character is a space, a break or a regular character
-        if((currentWidth > lineLength) || (*itr == '\n'))
+        // Whitespace may hang past the end of the line
+        if((currentWidth > lineLength && i > lineStart && !iswspace(c))
+            || forced)
         {
             // A non whitespace character has exceeded the line length.  Or a
-            // newline character has forced a line break.  Output the last
-            // line and start a new line after the break character.
+            // hard line break character has forced a line break.  Output the
+            // last line and start a new line after the break.
+            LayoutLine line;
+            line.start = lineStart;
+
             // If we have not yet found a break, break on the last character
-            if(breakItr == lineStart || (*itr == '\n'))
+            if(breakIndex == lineStart || forced)
             {
-                // Break on the previous character
-                breakItr = prevItr;
-                breakCharCount = charCount - 1;
-                breakWidth = prevWidth;
+                line.end = i;
+                line.width = prevWidth;
                 // None of the previous words will be carried to the next line
                 wordLength = 0;
-                // If the current character is a newline discard its advance
-                if(*itr == '\n') advance = 0;
+            }
+            else
+            {
+                line.end = breakIndex;
+                line.width = breakWidth;
             }
 
-            float remainingWidth = lineLength - breakWidth;
+            wrapped.push_back(line);
 
-            // Render the current substring
-            FTUnicodeStringItr<T> breakChar = breakItr;
-            // move past the break character and don't count it on the next line either
-            ++breakChar; --charCount;
-            // If the break character is a newline do not render it
-            if(*breakChar == '\n')
+            if(forced)
+            {
+                // Do not carry the line break over to the next line
+                lineStart = i + 1;
+                nextStart = currentWidth = 0;
+            }
+            else
             {
-                ++breakChar; --charCount;
+                // The current width is the width since the last break
+                lineStart = line.end;
+                nextStart = wordLength + advance;
+                currentWidth = wordLength + glyphWidth;
+                wordLength += advance;
             }
 
-            OutputWrapped(lineStart.getBufferFromHere(), breakCharCount,
-                          //breakItr.getBufferFromHere() - lineStart.getBufferFromHere(),
-                          position, renderMode, remainingWidth, bounds);
+            // Reset the safe break for the next line
+            breakIndex = lineStart;
+        }
+        else
+        {
+            // Record the width of the line at the start of a whitespace block
+            if(iswspace(c) && (i == lineStart || !iswspace(text[i - 1])))
+            {
+                blockWidth = currentWidth;
+            }
 
-            // Store the start of the next line
-            lineStart = breakChar;
-            // TODO: Is Height() the right value here?
-            pen -= FTPoint(0, currentFont->LineHeight() * lineSpacing);
-            // The current width is the width since the last break
-            nextStart = wordLength + advance;
             wordLength += advance;
-            currentWidth = wordLength + advance;
-            // Reset the safe break for the next line
-            breakItr = lineStart;
-            charCount -= breakCharCount;
         }
-        else if(iswspace(*itr))
+    }
+
+    // Output any remaining text as the last line
+    if(final)
+    {
+        LayoutLine line;
+        line.start = lineStart;
+        line.end = last;
+        line.width = currentWidth;
+        wrapped.push_back(line);
+    }
+}
+
+
+/* Constants of the optimal line breaking mode, with the values TeX uses.
+ * Badness measures how much a line has to be stretched, and demerits
+ * combine the badness of all the lines of a paragraph. */
+static const double LINE_PENALTY = 10.0;
+static const double ADJACENT_DEMERITS = 10000.0;
+static const double MAX_BADNESS = 10000.0;
+
+/* The space blocks of a justified line may stretch by this much of their
+ * natural width before the line counts as very loose. */
+static const float SPACE_STRETCH = 0.5f;
+
+/* Upper bound on the number of breaks considered at once, so that very
+ * long lines made of many short words stay fast to wrap. The worst ones
+ * are dropped first. */
+static const unsigned int MAX_ACTIVE_NODES = 128;
+
+
+void FTSimpleLayoutImpl::WrapOptimal(const int first, const int last,
+                                     FTVector<LayoutLine>& wrapped) const
+{
+    FTVector<BreakNode> nodes;
+    FTVector<int> active;
+
+    BreakNode start = { first, -1, 0, 0.0f, 0.0f, 0.0f, 0.0 };
+    nodes.push_back(start);
+    active.push_back(0);
+
+    float advance = 0.0f;       // advance from the paragraph start to i
+    float stretch = 0.0f;       // stretchability of the blocks before i
+    float blockAdvance = 0.0f;  // advance up to the current space block
+    int blockStart = -1;        // first character of the current space block
+    int bestNode = -1;          // the node ending the paragraph
+
+    for(int i = first; i <= last; i++)
+    {
+        bool end = (i == last);
+
+        if(!end && iswspace(text[i]))
         {
-            // This is the last word break position
-            wordLength = 0;
-            breakItr = itr;
-            breakCharCount = charCount;
+            if(blockStart < 0)
+            {
+                blockStart = i;
+                blockAdvance = advance;
+            }
+
+            advance += advances[i];
+            continue;
+        }
 
-            // Check to see if this is the first whitespace character in a run
-            if(buf == itr.getBufferFromHere() || !iswspace(*prevItr))
+        // A line broken here ends before the space block, if any
+        int lineEnd = (end || blockStart < 0) ? i : blockStart;
+        float endAdvance = (end || blockStart < 0) ? advance : blockAdvance;
+        float endStretch = stretch;
+
+        if(blockStart >= 0)
+        {
+            stretch += (advance - blockAdvance) * SPACE_STRETCH;
+            blockStart = -1;
+        }
+
+        // Lines can only be broken at break opportunities, and must be
+        // broken at the end of the paragraph
+        if(end || (i > first && breaks[i - 1] == FTLineBreak::ALLOWED))
+        {
+            int candidates[3] = { -1, -1, -1 };
+            BreakNode best[3];
+            unsigned int kept = 0;
+
+            for(unsigned int n = 0; n < active.size(); n++)
+            {
+                const BreakNode& node = nodes[active[n]];
+
+                if(lineEnd <= node.position)
+                {
+                    active[kept++] = active[n];
+                    continue;
+                }
+
+                float width = endAdvance - node.advance - advances[lineEnd - 1]
+                               + bounds[lineEnd - 1].Upper().Xf()
+                               - bounds[lineEnd - 1].Lower().Xf();
+
+                // Lines never shrink, and only get longer from here on, so
+                // the node can be forgotten
+                if(width > lineLength)
+                {
+                    continue;
+                }
+
+                active[kept++] = active[n];
+
+                double badness = 0.0;
+                int fitness = 0;
+
+                // The last line is not stretched
+                if(!end)
+                {
+                    float lineStretch = endStretch - node.stretch;
+                    double ratio = lineStretch > 0.0f
+                                    ? (lineLength - width) / lineStretch
+                                    : (width < lineLength ? MAX_BADNESS : 0.0);
+
+                    badness = 100.0 * ratio * ratio * ratio;
+                    if(badness > MAX_BADNESS)
+                    {
+                        badness = MAX_BADNESS;
+                    }
+
+                    fitness = ratio > 1.0 ? 2 : (ratio > 0.5 ? 1 : 0);
+                }
+
+                double demerits = (LINE_PENALTY + badness)
+                                   * (LINE_PENALTY + badness);
+
+                // Avoid a very loose line next to a decent one
+                if(fitness - node.fitness > 1 || node.fitness - fitness > 1)
+                {
+                    demerits += ADJACENT_DEMERITS;
+                }
+
+                demerits += node.demerits;
+
+                if(candidates[fitness] < 0
+                    || demerits < best[fitness].demerits)
+                {
+                    candidates[fitness] = active[n];
+                    best[fitness].position = i;
+                    best[fitness].previous = active[n];
+                    best[fitness].fitness = fitness;
+                    best[fitness].width = width;
+                    best[fitness].advance = advance;
+                    best[fitness].demerits = demerits;
+                }
+            }
+
+            active.resize(kept, 0);
+
+            // Keep the best break of each fitness class
+            for(int f = 0; f < 3; f++)
             {
-                // Record the width of the start of the block
-                breakWidth = currentWidth;
+                if(candidates[f] < 0)
+                {
+                    continue;
+                }
+
+                best[f].stretch = stretch;
+                nodes.push_back(best[f]);
+
+                if(end)
+                {
+                    if(bestNode < 0 || best[f].demerits
+                                        < nodes[bestNode].demerits)
+                    {
+                        bestNode = (int)nodes.size() - 1;
+                    }
+                }
+                else
+                {
+                    active.push_back((int)nodes.size() - 1);
+                }
+            }
+
+            while(active.size() > MAX_ACTIVE_NODES)
+            {
+                unsigned int worst = 0;
+
+                for(unsigned int n = 1; n < active.size(); n++)
+                {
+                    if(nodes[active[n]].demerits > nodes[active[worst]].demerits)
+                    {
+                        worst = n;
+                    }
+                }
+
+                active[worst] = active[active.size() - 1];
+                active.resize(active.size() - 1, 0);
+            }
+
+            // A word is too long to fit on any line
+            if(!active.size() && !end)
+            {
+                break;
             }
         }
-        else
+
+        if(!end)
         {
-            wordLength += advance;
+            advance += advances[i];
         }
     }
 
-    float remainingWidth = lineLength - currentWidth;
-    // Render any remaining text on the last line
-    // Disable justification for the last row
-    if(alignment == FTGL::ALIGN_JUSTIFY)
+    if(bestNode < 0)
     {
-        alignment = FTGL::ALIGN_LEFT;
-        OutputWrapped(lineStart.getBufferFromHere(), -1, position, renderMode,
-                      remainingWidth, bounds);
-        alignment = FTGL::ALIGN_JUSTIFY;
+        WrapGreedy(first, last, true, wrapped);
+        return;
     }
-    else
+
+    // Walk back along the best path, then output its lines in order
+    FTVector<int> path;
+    for(int n = bestNode; nodes[n].previous >= 0; n = nodes[n].previous)
     {
-        OutputWrapped(lineStart.getBufferFromHere(), -1, position, renderMode,
-                      remainingWidth, bounds);
+        path.push_back(n);
     }
-}
 
+    for(int n = (int)path.size() - 1; n >= 0; n--)
+    {
+        const BreakNode& node = nodes[path[n]];
 
-void FTSimpleLayoutImpl::WrapText(const char *buf, const int len,
-                                  FTPoint position, int renderMode,
-                                  FTBBox *bounds)
-{
-    WrapTextI(buf, len, position, renderMode, bounds);
+        LayoutLine line;
+        line.start = nodes[node.previous].position;
+        line.end = node.position;
+        line.width = node.width;
+        wrapped.push_back(line);
+    }
 }
 
 
-void FTSimpleLayoutImpl::WrapText(const wchar_t* buf, const int len,
-                                  FTPoint position, int renderMode,
-                                  FTBBox *bounds)
+int FTSimpleLayoutImpl::LineOf(const int index) const
 {
-    WrapTextI(buf, len, position, renderMode, bounds);
+    int low = 0, high = (int)lines.size() - 1;
+
+    while(low < high)
+    {
+        int middle = (low + high + 1) / 2;
+
+        if(lines[middle].start <= index)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return low;
 }
 
 
-template <typename T>
-inline void FTSimpleLayoutImpl::OutputWrappedI(const T *buf, const int len,
-                                               FTPoint position, int renderMode,
-                                               const float remaining,
-                                               FTBBox *bounds)
+FTPoint FTSimpleLayoutImpl::LinePosition(const int line,
+                                         float& distributeWidth) const
 {
-    float distributeWidth = 0.0;
+    float remaining = lineLength - lines[line].width;
+    float x = 0.0f;
+
+    distributeWidth = 0.0f;
+
     // Align the text according as specified by Alignment
     switch (alignment)
     {
         case FTGL::ALIGN_LEFT:
-            pen.X(0);
             break;
         case FTGL::ALIGN_CENTER:
-            pen.X(remaining / 2);
+            x = remaining / 2;
             break;
         case FTGL::ALIGN_RIGHT:
-            pen.X(remaining);
+            x = remaining;
             break;
         case FTGL::ALIGN_JUSTIFY:
-            pen.X(0);
-            distributeWidth = remaining;
+            // Disable justification for the last row
+            if(line + 1 < (int)lines.size())
+            {
+                distributeWidth = remaining;
+            }
             break;
     }
 
-    // If we have bounds expand them by the line's bounds, otherwise render
-    // the line.
-    if(bounds)
+    // TODO: Is Height() the right value here?
+    return FTPoint(x, -line * currentFont->LineHeight() * lineSpacing);
+}
+
+
+float FTSimpleLayoutImpl::BlockSpace(const int line,
+                                     const float distributeWidth) const
+{
+    if(distributeWidth <= 0.0f)
     {
-        FTBBox temp = currentFont->BBox(buf, len);
+        return 0.0f;
+    }
 
-        // Add the extra space to the upper x dimension
-        temp = FTBBox(temp.Lower() + pen,
-                      temp.Upper() + pen + FTPoint(distributeWidth, 0));
+    // Count the space blocks the extra space is shared between
+    int numSpaces = 0;
 
-        // See if this is the first area to be added to the bounds
-        if(bounds->IsValid())
-        {
-            *bounds |= temp;
-        }
-        else
+    for(int i = lines[line].start + 1; i < lines[line].end; i++)
+    {
+        if(!iswspace(text[i]) && iswspace(text[i - 1]))
         {
-            *bounds = temp;
+            numSpaces++;
         }
     }
-    else
-    {
-        RenderSpace(buf, len, position, renderMode, distributeWidth);
-    }
+
+    return numSpaces ? distributeWidth / numSpaces : 0.0f;
 }
 
 
-void FTSimpleLayoutImpl::OutputWrapped(const char *buf, const int len,
-                                       FTPoint position, int renderMode,
-                                       const float remaining, FTBBox *bounds)
+
+void FTSimpleLayoutImpl::BuildResult()
 {
-    OutputWrappedI(buf, len, position, renderMode, remaining, bounds);
-}
+    resultValid = true;
 
+    if(!currentFont)
+    {
+        result = FTLayoutResult();
+        return;
+    }
 
-void FTSimpleLayoutImpl::OutputWrapped(const wchar_t *buf, const int len,
-                                       FTPoint position, int renderMode,
-                                       const float remaining, FTBBox *bounds)
-{
-    OutputWrappedI(buf, len, position, renderMode, remaining, bounds);
-}
+    // Build a new result rather than touching the current one, which may
+    // still be held by the application
+    FTLayoutResultImpl *data = new FTLayoutResultImpl();
+    result = FTLayoutResult(data);
 
+    int count = (int)text.size();
 
-template <typename T>
-inline void FTSimpleLayoutImpl::RenderSpaceI(const T *string, const int len,
-                                             FTPoint position, int renderMode,
-                                             const float extraSpace)
-{
-    (void)position;
+    data->font = currentFont;
+    data->lineStep = currentFont->LineHeight() * lineSpacing;
+    data->advances = advances;
+
+    // Put the characters of lines holding right to left text in display
+    // order, measuring them again as the kerning pairs change. With a
+    // shaper, every line is shaped and measured by its glyphs instead.
+    data->logical.resize(count + 1, 0);
+
+    for(int i = 0; i <= count; i++)
+    {
+        data->logical[i] = i;
+    }
 
-    float space = 0.0;
+    bool shaping = currentFont->Shaper() != NULL;
 
-    // If there is space to distribute, count the number of spaces
-    if(extraSpace > 0.0)
+    FTVector<FTBBoxf> lineBounds;
+    FTVector<bool> shapedLines;
+    FTVector<FTShapedGlyph> glyphs;
+    FTVector<int> order;
+    FTVector<unsigned int> visual;
+    FTVector<float> visualAdvances;
+    FTVector<FTBBoxf> visualBounds;
+
+    lineBounds.resize(lines.size(), FTBBoxf());
+    shapedLines.resize(lines.size(), false);
+
+    for(unsigned int l = 0; l < lines.size(); l++)
     {
-        int numSpaces = 0;
+        const LayoutLine& line = lines[l];
+        int length = line.end - line.start;
+        bool mixed = (line.level & 1) != 0;
+
+        lineBounds[l] = line.bbox;
+
+        for(int n = line.start; n < line.end && !mixed; n++)
+        {
+            mixed = (levels[n] & 1) != 0;
+        }
+
+        if((!mixed && !shaping) || !length)
+        {
+            continue;
+        }
+
+        order.resize(length, 0);
+
+        if(mixed)
+        {
+            FTBidi::Reorder(&text[line.start], &levels[line.start], length,
+                            line.level, &order[0]);
+        }
+        else
+        {
+            for(int v = 0; v < length; v++)
+            {
+                order[v] = v;
+            }
+        }
+
+        for(int v = 0; v < length; v++)
+        {
+            data->logical[line.start + v] = line.start + order[v];
+        }
+
+        // The whitespace the line was wrapped at is left out of its bounds
+        int wrapped = (line.end < count && iswspace(text[line.end - 1]))
+                       ? line.end - 1 : -1;
+
+        int firstGlyph = (int)glyphs.size();
+
+        if(shaping && ShapeLine(line, &order[0], glyphs))
+        {
+            // Measure the line by its glyphs: the advance of each cluster
+            // goes to its first character
+            glyphIndices.resize(0, 0);
+            glyphPens.resize(0, FTPoint());
+            float x = 0.0f;
+
+            for(int n = line.start; n < line.end; n++)
+            {
+                data->advances[n] = 0.0f;
+            }
+
+            for(int i = firstGlyph; i < (int)glyphs.size(); i++)
+            {
+                const FTShapedGlyph& glyph = glyphs[i];
+
+                if((int)glyph.cluster != wrapped)
+                {
+                    glyphIndices.push_back(glyph.index);
+                    glyphPens.push_back(FTPoint(x, 0.0) + glyph.offset);
+                }
+
+                data->advances[glyph.cluster] += glyph.advance.Xf();
+                x += glyph.advance.Xf();
+            }
+
+            if(glyphIndices.size())
+            {
+                lineBounds[l] =
+                    FTBBoxf(currentFont->BBoxGlyphs(&glyphIndices[0],
+                                                    &glyphPens[0],
+                                                    glyphIndices.size()));
+            }
+
+            shapedLines[l] = true;
+            continue;
+        }
+
+        glyphs.resize(firstGlyph, FTShapedGlyph());
+
+        if(!mixed)
+        {
+            continue;
+        }
+
+        visual.resize(length, 0);
+        visualAdvances.resize(length, 0.0f);
+        visualBounds.resize(length, FTBBoxf());
 
-        // Count the number of space blocks in the input
-        FTUnicodeStringItr<T> prevItr(string), itr(string);
-        for(int i = 0; ((len < 0) && *itr) || ((len >= 0) && (i <= len));
-            ++i, prevItr = itr++)
+        for(int v = 0; v < length; v++)
         {
-            // If this is the end of a space block, increment the counter
-            if((i > 0) && !iswspace(*itr) && iswspace(*prevItr))
+            int n = line.start + order[v];
+            visual[v] = (levels[n] & 1) ? FTBidi::Mirror(text[n]) : text[n];
+        }
+
+        currentFont->impl->Metrics(&visual[0], length, 0,
+                                   &visualAdvances[0], &visualBounds[0]);
+
+        // Gather the bounds of the glyphs along the line
+        bool empty = true;
+        float x = 0.0f;
+
+        for(int v = 0; v < length; v++)
+        {
+            int n = line.start + order[v];
+
+            data->advances[n] = visualAdvances[v];
+
+            if(n != wrapped)
             {
-                numSpaces++;
+                FTBBoxf glyphBounds = visualBounds[v];
+                glyphBounds += FTPointf(x, 0.0f);
+
+                if(empty)
+                {
+                    lineBounds[l] = glyphBounds;
+                    empty = false;
+                }
+                else
+                {
+                    lineBounds[l] |= glyphBounds;
+                }
             }
+
+            x += visualAdvances[v];
         }
+    }
 
-        space = extraSpace/numSpaces;
+    // Keep a copy of the string in the native wide encoding, so that the
+    // result does not depend on the caller's buffer
+    data->offsets.reserve(count + 1);
+    data->text.reserve(count + 1);
+
+    for(int i = 0; i < count; i++)
+    {
+        int n = data->logical[i];
+        unsigned int c = (levels[n] & 1) ? FTBidi::Mirror(text[n]) : text[n];
+
+        data->offsets.push_back((int)data->text.size());
+
+        if(sizeof(wchar_t) == 2 && c >= 0x10000)
+        {
+            c -= 0x10000;
+            data->text.push_back((wchar_t)(0xd800 + (c >> 10)));
+            data->text.push_back((wchar_t)(0xdc00 + (c & 0x3ff)));
+        }
+        else
+        {
+            data->text.push_back((wchar_t)c);
+        }
     }
 
-    // Output all characters of the string
-    FTUnicodeStringItr<T> prevItr(string), itr(string);
-    for(int i = 0; ((len < 0) && *itr) || ((len >= 0) && (i <= len));
-        ++i, prevItr = itr++)
+    data->offsets.push_back((int)data->text.size());
+    data->text.push_back(0);
+
+    data->positions.resize(count + 1, FTPointf());
+
+    for(unsigned int l = 0; l < lines.size(); l++)
     {
-        // If this is the end of a space block, distribute the extra space
-        // inside it
-        if((i > 0) && !iswspace(*itr) && iswspace(*prevItr))
+        const LayoutLine& line = lines[l];
+        int next = l + 1 < lines.size() ? lines[l + 1].start : count + 1;
+
+        float distributeWidth;
+        FTPoint origin = LinePosition(l, distributeWidth);
+        float space = BlockSpace(l, distributeWidth);
+        float x = 0.0f;
+        int runStart = line.start;
+
+        // Position every character up to the start of the next line, from
+        // left to right, adding the extra space of justified lines after
+        // each space block
+        for(int v = line.start; v < next; v++)
         {
-            pen += FTPoint(space, 0);
+            int n = data->logical[v];
+
+            if(v > line.start && v < line.end && space > 0.0f
+                && !iswspace(text[n]) && iswspace(text[data->logical[v - 1]]))
+            {
+                FTLayoutResultImpl::Run run = { runStart, v };
+                if(!shapedLines[l])
+                {
+                    data->runs.push_back(run);
+                }
+
+                runStart = v;
+                x += space;
+            }
+
+            data->positions[n] = FTPointf(origin) + FTPointf(x, 0.0f);
+
+            if(n < count)
+            {
+                x += data->advances[n];
+            }
+        }
+
+        if(line.end > runStart && !shapedLines[l])
+        {
+            FTLayoutResultImpl::Run run = { runStart, line.end };
+            data->runs.push_back(run);
         }
 
-        pen = currentFont->Render(itr.getBufferFromHere(), 1, pen, FTPoint(), renderMode);
+        // Add the extra space to the upper x dimension
+        FTLayoutResultImpl::Line resultLine;
+        resultLine.start = line.start;
+        resultLine.end = line.end;
+        resultLine.pen = origin;
+        resultLine.bbox = FTBBox(origin + lineBounds[l].Lower(),
+                                 origin + lineBounds[l].Upper()
+                                  + FTPoint(distributeWidth, 0));
+        data->lines.push_back(resultLine);
+
+        // See if this is the first area to be added to the bounds
+        if(l == 0)
+        {
+            data->bbox = resultLine.bbox;
+        }
+        else
+        {
+            data->bbox |= resultLine.bbox;
+        }
     }
-}
 
+    // Place the shaped glyphs from the pen positions of their clusters
+    data->glyphs.reserve(glyphs.size());
+    data->glyphPositions.reserve(glyphs.size());
 
-void FTSimpleLayoutImpl::RenderSpace(const char *string, const int len,
-                                     FTPoint position, int renderMode,
-                                     const float extraSpace)
-{
-    RenderSpaceI(string, len, position, renderMode, extraSpace);
-}
+    float clusterX = 0.0f;
+
+    for(size_t i = 0; i < glyphs.size(); i++)
+    {
+        const FTShapedGlyph& glyph = glyphs[i];
 
+        if(i && glyph.cluster != glyphs[i - 1].cluster)
+        {
+            clusterX = 0.0f;
+        }
 
-void FTSimpleLayoutImpl::RenderSpace(const wchar_t *string, const int len,
-                                     FTPoint position, int renderMode,
-                                     const float extraSpace)
-{
-    RenderSpaceI(string, len, position, renderMode, extraSpace);
-}
+        data->glyphs.push_back(glyph.index);
+        data->glyphPositions.push_back(FTPoint(data->positions[glyph.cluster])
+                                       + FTPoint(clusterX, 0.0)
+                                       + glyph.offset);
 
+        clusterX += glyph.advance.Xf();
+    }
+}
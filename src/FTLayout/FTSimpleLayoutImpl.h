@@ -27,7 +27,9 @@
 #ifndef __FTSimpleLayoutImpl__
 #define __FTSimpleLayoutImpl__
 
+#include "FTBBoxf.h"
 #include "FTLayoutImpl.h"
+#include "FTVector.h"
 
 
 class FTFont;
@@ -54,121 +56,307 @@ class FTSimpleLayoutImpl : public FTLayoutImpl
                             FTPoint position, int renderMode);
 
         /**
-         * Render a string of characters and distribute extra space amongst
-         * the whitespace regions of the string.
+         * Lay out a string, reusing the previous result when neither the
+         * string nor the settings changed.
+         */
+        const FTLayoutResult& Layout(const char *string, const int len);
+        const FTLayoutResult& Layout(const wchar_t *string, const int len);
+
+        /**
+         * Get the number of lines of a formatted string.
+         */
+        int LineCount(const char *string, const int len);
+        int LineCount(const wchar_t *string, const int len);
+
+        /**
+         * Get the index of the first character of a line.
+         */
+        int LineStart(const char *string, const int len, const int line);
+        int LineStart(const wchar_t *string, const int len, const int line);
+
+        /**
+         * Get the pen position of a character.
+         */
+        FTPoint CharPosition(const char *string, const int len,
+                             const int index, FTPoint position);
+        FTPoint CharPosition(const wchar_t *string, const int len,
+                             const int index, FTPoint position);
+
+        /**
+         * Get the index of the character closest to a point.
+         */
+        int CharIndex(const char *string, const int len,
+                      FTPoint point, FTPoint position);
+        int CharIndex(const wchar_t *string, const int len,
+                      FTPoint point, FTPoint position);
+
+    private:
+        /**
+         * A wrapped line of the cached text.
+         */
+        struct LayoutLine
+        {
+            /**
+             * Index of the first character on the line.
+             */
+            int start;
+
+            /**
+             * One past the last character drawn on the line. This includes
+             * the whitespace the line was broken at, but not a newline.
+             */
+            int end;
+
+            /**
+             * The width of the line up to its break, used for alignment.
+             */
+            float width;
+
+            /**
+             * The bounds of the line, before alignment, relative to the
+             * pen position of its first character.
+             */
+            FTBBoxf bbox;
+
+            /**
+             * The embedding level of the paragraph holding the line: 1 if
+             * it is right to left.
+             */
+            int level;
+        };
+
+        /**
+         * A feasible break of a paragraph being wrapped by the optimal
+         * line breaking mode.
+         */
+        struct BreakNode
+        {
+            /**
+             * Index of the first character after the break.
+             */
+            int position;
+
+            /**
+             * The node of the previous break on the best path to this one,
+             * or -1 for the start of the paragraph.
+             */
+            int previous;
+
+            /**
+             * How loose the line ending at this break is: 0 for a decent
+             * line, 1 for a loose line and 2 for a very loose one.
+             */
+            int fitness;
+
+            /**
+             * The width of the line ending at this break, for alignment.
+             */
+            float width;
+
+            /**
+             * Total advance and stretchability of the paragraph up to the
+             * break.
+             */
+            float advance;
+            float stretch;
+
+            /**
+             * Sum of the demerits of the lines up to the break.
+             */
+            double demerits;
+        };
+
+        /**
+         * Bring the cached line breaks up to date with a string. Only the
+         * paragraphs that differ from the previously laid out string are
+         * measured and wrapped again; the lines of the unchanged leading
+         * and trailing paragraphs are reused.
          *
-         * @param string   A buffer of wchar_t characters to output.
+         * @param string  A char string.
          * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode Render mode to display
-         * @param extraSpace The amount of extra space to distribute amongst
-         *                   the characters.
+         *             will be used until a null character is encountered.
          */
-        virtual void RenderSpace(const char *string, const int len,
-                                 FTPoint position, int renderMode,
-                                 const float extraSpace);
+        void Update(const char *string, const int len);
 
         /**
-         * Render a string of characters and distribute extra space amongst
-         * the whitespace regions of the string.
+         * Bring the cached line breaks up to date with a string.
          *
-         * @param string   A buffer of wchar_t characters to output.
+         * @param string  A wchar_t string.
          * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode Render mode to display
-         * @param extraSpace The amount of extra space to distribute amongst
-         *                   the characters.
+         *             will be used until a null character is encountered.
          */
-        virtual void RenderSpace(const wchar_t *string, const int len,
-                                 FTPoint position, int renderMode,
-                                 const float extraSpace);
+        void Update(const wchar_t *string, const int len);
 
-    private:
         /**
-         * Either render a string of characters and wrap lines
-         * longer than a threshold or compute the bounds
-         * of a string of characters when wrapped.  The functionality
-         * of this method is exposed by the BBoxWrapped and
-         * RenderWrapped methods.
+         * Break a range of the cached text into lines, using the cached
+         * character metrics.
          *
-         * @param buf  A char string to output.
-         * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode  Render mode to display
-         * @param bounds      A pointer to a bounds object.  If non null
-         *                    the bounds of the text when laid out
-         *                    will be stored in bounds.  If null the
-         *                    text will be rendered.
-         */
-        virtual void WrapText(const char *buf, const int len,
-                              FTPoint position, int renderMode,
-                              FTBBox *bounds);
-
-        /**
-         * Either render a string of characters and wrap lines
-         * longer than a threshold or compute the bounds
-         * of a string of characters when wrapped.  The functionality
-         * of this method is exposed by the BBoxWrapped and
-         * RenderWrapped methods.
+         * @param first  Index of the first character of a paragraph.
+         * @param last   One past the last character to wrap.
+         * @param final  Whether <code>last</code> is the end of the text,
+         *               in which case the last line is output too.
+         * @param wrapped  Receives the lines.
+         */
+        void Wrap(const int first, const int last, const bool final,
+                  FTVector<LayoutLine>& wrapped) const;
+
+        /**
+         * Break a range of the cached text into lines, putting as many
+         * words as possible on each line.
          *
-         * @param buf  A wchar_t style string to output.
-         * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode  Render mode to display
-         * @param bounds      A pointer to a bounds object.  If non null
-         *                    the bounds of the text when laid out
-         *                    will be stored in bounds.  If null the
-         *                    text will be rendered.
+         * @param first  Index of the first character of a paragraph.
+         * @param last   One past the last character to wrap.
+         * @param final  Whether <code>last</code> is the end of the text.
+         * @param wrapped  Receives the lines.
          */
-        virtual void WrapText(const wchar_t *buf, const int len,
-                              FTPoint position, int renderMode,
-                              FTBBox *bounds);
+        void WrapGreedy(const int first, const int last, const bool final,
+                        FTVector<LayoutLine>& wrapped) const;
 
         /**
-         * A helper method used by WrapText to either output the text or
-         * compute it's bounds.
+         * Break a paragraph into lines, choosing the breaks that minimise
+         * the total demerits of its lines, following Knuth and Plass. Falls
+         * back to WrapGreedy() when a word does not fit on a line.
          *
-         * @param buf      A pointer to an array of character data.
-         * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode  Render mode to display
-         * @param RemainingWidth The amount of extra space left on the line.
-         * @param bounds     A pointer to a bounds object.  If non null the
-         *                   bounds will be initialized or expanded by the
-         *                   bounds of the line.  If null the text will be
-         *                   rendered.  If the bounds are invalid (lower > upper)
-         *                   they will be initialized.  Otherwise they
-         *                   will be expanded.
-         */
-        void OutputWrapped(const char *buf, const int len,
-                           FTPoint position, int renderMode,
-                           const float RemainingWidth, FTBBox *bounds);
-
-        /**
-         * A helper method used by WrapText to either output the text or
-         * compute it's bounds.
+         * @param first  Index of the first character of the paragraph.
+         * @param last   Index of the hard line break ending the paragraph,
+         *               or the end of the text.
+         * @param wrapped  Receives the lines.
+         */
+        void WrapOptimal(const int first, const int last,
+                         FTVector<LayoutLine>& wrapped) const;
+
+        /**
+         * Measure a run of the cached text by the glyphs the font's shaper
+         * makes of it, replacing the advances and bounds found through the
+         * character map. The advance and bounds of each cluster go to its
+         * first character, and the other characters of the cluster get
+         * none. The run is left alone if it could not be shaped.
          *
-         * @param buf      A pointer to an array of character data.
-         * @param len  The length of the string. If < 0 then all characters
-         *             will be displayed until a null character is encountered.
-         * @param position TODO
-         * @param renderMode  Render mode to display
-         * @param RemainingWidth The amount of extra space left on the line.
-         * @param bounds     A pointer to a bounds object.  If non null the
-         *                   bounds will be initialized or expanded by the
-         *                   bounds of the line.  If null the text will be
-         *                   rendered.  If the bounds are invalid (lower > upper)
-         *                   they will be initialized.  Otherwise they
-         *                   will be expanded.
-         */
-        void OutputWrapped(const wchar_t *buf, const int len,
-                           FTPoint position, int renderMode,
-                           const float RemainingWidth, FTBBox *bounds);
+         * @param start  Index of the first character of the run.
+         * @param count  The number of characters.
+         * @param rightToLeft  The direction of the run.
+         */
+        void MeasureShaped(const int start, const int count,
+                           const bool rightToLeft);
+
+        /**
+         * Shape a line with the font's shaper, one run of a single
+         * direction at a time.
+         *
+         * @param line  The line.
+         * @param order  The index, relative to the start of the line, of
+         *               the character at each display position.
+         * @param glyphs  Receives the glyphs from left to right, with
+         *                clusters counted from the start of the text.
+         * @return  <code>false</code> if a run could not be shaped.
+         */
+        bool ShapeLine(const LayoutLine& line, const int *order,
+                       FTVector<FTShapedGlyph>& glyphs);
+
+        /**
+         * Find the line holding a character.
+         *
+         * @param index  A character index.
+         * @return  The index of the line.
+         */
+        int LineOf(const int index) const;
+
+        /**
+         * Get the pen position of the first character of a line, relative
+         * to the layout position, according to the alignment.
+         *
+         * @param line  The index of the line.
+         * @param distributeWidth  Receives the extra width to distribute
+         *                         amongst the space blocks of the line.
+         * @return  The pen position.
+         */
+        FTPoint LinePosition(const int line, float& distributeWidth) const;
+
+        /**
+         * Get the extra space added at the end of each space block of a
+         * justified line.
+         *
+         * @param line  The index of the line.
+         * @param distributeWidth  The extra width of the line.
+         * @return  The extra space per space block.
+         */
+        float BlockSpace(const int line, const float distributeWidth) const;
+
+        /**
+         * Build a new result from the cached lines and the current
+         * alignment and line spacing.
+         */
+        void BuildResult();
+
+        /**
+         * The cached text as unicode code points.
+         */
+        FTVector<unsigned int> text;
+
+        /**
+         * Offset of each cached character in the string it was decoded
+         * from, counted in string elements (bytes for UTF-8). Has one more
+         * entry than the text, for the end of the string.
+         */
+        FTVector<int> offsets;
+
+        /**
+         * Kerned advance and glyph bounds of each cached character, filled
+         * in by a single metrics pass over the font.
+         */
+        FTVector<float> advances;
+        FTVector<FTBBoxf> bounds;
+
+        /**
+         * What may happen after each cached character: one of the
+         * FTLineBreak actions, found once per changed paragraph.
+         */
+        FTVector<unsigned char> breaks;
+
+        /**
+         * The bidirectional embedding level of each cached character,
+         * resolved once per changed paragraph.
+         */
+        FTVector<unsigned char> levels;
+
+        /**
+         * Scratch storage for measuring shaped glyphs.
+         */
+        FTVector<FTShapedGlyph> shapedGlyphs;
+        FTVector<unsigned int> glyphIndices;
+        FTVector<FTPoint> glyphPens;
+
+        /**
+         * The wrapped lines of the cached text.
+         */
+        FTVector<LayoutLine> lines;
+
+        /**
+         * The string being laid out, decoded before it is compared with the
+         * cached text.
+         */
+        FTVector<unsigned int> newText;
+        FTVector<int> newOffsets;
+
+        /**
+         * The settings the cached lines were computed with. The cache is
+         * thrown away when any of them change. <code>linesValid</code> is
+         * cleared by SetLineLength() rather than comparing line lengths.
+         */
+        FTFont *cachedFont;
+        unsigned int cachedSize;
+        unsigned int cachedRevision;
+        int cachedCharSize;
+        FTGL::LineBreakMode cachedBreakMode;
+        bool linesValid;
+
+        /**
+         * The result of the last layout. <code>resultValid</code> is
+         * cleared whenever the cached lines, the alignment or the line
+         * spacing change.
+         */
+        FTLayoutResult result;
+        bool resultValid;
 
         /**
          * The font to use for rendering the text.  The font is
@@ -188,6 +376,11 @@ class FTSimpleLayoutImpl : public FTLayoutImpl
          */
         FTGL::TextAlignment alignment;
 
+        /**
+         * The strategy used to break lines.
+         */
+        FTGL::LineBreakMode breakMode;
+
         /**
          * The height of each line of text expressed as
          * a percentage of the font's line height.
@@ -203,22 +396,13 @@ class FTSimpleLayoutImpl : public FTLayoutImpl
         inline void RenderI(const T* string, const int len,
                             FTPoint position, int renderMode);
 
-        /* Internal generic RenderSpace() implementation */
-        template <typename T>
-        inline void RenderSpaceI(const T* string, const int len,
-                                 FTPoint position, int renderMode,
-                                 const float extraSpace);
-
-        /* Internal generic WrapText() implementation */
+        /* Internal generic Layout() implementation */
         template <typename T>
-        void WrapTextI(const T* buf, const int len, FTPoint position,
-                       int renderMode, FTBBox *bounds);
+        inline const FTLayoutResult& LayoutI(const T* string, const int len);
 
-        /* Internal generic OutputWrapped() implementation */
+        /* Internal generic Update() implementation */
         template <typename T>
-        void OutputWrappedI(const T* buf, const int len, FTPoint position,
-                            int renderMode, const float RemainingWidth,
-                            FTBBox *bounds);
+        void UpdateI(const T* string, const int len);
 };
 
 #endif  //  __FTSimpleLayoutImpl__
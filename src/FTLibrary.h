@@ -32,6 +32,8 @@
 
 #include "FTGL/ftgl.h"
 
+#include "FTMutex.h"
+
 
 /**
  * FTLibrary class is the global accessor for the Freetype library.
@@ -48,6 +50,11 @@
  * for errors using the following code...
  * <code>err = FTLibrary::Instance().Error();</code>
  *
+ * A single FT_Library is shared by every thread. FreeType only requires
+ * that library-wide operations such as creating or destroying a face are
+ * serialised, which is what <code>Mutex()</code> is for. Each FT_Face is
+ * still owned by one font and must not be used by two threads at once.
+ *
  * @see "Freetype 2 Documentation"
  *
  */
@@ -75,6 +82,14 @@ class FTLibrary
          */
         FT_Error Error() const { return err; }
 
+        /**
+         * Gets the lock serialising FT_New_Face, FT_Done_Face and the other
+         * calls that touch the shared FT_Library.
+         *
+         * @return  The library lock.
+         */
+        FTMutex& Mutex() const { return mutex; }
+
         /**
          * Destructor
          *
@@ -117,6 +132,10 @@ class FTLibrary
          */
         FT_Error err;
 
+        /**
+         * Lock for library-wide operations.
+         */
+        mutable FTMutex mutex;
 };
 
 #endif  //  __FTLibrary__
@@ -0,0 +1,533 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include "FTLineBreak.h"
+
+
+/* The class of each ASCII character. */
+static const unsigned char asciiClasses[128] =
+{
+#define C(x) FTLineBreak::x
+    C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM),
+    C(CM), C(BA), C(LF), C(BK), C(BK), C(CR), C(CM), C(CM),
+    C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM),
+    C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM), C(CM),
+    C(SP), C(EX), C(QU), C(AL), C(PR), C(PO), C(AL), C(QU),
+    C(OP), C(CP), C(AL), C(PR), C(IS), C(HY), C(IS), C(SY),
+    C(NU), C(NU), C(NU), C(NU), C(NU), C(NU), C(NU), C(NU),
+    C(NU), C(NU), C(IS), C(IS), C(AL), C(AL), C(AL), C(EX),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(OP), C(PR), C(CP), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL), C(AL),
+    C(AL), C(AL), C(AL), C(OP), C(BA), C(CL), C(AL), C(CM)
+#undef C
+};
+
+
+/* The other classes, as a sorted list of ranges. Each entry holds the
+ * first code point of a range shifted left by 6 bits and the class of the
+ * range in the low bits; a range ends where the next one starts. Hangul
+ * syllables are left out, their class is computed. Generated from the
+ * LineBreak property of Unicode 14.0. */
+static const unsigned int classRanges[] =
+{
+    0x15, 0x251, 0x2a3, 0x2e1, 0x362, 0x395,
+    0x825, 0x846, 0x883, 0x8cc, 0x909, 0x94a,
+    0x98c, 0x9c3, 0xa00, 0xa42, 0xa8c, 0xac9,
+    0xb08, 0xb50, 0xb88, 0xbc7, 0xc0b, 0xe88,
+    0xf0c, 0xfc6, 0x100c, 0x16c0, 0x1709, 0x1742,
+    0x178c, 0x1ec0, 0x1f11, 0x1f41, 0x1f8c, 0x1fd5,
+    0x2164, 0x2195, 0x2804, 0x2840, 0x288a, 0x28c9,
+    0x298c, 0x2ac3, 0x2b0c, 0x2b51, 0x2b8c, 0x2c0a,
+    0x2c49, 0x2c8c, 0x2d12, 0x2d4c, 0x2ec3, 0x2f0c,
+    0x2fc0, 0x300c, 0xb212, 0xb24c, 0xb312, 0xb34c,
+    0xb7d2, 0xb80c, 0xc015, 0xd3c4, 0xd415, 0xd704,
+    0xd8d5, 0xdc0c, 0xdf88, 0xdfcc, 0x120d5, 0x1228c,
+    0x16248, 0x16291, 0x162cc, 0x163c9, 0x1640c, 0x16455,
+    0x16f91, 0x16fd5, 0x1700c, 0x17055, 0x170cc, 0x17115,
+    0x17186, 0x171d5, 0x1720c, 0x1740d, 0x17acc, 0x17bcd,
+    0x17ccc, 0x1824a, 0x18308, 0x1838c, 0x18415, 0x186c6,
+    0x18715, 0x18746, 0x1880c, 0x192d5, 0x1980b, 0x19a8a,
+    0x19acb, 0x19b4c, 0x19c15, 0x19c4c, 0x1b506, 0x1b54c,
+    0x1b595, 0x1b74c, 0x1b7d5, 0x1b94c, 0x1b9d5, 0x1ba4c,
+    0x1ba95, 0x1bb8c, 0x1bc0b, 0x1be8c, 0x1c455, 0x1c48c,
+    0x1cc15, 0x1d2cc, 0x1e995, 0x1ec4c, 0x1f00b, 0x1f28c,
+    0x1fad5, 0x1fd0c, 0x1fe08, 0x1fe46, 0x1fe8c, 0x1ff55,
+    0x1ff89, 0x2000c, 0x20595, 0x2068c, 0x206d5, 0x2090c,
+    0x20955, 0x20a0c, 0x20a55, 0x20b8c, 0x21655, 0x2170c,
+    0x22615, 0x2280c, 0x23295, 0x2388c, 0x238d5, 0x2410c,
+    0x24e95, 0x24f4c, 0x24f95, 0x2540c, 0x25455, 0x2560c,
+    0x25895, 0x25911, 0x2598b, 0x25c0c, 0x26055, 0x2610c,
+    0x26f15, 0x26f4c, 0x26f95, 0x2714c, 0x271d5, 0x2724c,
+    0x272d5, 0x2738c, 0x275d5, 0x2760c, 0x27895, 0x2790c,
+    0x2798b, 0x27c0c, 0x27c8a, 0x27d0c, 0x27e4a, 0x27e8c,
+    0x27ec9, 0x27f0c, 0x27f95, 0x27fcc, 0x28055, 0x2810c,
+    0x28f15, 0x28f4c, 0x28f95, 0x290cc, 0x291d5, 0x2924c,
+    0x292d5, 0x2938c, 0x29455, 0x2948c, 0x2998b, 0x29c15,
+    0x29c8c, 0x29d55, 0x29d8c, 0x2a055, 0x2a10c, 0x2af15,
+    0x2af4c, 0x2af95, 0x2b18c, 0x2b1d5, 0x2b28c, 0x2b2d5,
+    0x2b38c, 0x2b895, 0x2b90c, 0x2b98b, 0x2bc0c, 0x2bc49,
+    0x2bc8c, 0x2be95, 0x2c00c, 0x2c055, 0x2c10c, 0x2cf15,
+    0x2cf4c, 0x2cf95, 0x2d14c, 0x2d1d5, 0x2d24c, 0x2d2d5,
+    0x2d38c, 0x2d555, 0x2d60c, 0x2d895, 0x2d90c, 0x2d98b,
+    0x2dc0c, 0x2e095, 0x2e0cc, 0x2ef95, 0x2f0cc, 0x2f195,
+    0x2f24c, 0x2f295, 0x2f38c, 0x2f5d5, 0x2f60c, 0x2f98b,
+    0x2fc0c, 0x2fe49, 0x2fe8c, 0x30015, 0x3014c, 0x30f15,
+    0x30f4c, 0x30f95, 0x3114c, 0x31195, 0x3124c, 0x31295,
+    0x3138c, 0x31555, 0x315cc, 0x31895, 0x3190c, 0x3198b,
+    0x31c0c, 0x31dd2, 0x31e0c, 0x32055, 0x32112, 0x3214c,
+    0x32f15, 0x32f4c, 0x32f95, 0x3314c, 0x33195, 0x3324c,
+    0x33295, 0x3338c, 0x33555, 0x335cc, 0x33895, 0x3390c,
+    0x3398b, 0x33c0c, 0x34015, 0x3410c, 0x34ed5, 0x34f4c,
+    0x34f95, 0x3514c, 0x35195, 0x3524c, 0x35295, 0x3538c,
+    0x355d5, 0x3560c, 0x35895, 0x3590c, 0x3598b, 0x35c0c,
+    0x35e4a, 0x35e8c, 0x36055, 0x3610c, 0x37295, 0x372cc,
+    0x373d5, 0x3754c, 0x37595, 0x375cc, 0x37615, 0x3780c,
+    0x3798b, 0x37c0c, 0x37c95, 0x37d0c, 0x38fc9, 0x3900c,
+    0x3940b, 0x39691, 0x3970c, 0x3b40b, 0x3b68c, 0x3c052,
+    0x3c14c, 0x3c192, 0x3c204, 0x3c252, 0x3c2d1, 0x3c304,
+    0x3c346, 0x3c484, 0x3c4cc, 0x3c506, 0x3c54c, 0x3c615,
+    0x3c68c, 0x3c80b, 0x3ca8c, 0x3cd11, 0x3cd55, 0x3cd8c,
+    0x3cdd5, 0x3ce0c, 0x3ce55, 0x3ce80, 0x3cec1, 0x3cf00,
+    0x3cf41, 0x3cf95, 0x3d00c, 0x3dc55, 0x3dfd1, 0x3e015,
+    0x3e151, 0x3e195, 0x3e20c, 0x3e355, 0x3e60c, 0x3e655,
+    0x3ef4c, 0x3ef91, 0x3f00c, 0x3f195, 0x3f1cc, 0x3f412,
+    0x3f491, 0x3f4d2, 0x3f50c, 0x3f644, 0x3f6cc, 0x4100b,
+    0x41291, 0x4130c, 0x4240b, 0x4268c, 0x44019, 0x4581a,
+    0x46a1b, 0x4800c, 0x4d755, 0x4d80c, 0x4d851, 0x4d88c,
+    0x50011, 0x5004c, 0x5a011, 0x5a04c, 0x5a6c0, 0x5a701,
+    0x5a74c, 0x5bad1, 0x5bb8c, 0x5c495, 0x5c58c, 0x5cc95,
+    0x5cd51, 0x5cdcc, 0x5d495, 0x5d50c, 0x5dc95, 0x5dd0c,
+    0x5f511, 0x5f585, 0x5f5cc, 0x5f611, 0x5f64c, 0x5f691,
+    0x5f6c9, 0x5f70c, 0x5f80b, 0x5fa8c, 0x60086, 0x60111,
+    0x60192, 0x601cc, 0x60206, 0x6028c, 0x602d5, 0x60384,
+    0x603d5, 0x6040b, 0x6068c, 0x62155, 0x621cc, 0x62a55,
+    0x62a8c, 0x64815, 0x64b0c, 0x64c15, 0x64f0c, 0x65106,
+    0x6518b, 0x6540c, 0x6740b, 0x6768c, 0x685d5, 0x6870c,
+    0x69fd5, 0x6a00b, 0x6a28c, 0x6a40b, 0x6a68c, 0x6ac15,
+    0x6b3cc, 0x6c015, 0x6c14c, 0x6cd15, 0x6d14c, 0x6d40b,
+    0x6d691, 0x6d70c, 0x6d751, 0x6d84c, 0x6dad5, 0x6dd0c,
+    0x6df51, 0x6dfcc, 0x6e015, 0x6e0cc, 0x6e855, 0x6eb8c,
+    0x6ec0b, 0x6ee8c, 0x6f995, 0x6fd0c, 0x70915, 0x70e0c,
+    0x70ed1, 0x7100b, 0x7128c, 0x7140b, 0x7168c, 0x71f91,
+    0x7200c, 0x73415, 0x734cc, 0x73515, 0x73a4c, 0x73b55,
+    0x73b8c, 0x73d15, 0x73d4c, 0x73dd5, 0x73e8c, 0x77015,
+    0x7800c, 0x7ff52, 0x7ff8c, 0x80011, 0x801c4, 0x80211,
+    0x802d4, 0x80315, 0x8035f, 0x80395, 0x80411, 0x80444,
+    0x80491, 0x80513, 0x8054c, 0x80603, 0x80680, 0x806c3,
+    0x80780, 0x807c3, 0x8080c, 0x8090f, 0x809d1, 0x80a21,
+    0x80a95, 0x80bc4, 0x80c0a, 0x80e0c, 0x80e43, 0x80ecc,
+    0x80f05, 0x80f8c, 0x81108, 0x81140, 0x81181, 0x811c5,
+    0x8128c, 0x81591, 0x815cc, 0x81611, 0x8170c, 0x81751,
+    0x81816, 0x8184c, 0x81995, 0x81c0c, 0x81f40, 0x81f81,
+    0x81fcc, 0x82340, 0x82381, 0x823cc, 0x82809, 0x829ca,
+    0x82a09, 0x82d8a, 0x82dc9, 0x82eca, 0x82f09, 0x82f8a,
+    0x82fc9, 0x8300a, 0x83049, 0x83415, 0x83c4c, 0x840ca,
+    0x8410c, 0x8424a, 0x8428c, 0x84589, 0x845cc, 0x88489,
+    0x8850c, 0x8bbcf, 0x8bc0c, 0x8c200, 0x8c241, 0x8c280,
+    0x8c2c1, 0x8c30c, 0x8c68e, 0x8c70c, 0x8ca40, 0x8ca81,
+    0x8cacc, 0x8fc0e, 0x8fd0c, 0x9800e, 0x9810c, 0x9850e,
+    0x9858c, 0x9860e, 0x9864c, 0x9868e, 0x9875d, 0x9878e,
+    0x9880c, 0x98e4e, 0x98f0c, 0x99a0e, 0x99a4c, 0x99fce,
+    0x9a00c, 0x9af4e, 0x9b24c, 0x9b34e, 0x9b38c, 0x9b3ce,
+    0x9b48c, 0x9b4ce, 0x9b54c, 0x9b60e, 0x9b68c, 0x9b70e,
+    0x9b74c, 0x9b7ce, 0x9b88c, 0x9ba8e, 0x9bacc, 0x9bc4e,
+    0x9bd8c, 0x9bdce, 0x9be5d, 0x9be8e, 0x9becc, 0x9bf4e,
+    0x9c14c, 0x9c20e, 0x9c29d, 0x9c38c, 0x9d6c3, 0x9d84c,
+    0x9d886, 0x9d90e, 0x9d94c, 0x9da00, 0x9da41, 0x9da80,
+    0x9dac1, 0x9db00, 0x9db41, 0x9db80, 0x9dbc1, 0x9dc00,
+    0x9dc41, 0x9dc80, 0x9dcc1, 0x9dd00, 0x9dd41, 0x9dd8c,
+    0x9f140, 0x9f181, 0x9f1cc, 0x9f980, 0x9f9c1, 0x9fa00,
+    0x9fa41, 0x9fa80, 0x9fac1, 0x9fb00, 0x9fb41, 0x9fb80,
+    0x9fbc1, 0x9fc0c, 0xa60c0, 0xa6101, 0xa6140, 0xa6181,
+    0xa61c0, 0xa6201, 0xa6240, 0xa6281, 0xa62c0, 0xa6301,
+    0xa6340, 0xa6381, 0xa63c0, 0xa6401, 0xa6440, 0xa6481,
+    0xa64c0, 0xa6501, 0xa6540, 0xa6581, 0xa65c0, 0xa6601,
+    0xa664c, 0xa7600, 0xa7641, 0xa7680, 0xa76c1, 0xa770c,
+    0xa7f00, 0xa7f41, 0xa7f8c, 0xb3bd5, 0xb3c8c, 0xb3e46,
+    0xb3e91, 0xb3f4c, 0xb3f86, 0xb3fd1, 0xb400c, 0xb5c11,
+    0xb5c4c, 0xb5fd5, 0xb600c, 0xb7815, 0xb8003, 0xb8391,
+    0xb858c, 0xb85d1, 0xb8600, 0xb8651, 0xb868c, 0xb8703,
+    0xb878c, 0xb8803, 0xb8880, 0xb88c1, 0xb8900, 0xb8941,
+    0xb8980, 0xb89c1, 0xb8a00, 0xb8a41, 0xb8a91, 0xb8b86,
+    0xb8bcc, 0xb8c11, 0xb8c8c, 0xb8cd1, 0xb8d4c, 0xb8e93,
+    0xb8f11, 0xb8fcc, 0xb9011, 0xb9080, 0xb90d1, 0xb92cc,
+    0xb9311, 0xb934c, 0xb9391, 0xb940c, 0xb94c6, 0xb9540,
+    0xb9581, 0xb95c0, 0xb9601, 0xb9640, 0xb9681, 0xb96c0,
+    0xb9701, 0xb9751, 0xb978c, 0xba00e, 0xba68c, 0xba6ce,
+    0xbbd0c, 0xbc00e, 0xbf58c, 0xbfc0e, 0xbff0c, 0xc0011,
+    0xc0041, 0xc00ce, 0xc0145, 0xc018e, 0xc0200, 0xc0241,
+    0xc0280, 0xc02c1, 0xc0300, 0xc0341, 0xc0380, 0xc03c1,
+    0xc0400, 0xc0441, 0xc048e, 0xc0500, 0xc0541, 0xc0580,
+    0xc05c1, 0xc0600, 0xc0641, 0xc0680, 0xc06c1, 0xc0705,
+    0xc0740, 0xc0781, 0xc080e, 0xc0a95, 0xc0c0e, 0xc0d55,
+    0xc0d8e, 0xc0ec5, 0xc0f4e, 0xc100c, 0xc1045, 0xc108e,
+    0xc10c5, 0xc110e, 0xc1145, 0xc118e, 0xc11c5, 0xc120e,
+    0xc1245, 0xc128e, 0xc18c5, 0xc190e, 0xc20c5, 0xc210e,
+    0xc2145, 0xc218e, 0xc21c5, 0xc220e, 0xc2385, 0xc23ce,
+    0xc2545, 0xc25cc, 0xc2655, 0xc26c5, 0xc27ce, 0xc2805,
+    0xc288e, 0xc28c5, 0xc290e, 0xc2945, 0xc298e, 0xc29c5,
+    0xc2a0e, 0xc2a45, 0xc2a8e, 0xc30c5, 0xc310e, 0xc38c5,
+    0xc390e, 0xc3945, 0xc398e, 0xc39c5, 0xc3a0e, 0xc3b85,
+    0xc3bce, 0xc3d45, 0xc3dce, 0xc3ec5, 0xc3fce, 0xc400c,
+    0xc414e, 0xc4c0c, 0xc4c4e, 0xc63cc, 0xc640e, 0xc790c,
+    0xc7c05, 0xc800e, 0xc87cc, 0xc880e, 0xc920c, 0xc940e,
+    0x13700c, 0x13800e, 0x280545, 0x28058e, 0x29234c, 0x29240e,
+    0x2931cc, 0x293f91, 0x29400c, 0x298351, 0x298386, 0x2983d1,
+    0x29840c, 0x29880b, 0x298a8c, 0x299bd5, 0x299ccc, 0x299d15,
+    0x299f8c, 0x29a795, 0x29a80c, 0x29bc15, 0x29bc8c, 0x29bcd1,
+    0x29be0c, 0x2a0095, 0x2a00cc, 0x2a0195, 0x2a01cc, 0x2a02d5,
+    0x2a030c, 0x2a08d5, 0x2a0a0c, 0x2a0b15, 0x2a0b4c, 0x2a0e0a,
+    0x2a0e4c, 0x2a1d12, 0x2a1d86, 0x2a1e0c, 0x2a2015, 0x2a208c,
+    0x2a2d15, 0x2a318c, 0x2a3391, 0x2a340b, 0x2a368c, 0x2a3815,
+    0x2a3c8c, 0x2a3f12, 0x2a3f4c, 0x2a3fd5, 0x2a400b, 0x2a428c,
+    0x2a4995, 0x2a4b91, 0x2a4c0c, 0x2a51d5, 0x2a550c, 0x2a5819,
+    0x2a5f4c, 0x2a6015, 0x2a610c, 0x2a6cd5, 0x2a704c, 0x2a71d1,
+    0x2a728c, 0x2a740b, 0x2a768c, 0x2a7c0b, 0x2a7e8c, 0x2a8a55,
+    0x2a8dcc, 0x2a90d5, 0x2a910c, 0x2a9315, 0x2a938c, 0x2a940b,
+    0x2a968c, 0x2a9751, 0x2a980c, 0x2abad5, 0x2abc11, 0x2abc8c,
+    0x2abd55, 0x2abdcc, 0x2af8d5, 0x2afad1, 0x2afb15, 0x2afb8c,
+    0x2afc0b, 0x2afe8c, 0x2b0018, 0x35e90c, 0x35ec1a, 0x35f1cc,
+    0x35f2db, 0x35ff0c, 0x3e400e, 0x3ec00c, 0x3ec74d, 0x3ec795,
+    0x3ec7cd, 0x3eca4c, 0x3eca8d, 0x3ecdcc, 0x3ece0d, 0x3ecf4c,
+    0x3ecf8d, 0x3ecfcc, 0x3ed00d, 0x3ed08c, 0x3ed0cd, 0x3ed14c,
+    0x3ed18d, 0x3ed40c, 0x3f4f81, 0x3f4fc0, 0x3f500c, 0x3f7f0a,
+    0x3f7f4c, 0x3f8015, 0x3f8408, 0x3f8441, 0x3f84c8, 0x3f8546,
+    0x3f85c0, 0x3f8601, 0x3f864f, 0x3f868c, 0x3f8815, 0x3f8c0e,
+    0x3f8d40, 0x3f8d81, 0x3f8dc0, 0x3f8e01, 0x3f8e40, 0x3f8e81,
+    0x3f8ec0, 0x3f8f01, 0x3f8f40, 0x3f8f81, 0x3f8fc0, 0x3f9001,
+    0x3f9040, 0x3f9081, 0x3f90c0, 0x3f9101, 0x3f914e, 0x3f91c0,
+    0x3f9201, 0x3f924e, 0x3f9401, 0x3f944e, 0x3f9481, 0x3f94cc,
+    0x3f9505, 0x3f9586, 0x3f960e, 0x3f9640, 0x3f9681, 0x3f96c0,
+    0x3f9701, 0x3f9740, 0x3f9781, 0x3f97ce, 0x3f99cc, 0x3f9a0e,
+    0x3f9a49, 0x3f9a8a, 0x3f9ace, 0x3f9b0c, 0x3fbfd6, 0x3fc00c,
+    0x3fc046, 0x3fc08e, 0x3fc109, 0x3fc14a, 0x3fc18e, 0x3fc200,
+    0x3fc241, 0x3fc28e, 0x3fc301, 0x3fc34e, 0x3fc381, 0x3fc3ce,
+    0x3fc685, 0x3fc70e, 0x3fc7c6, 0x3fc80e, 0x3fcec0, 0x3fcf0e,
+    0x3fcf41, 0x3fcf8e, 0x3fd6c0, 0x3fd70e, 0x3fd741, 0x3fd78e,
+    0x3fd7c0, 0x3fd801, 0x3fd880, 0x3fd8c1, 0x3fd945, 0x3fd98e,
+    0x3fd9c5, 0x3fdc4e, 0x3fe785, 0x3fe80e, 0x3fefcc, 0x3ff08e,
+    0x3ff20c, 0x3ff28e, 0x3ff40c, 0x3ff48e, 0x3ff60c, 0x3ff68e,
+    0x3ff74c, 0x3ff80a, 0x3ff849, 0x3ff88e, 0x3ff949, 0x3ff9cc,
+    0x3ffe55, 0x3fff20, 0x3fff4c, 0x404011, 0x4040cc, 0x407f55,
+    0x407f8c, 0x40b815, 0x40b84c, 0x40dd95, 0x40decc, 0x40e7d1,
+    0x40e80c, 0x40f411, 0x40f44c, 0x41280b, 0x412a8c, 0x4215d1,
+    0x42160c, 0x4247d1, 0x42480c, 0x428055, 0x42810c, 0x428155,
+    0x4281cc, 0x428315, 0x42840c, 0x428e15, 0x428ecc, 0x428fd5,
+    0x42900c, 0x429411, 0x42960c, 0x42b955, 0x42b9cc, 0x42bc11,
+    0x42bd8f, 0x42bdcc, 0x42ce51, 0x42d00c, 0x434915, 0x434a0c,
+    0x434c0b, 0x434e8c, 0x43aad5, 0x43ab51, 0x43ab8c, 0x43d195,
+    0x43d44c, 0x43e095, 0x43e18c, 0x440015, 0x4400cc, 0x440e15,
+    0x4411d1, 0x44124c, 0x44198b, 0x441c15, 0x441c4c, 0x441cd5,
+    0x441d4c, 0x441fd5, 0x4420cc, 0x442c15, 0x442ecc, 0x442f91,
+    0x443095, 0x4430cc, 0x443c0b, 0x443e8c, 0x444015, 0x4440cc,
+    0x4449d5, 0x444d4c, 0x444d8b, 0x445011, 0x44510c, 0x445155,
+    0x4451cc, 0x445cd5, 0x445d0c, 0x445d52, 0x445d8c, 0x446015,
+    0x4460cc, 0x446cd5, 0x44704c, 0x447151, 0x4471cc, 0x447211,
+    0x447255, 0x44734c, 0x447395, 0x44740b, 0x44768c, 0x4476d2,
+    0x44770c, 0x447751, 0x44780c, 0x448b15, 0x448e11, 0x448e8c,
+    0x448ed1, 0x448f4c, 0x448f95, 0x448fcc, 0x44aa51, 0x44aa8c,
+    0x44b7d5, 0x44bacc, 0x44bc0b, 0x44be8c, 0x44c015, 0x44c10c,
+    0x44ced5, 0x44cf4c, 0x44cf95, 0x44d14c, 0x44d1d5, 0x44d24c,
+    0x44d2d5, 0x44d38c, 0x44d5d5, 0x44d60c, 0x44d895, 0x44d90c,
+    0x44d995, 0x44db4c, 0x44dc15, 0x44dd4c, 0x450d55, 0x4511cc,
+    0x4512d1, 0x4513cc, 0x45140b, 0x451691, 0x45170c, 0x451795,
+    0x4517cc, 0x452c15, 0x45310c, 0x45340b, 0x45368c, 0x456bd5,
+    0x456d8c, 0x456e15, 0x457052, 0x457091, 0x457106, 0x45718c,
+    0x457251, 0x45760c, 0x457715, 0x45778c, 0x458c15, 0x459051,
+    0x4590cc, 0x45940b, 0x45968c, 0x459812, 0x459b4c, 0x45aad5,
+    0x45ae0c, 0x45b00b, 0x45b28c, 0x45cc0b, 0x45ce8c, 0x45cf11,
+    0x45cfcc, 0x460b15, 0x460ecc, 0x46380b, 0x463a8c, 0x464c15,
+    0x464d8c, 0x464dd5, 0x464e4c, 0x464ed5, 0x464fcc, 0x465015,
+    0x46504c, 0x465095, 0x465111, 0x4651cc, 0x46540b, 0x46568c,
+    0x467455, 0x46760c, 0x467695, 0x46784c, 0x467892, 0x4678cc,
+    0x467915, 0x46794c, 0x468055, 0x4682cc, 0x468cd5, 0x468e8c,
+    0x468ed5, 0x468fd2, 0x46900c, 0x469051, 0x469152, 0x46918c,
+    0x4691d5, 0x46920c, 0x469455, 0x46970c, 0x46a295, 0x46a691,
+    0x46a74c, 0x46a792, 0x46a851, 0x46a8cc, 0x470bd5, 0x470dcc,
+    0x470e15, 0x47100c, 0x471051, 0x47118c, 0x47140b, 0x47168c,
+    0x471c12, 0x471c46, 0x471c8c, 0x472495, 0x472a0c, 0x472a55,
+    0x472dcc, 0x474c55, 0x474dcc, 0x474e95, 0x474ecc, 0x474f15,
+    0x474f8c, 0x474fd5, 0x47518c, 0x4751d5, 0x47520c, 0x47540b,
+    0x47568c, 0x476295, 0x4763cc, 0x476415, 0x47648c, 0x4764d5,
+    0x47660c, 0x47680b, 0x476a8c, 0x47bcd5, 0x47bdcc, 0x47f74a,
+    0x47f84c, 0x47ffd1, 0x48000c, 0x491c11, 0x491d4c, 0x4c9600,
+    0x4c96c1, 0x4c978c, 0x4ca081, 0x4ca0cc, 0x4ca180, 0x4ca1c1,
+    0x4ca200, 0x4ca241, 0x4ca28c, 0x4cde40, 0x4cde81, 0x4cdf0c,
+    0x4d0c04, 0x4d0dc0, 0x4d0e01, 0x4d0e4c, 0x517380, 0x5173c1,
+    0x51740c, 0x5a980b, 0x5a9a8c, 0x5a9b91, 0x5a9c0c, 0x5ab00b,
+    0x5ab28c, 0x5abc15, 0x5abd51, 0x5abd8c, 0x5acc15, 0x5acdd1,
+    0x5ace8c, 0x5ad111, 0x5ad14c, 0x5ad40b, 0x5ad68c, 0x5ba5d1,
+    0x5ba64c, 0x5bd3d5, 0x5bd40c, 0x5bd455, 0x5be20c, 0x5be3d5,
+    0x5be4cc, 0x5bf805, 0x5bf904, 0x5bf94c, 0x5bfc15, 0x5bfc8c,
+    0x5c000e, 0x61fe0c, 0x62000e, 0x62c00c, 0x63400e, 0x63424c,
+    0x6c000e, 0x6c48cc, 0x6c5405, 0x6c54cc, 0x6c5905, 0x6c5a0c,
+    0x6c5c0e, 0x6cbf0c, 0x6f2755, 0x6f27d1, 0x6f2815, 0x6f290c,
+    0x73c015, 0x73cb8c, 0x73cc15, 0x73d1cc, 0x745955, 0x745a8c,
+    0x745b55, 0x7460cc, 0x746155, 0x74630c, 0x746a95, 0x746b8c,
+    0x749095, 0x74914c, 0x75f38b, 0x76000c, 0x768015, 0x768dcc,
+    0x768ed5, 0x769b4c, 0x769d55, 0x769d8c, 0x76a115, 0x76a14c,
+    0x76a1d1, 0x76a2cc, 0x76a6d5, 0x76a80c, 0x76a855, 0x76ac0c,
+    0x780015, 0x7801cc, 0x780215, 0x78064c, 0x7806d5, 0x78088c,
+    0x7808d5, 0x78094c, 0x780995, 0x780acc, 0x784c15, 0x784dcc,
+    0x78500b, 0x78528c, 0x78ab95, 0x78abcc, 0x78bb15, 0x78bc0b,
+    0x78be8c, 0x78bfc9, 0x78c00c, 0x7a3415, 0x7a35cc, 0x7a5115,
+    0x7a52cc, 0x7a540b, 0x7a568c, 0x7a5780, 0x7a580c, 0x7b2b0a,
+    0x7b2b4c, 0x7b2c0a, 0x7b2c4c, 0x7c000e, 0x7c400c, 0x7c434e,
+    0x7c440c, 0x7c5b4e, 0x7c5c0c, 0x7c6b4e, 0x7c799c, 0x7c800e,
+    0x7ce15d, 0x7ce18e, 0x7ce70c, 0x7ce78e, 0x7ced4c, 0x7cedce,
+    0x7cef0c, 0x7cef4e, 0x7cf09d, 0x7cf14e, 0x7cf1dd, 0x7cf20e,
+    0x7cf29d, 0x7cf34e, 0x7cfede, 0x7d000e, 0x7d109d, 0x7d110e,
+    0x7d119d, 0x7d144e, 0x7d199d, 0x7d1e4e, 0x7d1f1d, 0x7d1f4e,
+    0x7d205d, 0x7d210e, 0x7d215d, 0x7d220e, 0x7d23dd, 0x7d240e,
+    0x7d245d, 0x7d248e, 0x7d280c, 0x7d284e, 0x7d288c, 0x7d28ce,
+    0x7d290c, 0x7d294e, 0x7d2a9d, 0x7d2ace, 0x7d2bcc, 0x7d2c0e,
+    0x7d2c4c, 0x7d2cce, 0x7d400c, 0x7d41ce, 0x7d45cc, 0x7d494e,
+    0x7d4c8c, 0x7d528e, 0x7d5d1d, 0x7d5d8e, 0x7d5e9d, 0x7d5ece,
+    0x7d641d, 0x7d644e, 0x7d655d, 0x7d65ce, 0x7d750c, 0x7d770e,
+    0x7d7d0c, 0x7d7e8e, 0x7d915d, 0x7d920e, 0x7d92dd, 0x7d940c,
+    0x7d9d83, 0x7d9e45, 0x7d9f0c, 0x7da00e, 0x7da8dd, 0x7da90e,
+    0x7dad1d, 0x7dadce, 0x7db01d, 0x7db04e, 0x7db31d, 0x7db34e,
+    0x7dc00c, 0x7ddd0e, 0x7de00c, 0x7df54e, 0x7e000c, 0x7e030e,
+    0x7e040c, 0x7e120e, 0x7e140c, 0x7e168e, 0x7e180c, 0x7e220e,
+    0x7e240c, 0x7e2b8e, 0x7e400c, 0x7e431d, 0x7e434e, 0x7e43dd,
+    0x7e440e, 0x7e461d, 0x7e480e, 0x7e499d, 0x7e49ce, 0x7e4c1d,
+    0x7e4e8e, 0x7e4f1d, 0x7e4fce, 0x7e5ddd, 0x7e5e0e, 0x7e6d5d,
+    0x7e6dce, 0x7e6e1d, 0x7e6e8e, 0x7e6edd, 0x7e6f0e, 0x7e735d,
+    0x7e740e, 0x7e745d, 0x7e778e, 0x7e800c, 0x7e950e, 0x7eb0dd,
+    0x7eb18e, 0x7ebc1d, 0x7ebdce, 0x7ec00c, 0x7efc0b, 0x7efe8c,
+    0x7f000e, 0x7fff8c, 0x80000e, 0xbfff8c, 0xc0000e, 0xffff8c,
+    0x3800055, 0x380008c, 0x3800815, 0x380200c, 0x3804015, 0x3807c0c
+};
+
+
+/* The UAX #14 pair table, indexed by the class before and after a break,
+ * from OP to CB, with columns in the same order as the rows. '^' prohibits
+ * a break, '%' allows it only after spaces and '_' always allows it.
+ * Combining marks are handled separately. */
+static const char pairTable[FTLineBreak::CB + 1][FTLineBreak::CB + 2] =
+{
+    "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^", /* OP */
+    "_^^%%^^^^%%____%%%__^_^__________", /* CL */
+    "_^^%%^^^^%%%%%_%%%__^_^__________", /* CP */
+    "^^^%%%^^^%%%%%%%%%%%^%^%%%%%%%%%%", /* QU */
+    "%^^%%%^^^%%%%%%%%%%%^%^%%%%%%%%%%", /* GL */
+    "_^^%%%^^^______%%%__^_^__________", /* NS */
+    "_^^%%%^^^______%%%__^_^__________", /* EX */
+    "_^^%%%^^^__%_%_%%%__^_^__________", /* SY */
+    "_^^%%%^^^__%%%_%%%__^_^__________", /* IS */
+    "%^^%%%^^^__%%%%%%%__^_^%%%%%_%%__", /* PR */
+    "%^^%%%^^^__%%%_%%%__^_^__________", /* PO */
+    "%^^%%%^^^%%%%%_%%%__^_^__________", /* NU */
+    "%^^%%%^^^%%%%%_%%%__^_^__________", /* AL */
+    "%^^%%%^^^%%%%%_%%%__^_^__________", /* HL */
+    "_^^%%%^^^_%____%%%__^_^__________", /* ID */
+    "_^^%%%^^^______%%%__^_^__________", /* IN */
+    "_^^%_%^^^__%___%%%__^_^__________", /* HY */
+    "_^^%_%^^^______%%%__^_^__________", /* BA */
+    "%^^%%%^^^%%%%%%%%%%%^%^%%%%%%%%%_", /* BB */
+    "_^^%%%^^^______%%%_^^_^__________", /* B2 */
+    "____________________^____________", /* ZW */
+    "_^^%%%^^^______%%%__^_^__________", /* CM */
+    "%^^%%%^^^%%%%%%%%%%%^%^%%%%%%%%%%", /* WJ */
+    "_^^%%%^^^_%____%%%__^_^___%%_____", /* H2 */
+    "_^^%%%^^^_%____%%%__^_^____%_____", /* H3 */
+    "_^^%%%^^^_%____%%%__^_^%%%%______", /* JL */
+    "_^^%%%^^^_%____%%%__^_^___%%_____", /* JV */
+    "_^^%%%^^^_%____%%%__^_^____%_____", /* JT */
+    "_^^%%%^^^______%%%__^_^_____%____", /* RI */
+    "_^^%%%^^^_%____%%%__^_^_______%__", /* EB */
+    "_^^%%%^^^_%____%%%__^_^__________", /* EM */
+    "%^^%%%^^^%%%%%%%%%%%^%^%%%%%%%%%%", /* ZWJ */
+    "_^^%%_^^^___________^_^__________", /* CB */
+};
+
+
+FTLineBreak::BreakClass FTLineBreak::Classify(const unsigned int c)
+{
+    if(c < 0x80)
+    {
+        return (BreakClass)asciiClasses[c];
+    }
+
+    // Hangul syllables are LV (H2) every 28 code points, LVT (H3) otherwise
+    if(c >= 0xac00 && c <= 0xd7a3)
+    {
+        return (c - 0xac00) % 28 ? H3 : H2;
+    }
+
+    // Find the last range starting at or before the character
+    int low = 0;
+    int high = sizeof(classRanges) / sizeof(classRanges[0]) - 1;
+
+    while(low < high)
+    {
+        int middle = (low + high + 1) / 2;
+
+        if((classRanges[middle] >> 6) <= c)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return (BreakClass)(classRanges[low] & 0x3f);
+}
+
+
+/* Resolve the class of a character at the start of a paragraph, where
+ * there is nothing it could attach to (LB10). */
+static FTLineBreak::BreakClass StartClass(FTLineBreak::BreakClass c)
+{
+    switch(c)
+    {
+        case FTLineBreak::SP:
+            return FTLineBreak::WJ;
+        case FTLineBreak::CM:
+        case FTLineBreak::ZWJ:
+            return FTLineBreak::AL;
+        default:
+            return c;
+    }
+}
+
+
+void FTLineBreak::Find(const unsigned int *text, const int count,
+                       unsigned char *breaks)
+{
+    if(count <= 0)
+    {
+        return;
+    }
+
+    BreakClass previous = Classify(text[0]);  // class of the last character
+    BreakClass before = StartClass(previous); // last class that is not SP
+    bool spaces = false;                      // whether spaces follow it
+    int regional = (before == RI) ? 1 : 0;    // regional indicators in a row
+
+    for(int i = 1; i < count; i++)
+    {
+        BreakClass current = Classify(text[i]);
+        BreakClass raw = current;
+        Action action;
+
+        if(previous == BK || previous == LF || previous == NL
+            || (previous == CR && current != LF))
+        {
+            // LB4, LB5: always break after hard line breaks
+            breaks[i - 1] = MANDATORY;
+
+            previous = current;
+            before = StartClass(current);
+            spaces = false;
+            regional = (before == RI) ? 1 : 0;
+            continue;
+        }
+
+        if(current == BK || current == CR || current == LF || current == NL
+            || current == SP)
+        {
+            // LB6, LB7: never break before hard line breaks or spaces
+            action = PROHIBITED;
+        }
+        else if((current == CM || current == ZWJ) && !spaces && before != ZW)
+        {
+            // LB9: combining marks take the class of their base
+            breaks[i - 1] = PROHIBITED;
+            previous = current;
+            continue;
+        }
+        else
+        {
+            // LB10: other combining marks are alphabetic
+            BreakClass after = (current == CM || current == ZWJ) ? AL
+                                                                 : current;
+
+            switch(pairTable[before][after])
+            {
+                case '_':
+                    action = ALLOWED;
+                    break;
+                case '%':
+                    action = spaces ? ALLOWED : PROHIBITED;
+                    break;
+                default:
+                    action = PROHIBITED;
+                    break;
+            }
+
+            // LB8a: never break after a zero width joiner
+            if(previous == ZWJ)
+            {
+                action = PROHIBITED;
+            }
+
+            // LB30a: break between pairs of regional indicators
+            if(before == RI && after == RI && !spaces)
+            {
+                action = (regional % 2) ? PROHIBITED : ALLOWED;
+            }
+
+            if(after == RI)
+            {
+                regional = (before == RI && !spaces) ? regional + 1 : 1;
+            }
+            else
+            {
+                regional = 0;
+            }
+
+            current = after;
+        }
+
+        breaks[i - 1] = action;
+
+        if(current == SP)
+        {
+            spaces = true;
+        }
+        else if(current != BK && current != CR && current != LF
+                 && current != NL)
+        {
+            before = current;
+            spaces = false;
+        }
+
+        previous = raw;
+    }
+
+    // Hard line breaks also end the line at the end of the text
+    BreakClass last = Classify(text[count - 1]);
+    breaks[count - 1] = (last == BK || last == CR || last == LF || last == NL)
+                         ? MANDATORY : PROHIBITED;
+}
+
@@ -0,0 +1,88 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTLineBreak__
+#define     __FTLineBreak__
+
+
+/**
+ * FTLineBreak finds where a string of unicode characters may be broken
+ * into lines, following the Unicode line breaking algorithm (UAX #14).
+ *
+ * Characters are classified with a compact range table built from the
+ * Unicode 14.0 LineBreak property, and break opportunities are resolved
+ * with the pair table of UAX #14 in a single pass over the string.
+ *
+ * Classes that depend on context are resolved the way UAX #14 suggests
+ * by default: AI, SA, SG and XX are treated as AL, and CJ as NS. The
+ * rule LB21a (Hebrew letter followed by a hyphen) and the East Asian
+ * width exceptions of LB30 are not implemented.
+ */
+class FTLineBreak
+{
+    public:
+        /**
+         * Line breaking classes.
+         */
+        enum BreakClass
+        {
+            OP, CL, CP, QU, GL, NS, EX, SY, IS, PR, PO, NU, AL, HL, ID, IN,
+            HY, BA, BB, B2, ZW, CM, WJ, H2, H3, JL, JV, JT, RI, EB, EM, ZWJ,
+            CB, BK, CR, LF, NL, SP
+        };
+
+        /**
+         * What may happen between two characters.
+         */
+        enum Action
+        {
+            PROHIBITED = 0,
+            ALLOWED = 1,
+            MANDATORY = 2
+        };
+
+        /**
+         * Get the line breaking class of a character.
+         *
+         * @param c  A unicode code point.
+         * @return  The class of the character.
+         */
+        static BreakClass Classify(const unsigned int c);
+
+        /**
+         * Find the break opportunities of a paragraph. The start of the
+         * text is taken as the start of a paragraph.
+         *
+         * @param text  The characters of the paragraph.
+         * @param count  The number of characters.
+         * @param breaks  Receives one Action per character, describing what
+         *                may happen after it. Nothing is allowed after the
+         *                last character unless it ends a line by itself.
+         */
+        static void Find(const unsigned int *text, const int count,
+                         unsigned char *breaks);
+};
+
+
+#endif  //  __FTLineBreak__
+
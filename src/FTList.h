@@ -30,6 +30,9 @@
 
 /**
 * Provides a non-STL alternative to the STL list
+*
+* Items never move once added, so pointers to them stay valid. Nodes are
+* allocated in blocks rather than one at a time.
  */
 template <typename FT_LIST_ITEM_TYPE>
 class FTList
@@ -45,20 +48,20 @@ class FTList
          */
         FTList()
         :   listSize(0),
-            tail(0)
-        {
-            tail = NULL;
-            head = new Node;
-        }
+            tail(0),
+            blocks(0),
+            freeNode(0),
+            freeEnd(0)
+        {}
 
         /**
          * Destructor
          */
         ~FTList()
         {
-            Node* next;
+            Block* next;
 
-            for(Node *walk = head; walk; walk = next)
+            for(Block *walk = blocks; walk; walk = next)
             {
                 next = walk->next;
                 delete walk;
@@ -73,24 +76,54 @@ class FTList
             return listSize;
         }
 
+        /**
+         * Make room for <code>n</code> more items in a single allocation.
+         */
+        void reserve(size_type n)
+        {
+            size_type spare = freeEnd - freeNode;
+            if(spare < n)
+            {
+                grow(n);
+            }
+        }
+
         /**
          * Add an item to the end of the list
          */
         void push_back(const value_type& item)
         {
-            Node* node = new Node(item);
+            emplace_back() = item;
+        }
 
-            if(head->next == NULL)
+        /**
+         * Add a default item to the end of the list and return it, so that
+         * it can be filled in place.
+         */
+        reference emplace_back()
+        {
+            if(freeNode == freeEnd)
             {
-                head->next = node;
+                // Each block is as large as the list so far
+                grow(listSize < 16 ? 16 : listSize);
             }
 
+            Node* node = freeNode++;
+            node->next = NULL;
+            node->payload = value_type();
+
             if(tail)
             {
                 tail->next = node;
             }
+            else
+            {
+                head.next = node;
+            }
             tail = node;
             ++listSize;
+
+            return node->payload;
         }
 
         /**
@@ -98,7 +131,7 @@ class FTList
          */
         reference front() const
         {
-            return head->next->payload;
+            return head.next->payload;
         }
 
         /**
@@ -116,21 +149,50 @@ class FTList
             : next(NULL)
             {}
 
-            Node(const value_type& item)
-            : next(NULL)
-            {
-                payload = item;
-            }
-
             Node* next;
 
             value_type payload;
         };
 
+        struct Block
+        {
+            Block(size_type n)
+            :   next(NULL),
+                nodes(new Node[n])
+            {}
+
+            ~Block()
+            {
+                delete [] nodes;
+            }
+
+            Block* next;
+            Node* nodes;
+        };
+
+        void grow(size_type n)
+        {
+            // Any nodes left in the current block are abandoned
+            Block* block = new Block(n);
+            block->next = blocks;
+            blocks = block;
+
+            freeNode = block->nodes;
+            freeEnd = block->nodes + n;
+        }
+
         size_type listSize;
 
-        Node* head;
+        Node head;
         Node* tail;
+
+        Block* blocks;
+        Node* freeNode;
+        Node* freeEnd;
+
+        /* Disallow copies */
+        FTList(const FTList&);
+        FTList& operator=(const FTList&);
 };
 
 #endif // __FTList__
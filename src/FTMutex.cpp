@@ -0,0 +1,198 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#if defined WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#elif defined HAVE_PTHREAD_H
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+#include "FTMutex.h"
+
+
+#if defined WIN32
+
+FTMutex::FTMutex()
+{
+    CRITICAL_SECTION *cs = new CRITICAL_SECTION;
+    InitializeCriticalSection(cs);
+    handle = cs;
+}
+
+
+FTMutex::~FTMutex()
+{
+    CRITICAL_SECTION *cs = static_cast<CRITICAL_SECTION *>(handle);
+    DeleteCriticalSection(cs);
+    delete cs;
+}
+
+
+void FTMutex::Lock()
+{
+    EnterCriticalSection(static_cast<CRITICAL_SECTION *>(handle));
+}
+
+
+void FTMutex::Unlock()
+{
+    LeaveCriticalSection(static_cast<CRITICAL_SECTION *>(handle));
+}
+
+
+long FTAtomicIncrement(volatile long *count)
+{
+    return InterlockedIncrement(count);
+}
+
+
+long FTAtomicDecrement(volatile long *count)
+{
+    return InterlockedDecrement(count);
+}
+
+
+void FTThreadYield()
+{
+    SwitchToThread();
+}
+
+#elif defined HAVE_PTHREAD_H
+
+FTMutex::FTMutex()
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+    pthread_mutex_t *m = new pthread_mutex_t;
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    handle = m;
+}
+
+
+FTMutex::~FTMutex()
+{
+    pthread_mutex_t *m = static_cast<pthread_mutex_t *>(handle);
+    pthread_mutex_destroy(m);
+    delete m;
+}
+
+
+void FTMutex::Lock()
+{
+    pthread_mutex_lock(static_cast<pthread_mutex_t *>(handle));
+}
+
+
+void FTMutex::Unlock()
+{
+    pthread_mutex_unlock(static_cast<pthread_mutex_t *>(handle));
+}
+
+
+void FTThreadYield()
+{
+    sched_yield();
+}
+
+
+#if defined __GNUC__
+
+long FTAtomicIncrement(volatile long *count)
+{
+    return __sync_add_and_fetch(count, 1);
+}
+
+
+long FTAtomicDecrement(volatile long *count)
+{
+    return __sync_sub_and_fetch(count, 1);
+}
+
+#else
+
+// Without compiler builtins, all counts share one lock
+static pthread_mutex_t countMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+long FTAtomicIncrement(volatile long *count)
+{
+    pthread_mutex_lock(&countMutex);
+    long result = ++*count;
+    pthread_mutex_unlock(&countMutex);
+    return result;
+}
+
+
+long FTAtomicDecrement(volatile long *count)
+{
+    pthread_mutex_lock(&countMutex);
+    long result = --*count;
+    pthread_mutex_unlock(&countMutex);
+    return result;
+}
+
+#endif
+
+#else
+
+FTMutex::FTMutex()
+:   handle(0)
+{}
+
+
+FTMutex::~FTMutex()
+{}
+
+
+void FTMutex::Lock()
+{}
+
+
+void FTMutex::Unlock()
+{}
+
+
+long FTAtomicIncrement(volatile long *count)
+{
+    return ++*count;
+}
+
+
+long FTAtomicDecrement(volatile long *count)
+{
+    return --*count;
+}
+
+
+void FTThreadYield()
+{}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTMutex__
+#define     __FTMutex__
+
+
+/**
+ * FTMutex is a minimal recursive lock used to protect the few pieces of
+ * state FTGL shares between threads.
+ *
+ * The platform specific data is kept behind an opaque pointer so that the
+ * layout of this class does not depend on config.h. On platforms without
+ * thread support (or when configured with --disable-threads) locking is a
+ * no-op.
+ *
+ * The lock is recursive because font methods call each other, e.g.
+ * FTBufferFont::Render() calls BBox() on the same font.
+ */
+class FTMutex
+{
+    public:
+        /**
+         * Constructor
+         */
+        FTMutex();
+
+        /**
+         * Destructor
+         */
+        ~FTMutex();
+
+        /**
+         * Acquire the lock, blocking until it is available.
+         */
+        void Lock();
+
+        /**
+         * Release the lock.
+         */
+        void Unlock();
+
+    private:
+        /**
+         * Disallow copies.
+         */
+        FTMutex(const FTMutex&);
+        FTMutex& operator=(const FTMutex&);
+
+        /**
+         * Native mutex handle.
+         */
+        void* handle;
+};
+
+
+/**
+ * FTMutexLock holds an FTMutex for the lifetime of the object.
+ */
+class FTMutexLock
+{
+    public:
+        FTMutexLock(FTMutex& m) : mutex(m) { mutex.Lock(); }
+
+        ~FTMutexLock() { mutex.Unlock(); }
+
+    private:
+        FTMutexLock(const FTMutexLock&);
+        FTMutexLock& operator=(const FTMutexLock&);
+
+        FTMutex& mutex;
+};
+
+
+/**
+ * Add one to a reference count shared between threads.
+ *
+ * @param count  The count.
+ * @return  The new count.
+ */
+long FTAtomicIncrement(volatile long *count);
+
+/**
+ * Subtract one from a reference count shared between threads.
+ *
+ * @param count  The count.
+ * @return  The new count.
+ */
+long FTAtomicDecrement(volatile long *count);
+
+/**
+ * Let other threads run, while waiting for them to finish something.
+ */
+void FTThreadYield();
+
+#endif  //  __FTMutex__
@@ -0,0 +1,148 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTPointf__
+#define     __FTPointf__
+
+#include "FTGL/ftgl.h"
+
+
+/* Where the heap returns 16 byte aligned blocks, which is the case on the
+ * 64 bit platforms, the compact types are aligned to match so that a
+ * compiler may load a whole point at once. Elsewhere they keep the same
+ * 16 byte size but only the alignment of a float. */
+#if defined _MSC_VER && defined _WIN64
+#   define FTGL_ALIGN16 __declspec(align(16))
+#elif defined __GNUC__ && defined __LP64__
+#   define FTGL_ALIGN16 __attribute__((aligned(16)))
+#else
+#   define FTGL_ALIGN16
+#endif
+
+
+/**
+ * FTPointf is a single precision point, used inside FTGL where many points
+ * are kept or added up: pen positions, glyph positions of a layout and
+ * texture coordinates.
+ *
+ * It takes 16 bytes where an FTPoint takes 24, and its fourth coordinate,
+ * always zero, lets the arithmetic work on four floats at a time. It
+ * converts to FTPoint for the public interfaces, which stay in double
+ * precision.
+ */
+class FTGL_ALIGN16 FTPointf
+{
+    friend class FTBBoxf;
+
+    public:
+        FTPointf()
+        {
+            values[0] = values[1] = values[2] = values[3] = 0.0f;
+        }
+
+        FTPointf(const float x, const float y, const float z = 0.0f)
+        {
+            values[0] = x;
+            values[1] = y;
+            values[2] = z;
+            values[3] = 0.0f;
+        }
+
+        explicit FTPointf(const FTPoint& point)
+        {
+            values[0] = point.Xf();
+            values[1] = point.Yf();
+            values[2] = point.Zf();
+            values[3] = 0.0f;
+        }
+
+        operator FTPoint() const
+        {
+            return FTPoint(values[0], values[1], values[2]);
+        }
+
+        FTPointf& operator += (const FTPointf& point)
+        {
+            for(int i = 0; i < 4; i++)
+            {
+                values[i] += point.values[i];
+            }
+
+            return *this;
+        }
+
+        FTPointf operator + (const FTPointf& point) const
+        {
+            FTPointf temp(*this);
+            return temp += point;
+        }
+
+        FTPointf& operator -= (const FTPointf& point)
+        {
+            for(int i = 0; i < 4; i++)
+            {
+                values[i] -= point.values[i];
+            }
+
+            return *this;
+        }
+
+        FTPointf operator - (const FTPointf& point) const
+        {
+            FTPointf temp(*this);
+            return temp -= point;
+        }
+
+        FTPointf operator * (const float multiplier) const
+        {
+            FTPointf temp;
+            for(int i = 0; i < 4; i++)
+            {
+                temp.values[i] = values[i] * multiplier;
+            }
+
+            return temp;
+        }
+
+        void X(const float x) { values[0] = x; }
+        void Y(const float y) { values[1] = y; }
+        void Z(const float z) { values[2] = z; }
+
+        float Xf() const { return values[0]; }
+        float Yf() const { return values[1]; }
+        float Zf() const { return values[2]; }
+
+        /**
+         * The coordinates, for glVertex3fv() and the like.
+         */
+        const float *Values() const { return values; }
+
+    private:
+        /**
+         * The x, y and z coordinates, and a fourth one kept at zero.
+         */
+        float values[4];
+};
+
+#endif  //  __FTPointf__
+
@@ -0,0 +1,222 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include "FTInternals.h"
+
+#ifdef HAVE_HARFBUZZ
+#   include <hb.h>
+#   include <hb-ft.h>
+#endif
+
+
+//
+//  FTShaper
+//
+
+
+FTShaper::~FTShaper()
+{
+}
+
+
+//
+//  FTHarfBuzzShaperImpl
+//
+
+
+class FTHarfBuzzShaperImpl
+{
+    public:
+        FTHarfBuzzShaperImpl()
+#ifdef HAVE_HARFBUZZ
+        :   face(0),
+            font(0),
+            xScale(0),
+            yScale(0)
+        {
+            buffer = hb_buffer_create();
+        }
+#else
+        {}
+#endif
+
+        ~FTHarfBuzzShaperImpl()
+        {
+#ifdef HAVE_HARFBUZZ
+            if(font)
+            {
+                hb_font_destroy(font);
+            }
+
+            hb_buffer_destroy(buffer);
+#endif
+        }
+
+#ifdef HAVE_HARFBUZZ
+        /**
+         * The face the HarfBuzz font was made for.
+         */
+        FT_Face face;
+
+        /**
+         * The HarfBuzz font, reading the tables of the face.
+         */
+        hb_font_t *font;
+
+        /**
+         * The size the font was made for, to notice FaceSize() changes.
+         */
+        FT_Fixed xScale, yScale;
+
+        /**
+         * The characters being shaped, reused across calls.
+         */
+        hb_buffer_t *buffer;
+#endif
+};
+
+
+//
+//  FTHarfBuzzShaper
+//
+
+
+FTHarfBuzzShaper::FTHarfBuzzShaper()
+{
+    impl = new FTHarfBuzzShaperImpl();
+}
+
+
+FTHarfBuzzShaper::~FTHarfBuzzShaper()
+{
+    delete impl;
+}
+
+
+bool FTHarfBuzzShaper::Available()
+{
+#ifdef HAVE_HARFBUZZ
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+int FTHarfBuzzShaper::Shape(FT_Face face, const unsigned int *text,
+                            const int count, const bool rightToLeft,
+                            FTShapedGlyph *glyphs, const int maxGlyphs)
+{
+#ifdef HAVE_HARFBUZZ
+    if(!face || !face->size)
+    {
+        return -1;
+    }
+
+    // The font caches the scale of the face, so follow size changes
+    if(impl->face != face)
+    {
+        if(impl->font)
+        {
+            hb_font_destroy(impl->font);
+        }
+
+        impl->face = face;
+        impl->font = hb_ft_font_create_referenced(face);
+    }
+    else if(impl->xScale != face->size->metrics.x_scale
+             || impl->yScale != face->size->metrics.y_scale)
+    {
+        hb_ft_font_changed(impl->font);
+    }
+
+    impl->xScale = face->size->metrics.x_scale;
+    impl->yScale = face->size->metrics.y_scale;
+
+    hb_buffer_clear_contents(impl->buffer);
+    hb_buffer_add_utf32(impl->buffer, (const uint32_t *)text, count, 0, count);
+    hb_buffer_set_direction(impl->buffer, rightToLeft ? HB_DIRECTION_RTL
+                                                      : HB_DIRECTION_LTR);
+    hb_buffer_guess_segment_properties(impl->buffer);
+    hb_shape(impl->font, impl->buffer, NULL, 0);
+
+    unsigned int n = 0;
+    hb_glyph_info_t *info = hb_buffer_get_glyph_infos(impl->buffer, &n);
+    hb_glyph_position_t *pos = hb_buffer_get_glyph_positions(impl->buffer,
+                                                             NULL);
+
+    // Positions are in 26.6 fixed point, like FreeType's
+    for(int i = 0; i < (int)n && i < maxGlyphs; i++)
+    {
+        glyphs[i].index = info[i].codepoint;
+        glyphs[i].cluster = info[i].cluster;
+        glyphs[i].advance = FTPoint(pos[i].x_advance / 64.0,
+                                    pos[i].y_advance / 64.0);
+        glyphs[i].offset = FTPoint(pos[i].x_offset / 64.0,
+                                   pos[i].y_offset / 64.0);
+    }
+
+    return n;
+#else
+    (void)face; (void)text; (void)count; (void)rightToLeft;
+    (void)glyphs; (void)maxGlyphs;
+    return -1;
+#endif
+}
+
+
+//
+//  C API
+//
+
+
+FTGL_BEGIN_C_DECLS
+
+FTGLshaper *ftglCreateHarfBuzzShaper(void)
+{
+    if(!FTHarfBuzzShaper::Available())
+    {
+        return NULL;
+    }
+
+    FTGLshaper *ftgl = (FTGLshaper *)malloc(sizeof(FTGLshaper));
+    ftgl->ptr = new FTHarfBuzzShaper();
+    return ftgl;
+}
+
+
+void ftglDestroyShaper(FTGLshaper *s)
+{
+    if(!s || !s->ptr)
+    {
+        fprintf(stderr, "FTGL warning: NULL pointer in %s\n", __FUNC__);
+        return;
+    }
+    delete s->ptr;
+    free(s);
+}
+
+FTGL_END_C_DECLS
+
@@ -46,7 +46,7 @@ bool FTSize::CharSize(FT_Face* face, unsigned int pointSize, unsigned int xRes,
 {
     if(size != pointSize || xResolution != xRes || yResolution != yRes)
     {
-        err = FT_Set_Char_Size(*face, 0L, pointSize * 64, xResolution, yResolution);
+        err = FT_Set_Char_Size(*face, 0L, pointSize * 64, xRes, yRes);
 
         if(!err)
         {
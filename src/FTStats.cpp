@@ -0,0 +1,190 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#if defined WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <sys/time.h>
+#   include <time.h>
+#endif
+
+#include "FTMutex.h"
+#include "FTStats.h"
+
+
+/* The live statistics, and the totals of the fonts already destroyed */
+static FTStats *head = 0;
+static FTGL_UINT64 retired[FTStats::COUNT];
+static FTGL_UINT64 globalBaseline[FTStats::COUNT];
+
+
+static FTMutex& ListMutex()
+{
+    static FTMutex mutex;
+    return mutex;
+}
+
+
+FTStats::FTStats(FTMutex& lock)
+:   mutex(lock),
+    prev(0)
+{
+    for(int i = 0; i < COUNT; i++)
+    {
+        values[i] = baseline[i] = 0;
+    }
+
+    FTMutexLock listLock(ListMutex());
+
+    next = head;
+    if(head)
+    {
+        head->prev = this;
+    }
+    head = this;
+}
+
+
+FTStats::~FTStats()
+{
+    FTMutexLock listLock(ListMutex());
+
+    for(int i = 0; i < COUNT; i++)
+    {
+        if(!IsGauge(i))
+        {
+            retired[i] += values[i];
+        }
+    }
+
+    if(prev)
+    {
+        prev->next = next;
+    }
+    else
+    {
+        head = next;
+    }
+
+    if(next)
+    {
+        next->prev = prev;
+    }
+}
+
+
+FTGL_UINT64 FTStats::Get(FTGL::Statistic which) const
+{
+    if((int)which < 0 || (int)which >= COUNT)
+    {
+        return 0;
+    }
+
+    return values[which] - baseline[which];
+}
+
+
+void FTStats::Reset()
+{
+    for(int i = 0; i < COUNT; i++)
+    {
+        if(!IsGauge(i))
+        {
+            baseline[i] = values[i];
+        }
+    }
+}
+
+
+FTGL_UINT64 FTStats::Global(FTGL::Statistic which)
+{
+    if((int)which < 0 || (int)which >= COUNT)
+    {
+        return 0;
+    }
+
+    FTMutexLock listLock(ListMutex());
+
+    // Unsigned arithmetic wraps, so the baseline can be taken off first
+    FTGL_UINT64 total = 0;
+    if(!IsGauge(which))
+    {
+        total = retired[which] - globalBaseline[which];
+    }
+
+    for(const FTStats *s = head; s; s = s->next)
+    {
+        FTMutexLock fontLock(s->mutex);
+        total += s->values[which];
+    }
+
+    return total;
+}
+
+
+void FTStats::ResetGlobal()
+{
+    FTMutexLock listLock(ListMutex());
+
+    for(int i = 0; i < COUNT; i++)
+    {
+        globalBaseline[i] = retired[i];
+    }
+
+    for(const FTStats *s = head; s; s = s->next)
+    {
+        FTMutexLock fontLock(s->mutex);
+
+        for(int i = 0; i < COUNT; i++)
+        {
+            if(!IsGauge(i))
+            {
+                globalBaseline[i] += s->values[i];
+            }
+        }
+    }
+}
+
+
+FTGL_UINT64 FTStats::Now()
+{
+#if defined WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (FTGL_UINT64)((double)counter.QuadPart * 1e9
+                          / (double)frequency.QuadPart);
+#elif defined HAVE_CLOCK_GETTIME && defined CLOCK_MONOTONIC
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (FTGL_UINT64)t.tv_sec * 1000000000u + (FTGL_UINT64)t.tv_nsec;
+#else
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return (FTGL_UINT64)t.tv_sec * 1000000000u
+            + (FTGL_UINT64)t.tv_usec * 1000u;
+#endif
+}
@@ -0,0 +1,172 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTStats__
+#define     __FTStats__
+
+#include "FTGL/ftgl.h"
+
+class FTMutex;
+
+
+/**
+ * FTStats holds the statistics of one font.
+ *
+ * The values are plain integers updated under the lock of the font that
+ * owns them, which every FTFont entry point already holds, so counting
+ * costs no more than an increment. The totals over all fonts are summed
+ * on demand from a list of the live statistics plus what the destroyed
+ * fonts left behind.
+ *
+ * Resetting never clears the values themselves: a baseline is recorded
+ * and subtracted when reading, so that resetting one font does not
+ * change the totals and resetting the totals does not change any font.
+ */
+class FTStats
+{
+    public:
+        /**
+         * Number of statistics.
+         */
+        enum { COUNT = FTGL::STAT_ATLAS_TEXELS_USED + 1 };
+
+        /**
+         * Constructor
+         *
+         * @param lock  The lock held while the statistics are updated.
+         */
+        FTStats(FTMutex& lock);
+
+        /**
+         * Destructor
+         */
+        ~FTStats();
+
+        /**
+         * Add to a counter, a timer or a gauge.
+         */
+        void Add(FTGL::Statistic which, FTGL_UINT64 n = 1)
+        {
+            values[which] += n;
+        }
+
+        /**
+         * Set a gauge.
+         */
+        void Set(FTGL::Statistic which, FTGL_UINT64 n)
+        {
+            values[which] = n;
+        }
+
+        /**
+         * Get a statistic since the last Reset(). The caller holds the
+         * lock given to the constructor.
+         *
+         * @param which  The statistic. Out of range values read as zero.
+         */
+        FTGL_UINT64 Get(FTGL::Statistic which) const;
+
+        /**
+         * Restart the counters and timers from zero. Gauges are left
+         * alone.
+         */
+        void Reset();
+
+        /**
+         * Get a statistic summed over all fonts, including the ones that
+         * have been destroyed, since the last ResetGlobal().
+         */
+        static FTGL_UINT64 Global(FTGL::Statistic which);
+
+        /**
+         * Restart the global counters and timers from zero.
+         */
+        static void ResetGlobal();
+
+        /**
+         * A monotonic clock for the timers.
+         *
+         * @return  The time in nanoseconds from an arbitrary origin.
+         */
+        static FTGL_UINT64 Now();
+
+    private:
+        /**
+         * Whether a statistic describes current state rather than
+         * counting events.
+         */
+        static bool IsGauge(int which)
+        {
+            return which >= FTGL::STAT_ATLAS_TEXTURES;
+        }
+
+        /**
+         * Disallow copies.
+         */
+        FTStats(const FTStats&);
+        FTStats& operator=(const FTStats&);
+
+        FTGL_UINT64 values[COUNT];
+
+        FTGL_UINT64 baseline[COUNT];
+
+        FTMutex& mutex;
+
+        /**
+         * The list of live statistics.
+         */
+        FTStats *prev;
+        FTStats *next;
+};
+
+
+/**
+ * FTStatsTimer counts an event and adds its duration, the lifetime of the
+ * timer, to a timer statistic.
+ */
+class FTStatsTimer
+{
+    public:
+        FTStatsTimer(FTStats& s, FTGL::Statistic count, FTGL::Statistic time)
+        :   stats(s),
+            timer(time),
+            start(FTStats::Now())
+        {
+            stats.Add(count);
+        }
+
+        ~FTStatsTimer()
+        {
+            stats.Add(timer, FTStats::Now() - start);
+        }
+
+    private:
+        FTStatsTimer(const FTStatsTimer&);
+        FTStatsTimer& operator=(const FTStatsTimer&);
+
+        FTStats& stats;
+        FTGL::Statistic timer;
+        FTGL_UINT64 start;
+};
+
+#endif  //  __FTStats__
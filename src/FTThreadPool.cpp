@@ -0,0 +1,317 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#if defined WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#elif defined HAVE_PTHREAD_H
+#   include <pthread.h>
+#   include <unistd.h>
+#endif
+
+#include "FTThreadPool.h"
+
+
+/* Upper bound on the number of worker threads of the shared pool. */
+static const int MAX_WORKERS = 15;
+
+
+#if defined WIN32 || defined HAVE_PTHREAD_H
+
+#if defined WIN32
+    typedef CRITICAL_SECTION   PoolLock;
+    typedef CONDITION_VARIABLE PoolCond;
+    typedef HANDLE             PoolThread;
+
+    static inline void LockInit(PoolLock *l) { InitializeCriticalSection(l); }
+    static inline void LockDone(PoolLock *l) { DeleteCriticalSection(l); }
+    static inline void Lock(PoolLock *l) { EnterCriticalSection(l); }
+    static inline void Unlock(PoolLock *l) { LeaveCriticalSection(l); }
+    static inline void CondInit(PoolCond *c) { InitializeConditionVariable(c); }
+    static inline void CondDone(PoolCond *c) { (void)c; }
+    static inline void CondWait(PoolCond *c, PoolLock *l)
+    {
+        SleepConditionVariableCS(c, l, INFINITE);
+    }
+    static inline void CondBroadcast(PoolCond *c) { WakeAllConditionVariable(c); }
+#else
+    typedef pthread_mutex_t PoolLock;
+    typedef pthread_cond_t  PoolCond;
+    typedef pthread_t       PoolThread;
+
+    static inline void LockInit(PoolLock *l) { pthread_mutex_init(l, 0); }
+    static inline void LockDone(PoolLock *l) { pthread_mutex_destroy(l); }
+    static inline void Lock(PoolLock *l) { pthread_mutex_lock(l); }
+    static inline void Unlock(PoolLock *l) { pthread_mutex_unlock(l); }
+    static inline void CondInit(PoolCond *c) { pthread_cond_init(c, 0); }
+    static inline void CondDone(PoolCond *c) { pthread_cond_destroy(c); }
+    static inline void CondWait(PoolCond *c, PoolLock *l)
+    {
+        pthread_cond_wait(c, l);
+    }
+    static inline void CondBroadcast(PoolCond *c) { pthread_cond_broadcast(c); }
+#endif
+
+
+struct FTThreadPoolData
+{
+    PoolLock lock;
+    PoolCond wake;   // signalled when a batch starts or the pool stops
+    PoolCond done;   // signalled when the last task of a batch completes
+
+    PoolThread *threads;
+    int numThreads;
+
+    FTThreadPool::Task task;
+    void *data;
+    int count;       // number of tasks in the current batch
+    int next;        // next task to hand out
+    int pending;     // tasks handed out or queued but not yet finished
+
+    bool busy;
+    bool quit;
+};
+
+
+/* Take tasks from the current batch until there are none left. Must be
+ * called with the lock held; returns with the lock held. */
+static void RunTasks(FTThreadPoolData *p)
+{
+    while(p->next < p->count)
+    {
+        int index = p->next++;
+        FTThreadPool::Task task = p->task;
+        void *data = p->data;
+
+        Unlock(&p->lock);
+        task(data, index);
+        Lock(&p->lock);
+
+        if(--p->pending == 0)
+        {
+            CondBroadcast(&p->done);
+        }
+    }
+}
+
+
+#if defined WIN32
+static DWORD WINAPI WorkerMain(LPVOID arg)
+#else
+static void *WorkerMain(void *arg)
+#endif
+{
+    FTThreadPoolData *p = static_cast<FTThreadPoolData *>(arg);
+
+    Lock(&p->lock);
+    while(!p->quit)
+    {
+        if(p->next < p->count)
+        {
+            RunTasks(p);
+        }
+        else
+        {
+            CondWait(&p->wake, &p->lock);
+        }
+    }
+    Unlock(&p->lock);
+
+    return 0;
+}
+
+
+static int CPUCount()
+{
+#if defined WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#elif defined _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+
+FTThreadPool& FTThreadPool::Instance()
+{
+    static FTThreadPool pool(CPUCount() - 1 < MAX_WORKERS
+                              ? CPUCount() - 1 : MAX_WORKERS);
+    return pool;
+}
+
+
+FTThreadPool::FTThreadPool(int workers)
+{
+    FTThreadPoolData *p = new FTThreadPoolData;
+
+    LockInit(&p->lock);
+    CondInit(&p->wake);
+    CondInit(&p->done);
+
+    p->task = 0;
+    p->data = 0;
+    p->count = p->next = p->pending = 0;
+    p->busy = p->quit = false;
+
+    p->numThreads = 0;
+    p->threads = workers > 0 ? new PoolThread[workers] : 0;
+
+    for(int i = 0; i < workers; i++)
+    {
+#if defined WIN32
+        PoolThread t = CreateThread(NULL, 0, WorkerMain, p, 0, NULL);
+        if(t == NULL)
+        {
+            break;
+        }
+#else
+        PoolThread t;
+        if(pthread_create(&t, NULL, WorkerMain, p) != 0)
+        {
+            break;
+        }
+#endif
+        p->threads[p->numThreads++] = t;
+    }
+
+    handle = p;
+}
+
+
+FTThreadPool::~FTThreadPool()
+{
+    FTThreadPoolData *p = static_cast<FTThreadPoolData *>(handle);
+
+    Lock(&p->lock);
+    p->quit = true;
+    CondBroadcast(&p->wake);
+    Unlock(&p->lock);
+
+    for(int i = 0; i < p->numThreads; i++)
+    {
+#if defined WIN32
+        WaitForSingleObject(p->threads[i], INFINITE);
+        CloseHandle(p->threads[i]);
+#else
+        pthread_join(p->threads[i], NULL);
+#endif
+    }
+
+    delete[] p->threads;
+    CondDone(&p->done);
+    CondDone(&p->wake);
+    LockDone(&p->lock);
+    delete p;
+}
+
+
+int FTThreadPool::ThreadCount() const
+{
+    return static_cast<FTThreadPoolData *>(handle)->numThreads + 1;
+}
+
+
+void FTThreadPool::Run(Task task, void *data, int count)
+{
+    FTThreadPoolData *p = static_cast<FTThreadPoolData *>(handle);
+
+    Lock(&p->lock);
+
+    // Another thread owns the workers: do the work ourselves rather than
+    // queueing behind it.
+    if(p->busy || p->numThreads == 0 || count < 2)
+    {
+        Unlock(&p->lock);
+
+        for(int i = 0; i < count; i++)
+        {
+            task(data, i);
+        }
+
+        return;
+    }
+
+    p->busy = true;
+    p->task = task;
+    p->data = data;
+    p->count = count;
+    p->next = 0;
+    p->pending = count;
+    CondBroadcast(&p->wake);
+
+    RunTasks(p);
+
+    while(p->pending > 0)
+    {
+        CondWait(&p->done, &p->lock);
+    }
+
+    p->task = 0;
+    p->data = 0;
+    p->count = p->next = 0;
+    p->busy = false;
+
+    Unlock(&p->lock);
+}
+
+#else
+
+FTThreadPool& FTThreadPool::Instance()
+{
+    static FTThreadPool pool(0);
+    return pool;
+}
+
+
+FTThreadPool::FTThreadPool(int workers)
+:   handle(0)
+{
+    (void)workers;
+}
+
+
+FTThreadPool::~FTThreadPool()
+{}
+
+
+int FTThreadPool::ThreadCount() const
+{
+    return 1;
+}
+
+
+void FTThreadPool::Run(Task task, void *data, int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        task(data, i);
+    }
+}
+
+#endif
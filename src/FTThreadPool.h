@@ -0,0 +1,101 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTThreadPool__
+#define     __FTThreadPool__
+
+
+/**
+ * FTThreadPool runs small batches of independent tasks on a fixed set of
+ * worker threads.
+ *
+ * The pool is used for CPU-only work such as blitting glyphs into an
+ * FTBuffer. The calling thread takes part in the work and
+ * <code>Run()</code> only returns once every task has completed. If the
+ * pool is already busy with another batch, or if FTGL was built without
+ * thread support, the tasks are simply run in the calling thread.
+ *
+ * Like FTMutex, the platform data is hidden behind an opaque pointer.
+ */
+class FTThreadPool
+{
+    public:
+        /**
+         * A task callback. <code>index</code> goes from 0 to the task count
+         * passed to <code>Run()</code>, minus one.
+         */
+        typedef void (*Task)(void *data, int index);
+
+        /**
+         * Global access point to the shared pool. It is created on first
+         * use with one worker per additional CPU core.
+         *
+         * @return  The shared FTThreadPool object.
+         */
+        static FTThreadPool& Instance();
+
+        /**
+         * Constructor
+         *
+         * @param workers  The number of worker threads to start, not
+         *                 counting the threads calling <code>Run()</code>.
+         */
+        FTThreadPool(int workers);
+
+        /**
+         * Destructor. Stops and joins the worker threads.
+         */
+        ~FTThreadPool();
+
+        /**
+         * Get the number of threads that may run tasks concurrently,
+         * including the calling thread.
+         *
+         * @return  The thread count, at least one.
+         */
+        int ThreadCount() const;
+
+        /**
+         * Run <code>task(data, i)</code> for every <code>i</code> in
+         * <code>[0, count)</code> and wait for all of them to finish.
+         *
+         * @param task   The task callback.
+         * @param data   Opaque data passed to every task.
+         * @param count  The number of tasks.
+         */
+        void Run(Task task, void *data, int count);
+
+    private:
+        /**
+         * Disallow copies.
+         */
+        FTThreadPool(const FTThreadPool&);
+        FTThreadPool& operator=(const FTThreadPool&);
+
+        /**
+         * Native threads and synchronisation objects.
+         */
+        void* handle;
+};
+
+#endif  //  __FTThreadPool__
@@ -0,0 +1,415 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+
+#include "FTInternals.h"
+#include "FTMutex.h"
+#include "FTStats.h"
+#include "FTTraceSpan.h"
+
+
+#ifdef FTGL_TRACING
+
+/* Spans nest per thread, so the current one is kept in thread local
+ * storage where the compiler offers it */
+#if defined _MSC_VER
+#   define FTGL_THREAD_LOCAL __declspec(thread)
+#elif defined __GNUC__
+#   define FTGL_THREAD_LOCAL __thread
+#else
+#   define FTGL_THREAD_LOCAL
+#endif
+
+
+//
+//  FTTraceSpan
+//
+
+
+volatile bool FTTraceSpan::enabled = false;
+
+/* The current sink, changed and taken by spans under the lock */
+static FTTraceSpan::Sink *currentSink = 0;
+static FTMutex sinkMutex;
+
+static FTGL_THREAD_LOCAL FTTraceSpan *currentSpan = 0;
+static FTGL_THREAD_LOCAL unsigned int currentThread = 0;
+
+
+static unsigned int ThreadNumber()
+{
+    if(!currentThread)
+    {
+        static FTMutex mutex;
+        static unsigned int threads = 0;
+
+        FTMutexLock lock(mutex);
+        currentThread = ++threads;
+    }
+
+    return currentThread;
+}
+
+
+void FTTraceSpan::SetCallback(FTTraceCallback callback, void *data)
+{
+    Sink *next = 0;
+
+    if(callback)
+    {
+        next = new Sink;
+        next->callback = callback;
+        next->data = data;
+        next->spans = 0;
+    }
+
+    Replace(next, true, 0, 0);
+}
+
+
+void FTTraceSpan::RemoveCallback(FTTraceCallback callback, void *data)
+{
+    Replace(0, false, callback, data);
+}
+
+
+void FTTraceSpan::Replace(Sink *next, bool always, FTTraceCallback callback,
+                          void *data)
+{
+    Sink *previous;
+
+    {
+        FTMutexLock lock(sinkMutex);
+
+        previous = currentSink;
+
+        if(!always && (!previous || previous->callback != callback
+                        || previous->data != data))
+        {
+            delete next;
+            return;
+        }
+
+        currentSink = next;
+        enabled = (next != 0);
+    }
+
+    // Steps that started with the previous sink still report to it
+    if(previous)
+    {
+        while(previous->spans)
+        {
+            FTThreadYield();
+        }
+
+        delete previous;
+    }
+}
+
+
+void FTTraceSpan::Begin(FTGL::TracePhase phase, const void *font,
+                        unsigned int character, unsigned int glyph)
+{
+    {
+        FTMutexLock lock(sinkMutex);
+
+        sink = currentSink;
+        if(!sink)
+        {
+            return;
+        }
+
+        FTAtomicIncrement(&sink->spans);
+    }
+
+    parent = currentSpan;
+    currentSpan = this;
+
+    if(!font && parent)
+    {
+        font = parent->event.font;
+
+        if(!glyph || glyph == parent->event.glyph)
+        {
+            glyph = parent->event.glyph;
+            character = parent->event.character;
+        }
+    }
+
+    event.phase = phase;
+    event.begin = 1;
+    event.font = font;
+    event.character = character;
+    event.glyph = glyph;
+    event.thread = ThreadNumber();
+    event.time = FTStats::Now();
+
+    sink->callback(&event, sink->data);
+}
+
+
+void FTTraceSpan::End()
+{
+    currentSpan = parent;
+
+    // The step reports to the sink it started with, which is kept until
+    // its last step has ended
+    event.begin = 0;
+    event.time = FTStats::Now();
+
+    sink->callback(&event, sink->data);
+
+    FTAtomicDecrement(&sink->spans);
+}
+
+#endif // FTGL_TRACING
+
+
+//
+//  FTTrace
+//
+
+
+bool FTTrace::Available()
+{
+#ifdef FTGL_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool FTTrace::SetCallback(FTTraceCallback callback, void *data)
+{
+#ifdef FTGL_TRACING
+    FTTraceSpan::SetCallback(callback, data);
+    return true;
+#else
+    (void)callback; (void)data;
+    return false;
+#endif
+}
+
+
+//
+//  FTChromeTraceImpl
+//
+
+
+class FTChromeTraceImpl
+{
+    public:
+        FTChromeTraceImpl(const char *fileName)
+        :   events(0),
+            err(0)
+        {
+            start = FTStats::Now();
+
+            if(!FTTrace::Available())
+            {
+                file = NULL;
+                err = 0x07; // Unimplemented_Feature
+                return;
+            }
+
+            file = fopen(fileName, "w");
+            if(!file)
+            {
+                err = 0x51; // Cannot_Open_Stream
+                return;
+            }
+
+            fputs("{\"traceEvents\":[\n", file);
+            FTTrace::SetCallback(Write, this);
+        }
+
+        ~FTChromeTraceImpl()
+        {
+            Stop();
+        }
+
+        void Stop()
+        {
+#ifdef FTGL_TRACING
+            FTTraceSpan::RemoveCallback(Write, this);
+#endif
+
+            FTMutexLock lock(mutex);
+
+            if(file)
+            {
+                fputs("\n],\"displayTimeUnit\":\"ns\"}\n", file);
+
+                if(ferror(file) || fclose(file))
+                {
+                    err = 0x55; // Invalid_Stream_Operation
+                }
+
+                file = NULL;
+            }
+        }
+
+        static void Write(const FTTraceEvent *event, void *data)
+        {
+            static const char *names[] =
+            {
+                "glyph", "load", "make glyph", "rasterise",
+                "tessellate", "compile", "upload", "render"
+            };
+
+            FTChromeTraceImpl *trace = static_cast<FTChromeTraceImpl *>(data);
+            FTMutexLock lock(trace->mutex);
+
+            if(!trace->file)
+            {
+                return;
+            }
+
+            const char *name = "unknown";
+            if(event->phase >= 0
+                && event->phase < (int)(sizeof(names) / sizeof(names[0])))
+            {
+                name = names[event->phase];
+            }
+
+            // Time stamps are in microseconds from the start of the trace
+            double us = (double)(event->time - trace->start) / 1000.0;
+
+            fprintf(trace->file,
+                    "%s{\"name\":\"%s\",\"cat\":\"ftgl\",\"ph\":\"%s\","
+                    "\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                    trace->events ? ",\n" : "", name,
+                    event->begin ? "B" : "E", us, event->thread);
+
+            if(event->begin)
+            {
+                fprintf(trace->file,
+                        ",\"args\":{\"font\":\"%p\",\"character\":%u,"
+                        "\"glyph\":%u}", event->font, event->character,
+                        event->glyph);
+            }
+
+            fputs("}", trace->file);
+            trace->events++;
+        }
+
+        /**
+         * The file being written, or NULL once the trace has stopped.
+         */
+        FILE *file;
+
+        /**
+         * Serialises the events of several threads.
+         */
+        FTMutex mutex;
+
+        /**
+         * When the trace started, in nanoseconds.
+         */
+        FTGL_UINT64 start;
+
+        /**
+         * Number of events written.
+         */
+        unsigned long events;
+
+        /**
+         * Current error code. Zero means no error.
+         */
+        FT_Error err;
+};
+
+
+//
+//  FTChromeTrace
+//
+
+
+FTChromeTrace::FTChromeTrace(const char *fileName)
+:   impl(new FTChromeTraceImpl(fileName))
+{
+}
+
+
+FTChromeTrace::~FTChromeTrace()
+{
+    delete impl;
+}
+
+
+void FTChromeTrace::Stop()
+{
+    impl->Stop();
+}
+
+
+int FTChromeTrace::Error() const
+{
+    return impl->err;
+}
+
+
+//
+//  C API
+//
+
+
+FTGL_BEGIN_C_DECLS
+
+static FTChromeTrace *chromeTrace = NULL;
+
+
+int ftglSetTraceCallback(FTTraceCallback callback, void *data)
+{
+    return FTTrace::SetCallback(callback, data) ? 1 : 0;
+}
+
+
+int ftglStartChromeTrace(const char *fileName)
+{
+    delete chromeTrace;
+    chromeTrace = new FTChromeTrace(fileName);
+
+    if(chromeTrace->Error())
+    {
+        delete chromeTrace;
+        chromeTrace = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+
+void ftglStopChromeTrace(void)
+{
+    delete chromeTrace;
+    chromeTrace = NULL;
+}
+
+FTGL_END_C_DECLS
+
@@ -0,0 +1,163 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef     __FTTraceSpan__
+#define     __FTTraceSpan__
+
+#include "FTGL/ftgl.h"
+
+
+#ifdef FTGL_TRACING
+
+/**
+ * FTTraceSpan reports the start of a step to the trace callback when it is
+ * made, and the end of the step when it goes out of scope.
+ *
+ * A span without a font belongs to the span it is nested in on the same
+ * thread: glyph constructors do not know which font made them, so they
+ * take the font and the character from the glyph creation span around
+ * them.
+ *
+ * Use it through FTGL_TRACE_SPAN, which compiles to nothing unless FTGL is
+ * configured with --enable-tracing.
+ */
+class FTTraceSpan
+{
+    public:
+        /**
+         * Start a step.
+         *
+         * @param phase  The step.
+         * @param font  The FTFont doing the work, or 0 to use the font of
+         *              the enclosing span.
+         * @param character  The character code, or 0.
+         * @param glyph  The glyph index, or 0.
+         */
+        FTTraceSpan(FTGL::TracePhase phase, const void *font,
+                    unsigned int character, unsigned int glyph)
+        :   sink(0)
+        {
+            if(enabled)
+            {
+                Begin(phase, font, character, glyph);
+            }
+        }
+
+        /**
+         * End the step.
+         */
+        ~FTTraceSpan()
+        {
+            if(sink)
+            {
+                End();
+            }
+        }
+
+        /**
+         * Change the function called with every event. Returns once no
+         * step is still reporting to the previous function, so that its
+         * data may be freed; it must not be called from a callback.
+         *
+         * @param callback  The function, or 0 to stop tracing.
+         * @param data  Passed to the function with every event.
+         */
+        static void SetCallback(FTTraceCallback callback, void *data);
+
+        /**
+         * Stop tracing if the function called with every event is still
+         * the given one, with the same data, and wait like
+         * <code>SetCallback()</code>.
+         *
+         * @param callback  The function.
+         * @param data  Its data.
+         */
+        static void RemoveCallback(FTTraceCallback callback, void *data);
+
+        /**
+         * A function and its data, shared by the spans that started while
+         * it was set.
+         */
+        struct Sink
+        {
+            FTTraceCallback callback;
+            void *data;
+
+            /**
+             * The number of spans that still report to this sink.
+             */
+            volatile long spans;
+        };
+
+    private:
+        /**
+         * Make a sink current, if the current one matches, and free the
+         * one it replaces once its spans have ended.
+         */
+        static void Replace(Sink *next, bool always, FTTraceCallback callback,
+                            void *data);
+
+        void Begin(FTGL::TracePhase phase, const void *font,
+                   unsigned int character, unsigned int glyph);
+        void End();
+
+        FTTraceSpan(const FTTraceSpan&);
+        FTTraceSpan& operator=(const FTTraceSpan&);
+
+        /**
+         * Whether a callback is set. Only a hint: spans that see it take
+         * the current sink under a lock.
+         */
+        static volatile bool enabled;
+
+        /**
+         * The sink the span reports to, or 0 if none was set when the
+         * step started.
+         */
+        Sink *sink;
+
+        /**
+         * The event sent at the start, reused for the end.
+         */
+        FTTraceEvent event;
+
+        /**
+         * The span this one is nested in, on this thread.
+         */
+        FTTraceSpan *parent;
+};
+
+#define FTGL_TRACE_NAME2(line) ftglTraceSpan ## line
+#define FTGL_TRACE_NAME(line) FTGL_TRACE_NAME2(line)
+
+#define FTGL_TRACE_SPAN(phase, font, character, glyph) \
+    FTTraceSpan FTGL_TRACE_NAME(__LINE__)(phase, font, character, glyph)
+
+#else
+
+#define FTGL_TRACE_SPAN(phase, font, character, glyph) do {} while(0)
+
+#endif // FTGL_TRACING
+
+#endif  //  __FTTraceSpan__
+
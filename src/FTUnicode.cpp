@@ -0,0 +1,438 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <cstring>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define FTGL_ASCII_SSE2
+#endif
+
+#include "FTUnicode.h"
+
+
+static const unsigned int replacementChar = 0xFFFD;
+
+
+/* Copy the characters of a run of ASCII bytes, up to a limit, and return
+ * how many were copied. */
+static inline int CopyASCII(const unsigned char *s, const int limit,
+                            unsigned int *out)
+{
+    int n = 0;
+
+#ifdef FTGL_ASCII_SSE2
+    const __m128i zero = _mm_setzero_si128();
+
+    while(limit - n >= 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(s + n));
+        if(_mm_movemask_epi8(bytes))
+        {
+            break;
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128((__m128i *)(out + n), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(out + n + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(out + n + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i *)(out + n + 12), _mm_unpackhi_epi16(hi, zero));
+        n += 16;
+    }
+#endif
+
+    while(n < limit && s[n] < 0x80)
+    {
+        out[n] = s[n];
+        n++;
+    }
+
+    return n;
+}
+
+
+/* Read one UTF-8 character and move past it. At most avail bytes are
+ * read; a malformed sequence gives U+FFFD and only its first byte is
+ * skipped, so a null character always stops it. */
+static inline unsigned int ReadUTF8(const unsigned char *&s, const int avail)
+{
+    unsigned int c = *s;
+    int extra;
+    unsigned int min = 0x80, max = 0xBF;
+
+    if(c < 0x80)
+    {
+        s++;
+        return c;
+    }
+    else if(c >= 0xC2 && c <= 0xDF)
+    {
+        extra = 1;
+        c &= 0x1F;
+    }
+    else if(c >= 0xE0 && c <= 0xEF)
+    {
+        extra = 2;
+        min = (c == 0xE0) ? 0xA0 : 0x80; // overlong forms
+        max = (c == 0xED) ? 0x9F : 0xBF; // surrogates
+        c &= 0x0F;
+    }
+    else if(c >= 0xF0 && c <= 0xF4)
+    {
+        extra = 3;
+        min = (c == 0xF0) ? 0x90 : 0x80; // overlong forms
+        max = (c == 0xF4) ? 0x8F : 0xBF; // beyond U+10FFFF
+        c &= 0x07;
+    }
+    else
+    {
+        s++;
+        return replacementChar;
+    }
+
+    if(avail <= extra || s[1] < min || s[1] > max)
+    {
+        s++;
+        return replacementChar;
+    }
+
+    for(int i = 2; i <= extra; i++)
+    {
+        if((s[i] & 0xC0) != 0x80)
+        {
+            s++;
+            return replacementChar;
+        }
+    }
+
+    for(int i = 1; i <= extra; i++)
+    {
+        c = (c << 6) | (s[i] & 0x3F);
+    }
+
+    s += extra + 1;
+    return c;
+}
+
+
+/* Read one UTF-16 character and move past it, reading at most avail
+ * units. An unpaired surrogate gives U+FFFD. */
+template <typename T>
+static inline unsigned int ReadUTF16(const T *&s, const int avail)
+{
+    unsigned int c = (unsigned short)*s++;
+
+    if(c < 0xD800 || c > 0xDFFF)
+    {
+        return c;
+    }
+
+    if(c <= 0xDBFF && avail > 1)
+    {
+        unsigned int c2 = (unsigned short)*s;
+
+        if(c2 >= 0xDC00 && c2 <= 0xDFFF)
+        {
+            s++;
+            return ((c - 0xD800) << 10) + (c2 - 0xDC00) + 0x10000;
+        }
+    }
+
+    return replacementChar;
+}
+
+
+FTUnicodeDecoder::FTUnicodeDecoder()
+:   chars(0),
+    capacity(0),
+    count(0)
+{
+    Reserve(255);
+}
+
+
+FTUnicodeDecoder::~FTUnicodeDecoder()
+{
+    delete [] chars;
+}
+
+
+/* The buffer is only grown before a string is decoded, so its contents
+ * need not be kept. */
+void FTUnicodeDecoder::Reserve(const int n)
+{
+    if(n < capacity)
+    {
+        return;
+    }
+
+    // Keep room for the character after the string
+    while(capacity <= n)
+    {
+        capacity = capacity ? capacity * 2 : 256;
+    }
+
+    delete [] chars;
+    chars = new unsigned int[capacity];
+}
+
+
+int FTUnicodeDecoder::Clear()
+{
+    count = 0;
+    chars[0] = 0;
+    return 0;
+}
+
+
+int FTUnicodeDecoder::Decode(const unsigned char *string, const int len)
+{
+    if(!string)
+    {
+        return Clear();
+    }
+
+    if(len < 0)
+    {
+        return DecodeUTF8(string, -1);
+    }
+
+    // There are at least as many bytes as characters left, so ASCII runs
+    // are copied without looking for a null, and the character after the
+    // last one is read as well, as it is kerned
+    const unsigned char *s = string;
+
+    count = 0;
+    Reserve(len);
+
+    while(count < len)
+    {
+        int n = CopyASCII(s, len - count, chars + count);
+        s += n;
+        count += n;
+
+        if(count < len)
+        {
+            chars[count++] = ReadUTF8(s, 4);
+        }
+    }
+
+    chars[count] = ReadUTF8(s, 4);
+    return count;
+}
+
+
+int FTUnicodeDecoder::Decode(const wchar_t *string, const int len)
+{
+    if(!string)
+    {
+        return Clear();
+    }
+
+    if(sizeof(wchar_t) == 2)
+    {
+        return DecodeChars16(string, len);
+    }
+
+    return DecodeChars32(string, len);
+}
+
+
+int FTUnicodeDecoder::DecodeUTF8(const unsigned char *string, const int units)
+{
+    if(!string)
+    {
+        return Clear();
+    }
+
+    // The byte length bounds both the reads and the character count
+    const int bytes = (units < 0) ? (int)strlen((const char *)string) : units;
+    const unsigned char *s = string;
+    const unsigned char *end = string + bytes;
+
+    count = 0;
+    Reserve(bytes);
+
+    while(s < end)
+    {
+        int n = CopyASCII(s, (int)(end - s), chars + count);
+        s += n;
+        count += n;
+
+        if(s < end)
+        {
+            chars[count++] = ReadUTF8(s, (int)(end - s));
+        }
+    }
+
+    chars[count] = 0;
+    return count;
+}
+
+
+int FTUnicodeDecoder::DecodeUTF16(const unsigned short *string,
+                                  const int units)
+{
+    if(!string)
+    {
+        return Clear();
+    }
+
+    return DecodeUnits16(string, units);
+}
+
+
+int FTUnicodeDecoder::DecodeUTF32(const unsigned int *string, const int units)
+{
+    if(!string)
+    {
+        return Clear();
+    }
+
+    return DecodeUnits32(string, units);
+}
+
+
+int FTUnicodeDecoder::Decode(const FTUnicodeText *text, const int units)
+{
+    if(text->utf16)
+    {
+        return DecodeUTF16(text->utf16, units);
+    }
+
+    if(text->utf32)
+    {
+        return DecodeUTF32(text->utf32, units);
+    }
+
+    return DecodeUTF8(text->utf8, units);
+}
+
+
+template <typename T>
+int FTUnicodeDecoder::DecodeUnits16(const T *string, const int units)
+{
+    int length = units;
+    if(length < 0)
+    {
+        length = 0;
+        while(string[length])
+        {
+            length++;
+        }
+    }
+
+    const T *s = string;
+    const T *end = string + length;
+
+    count = 0;
+    Reserve(length);
+
+    while(s < end)
+    {
+        chars[count++] = ReadUTF16(s, (int)(end - s));
+    }
+
+    chars[count] = 0;
+    return count;
+}
+
+
+template <typename T>
+int FTUnicodeDecoder::DecodeChars16(const T *string, const int len)
+{
+    if(len < 0)
+    {
+        return DecodeUnits16(string, -1);
+    }
+
+    const T *s = string;
+
+    count = 0;
+    Reserve(len);
+
+    while(count < len)
+    {
+        chars[count++] = ReadUTF16(s, 2);
+    }
+
+    chars[count] = ReadUTF16(s, 2);
+    return count;
+}
+
+
+/* Code points outside the unicode range, and surrogates, give U+FFFD */
+static inline unsigned int CheckUTF32(const unsigned int c)
+{
+    return (c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) ? replacementChar
+                                                          : c;
+}
+
+
+template <typename T>
+int FTUnicodeDecoder::DecodeUnits32(const T *string, const int units)
+{
+    int length = units;
+    if(length < 0)
+    {
+        length = 0;
+        while(string[length])
+        {
+            length++;
+        }
+    }
+
+    Reserve(length);
+
+    for(count = 0; count < length; count++)
+    {
+        chars[count] = CheckUTF32((unsigned int)string[count]);
+    }
+
+    chars[count] = 0;
+    return count;
+}
+
+
+template <typename T>
+int FTUnicodeDecoder::DecodeChars32(const T *string, const int len)
+{
+    if(len < 0)
+    {
+        return DecodeUnits32(string, -1);
+    }
+
+    Reserve(len);
+
+    for(count = 0; count < len; count++)
+    {
+        chars[count] = CheckUTF32((unsigned int)string[count]);
+    }
+
+    chars[count] = CheckUTF32((unsigned int)string[count]);
+    return count;
+}
+
@@ -190,12 +190,12 @@ inline void FTUnicodeStringItr<T>::readUTF8()
     // falls through
     switch (extraBytesToRead)
     {
-          case 6: ch += *nextPos++; ch <<= 6; /* remember, illegal UTF-8 */
-          case 5: ch += *nextPos++; ch <<= 6; /* remember, illegal UTF-8 */
-          case 4: ch += *nextPos++; ch <<= 6;
-          case 3: ch += *nextPos++; ch <<= 6;
-          case 2: ch += *nextPos++; ch <<= 6;
-          case 1: ch += *nextPos++;
+          case 6: ch += (unsigned char)*nextPos++; ch <<= 6; /* remember, illegal UTF-8 */
+          case 5: ch += (unsigned char)*nextPos++; ch <<= 6; /* remember, illegal UTF-8 */
+          case 4: ch += (unsigned char)*nextPos++; ch <<= 6;
+          case 3: ch += (unsigned char)*nextPos++; ch <<= 6;
+          case 2: ch += (unsigned char)*nextPos++; ch <<= 6;
+          case 1: ch += (unsigned char)*nextPos++;
     }
     ch -= offsetsFromUTF8[extraBytesToRead-1];
     curChar = ch;
@@ -222,7 +222,7 @@ inline void FTUnicodeStringItr<T>::readUTF16()
     // if we have the first half of the surrogate pair
     if (ch >= highSurrogateStart && ch <= highSurrogateEnd)
     {
-        unsigned int ch2 = *curPos;
+        unsigned int ch2 = *nextPos;
         // complete the surrogate pair
         if (ch2 >= lowSurrogateStart && ch2 <= lowSurrogateEnd)
         {
@@ -234,4 +234,133 @@ inline void FTUnicodeStringItr<T>::readUTF16()
     curChar = ch;
 }
 
+
+/**
+ * A UTF-8, UTF-16 or UTF-32 string, of which only one pointer is set. The
+ * length-delimited entry points of FTFont and FTLayout pass it, with the
+ * length of the string in code units, wherever a string would go.
+ */
+struct FTUnicodeText
+{
+    const unsigned char *utf8;
+    const unsigned short *utf16;
+    const unsigned int *utf32;
+};
+
+
+/**
+ * Decodes whole strings into a buffer of unicode code points that is
+ * reused from one string to the next, so that text can be walked as a
+ * plain array whose length is known up front. Runs of ASCII characters
+ * in UTF-8 strings are copied 16 bytes at a time where SSE2 is available.
+ *
+ * Unlike FTUnicodeStringItr, the input is validated: malformed UTF-8
+ * sequences, unpaired UTF-16 surrogates and values outside the unicode
+ * range are decoded as U+FFFD, and a multi-byte sequence or surrogate pair
+ * is never read past a null character.
+ */
+class FTUnicodeDecoder
+{
+    public:
+        FTUnicodeDecoder();
+
+        ~FTUnicodeDecoder();
+
+        /**
+         * Decode a UTF-8 string.
+         *
+         * Given a length, the characters are decoded like FTFont has always
+         * read them: null characters among them are decoded like any
+         * other, and the character after the last one is read as well so
+         * that the last one can be kerned. The string must hold at least
+         * <code>len</code> characters followed by one more, which may be
+         * its terminating null.
+         *
+         * @param string  The string to decode.
+         * @param len  The number of characters to decode. If < 0 then all
+         *             characters are decoded until a null character is
+         *             encountered.
+         * @return  The number of characters decoded.
+         */
+        int Decode(const unsigned char *string, const int len);
+
+        /**
+         * Decode a UTF-16 or UTF-32 string, depending on the size of
+         * wchar_t.
+         *
+         * Given a length, the characters are decoded like FTFont has always
+         * read them: null characters among them are decoded like any
+         * other, and the character after the last one is read as well so
+         * that the last one can be kerned. The string must hold at least
+         * <code>len</code> characters followed by one more, which may be
+         * its terminating null.
+         *
+         * @param string  The string to decode.
+         * @param len  The number of characters to decode. If < 0 then all
+         *             characters are decoded until a null character is
+         *             encountered.
+         * @return  The number of characters decoded.
+         */
+        int Decode(const wchar_t *string, const int len);
+
+        /**
+         * Decode a UTF-8, UTF-16 or UTF-32 string of a given number of code
+         * units. Nothing past them is read: the last character is followed
+         * by zero.
+         *
+         * @param string  The string to decode.
+         * @param units  The length of the string in code units. If < 0 then
+         *               the string ends with a null character.
+         * @return  The number of characters decoded.
+         */
+        int DecodeUTF8(const unsigned char *string, const int units);
+        int DecodeUTF16(const unsigned short *string, const int units);
+        int DecodeUTF32(const unsigned int *string, const int units);
+        int Decode(const FTUnicodeText *text, const int units);
+
+        /**
+         * The characters of the last decoded string. They are followed by
+         * the character after them in the string, which is zero at the end
+         * of a null-terminated string, so that the last one can be kerned.
+         */
+        const unsigned int *Chars() const { return chars; }
+
+        /**
+         * The number of characters of the last decoded string.
+         */
+        int Count() const { return count; }
+
+    private:
+        /**
+         * Make room for <code>n</code> characters and the one after them.
+         */
+        void Reserve(const int n);
+
+        /**
+         * Empty the buffer.
+         *
+         * @return  Zero.
+         */
+        int Clear();
+
+        /* Decoders for strings of 16 and 32 bit units, with a length
+         * counted in code units or in characters */
+        template <typename T>
+        int DecodeUnits16(const T *string, const int units);
+        template <typename T>
+        int DecodeChars16(const T *string, const int len);
+        template <typename T>
+        int DecodeUnits32(const T *string, const int units);
+        template <typename T>
+        int DecodeChars32(const T *string, const int len);
+
+        /* Disallow copies */
+        FTUnicodeDecoder(const FTUnicodeDecoder&);
+        FTUnicodeDecoder& operator=(const FTUnicodeDecoder&);
+
+        unsigned int *chars;
+        int capacity;
+        int count;
+};
+
 #endif
@@ -48,6 +48,13 @@ class FTVector
             Items = 0;
         }
 
+        FTVector(const FTVector& v)
+        {
+            Capacity = Size = 0;
+            Items = 0;
+            *this = v;
+        }
+
 
         virtual ~FTVector()
         {
@@ -56,7 +63,12 @@ class FTVector
 
         FTVector& operator =(const FTVector& v)
         {
-            reserve(v.capacity());
+            if(&v == this)
+            {
+                return *this;
+            }
+
+            reserve(v.size());
 
             iterator ptr = begin();
             const_iterator vbegin = v.begin();
@@ -126,14 +138,37 @@ class FTVector
             }
         }
 
+        /**
+         * Make room for exactly <code>n</code> items, so that a vector
+         * whose final size is known up front is allocated only once.
+         */
         void reserve(size_type n)
         {
             if(capacity() < n)
             {
-                expand(n);
+                reallocate(n);
             }
         }
 
+        /**
+         * Exchange the contents of two vectors without copying items.
+         * This is how a vector is moved.
+         */
+        void swap(FTVector& v)
+        {
+            size_type oldCapacity = Capacity;
+            size_type oldSize = Size;
+            value_type *oldItems = Items;
+
+            Capacity = v.Capacity;
+            Size = v.Size;
+            Items = v.Items;
+
+            v.Capacity = oldCapacity;
+            v.Size = oldSize;
+            v.Items = oldItems;
+        }
+
         void push_back(const value_type& x)
         {
             if(size() == capacity())
@@ -145,6 +180,23 @@ class FTVector
             ++Size;
         }
 
+        /**
+         * Append a default item and return it, so that it can be filled
+         * in place rather than built elsewhere and copied in.
+         */
+        reference emplace_back()
+        {
+            if(size() == capacity())
+            {
+                expand();
+            }
+
+            reference x = (*this)[size()];
+            x = value_type();
+            ++Size;
+            return x;
+        }
+
         void resize(size_type n, value_type x)
         {
             if(n == size())
@@ -176,17 +228,13 @@ class FTVector
 
 
     private:
-        void expand(size_type capacity_hint = 0)
+        void expand()
         {
-            size_type new_capacity = (capacity() == 0) ? 256 : capacity() * 2;
-            if(capacity_hint)
-            {
-                while(new_capacity < capacity_hint)
-                {
-                    new_capacity *= 2;
-                }
-            }
+            reallocate((capacity() == 0) ? 256 : capacity() * 2);
+        }
 
+        void reallocate(size_type new_capacity)
+        {
             value_type *new_items = new value_type[new_capacity];
 
             iterator ibegin = this->begin();
@@ -27,7 +27,10 @@
 
 #include "config.h"
 
+#include <new>
+
 #include "FTInternals.h"
+#include "FTTraceSpan.h"
 #include "FTVectoriser.h"
 
 #ifndef CALLBACK
@@ -86,11 +89,6 @@ FTMesh::FTMesh()
 
 FTMesh::~FTMesh()
 {
-    for(size_t t = 0; t < tesselationList.size(); ++t)
-    {
-        delete tesselationList[t];
-    }
-
     tesselationList.clear();
 }
 
@@ -110,30 +108,38 @@ const FTGL_DOUBLE* FTMesh::Combine(const FTGL_DOUBLE x, const FTGL_DOUBLE y, con
 
 void FTMesh::Begin(GLenum meshType)
 {
-    currentTesselation = new FTTesselation(meshType);
+    // The tesselation is added now: its points go straight to the store
+    currentTesselation = &tesselationList.emplace_back();
+    *currentTesselation = FTTesselation(meshType, &pointStore);
 }
 
 
 void FTMesh::End()
 {
-    tesselationList.push_back(currentTesselation);
+    currentTesselation = 0;
 }
 
 
 FTTesselation const * FTMesh::Tesselation(size_t index) const
 {
-    return (index < tesselationList.size()) ? tesselationList[index] : NULL;
+    return (index < tesselationList.size()) ? &tesselationList[index] : NULL;
 }
 
 
 FTVectoriser::FTVectoriser(const FT_GlyphSlot glyph)
 :   contourList(0),
     mesh(0),
+    frontOutsetSize(0.0f),
+    backOutsetSize(0.0f),
+    meshNormal(0.0),
+    meshOutsetSize(0.0f),
     ftContourCount(0),
     contourFlag(0)
 {
     if(glyph)
     {
+        FTGL_TRACE_SPAN(FTGL::TRACE_TESSELLATE, 0, 0, glyph->glyph_index);
+
         outline = glyph->outline;
 
         ftContourCount = outline.n_contours;
@@ -149,10 +155,10 @@ FTVectoriser::~FTVectoriser()
 {
     for(size_t c = 0; c < ContourCount(); ++c)
     {
-        delete contourList[c];
+        contourList[c].~FTContour();
     }
 
-    delete [] contourList;
+    ::operator delete(contourList);
     delete mesh;
 }
 
@@ -163,7 +169,11 @@ void FTVectoriser::ProcessContours()
     short startIndex = 0;
     short endIndex = 0;
 
-    contourList = new FTContour*[ftContourCount];
+    // Size everything for the worst case up front: one block for the
+    // contours, and one store for all their points.
+    contourList = static_cast<FTContour*>(::operator new(ftContourCount
+                                                         * sizeof(FTContour)));
+    contourPoints.reserve(FTContour::MaxPointCount(outline.n_points));
 
     for(int i = 0; i < ftContourCount; ++i)
     {
@@ -173,9 +183,8 @@ void FTVectoriser::ProcessContours()
         endIndex = outline.contours[i];
         contourLength =  (endIndex - startIndex) + 1;
 
-        FTContour* contour = new FTContour(pointList, tagList, contourLength);
-
-        contourList[i] = contour;
+        new(&contourList[i]) FTContour(pointList, tagList, contourLength,
+                                       &contourPoints);
 
         startIndex = endIndex + 1;
     }
@@ -184,7 +193,7 @@ void FTVectoriser::ProcessContours()
     // can do it for us.
     for(int i = 0; i < ftContourCount; i++)
     {
-        FTContour *c1 = contourList[i];
+        FTContour *c1 = &contourList[i];
 
         // 1. Find the leftmost point.
         FTPoint leftmost(65536.0, 0.0);
@@ -209,7 +218,7 @@ void FTVectoriser::ProcessContours()
                 continue;
             }
 
-            FTContour *c2 = contourList[j];
+            FTContour *c2 = &contourList[j];
 
             for(size_t n = 0; n < c2->PointCount(); n++)
             {
@@ -245,32 +254,94 @@ void FTVectoriser::ProcessContours()
 }
 
 
-size_t FTVectoriser::PointCount()
+FTContour const * FTVectoriser::Contour(size_t index) const
 {
-    size_t s = 0;
-    for(size_t c = 0; c < ContourCount(); ++c)
-    {
-        s += contourList[c]->PointCount();
-    }
+    return (index < ContourCount()) ? &contourList[index] : NULL;
+}
+
 
-    return s;
+/* Whether two sizes or normals are the same, for reusing what was built
+ * from them */
+static inline bool Same(const FTGL_DOUBLE a, const FTGL_DOUBLE b)
+{
+    return !(a < b) && !(a > b);
 }
 
 
-FTContour const * FTVectoriser::Contour(size_t index) const
+void FTVectoriser::BuildOutset(int outsetType, float outsetSize)
 {
-    return (index < ContourCount()) ? contourList[index] : NULL;
+    if(outsetType != 1 && outsetType != 2)
+    {
+        return;
+    }
+
+    float& builtSize = (outsetType == 1) ? frontOutsetSize : backOutsetSize;
+    FTContour::PointVector& store = (outsetType == 1) ? frontPoints
+                                                      : backPoints;
+
+    if(Same(outsetSize, builtSize))
+    {
+        return;
+    }
+
+    bool outset = outsetSize < 0.0f || outsetSize > 0.0f;
+
+    if(outset && outsetPoints.empty())
+    {
+        outsetPoints.reserve(PointCount());
+
+        for(size_t c = 0; c < ContourCount(); ++c)
+        {
+            contourList[c].BuildOutsets(&outsetPoints);
+        }
+    }
+
+    // The outset points are rebuilt in place, so the store never grows.
+    store.resize(0, FTPoint());
+    store.reserve(PointCount());
+
+    for(size_t c = 0; c < ContourCount(); ++c)
+    {
+        switch(outsetType)
+        {
+            case 1 : contourList[c].buildFrontOutset(outsetSize, &store); break;
+            case 2 : contourList[c].buildBackOutset(outsetSize, &store); break;
+        }
+    }
+
+    builtSize = outsetSize;
 }
 
 
 void FTVectoriser::MakeMesh(FTGL_DOUBLE zNormal, int outsetType, float outsetSize)
 {
+    if(outsetType != 1 && outsetType != 2)
+    {
+        outsetSize = 0.0f;
+    }
+
+    BuildOutset(outsetType, outsetSize);
+
+    // Front and back points of the same size are the same points
+    if(mesh && Same(zNormal, meshNormal) && Same(outsetSize, meshOutsetSize))
+    {
+        return;
+    }
+
+    FTGL_TRACE_SPAN(FTGL::TRACE_TESSELLATE, 0, 0, 0);
+
     if(mesh)
     {
         delete mesh;
     }
 
     mesh = new FTMesh;
+    meshNormal = zNormal;
+    meshOutsetSize = outsetSize;
+
+    // Most primitives are triangles, fans and strips over the contour
+    // points, with a few combine points.
+    mesh->Reserve(3 * PointCount());
 
     GLUtesselator* tobj = gluNewTess();
 
@@ -296,13 +367,7 @@ void FTVectoriser::MakeMesh(FTGL_DOUBLE zNormal, int outsetType, float outsetSiz
 
         for(size_t c = 0; c < ContourCount(); ++c)
         {
-            /* Build the */
-            switch(outsetType)
-            {
-                case 1 : contourList[c]->buildFrontOutset(outsetSize); break;
-                case 2 : contourList[c]->buildBackOutset(outsetSize); break;
-            }
-            const FTContour* contour = contourList[c];
+            const FTContour* contour = &contourList[c];
 
 
             gluTessBeginContour(tobj);
@@ -45,14 +45,22 @@
 class FTTesselation
 {
     public:
+        typedef FTVector<FTPoint> PointVector;
+
         /**
          * Default constructor
+         *
+         * @param m  The OpenGL primitive type.
+         * @param store  Where to append the points, shared by the
+         *               tesselations of a mesh, or <code>NULL</code> to
+         *               keep them in the tesselation.
          */
-        FTTesselation(GLenum m)
-        : meshType(m)
-        {
-            pointList.reserve(128);
-        }
+        FTTesselation(GLenum m = 0, PointVector* store = NULL)
+        : pointStore(store),
+          firstPoint(store ? store->size() : 0),
+          pointCount(0),
+          meshType(m)
+        {}
 
         /**
          *  Destructor
@@ -68,19 +76,22 @@ class FTTesselation
         void AddPoint(const FTGL_DOUBLE x, const FTGL_DOUBLE y,
                       const FTGL_DOUBLE z)
         {
-            pointList.push_back(FTPoint(x, y, z));
+            (pointStore ? *pointStore : pointList).push_back(FTPoint(x, y, z));
+            ++pointCount;
         }
 
         /**
          * The number of points in this mesh
          */
-        size_t PointCount() const { return pointList.size(); }
+        size_t PointCount() const { return pointCount; }
 
         /**
          *
          */
         const FTPoint& Point(unsigned int index) const
-        { return pointList[index]; }
+        {
+            return (pointStore ? *pointStore : pointList)[firstPoint + index];
+        }
 
         /**
          * Return the OpenGL polygon type.
@@ -89,11 +100,19 @@ class FTTesselation
 
     private:
         /**
-         * Points generated by gluTesselator.
+         * Points generated by gluTesselator, when not in a shared store.
          */
-        typedef FTVector<FTPoint> PointVector;
         PointVector pointList;
 
+        /**
+         * Where the points are, or <code>NULL</code> when they are in
+         * pointList, and which of them are ours. The store may grow
+         * while we are built, so we keep an index.
+         */
+        PointVector* pointStore;
+        size_t firstPoint;
+        size_t pointCount;
+
         /**
          * OpenGL primitive type from gluTesselator.
          */
@@ -106,7 +125,7 @@ class FTTesselation
  */
 class FTMesh
 {
-        typedef FTVector<FTTesselation*> TesselationVector;
+        typedef FTVector<FTTesselation> TesselationVector;
         typedef FTList<FTPoint> PointList;
 
     public:
@@ -120,6 +139,14 @@ class FTMesh
          */
         ~FTMesh();
 
+        /**
+         * Make room for the points of all the tesselations, so that
+         * they do not grow the store one primitive at a time.
+         *
+         * @param pointCount  The expected number of points.
+         */
+        void Reserve(size_t pointCount) { pointStore.reserve(pointCount); }
+
         /**
          * Add a point to the mesh
          */
@@ -174,10 +201,16 @@ class FTMesh
         FTTesselation* currentTesselation;
 
         /**
-         * Holds each sub mesh that comprises this glyph.
+         * Holds each sub mesh that comprises this glyph. They only refer
+         * to their points in pointStore, so they are kept by value.
          */
         TesselationVector tesselationList;
 
+        /**
+         * Holds the points of all the tesselations, one after another.
+         */
+        FTTesselation::PointVector pointStore;
+
         /**
          * Holds extra points created by gluTesselator. See ftglCombine.
          */
@@ -220,7 +253,8 @@ class FTVectoriser
         virtual ~FTVectoriser();
 
         /**
-         * Build an FTMesh from the vector outline data.
+         * Build an FTMesh from the vector outline data. The mesh is kept
+         * as long as the same points are asked for with the same normal.
          *
          * @param zNormal   The direction of the z axis of the normal
          *                  for this mesh
@@ -233,6 +267,17 @@ class FTVectoriser
          */
         void MakeMesh(FTGL_DOUBLE zNormal = FTGL_FRONT_FACING, int outsetType = 0, float outsetSize = 0.0f);
 
+        /**
+         * Build the front or back outset points of every contour, unless
+         * they are already there for this size. A zero outset needs no
+         * points, and the outset vectors are only computed for the first
+         * outset that is not zero.
+         *
+         * @param outsetType  1 for the front points, 2 for the back points
+         * @param outsetSize  The outset distance
+         */
+        void BuildOutset(int outsetType, float outsetSize);
+
         /**
          * Get the current mesh.
          */
@@ -243,7 +288,7 @@ class FTVectoriser
          *
          * @return the number of points
          */
-        size_t PointCount();
+        size_t PointCount() const { return contourPoints.size(); }
 
         /**
          * Get the count of contours in this outline
@@ -265,7 +310,7 @@ class FTVectoriser
          * @param c     The contour index
          * @return      the number of points in contour[c]
          */
-        size_t ContourSize(int c) const { return contourList[c]->PointCount(); }
+        size_t ContourSize(int c) const { return contourList[c].PointCount(); }
 
         /**
          * Get the flag for the tesselation rule for this outline
@@ -284,15 +329,38 @@ class FTVectoriser
         void ProcessContours();
 
         /**
-         * The list of contours in the glyph
+         * The contours in the glyph, constructed in a single block
          */
-        FTContour** contourList;
+        FTContour* contourList;
+
+        /**
+         * The points of all the contours, one contour after another,
+         * and their outset vectors and front and back outset points.
+         * Each is reserved once before use and never reallocates, as the
+         * contours point into them.
+         */
+        FTContour::PointVector contourPoints;
+        FTContour::PointVector outsetPoints;
+        FTContour::PointVector frontPoints;
+        FTContour::PointVector backPoints;
 
         /**
          * A Mesh for tesselations
          */
         FTMesh* mesh;
 
+        /**
+         * The outset sizes the front and back points were built for
+         */
+        float frontOutsetSize;
+        float backOutsetSize;
+
+        /**
+         * The normal and outset size the mesh was built for
+         */
+        FTGL_DOUBLE meshNormal;
+        float meshOutsetSize;
+
         /**
          * The number of contours reported by Freetype
          */
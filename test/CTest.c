@@ -48,6 +48,10 @@ int main(int argc, char *argv[])
     for(i = 0; i < 6; i++)
         ftglRenderFont(f[i], "Hello world", FTGL_RENDER_ALL);
 
+    for(i = 0; i < 6; i++)
+        if(ftglGetFontStatistic(f[i], FTGL_STAT_RENDER_CALLS) != 2)
+            return 3;
+
     for(i = 0; i < 6; i++)
         ftglDestroyFont(f[i]);
 
@@ -0,0 +1,117 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <string.h>
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+#include "FTArena.h"
+
+
+class FTArenaTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTArenaTest);
+        CPPUNIT_TEST(testAllocate);
+        CPPUNIT_TEST(testBlocks);
+        CPPUNIT_TEST(testLargeAllocation);
+        CPPUNIT_TEST(testLend);
+        CPPUNIT_TEST(testFontGlyphs);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTArenaTest() : CppUnit::TestCase("FTArena Test")
+        {}
+
+        FTArenaTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        void testAllocate()
+        {
+            FTArena arena;
+            CPPUNIT_ASSERT_EQUAL(0, (int)arena.Capacity());
+
+            char *first = static_cast<char*>(arena.Allocate(3));
+            char *second = static_cast<char*>(arena.Allocate(20));
+            char *third = static_cast<char*>(arena.Allocate(1));
+
+            CPPUNIT_ASSERT(first && second && third);
+            CPPUNIT_ASSERT_EQUAL(16, (int)(second - first));
+            CPPUNIT_ASSERT_EQUAL(32, (int)(third - second));
+
+            memset(first, 1, 3);
+            memset(second, 2, 20);
+            memset(third, 3, 1);
+            CPPUNIT_ASSERT_EQUAL(1, (int)first[2]);
+            CPPUNIT_ASSERT_EQUAL(2, (int)second[19]);
+            CPPUNIT_ASSERT_EQUAL(3, (int)third[0]);
+        }
+
+        void testBlocks()
+        {
+            FTArena arena(1024);
+
+            for(int i = 0; i < 100; i++)
+            {
+                memset(arena.Allocate(64), i, 64);
+            }
+
+            // 16 allocations fit in each block
+            CPPUNIT_ASSERT_EQUAL(7 * 1024, (int)arena.Capacity());
+        }
+
+        void testLargeAllocation()
+        {
+            FTArena arena(1024);
+
+            char *small = static_cast<char*>(arena.Allocate(16));
+            char *large = static_cast<char*>(arena.Allocate(4000));
+            char *next = static_cast<char*>(arena.Allocate(16));
+
+            memset(large, 0, 4000);
+
+            CPPUNIT_ASSERT_EQUAL(1024 + 4000, (int)arena.Capacity());
+            CPPUNIT_ASSERT_EQUAL(16, (int)(next - small));
+        }
+
+        void testLend()
+        {
+            FTArena arena;
+            FT_GlyphSlotRec slot;
+            memset(&slot, 0, sizeof(slot));
+
+            CPPUNIT_ASSERT(FTArena::Borrowed(NULL) == NULL);
+            CPPUNIT_ASSERT(FTArena::Borrowed(&slot) == NULL);
+
+            arena.Lend(&slot);
+            CPPUNIT_ASSERT(FTArena::Borrowed(&slot) == &arena);
+
+            // Client data that isn't an arena is left alone
+            slot.generic.finalizer = NULL;
+            CPPUNIT_ASSERT(FTArena::Borrowed(&slot) == NULL);
+        }
+
+        void testFontGlyphs()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            float advance = font->Advance(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT(advance > 0);
+
+            // Glyphs made again after a size change are just as good
+            font->FaceSize(36);
+            CPPUNIT_ASSERT(font->Advance(GOOD_ASCII_TEST_STRING) > advance);
+            CPPUNIT_ASSERT_EQUAL(0, (int)font->Error());
+
+            delete font;
+        }
+
+        void setUp()
+        {}
+
+        void tearDown()
+        {}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTArenaTest);
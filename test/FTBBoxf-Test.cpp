@@ -0,0 +1,107 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <assert.h>
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+#include "FTBBoxf.h"
+
+
+class FTBBoxfTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTBBoxfTest);
+        CPPUNIT_TEST(testSize);
+        CPPUNIT_TEST(testDefaultConstructor);
+        CPPUNIT_TEST(testConversion);
+        CPPUNIT_TEST(testMoveBBox);
+        CPPUNIT_TEST(testUnion);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTBBoxfTest() : CppUnit::TestCase("FTBBoxf Test")
+        {}
+
+        FTBBoxfTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        void testSize()
+        {
+            CPPUNIT_ASSERT_EQUAL(32, (int)sizeof(FTBBoxf));
+            CPPUNIT_ASSERT(sizeof(FTBBoxf) < sizeof(FTBBox));
+        }
+
+        void testDefaultConstructor()
+        {
+            FTBBoxf boundingBox;
+            FTPointf lower = boundingBox.Lower();
+            FTPointf upper = boundingBox.Upper();
+
+            CPPUNIT_ASSERT(lower.Xf() == 0.0f);
+            CPPUNIT_ASSERT(lower.Yf() == 0.0f);
+            CPPUNIT_ASSERT(lower.Zf() == 0.0f);
+            CPPUNIT_ASSERT(upper.Xf() == 0.0f);
+            CPPUNIT_ASSERT(upper.Yf() == 0.0f);
+            CPPUNIT_ASSERT(upper.Zf() == 0.0f);
+        }
+
+        void testConversion()
+        {
+            FTBBoxf boundingBox(FTBBox(-1.0f, -2.0f, 0.0f, 3.0f, 4.0f, 5.0f));
+            FTPointf lower = boundingBox.Lower();
+            FTPointf upper = boundingBox.Upper();
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0f, lower.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0f, lower.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0f, upper.Zf(), 0.0001);
+
+            FTBBox back = boundingBox;
+
+            CPPUNIT_ASSERT(back.Lower() == FTPoint(-1.0f, -2.0f, 0.0f));
+            CPPUNIT_ASSERT(back.Upper() == FTPoint(3.0f, 4.0f, 5.0f));
+        }
+
+        void testMoveBBox()
+        {
+            FTBBoxf boundingBox(FTPointf(0.0f, 0.0f), FTPointf(2.0f, 3.0f));
+            boundingBox += FTPointf(1.0f, -1.0f, 0.5f);
+
+            FTPointf lower = boundingBox.Lower();
+            FTPointf upper = boundingBox.Upper();
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0f, lower.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0f, lower.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5f, lower.Zf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0f, upper.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, upper.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5f, upper.Zf(), 0.0001);
+        }
+
+        void testUnion()
+        {
+            FTBBoxf boundingBox(FTPointf(0.0f, 0.0f), FTPointf(2.0f, 3.0f));
+            FTBBoxf other(FTPointf(1.0f, -1.0f, -2.0f),
+                          FTPointf(4.0f, 1.0f, 0.0f));
+
+            boundingBox |= other;
+
+            FTPointf lower = boundingBox.Lower();
+            FTPointf upper = boundingBox.Upper();
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, lower.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0f, lower.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0f, lower.Zf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0f, upper.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0f, upper.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, upper.Zf(), 0.0001);
+        }
+
+        void setUp()
+        {}
+
+        void tearDown()
+        {}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTBBoxfTest);
@@ -0,0 +1,865 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * FTBench - throughput benchmarks for FTGL.
+ *
+ * Every benchmark runs a fixed workload (ASCII, CJK or mixed text) against
+ * one font type and reports, one JSON object per line, the time spent per
+ * glyph and the number of C++ allocations made per call. "cold" runs start
+ * from an empty glyph cache, "warm" runs reuse the glyphs loaded by the
+ * previous call.
+ *
+ * The glyph loading, metrics, layout, FTBuffer and tessellation benchmarks
+ * do not touch OpenGL and run anywhere. The render benchmarks need a window
+ * and only run when --gl is given.
+ *
+ * Usage: FTBench [--gl] [--time=ms] [--size=points] [--suite=name]
+ *                font [cjkfont]
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#   include <windows.h>
+#else
+#   include <sys/time.h>
+#   include <time.h>
+#endif
+
+#if defined HAVE_GL_GLUT_H
+#   include <GL/glut.h>
+#   define FTBENCH_GL 1
+#elif defined HAVE_GLUT_GLUT_H
+#   include <GLUT/glut.h>
+#   define FTBENCH_GL 1
+#endif
+
+#include "FTGL/ftgl.h"
+#include "FTInternals.h"
+#include "FTFace.h"
+#include "FTVectoriser.h"
+
+
+//
+//  Allocation counting
+//
+
+/* Number of C++ allocations so far. The counting operator new and
+ * delete live in FTBenchAlloc.cpp, so that the compiler does not see
+ * free() called on a pointer from a new-expression here. */
+unsigned long FTBenchAllocations();
+
+
+//
+//  Timing
+//
+
+/* Monotonic time in nanoseconds */
+static double Now()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#elif defined CLOCK_MONOTONIC
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+#else
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_usec * 1e3;
+#endif
+}
+
+
+/* Results are accumulated here so that no call can be optimised away */
+static volatile double sink = 0.0;
+
+
+//
+//  Workloads
+//
+
+struct Workload
+{
+    const char *name;
+    const char *fontFile;
+    std::string text;
+    std::vector<unsigned int> chars;
+};
+
+
+static void Append(Workload& workload, unsigned int c)
+{
+    std::string& s = workload.text;
+
+    if(c < 0x80)
+    {
+        s += (char)c;
+    }
+    else if(c < 0x800)
+    {
+        s += (char)(0xc0 | (c >> 6));
+        s += (char)(0x80 | (c & 0x3f));
+    }
+    else if(c < 0x10000)
+    {
+        s += (char)(0xe0 | (c >> 12));
+        s += (char)(0x80 | ((c >> 6) & 0x3f));
+        s += (char)(0x80 | (c & 0x3f));
+    }
+    else
+    {
+        s += (char)(0xf0 | (c >> 18));
+        s += (char)(0x80 | ((c >> 12) & 0x3f));
+        s += (char)(0x80 | ((c >> 6) & 0x3f));
+        s += (char)(0x80 | (c & 0x3f));
+    }
+
+    workload.chars.push_back(c);
+}
+
+
+static void Append(Workload& workload, const char *ascii)
+{
+    while(*ascii)
+    {
+        Append(workload, (unsigned char)*ascii++);
+    }
+}
+
+
+/* A fixed linear congruential generator, so every run sees the same text */
+static unsigned int Random(unsigned int& state)
+{
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+
+static unsigned int RandomIdeograph(unsigned int& state)
+{
+    /* The first 2048 CJK unified ideographs hold the most common ones */
+    return 0x4e00 + Random(state) % 2048;
+}
+
+
+static const char *asciiText =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five "
+    "dozen liquor jugs! How vexingly quick daft zebras jump; sphinx of "
+    "black quartz, judge my vow. 0123456789 (+-*/=) [a, b] {c: d} <e|f> "
+    "\"quoted\" 'text' & more ~ text @ 42% #7 $3.50 ^_` ? ";
+
+
+static void MakeASCII(Workload& workload)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        Append(workload, asciiText);
+    }
+}
+
+
+static void MakeCJK(Workload& workload)
+{
+    unsigned int state = 1;
+
+    for(int i = 1; i <= 512; i++)
+    {
+        Append(workload, RandomIdeograph(state));
+
+        if(i % 48 == 0)
+        {
+            Append(workload, 0x3002); // Ideographic full stop
+        }
+        else if(i % 16 == 0)
+        {
+            Append(workload, 0x3001); // Ideographic comma
+        }
+    }
+}
+
+
+static void MakeMixed(Workload& workload)
+{
+    static const char *words[] =
+    {
+        "font", "glyph", "layout", "FTGL", "OpenGL", "render", "3.14", "UTF-8"
+    };
+    static const unsigned int latin[][6] =
+    {
+        { 'c', 'a', 'f', 0xe9, 0, 0 },                // cafe
+        { 'n', 'a', 0xef, 'v', 'e', 0 },              // naive
+        { 0xc4, 'r', 'g', 'e', 'r', 0 },              // Aerger
+        { 0x41f, 0x440, 0x438, 0x432, 0x435, 0x442 }, // Privet
+    };
+    unsigned int state = 2;
+
+    while(workload.chars.size() < 512)
+    {
+        unsigned int r = Random(state);
+
+        switch(r % 3)
+        {
+            case 0:
+                Append(workload, words[r / 3 % 8]);
+                break;
+            case 1:
+                for(unsigned int i = 0; i < 6 && latin[r / 3 % 4][i]; i++)
+                {
+                    Append(workload, latin[r / 3 % 4][i]);
+                }
+                break;
+            default:
+                for(unsigned int i = 0; i < 1 + r / 3 % 4; i++)
+                {
+                    Append(workload, RandomIdeograph(state));
+                }
+                break;
+        }
+
+        Append(workload, ' ');
+    }
+}
+
+
+//
+//  Fonts
+//
+
+struct FontType
+{
+    const char *name;
+    FTFont *(*create)(const char *fontFile);
+    bool headless;
+};
+
+
+static FTFont *CreateBitmap(const char *f) { return new FTBitmapFont(f); }
+static FTFont *CreatePixmap(const char *f) { return new FTPixmapFont(f); }
+static FTFont *CreateBuffer(const char *f) { return new FTBufferFont(f); }
+static FTFont *CreateTexture(const char *f) { return new FTTextureFont(f); }
+static FTFont *CreatePolygon(const char *f) { return new FTPolygonFont(f); }
+static FTFont *CreateOutline(const char *f) { return new FTOutlineFont(f); }
+static FTFont *CreateExtrude(const char *f) { return new FTExtrudeFont(f); }
+
+
+/* Fonts that upload textures from their constructor or while loading
+ * glyphs need a context even when nothing is rendered. */
+static const FontType fontTypes[] =
+{
+    { "bitmap", CreateBitmap, true },
+    { "pixmap", CreatePixmap, true },
+    { "buffer", CreateBuffer, false },
+    { "texture", CreateTexture, false },
+    { "polygon", CreatePolygon, true },
+    { "outline", CreateOutline, true },
+    { "extrude", CreateExtrude, true },
+};
+
+static const int fontTypeCount = sizeof(fontTypes) / sizeof(fontTypes[0]);
+
+
+//
+//  Benchmarks
+//
+
+struct Options
+{
+    double minTime;
+    unsigned int size;
+    bool gl;
+    const char *suite;
+};
+
+static Options options;
+
+
+class Case
+{
+    public:
+        virtual ~Case() {}
+
+        /* Untimed set up before every call */
+        virtual void Prepare() {}
+
+        /* The timed call */
+        virtual void Run() = 0;
+};
+
+
+static void PrintString(const char *s)
+{
+    putchar('"');
+    for(; *s; s++)
+    {
+        if(*s == '"' || *s == '\\')
+        {
+            putchar('\\');
+        }
+        putchar(*s);
+    }
+    putchar('"');
+}
+
+
+static void Measure(const char *suite, const char *font,
+                    const Workload& workload, const char *cache, Case& c)
+{
+    if(options.suite && strcmp(options.suite, suite))
+    {
+        return;
+    }
+
+    // One untimed call to settle caches and lazy initialisation
+    c.Prepare();
+    c.Run();
+
+    double elapsed = 0.0;
+    unsigned long allocs = 0;
+    unsigned long calls = 0;
+
+    while(calls < 3 || elapsed < options.minTime)
+    {
+        c.Prepare();
+
+        unsigned long before = FTBenchAllocations();
+        double start = Now();
+        c.Run();
+        elapsed += Now() - start;
+        allocs += FTBenchAllocations() - before;
+        calls++;
+    }
+
+    double glyphs = (double)workload.chars.size() * (double)calls;
+
+    printf("{\"suite\":\"%s\",\"font\":\"%s\",\"text\":\"%s\","
+           "\"cache\":\"%s\",\"glyphs\":%lu,\"calls\":%lu,"
+           "\"ns_per_glyph\":%.2f,\"ns_per_call\":%.0f,"
+           "\"allocs_per_call\":%.2f}\n",
+           suite, font, workload.name, cache,
+           (unsigned long)workload.chars.size(), calls,
+           elapsed / glyphs, elapsed / (double)calls,
+           (double)allocs / (double)calls);
+    fflush(stdout);
+}
+
+
+/* Glyph loading: every call starts from an empty glyph cache */
+class LoadCase : public Case
+{
+    public:
+        LoadCase(FTFont *f, const Workload& w) : font(f), workload(w) {}
+
+        virtual void Prepare() { font->FaceSize(options.size); }
+        virtual void Run() { sink += font->Advance(workload.text.c_str()); }
+
+    private:
+        FTFont *font;
+        const Workload& workload;
+};
+
+
+class AdvanceCase : public Case
+{
+    public:
+        AdvanceCase(FTFont *f, const Workload& w) : font(f), workload(w) {}
+
+        virtual void Run() { sink += font->Advance(workload.text.c_str()); }
+
+    private:
+        FTFont *font;
+        const Workload& workload;
+};
+
+
+class BBoxCase : public Case
+{
+    public:
+        BBoxCase(FTFont *f, const Workload& w) : font(f), workload(w) {}
+
+        virtual void Run()
+        {
+            sink += font->BBox(workload.text.c_str()).Upper().X();
+        }
+
+    private:
+        FTFont *font;
+        const Workload& workload;
+};
+
+
+/* Line breaking and alignment with a warm glyph cache. A cold run uses a
+ * new layout for every call so that nothing it memoised is reused. */
+class LayoutCase : public Case
+{
+    public:
+        LayoutCase(FTFont *f, const Workload& w, bool c)
+        :   font(f),
+            workload(w),
+            cold(c),
+            layout(NULL)
+        {}
+
+        virtual ~LayoutCase() { delete layout; }
+
+        virtual void Prepare()
+        {
+            if(!layout || cold)
+            {
+                delete layout;
+                layout = new FTSimpleLayout;
+                layout->SetFont(font);
+                layout->SetLineLength(40.0f * options.size);
+                layout->SetAlignment(FTGL::ALIGN_JUSTIFY);
+            }
+        }
+
+        virtual void Run()
+        {
+            sink += layout->BBox(workload.text.c_str()).Lower().Y();
+        }
+
+    private:
+        FTFont *font;
+        const Workload& workload;
+        bool cold;
+        FTSimpleLayout *layout;
+};
+
+
+/* Glyph indices and outlines straight from FreeType, for the benchmarks
+ * that work below the font classes. */
+class FaceCase : public Case
+{
+    public:
+        FaceCase(const Workload& w, FT_Int flags)
+        :   face(w.fontFile),
+            loadFlags(flags)
+        {
+            face.Size(options.size, 72);
+
+            for(size_t i = 0; i < w.chars.size(); i++)
+            {
+                indices.push_back(FT_Get_Char_Index(*face.Face(),
+                                                    w.chars[i]));
+            }
+        }
+
+    protected:
+        FT_GlyphSlot Glyph(size_t i)
+        {
+            return face.Glyph(indices[i], loadFlags);
+        }
+
+        FTFace face;
+        FT_Int loadFlags;
+        std::vector<unsigned int> indices;
+};
+
+
+/* FTBufferGlyph creation: load, rasterise and copy every glyph */
+class BufferLoadCase : public FaceCase
+{
+    public:
+        BufferLoadCase(const Workload& w)
+        :   FaceCase(w, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP)
+        {
+            buffer.Size(1024, 1024);
+        }
+
+        virtual void Run()
+        {
+            for(size_t i = 0; i < indices.size(); i++)
+            {
+                FT_GlyphSlot slot = Glyph(i);
+                if(slot)
+                {
+                    FTBufferGlyph glyph(slot, &buffer);
+                    sink += glyph.Advance();
+                }
+            }
+        }
+
+    private:
+        FTBuffer buffer;
+};
+
+
+/* FTBufferGlyph blits into a 1024x1024 buffer, wrapping at the edge */
+class BufferBlitCase : public FaceCase
+{
+    public:
+        BufferBlitCase(const Workload& w)
+        :   FaceCase(w, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP)
+        {
+            buffer.Size(1024, 1024);
+
+            for(size_t i = 0; i < indices.size(); i++)
+            {
+                FT_GlyphSlot slot = Glyph(i);
+                if(slot)
+                {
+                    glyphs.push_back(new FTBufferGlyph(slot, &buffer));
+                }
+            }
+        }
+
+        virtual ~BufferBlitCase()
+        {
+            for(size_t i = 0; i < glyphs.size(); i++)
+            {
+                delete glyphs[i];
+            }
+        }
+
+        virtual void Run()
+        {
+            float lineHeight = 1.2f * options.size;
+            FTPoint pen(0.0, 1024.0 - lineHeight);
+
+            for(size_t i = 0; i < glyphs.size(); i++)
+            {
+                if(pen.Xf() > 1024.0f - 2.0f * options.size)
+                {
+                    pen = FTPoint(0.0, pen.Yf() - lineHeight);
+                }
+
+                pen += glyphs[i]->Render(pen, FTGL::RENDER_ALL);
+            }
+
+            sink += buffer.Pixels()[0];
+        }
+
+    private:
+        FTBuffer buffer;
+        std::vector<FTBufferGlyph *> glyphs;
+};
+
+
+/* Contour extraction and tessellation, as done by the polygon and
+ * extruded glyphs. An outset of zero skips the contour outsets. */
+class TessellateCase : public FaceCase
+{
+    public:
+        TessellateCase(const Workload& w, int type, float size)
+        :   FaceCase(w, FT_LOAD_NO_HINTING),
+            outsetType(type),
+            outsetSize(size)
+        {}
+
+        virtual void Run()
+        {
+            for(size_t i = 0; i < indices.size(); i++)
+            {
+                FT_GlyphSlot slot = Glyph(i);
+                if(slot)
+                {
+                    FTVectoriser vectoriser(slot);
+                    vectoriser.MakeMesh(1.0, outsetType, outsetSize);
+                    sink += (double)vectoriser.PointCount();
+                }
+            }
+        }
+
+    private:
+        int outsetType;
+        float outsetSize;
+};
+
+
+#ifdef FTBENCH_GL
+/* Draw the text as lines of 32 characters and wait for the GPU. A cold
+ * run starts from an empty glyph cache. */
+class RenderCase : public Case
+{
+    public:
+        RenderCase(FTFont *f, const Workload& w, bool c)
+        :   font(f),
+            workload(w),
+            cold(c)
+        {
+            const std::string& text = workload.text;
+            size_t start = 0;
+            int n = 0;
+
+            for(size_t i = 0; i < text.size(); i++)
+            {
+                // Count lead bytes only
+                if((text[i] & 0xc0) != 0x80 && n++ == 32)
+                {
+                    lines.push_back(start);
+                    start = i;
+                    n = 1;
+                }
+            }
+            lines.push_back(start);
+            lines.push_back(text.size());
+        }
+
+        virtual void Prepare()
+        {
+            if(cold)
+            {
+                font->FaceSize(options.size);
+            }
+        }
+
+        virtual void Run()
+        {
+            const char *text = workload.text.c_str();
+            float lineHeight = font->LineHeight();
+
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            for(size_t i = 0; i + 1 < lines.size(); i++)
+            {
+                FTPoint pos(8.0, 1024.0 - lineHeight * (i + 1));
+                font->Render(text + lines[i], (int)(lines[i + 1] - lines[i]),
+                             pos);
+            }
+            glFinish();
+        }
+
+    private:
+        FTFont *font;
+        const Workload& workload;
+        bool cold;
+        std::vector<size_t> lines;
+};
+
+
+static bool CreateContext(int *argc, char **argv)
+{
+    glutInit(argc, argv);
+    glutInitDisplayMode(GLUT_DEPTH | GLUT_RGB | GLUT_DOUBLE);
+    glutInitWindowPosition(0, 0);
+    glutInitWindowSize(1024, 1024);
+    glutCreateWindow("FTGL benchmark");
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0, 1024.0, 0.0, 1024.0, -1000.0, 1000.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    return true;
+}
+#endif
+
+
+static FTFont *OpenFont(const FontType& type, const char *fontFile)
+{
+    FTFont *font = type.create(fontFile);
+
+    if(font->Error())
+    {
+        fprintf(stderr, "FTBench: could not open %s\n", fontFile);
+        exit(1);
+    }
+
+    if(!options.gl)
+    {
+        font->UseDisplayList(false);
+    }
+    font->FaceSize(options.size);
+
+    return font;
+}
+
+
+static void RunFont(const FontType& type, const Workload& workload)
+{
+    FTFont *font = OpenFont(type, workload.fontFile);
+
+    LoadCase load(font, workload);
+    Measure("load", type.name, workload, "cold", load);
+
+    AdvanceCase advance(font, workload);
+    Measure("advance", type.name, workload, "warm", advance);
+
+    BBoxCase bbox(font, workload);
+    Measure("bbox", type.name, workload, "warm", bbox);
+
+#ifdef FTBENCH_GL
+    if(options.gl)
+    {
+        RenderCase coldRender(font, workload, true);
+        Measure("render", type.name, workload, "cold", coldRender);
+
+        RenderCase warmRender(font, workload, false);
+        Measure("render", type.name, workload, "warm", warmRender);
+    }
+#endif
+
+    delete font;
+}
+
+
+static void RunWorkload(const Workload& workload)
+{
+    for(int i = 0; i < fontTypeCount; i++)
+    {
+        if(fontTypes[i].headless || options.gl)
+        {
+            RunFont(fontTypes[i], workload);
+        }
+    }
+
+    FTFont *font = OpenFont(fontTypes[1], workload.fontFile);
+
+    LayoutCase coldLayout(font, workload, true);
+    Measure("layout", "pixmap", workload, "cold", coldLayout);
+
+    LayoutCase warmLayout(font, workload, false);
+    Measure("layout", "pixmap", workload, "warm", warmLayout);
+
+    delete font;
+
+    BufferLoadCase bufferLoad(workload);
+    Measure("buffer_load", "buffer", workload, "cold", bufferLoad);
+
+    BufferBlitCase bufferBlit(workload);
+    Measure("buffer_blit", "buffer", workload, "warm", bufferBlit);
+
+    TessellateCase tessellate(workload, 0, 0.0f);
+    Measure("tessellate", "polygon", workload, "cold", tessellate);
+
+    TessellateCase outset(workload, 1, 0.1f * options.size);
+    Measure("tessellate_outset", "extrude", workload, "cold", outset);
+}
+
+
+static void Usage()
+{
+    fprintf(stderr, "usage: FTBench [--gl] [--time=ms] [--size=points] "
+                    "[--suite=name] font [cjkfont]\n");
+    exit(2);
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *fontFile = NULL;
+    const char *cjkFontFile = NULL;
+
+    options.minTime = 200e6;
+    options.size = 24;
+    options.gl = false;
+    options.suite = NULL;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "--gl"))
+        {
+            options.gl = true;
+        }
+        else if(!strncmp(argv[i], "--time=", 7))
+        {
+            options.minTime = atof(argv[i] + 7) * 1e6;
+        }
+        else if(!strncmp(argv[i], "--size=", 7))
+        {
+            options.size = (unsigned int)atoi(argv[i] + 7);
+        }
+        else if(!strncmp(argv[i], "--suite=", 8))
+        {
+            options.suite = argv[i] + 8;
+        }
+        else if(argv[i][0] == '-')
+        {
+            Usage();
+        }
+        else if(!fontFile)
+        {
+            fontFile = argv[i];
+        }
+        else if(!cjkFontFile)
+        {
+            cjkFontFile = argv[i];
+        }
+        else
+        {
+            Usage();
+        }
+    }
+
+    if(!fontFile || !options.size)
+    {
+        Usage();
+    }
+
+    if(!cjkFontFile)
+    {
+        cjkFontFile = fontFile;
+    }
+
+    if(options.gl)
+    {
+#ifdef FTBENCH_GL
+        CreateContext(&argc, argv);
+#else
+        fprintf(stderr, "FTBench: built without GLUT, --gl ignored\n");
+        options.gl = false;
+#endif
+    }
+
+    printf("{\"version\":\"%s\",\"font\":", PACKAGE_VERSION);
+    PrintString(fontFile);
+    printf(",\"cjk_font\":");
+    PrintString(cjkFontFile);
+    printf(",\"size\":%u,\"min_time_ms\":%.0f,\"gl\":%s}\n", options.size,
+           options.minTime / 1e6, options.gl ? "true" : "false");
+
+    Workload workloads[3];
+
+    workloads[0].name = "ascii";
+    workloads[0].fontFile = fontFile;
+    MakeASCII(workloads[0]);
+
+    workloads[1].name = "cjk";
+    workloads[1].fontFile = cjkFontFile;
+    MakeCJK(workloads[1]);
+
+    workloads[2].name = "mixed";
+    workloads[2].fontFile = cjkFontFile;
+    MakeMixed(workloads[2]);
+
+    for(int i = 0; i < 3; i++)
+    {
+        RunWorkload(workloads[i]);
+    }
+
+    return 0;
+}
+
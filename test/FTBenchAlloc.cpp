@@ -0,0 +1,95 @@
+/*
+ * FTGL - OpenGL font library
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Allocation counting for FTBench: the global operator new and delete,
+ * replaced to count the C++ allocations made by each benchmark.
+ */
+
+#include "config.h"
+
+#include <stdlib.h>
+
+#include <new>
+
+
+#if __cplusplus >= 201103L
+#   define FTBENCH_THROW
+#   define FTBENCH_NOTHROW noexcept
+#else
+#   define FTBENCH_THROW throw(std::bad_alloc)
+#   define FTBENCH_NOTHROW throw()
+#endif
+
+static unsigned long allocations = 0;
+
+
+unsigned long FTBenchAllocations()
+{
+    return allocations;
+}
+
+
+void *operator new(size_t size) FTBENCH_THROW
+{
+    void *p = malloc(size ? size : 1);
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+
+    ++allocations;
+    return p;
+}
+
+
+void *operator new[](size_t size) FTBENCH_THROW
+{
+    return operator new(size);
+}
+
+
+void operator delete(void *p) FTBENCH_NOTHROW
+{
+    free(p);
+}
+
+
+void operator delete[](void *p) FTBENCH_NOTHROW
+{
+    free(p);
+}
+
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *p, size_t) FTBENCH_NOTHROW
+{
+    free(p);
+}
+
+
+void operator delete[](void *p, size_t) FTBENCH_NOTHROW
+{
+    free(p);
+}
+#endif
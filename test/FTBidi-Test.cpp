@@ -0,0 +1,323 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+
+#include "FTBidi.h"
+
+
+class FTBidiTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTBidiTest);
+        CPPUNIT_TEST(testClassify);
+        CPPUNIT_TEST(testIsMixed);
+        CPPUNIT_TEST(testParagraphLevel);
+        CPPUNIT_TEST(testEmbeddedRuns);
+        CPPUNIT_TEST(testNumbers);
+        CPPUNIT_TEST(testMirror);
+        CPPUNIT_TEST(testBrackets);
+        CPPUNIT_TEST(testOverride);
+        CPPUNIT_TEST(testIsolate);
+        CPPUNIT_TEST(testTrailingWhitespace);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTBidiTest() : CppUnit::TestCase("FTBidi Test")
+        {}
+
+        FTBidiTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+
+        void testClassify()
+        {
+            CPPUNIT_ASSERT_EQUAL(FTBidi::L, FTBidi::Classify('a'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::R, FTBidi::Classify(0x5d0));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::AL, FTBidi::Classify(0x627));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::EN, FTBidi::Classify('1'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::ES, FTBidi::Classify('+'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::ET, FTBidi::Classify('$'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::AN, FTBidi::Classify(0x660));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::CS, FTBidi::Classify(','));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::NSM, FTBidi::Classify(0x301));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::BN, FTBidi::Classify(0x200b));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::B, FTBidi::Classify('\n'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::S, FTBidi::Classify('\t'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::WS, FTBidi::Classify(' '));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::ON, FTBidi::Classify('!'));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::RLO, FTBidi::Classify(0x202e));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::RLI, FTBidi::Classify(0x2067));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::R, FTBidi::Classify(0x5ff));
+            CPPUNIT_ASSERT_EQUAL(FTBidi::L, FTBidi::Classify(0x10fffd));
+        }
+
+
+        void testIsMixed()
+        {
+            unsigned int latin[] = { 'a', 0xe9, ' ', '1' };
+            unsigned int hebrew[] = { 'a', 0x5d0 };
+            unsigned int digits[] = { 'a', 0x660 };
+            unsigned int override[] = { 0x202e, 'a' };
+
+            CPPUNIT_ASSERT(!FTBidi::IsMixed(latin, 4));
+            CPPUNIT_ASSERT(FTBidi::IsMixed(hebrew, 2));
+            CPPUNIT_ASSERT(FTBidi::IsMixed(digits, 2));
+            CPPUNIT_ASSERT(FTBidi::IsMixed(override, 2));
+        }
+
+
+        void testParagraphLevel()
+        {
+            CPPUNIT_ASSERT_EQUAL(0, Level("abc"));
+            CPPUNIT_ASSERT_EQUAL(1, Level("ABC"));
+            CPPUNIT_ASSERT_EQUAL(1, Level("123 ABC def"));
+            CPPUNIT_ASSERT_EQUAL(0, Level("123"));
+            CPPUNIT_ASSERT_EQUAL(0, Level(""));
+
+            // Isolates are skipped, and the first paragraph decides
+            unsigned int isolated[] = { 0x2067, 0x5d0, 0x2069, 'a' };
+            unsigned int paragraphs[] = { '1', '\n', 0x5d0 };
+
+            CPPUNIT_ASSERT_EQUAL(0, FTBidi::ParagraphLevel(isolated, 4));
+            CPPUNIT_ASSERT_EQUAL(0, FTBidi::ParagraphLevel(paragraphs, 3));
+        }
+
+
+        void testEmbeddedRuns()
+        {
+            // Upper case letters stand for Hebrew ones
+            CPPUNIT_ASSERT_EQUAL(std::string("car means RAC."),
+                                 Display("car means CAR."));
+            CPPUNIT_ASSERT_EQUAL(std::string(".IHG def CBA"),
+                                 Display("ABC def GHI."));
+            CPPUNIT_ASSERT_EQUAL(std::string("he said \"KO ,123 SI TI\"."),
+                                 Display("he said \"IT IS 123, OK\"."));
+
+            // Paragraphs are resolved separately
+            CPPUNIT_ASSERT_EQUAL(std::string("ab\nDC"), Display("ab\nCD"));
+        }
+
+
+        void testNumbers()
+        {
+            CPPUNIT_ASSERT_EQUAL(std::string("C 12 BA"), Display("AB 12 C"));
+            CPPUNIT_ASSERT_EQUAL(std::string("C 1.5-2 BA"),
+                                 Display("AB 1.5-2 C"));
+
+            // Numbers after Arabic letters are Arabic numbers
+            unsigned int text[] = { 0x627, ' ', '1', '2' };
+            unsigned char levels[4];
+            FTBidi::Resolve(text, 4, levels);
+
+            CPPUNIT_ASSERT_EQUAL(1, (int)levels[0]);
+            CPPUNIT_ASSERT_EQUAL(1, (int)levels[1]);
+            CPPUNIT_ASSERT_EQUAL(2, (int)levels[2]);
+            CPPUNIT_ASSERT_EQUAL(2, (int)levels[3]);
+        }
+
+
+        void testMirror()
+        {
+            CPPUNIT_ASSERT_EQUAL(0x29u, FTBidi::Mirror(0x28));
+            CPPUNIT_ASSERT_EQUAL(0x28u, FTBidi::Mirror(0x29));
+            CPPUNIT_ASSERT_EQUAL(0x2265u, FTBidi::Mirror(0x2264));
+            CPPUNIT_ASSERT_EQUAL(0x29f5u, FTBidi::Mirror(0x2215));
+            CPPUNIT_ASSERT_EQUAL(0x300bu, FTBidi::Mirror(0x300a));
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', FTBidi::Mirror('a'));
+
+            // Brackets in right to left text are drawn facing the other way
+            CPPUNIT_ASSERT_EQUAL(std::string("(C) BA"), Display("AB (C)"));
+            CPPUNIT_ASSERT_EQUAL(std::string("a (b) c"), Display("a (b) c"));
+        }
+
+
+        void testBrackets()
+        {
+            // Brackets around left to right text in a right to left
+            // paragraph stay with the text they enclose
+            unsigned int text[] = { 0x5d0, ' ', 'x', '(', 'y', ')', ' ',
+                                    0x5d1 };
+            unsigned char levels[8];
+            FTBidi::Resolve(text, 8, levels);
+
+            int expected[] = { 1, 1, 2, 2, 2, 2, 1, 1 };
+            for(int i = 0; i < 8; i++)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected[i], (int)levels[i]);
+            }
+
+            CPPUNIT_ASSERT_EQUAL(std::string("B x(y) A"), Display("A x(y) B"));
+
+            // Canonically equivalent brackets pair up
+            text[3] = 0x2329;
+            text[5] = 0x3009;
+            FTBidi::Resolve(text, 8, levels);
+            CPPUNIT_ASSERT_EQUAL(2, (int)levels[5]);
+
+            // Brackets around right to left text in a left to right
+            // paragraph follow the right to left text before them
+            CPPUNIT_ASSERT_EQUAL(std::string("x (B)A c"), Display("x A(B) c"));
+            CPPUNIT_ASSERT_EQUAL(std::string("a (B) c"), Display("a (B) c"));
+
+            // Text matching the embedding direction wins, and brackets
+            // with nothing strong inside or no partner are left alone
+            CPPUNIT_ASSERT_EQUAL(std::string("x (B c) D"),
+                                 Display("x (B c) D"));
+            CPPUNIT_ASSERT_EQUAL(std::string("C (!) BA"), Display("AB (!) C"));
+            CPPUNIT_ASSERT_EQUAL(std::string("c( BA"), Display("AB )c"));
+
+            // Marks after a bracket take its direction
+            unsigned int marked[] = { 0x5d0, ' ', 'x', '(', 'y', ')',
+                                      0x301, ' ', 0x5d1 };
+            unsigned char markedLevels[9];
+            FTBidi::Resolve(marked, 9, markedLevels);
+            CPPUNIT_ASSERT_EQUAL(2, (int)markedLevels[6]);
+        }
+
+
+        void testOverride()
+        {
+            // RLO a b c PDF d
+            unsigned int text[] = { 0x202e, 'a', 'b', 'c', 0x202c, 'd' };
+            int order[6];
+
+            Reorder(text, 6, order);
+
+            CPPUNIT_ASSERT_EQUAL(0, order[0]);
+            CPPUNIT_ASSERT_EQUAL(4, order[1]);
+            CPPUNIT_ASSERT_EQUAL(3, order[2]);
+            CPPUNIT_ASSERT_EQUAL(2, order[3]);
+            CPPUNIT_ASSERT_EQUAL(1, order[4]);
+            CPPUNIT_ASSERT_EQUAL(5, order[5]);
+        }
+
+
+        void testIsolate()
+        {
+            // a FSI B C space d PDI e: the isolate is right to left
+            unsigned int text[] = { 'a', 0x2068, 0x5d1, 0x5d2, ' ', 'd',
+                                    0x2069, 'e' };
+            int order[8];
+
+            Reorder(text, 8, order);
+
+            int expected[] = { 0, 1, 5, 4, 3, 2, 6, 7 };
+            for(int i = 0; i < 8; i++)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected[i], order[i]);
+            }
+        }
+
+
+        void testTrailingWhitespace()
+        {
+            // The space ending the line goes back to the paragraph level
+            unsigned int text[] = { 'a', 'b', ' ', 0x5d2, 0x5d3, ' ',
+                                    0x5d4, 0x5d5 };
+            unsigned char levels[8];
+            int order[6];
+
+            FTBidi::Resolve(text, 8, levels);
+            CPPUNIT_ASSERT_EQUAL(1, (int)levels[5]);
+
+            FTBidi::Reorder(text, levels, 6, 0, order);
+
+            int expected[] = { 0, 1, 2, 4, 3, 5 };
+            for(int i = 0; i < 6; i++)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected[i], order[i]);
+            }
+        }
+
+
+        void setUp()
+        {}
+
+
+        void tearDown()
+        {}
+
+    private:
+        /* Decode an ASCII string, with upper case letters standing for
+         * Hebrew letters. */
+        int Decode(const char *string, unsigned int *text)
+        {
+            int count = 0;
+
+            for(; string[count]; count++)
+            {
+                char c = string[count];
+                text[count] = (c >= 'A' && c <= 'Z') ? 0x5d0 + c - 'A'
+                                                     : (unsigned char)c;
+            }
+
+            return count;
+        }
+
+
+        int Level(const char *string)
+        {
+            unsigned int text[64];
+            int count = Decode(string, text);
+
+            return FTBidi::ParagraphLevel(text, count);
+        }
+
+
+        void Reorder(const unsigned int *text, const int count, int *order)
+        {
+            unsigned char levels[64];
+
+            FTBidi::Resolve(text, count, levels);
+            FTBidi::Reorder(text, levels, count,
+                            FTBidi::ParagraphLevel(text, count), order);
+        }
+
+
+        /* Put a string in display order, one line per paragraph. */
+        std::string Display(const char *string)
+        {
+            unsigned int text[64];
+            unsigned char levels[64];
+            int order[64];
+            int count = Decode(string, text);
+
+            FTBidi::Resolve(text, count, levels);
+
+            std::string result;
+            int start = 0;
+
+            for(int i = 0; i <= count; i++)
+            {
+                if(i < count && text[i] != '\n')
+                {
+                    continue;
+                }
+
+                FTBidi::Reorder(text + start, levels + start, i - start,
+                                FTBidi::ParagraphLevel(text + start,
+                                                       i - start),
+                                order);
+
+                for(int v = 0; v < i - start; v++)
+                {
+                    int n = start + order[v];
+                    unsigned int c = (levels[n] & 1) ? FTBidi::Mirror(text[n])
+                                                     : text[n];
+                    result += (c >= 0x5d0) ? (char)('A' + c - 0x5d0)
+                                           : (char)c;
+                }
+
+                if(i < count)
+                {
+                    result += '\n';
+                }
+
+                start = i + 1;
+            }
+
+            return result;
+        }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTBidiTest);
+
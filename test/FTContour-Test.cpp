@@ -145,6 +145,8 @@ class FTContourTest : public CppUnit::TestCase
         CPPUNIT_TEST(testDoubleConicCurve);
         CPPUNIT_TEST(testCubicCurve);
         CPPUNIT_TEST(testCompositeCurve);
+        CPPUNIT_TEST(testSharedStore);
+        CPPUNIT_TEST(testLazyOutset);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -212,6 +214,58 @@ class FTContourTest : public CppUnit::TestCase
         }
 
 
+        void testSharedStore()
+        {
+            FTContour::PointVector store;
+            store.reserve(FTContour::MaxPointCount(3 + 4));
+            const FTPoint* items = store.begin();
+
+            FTContour line(straightLinePoints, straightLineTags, 3, &store);
+            FTContour conic(doubleConicPoints, doubleConicTags, 4, &store);
+            FTContour alone(doubleConicPoints, doubleConicTags, 4);
+
+            CPPUNIT_ASSERT(store.begin() == items);
+            CPPUNIT_ASSERT(store.size() == line.PointCount()
+                                           + conic.PointCount());
+            CPPUNIT_ASSERT(&line.Point(0) == &store[0]);
+            CPPUNIT_ASSERT(&conic.Point(0) == &store[3]);
+
+            for(size_t i = 0; i < alone.PointCount(); ++i)
+            {
+                CPPUNIT_ASSERT(conic.Point(i) == alone.Point(i));
+            }
+
+            FTContour::PointVector outsets;
+            outsets.reserve(store.size());
+            line.BuildOutsets(&outsets);
+            conic.BuildOutsets(&outsets);
+            alone.BuildOutsets();
+
+            CPPUNIT_ASSERT(outsets.size() == store.size());
+            CPPUNIT_ASSERT(conic.Outset(0) == alone.Outset(0));
+        }
+
+
+        void testLazyOutset()
+        {
+            FTContour contour(doubleConicPoints, doubleConicTags, 4);
+            contour.SetParity(0);
+
+            contour.buildFrontOutset(0.0f);
+            CPPUNIT_ASSERT(&contour.FrontPoint(0) == &contour.Point(0));
+
+            contour.buildFrontOutset(2.0f);
+            contour.buildBackOutset(-1.0f);
+            CPPUNIT_ASSERT(contour.FrontPoint(0)
+                            == contour.Point(0) + contour.Outset(0) * 2.0f);
+            CPPUNIT_ASSERT(contour.BackPoint(0)
+                            == contour.Point(0) - contour.Outset(0));
+
+            contour.buildBackOutset(0.0f);
+            CPPUNIT_ASSERT(&contour.BackPoint(0) == &contour.Point(0));
+        }
+
+
         void setUp()
         {}
 
@@ -18,6 +18,7 @@ class FTExtrudeFontTest : public CppUnit::TestCase
         CPPUNIT_TEST(testRender);
         CPPUNIT_TEST(testBadDisplayList);
         CPPUNIT_TEST(testGoodDisplayList);
+        CPPUNIT_TEST(testRepeatedRender);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -97,6 +98,43 @@ class FTExtrudeFontTest : public CppUnit::TestCase
             delete extrudedFont;
         }
 
+        void testRepeatedRender()
+        {
+            buildGLContext();
+
+            FTExtrudeFont* extrudedFont = new FTExtrudeFont(FONT_FILE);
+            extrudedFont->FaceSize(18);
+            extrudedFont->Depth(5);
+
+            // The string is compiled on its second use and called after
+            // that, wherever it is drawn
+            FTPoint first = extrudedFont->Render(GOOD_ASCII_TEST_STRING);
+            for(int i = 1; i < 4; i++)
+            {
+                FTPoint position(10.0f * i, 5.0f * i, 1.0f);
+                FTPoint end = extrudedFont->Render(GOOD_ASCII_TEST_STRING,
+                                                   -1, position);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(first.X() + position.X(),
+                                             end.X(), 0.01);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(position.Y(), end.Y(), 0.01);
+            }
+
+            extrudedFont->Depth(10);
+            extrudedFont->Outset(1, 2);
+            extrudedFont->Render(GOOD_ASCII_TEST_STRING);
+            extrudedFont->Render(GOOD_ASCII_TEST_STRING);
+
+            extrudedFont->FaceSize(36);
+            FTPoint larger = extrudedFont->Render(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT(larger.X() > first.X());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(larger.X(),
+                extrudedFont->Render(GOOD_ASCII_TEST_STRING).X(), 0.01);
+
+            CPPUNIT_ASSERT_EQUAL(extrudedFont->Error(), 0);
+            CPPUNIT_ASSERT_EQUAL(GL_NO_ERROR, (int)glGetError());
+            delete extrudedFont;
+        }
+
         void setUp()
         {}
 
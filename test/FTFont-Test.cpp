@@ -84,6 +84,9 @@ class FTFontTest : public CppUnit::TestCase
         CPPUNIT_TEST(testCheckGlyphFailure);
         CPPUNIT_TEST(testAdvance);
         CPPUNIT_TEST(testRender);
+        CPPUNIT_TEST(testBidi);
+        CPPUNIT_TEST(testGlyphIndices);
+        CPPUNIT_TEST(testUnicodeStrings);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -260,6 +263,166 @@ class FTFontTest : public CppUnit::TestCase
         }
 
 
+        void testBidi()
+        {
+            CPPUNIT_ASSERT(testFont->FaceSize(FONT_POINT_SIZE));
+
+            // Both strings are displayed as a latin letter followed by a
+            // Hebrew one, the second as a right to left paragraph
+            const wchar_t ltr[] = { 'a', 0x5d0, 0 };
+            const wchar_t rtl[] = { 0x5d0, 'a', 0 };
+
+            FTBBox ltrBox = testFont->BBox(ltr);
+            FTBBox rtlBox = testFont->BBox(rtl);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(ltrBox.Lower().X(),
+                                         rtlBox.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(ltrBox.Upper().X(),
+                                         rtlBox.Upper().X(), 0.01);
+
+            // Drawing the same string again uses the cached order
+            testFont->Render(rtl);
+            testFont->Render(rtl);
+            CPPUNIT_ASSERT_EQUAL(testFont->Error(), 0);
+        }
+
+
+        void testGlyphIndices()
+        {
+            CPPUNIT_ASSERT(testFont->FaceSize(FONT_POINT_SIZE));
+
+            // Map the test string to glyphs with FreeType directly
+            FT_Library library;
+            FT_Face face;
+            CPPUNIT_ASSERT_EQUAL(0, (int)FT_Init_FreeType(&library));
+            CPPUNIT_ASSERT_EQUAL(0, (int)FT_New_Face(library, GOOD_FONT_FILE,
+                                                     0, &face));
+
+            const char *text = GOOD_ASCII_TEST_STRING;
+            unsigned int glyphs[32];
+            int count = 0;
+            while(text[count])
+            {
+                glyphs[count] = FT_Get_Char_Index(face, text[count]);
+                count++;
+            }
+
+            FT_Done_Face(face);
+            FT_Done_FreeType(library);
+
+            // Without positions, glyphs are laid out like the string
+            FTPoint spacing(2.0, 0.0);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(testFont->Advance(text, -1, spacing),
+                testFont->AdvanceGlyphs(glyphs, NULL, count, spacing), 0.01);
+
+            FTBBox stringBox = testFont->BBox(text);
+            FTBBox glyphBox = testFont->BBoxGlyphs(glyphs, NULL, count);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(stringBox.Lower().X(),
+                                         glyphBox.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(stringBox.Upper().X(),
+                                         glyphBox.Upper().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(stringBox.Upper().Y(),
+                                         glyphBox.Upper().Y(), 0.01);
+
+            FTPoint stringEnd = testFont->Render(text, -1, FTPoint(10.0, 5.0));
+            FTPoint glyphEnd = testFont->RenderGlyphs(glyphs, NULL, count,
+                                                      FTPoint(10.0, 5.0));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(stringEnd.X(), glyphEnd.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(stringEnd.Y(), glyphEnd.Y(), 0.01);
+            CPPUNIT_ASSERT_EQUAL(testFont->Error(), 0);
+
+            // With positions, each glyph is drawn where it is told to
+            FTPoint positions[2] = { FTPoint(0.0, 0.0), FTPoint(100.0, 20.0) };
+            float last = testFont->Advance(text + 1, 1);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 + last,
+                testFont->AdvanceGlyphs(glyphs, positions, 2), 0.01);
+
+            glyphEnd = testFont->RenderGlyphs(glyphs, positions, 2,
+                                              FTPoint(10.0, 5.0));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(110.0 + last, glyphEnd.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(25.0, glyphEnd.Y(), 0.01);
+
+            FTBBox secondBox = testFont->BBox(text + 1, 1);
+            glyphBox = testFont->BBoxGlyphs(glyphs, positions, 2);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(secondBox.Upper().X() + 100.0,
+                                         glyphBox.Upper().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(secondBox.Upper().Y() + 20.0,
+                                         glyphBox.Upper().Y(), 0.01);
+        }
+
+
+        void testUnicodeStrings()
+        {
+            testFont->FaceSize(18);
+
+            // "AVé" followed by U+1F600, in each encoding
+            const char *utf8 = "AV\xc3\xa9\xf0\x9f\x98\x80";
+            const unsigned short utf16[] = { 'A', 'V', 0xe9, 0xd83d, 0xde00 };
+            const unsigned int utf32[] = { 'A', 'V', 0xe9, 0x1f600 };
+            const wchar_t wide[] = { 'A', 'V', 0xe9, 0 };
+
+            float advance = testFont->Advance(utf8);
+            CPPUNIT_ASSERT(advance > 0.0f);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance,
+                testFont->AdvanceUTF8(utf8, -1), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance,
+                testFont->AdvanceUTF8(utf8, 8), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance,
+                testFont->AdvanceUTF16(utf16, 5), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance,
+                testFont->AdvanceUTF32(utf32, 4), 0.01);
+
+            // Lengths are in code units, and the string ends there: the
+            // last character is not kerned with the next one
+            float prefix = testFont->Advance(wide);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(prefix,
+                testFont->AdvanceUTF8(utf8, 4), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(prefix,
+                testFont->AdvanceUTF16(utf16, 3), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(prefix,
+                testFont->AdvanceUTF32(utf32, 3), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(testFont->Advance("A"),
+                testFont->AdvanceUTF8(utf8, 1), 0.01);
+
+            FTBBox box = testFont->BBox(wide);
+            FTBBox box16 = testFont->BBoxUTF16(utf16, 3, FTPoint(), FTPoint());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(box.Upper().X(), box16.Upper().X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(box.Upper().Y(), box16.Upper().Y(),
+                                         0.01);
+
+            FTPoint end = testFont->RenderUTF32(utf32, 3, FTPoint(10.0, 5.0));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0 + prefix, end.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, end.Y(), 0.01);
+
+#ifdef FTGL_HAS_UNICODE_CHARS
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(prefix,
+                testFont->Advance(u"AV\u00e9"), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance,
+                testFont->Advance(U"AV\u00e9\U0001f600"), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0 + prefix,
+                testFont->Render(u"AV\u00e9", -1, FTPoint(10.0, 5.0)).X(),
+                0.01);
+#endif
+
+#ifdef FTGL_HAS_STRING_VIEW
+            std::string text = "AVAVAV";
+            std::u16string text16 = u"AVAVAV";
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(testFont->Advance("AVA"),
+                testFont->Advance(std::string_view(text).substr(0, 3)), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(testFont->Advance("AVA"),
+                testFont->Advance(std::u16string_view(text16).substr(2, 3)),
+                0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(testFont->BBox("AVA").Upper().X(),
+                testFont->BBox(std::string_view(text).substr(0, 3)).Upper().X(),
+                0.01);
+#endif
+
+            CPPUNIT_ASSERT_EQUAL(testFont->Error(), 0);
+        }
+
+
         void setUp()
         {
             testFont = new TestFont(GOOD_FONT_FILE);
@@ -15,8 +15,8 @@
 class TestGlyph : public FTGlyph
 {
     public:
-        TestGlyph()
-        :   FTGlyph((FT_GlyphSlot)0)
+        TestGlyph(FT_GlyphSlot glyph = 0)
+        :   FTGlyph(glyph)
         {
             advance = FTPoint(50.0f, 0.0f, 0.0f);
         }
@@ -35,6 +35,7 @@ class FTGlyphContainerTest : public CppUnit::TestCase
         CPPUNIT_TEST(testSetCharMap);
         CPPUNIT_TEST(testGlyphIndex);
         CPPUNIT_TEST(testAdvance);
+        CPPUNIT_TEST(testMetrics);
         CPPUNIT_TEST(testRender);
     CPPUNIT_TEST_SUITE_END();
 
@@ -92,6 +93,31 @@ class FTGlyphContainerTest : public CppUnit::TestCase
         }
 
 
+        void testMetrics()
+        {
+            unsigned int index = glyphContainer->FontIndex(CHARACTER_CODE_A);
+            TestGlyph* glyph = new TestGlyph(face->Glyph(index,
+                                                         FT_LOAD_NO_HINTING));
+
+            FTBBox bbox = glyphContainer->BBox(CHARACTER_CODE_A);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0, bbox.Upper().X() - bbox.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0, glyphContainer->IndexedAdvance(index, 0), 0.01);
+
+            glyphContainer->Add(glyph, CHARACTER_CODE_A);
+
+            bbox = glyphContainer->BBox(CHARACTER_CODE_A);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(glyph->BBox().Lower().X(), bbox.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(glyph->BBox().Upper().Y(), bbox.Upper().Y(), 0.01);
+            CPPUNIT_ASSERT(bbox.Upper().X() > bbox.Lower().X());
+
+            bbox = glyphContainer->IndexedBounds(index);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(glyph->BBox().Upper().X(), bbox.Upper().X(), 0.01);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(glyph->Advance(),
+                                         glyphContainer->IndexedAdvance(index, 0), 0.01);
+        }
+
+
         void testRender()
         {
             TestGlyph* glyph = new TestGlyph();
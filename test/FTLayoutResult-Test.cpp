@@ -0,0 +1,180 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+
+#include "Fontdefs.h"
+#include "FTGL/ftgl.h"
+
+
+class FTLayoutResultTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTLayoutResultTest);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testLines);
+        CPPUNIT_TEST(testPosition);
+        CPPUNIT_TEST(testSettingsChange);
+        CPPUNIT_TEST(testCopy);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTLayoutResultTest() : CppUnit::TestCase("FTLayoutResult Test")
+        {}
+
+        FTLayoutResultTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+
+        void testEmpty()
+        {
+            FTLayoutResult result;
+
+            CPPUNIT_ASSERT_EQUAL(0, result.CharCount());
+            CPPUNIT_ASSERT_EQUAL(0, result.LineCount());
+            CPPUNIT_ASSERT_EQUAL(-1, result.LineStart(0));
+            CPPUNIT_ASSERT_EQUAL(-1, result.CharIndex(FTPoint()));
+
+            // No font set
+            FTSimpleLayout layout;
+            result = layout.Layout("hello");
+            CPPUNIT_ASSERT_EQUAL(0, result.LineCount());
+
+            result.Render();
+        }
+
+
+        void testLines()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(1000.0f);
+
+            FTLayoutResult result = layout.Layout("one\ntwo words");
+
+            CPPUNIT_ASSERT_EQUAL(13, result.CharCount());
+            CPPUNIT_ASSERT_EQUAL(2, result.LineCount());
+            CPPUNIT_ASSERT_EQUAL(0, result.LineStart(0));
+            CPPUNIT_ASSERT_EQUAL(3, result.LineEnd(0));
+            CPPUNIT_ASSERT_EQUAL(4, result.LineStart(1));
+            CPPUNIT_ASSERT_EQUAL(13, result.LineEnd(1));
+
+            FTPoint second = result.LinePosition(1);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, second.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-font.LineHeight(), second.Y(), 0.01);
+
+            FTPoint end = result.CharPosition(13);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(font.Advance("two words"), end.X(),
+                                         0.01);
+            CPPUNIT_ASSERT_EQUAL(4, result.CharIndex(second));
+
+            FTBBox box = result.BBox();
+            FTBBox lines = result.LineBBox(0);
+            lines |= result.LineBBox(1);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(lines.Upper().X(), box.Upper().X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(lines.Lower().Y(), box.Lower().Y(),
+                                         0.01);
+
+            // Wide strings give the same lines
+            FTLayoutResult wide = layout.Layout(L"one\ntwo words");
+            CPPUNIT_ASSERT_EQUAL(2, wide.LineCount());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(end.X(), wide.CharPosition(13).X(),
+                                         0.01);
+        }
+
+
+        void testPosition()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+
+            FTLayoutResult result = layout.Layout("hello world");
+
+            FTBBox box = result.BBox();
+            FTBBox moved = result.BBox(FTPoint(10.0f, 20.0f));
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(box.Lower().X() + 10.0,
+                                         moved.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(box.Upper().Y() + 20.0,
+                                         moved.Upper().Y(), 0.01);
+
+            FTBBox direct = layout.BBox("hello world", -1,
+                                        FTPoint(10.0f, 20.0f));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(direct.Upper().X(),
+                                         moved.Upper().X(), 0.01);
+        }
+
+
+        void testSettingsChange()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(1000.0f);
+
+            FTLayoutResult result = layout.Layout("one two three");
+            FTBBox box = result.BBox();
+
+            layout.SetLineLength(font.Advance("one two") + 1.0f);
+            layout.SetAlignment(FTGL::ALIGN_RIGHT);
+
+            FTLayoutResult wrapped = layout.Layout("one two three");
+            CPPUNIT_ASSERT_EQUAL(2, wrapped.LineCount());
+
+            // The first result is left as it was
+            CPPUNIT_ASSERT_EQUAL(1, result.LineCount());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(box.Upper().X(),
+                                         result.BBox().Upper().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, result.LinePosition(0).X(),
+                                         0.01);
+
+            // Only the alignment changes
+            layout.SetAlignment(FTGL::ALIGN_LEFT);
+            FTLayoutResult left = layout.Layout("one two three");
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, left.LinePosition(1).X(), 0.01);
+            CPPUNIT_ASSERT(wrapped.LinePosition(1).X() > 0.0);
+        }
+
+
+        void testCopy()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+
+            FTLayoutResult result = layout.Layout("hello");
+            FTLayoutResult copy(result);
+            FTLayoutResult again = layout.Layout("hello");
+
+            result = FTLayoutResult();
+
+            CPPUNIT_ASSERT_EQUAL(0, result.LineCount());
+            CPPUNIT_ASSERT_EQUAL(1, copy.LineCount());
+            CPPUNIT_ASSERT_EQUAL(5, again.CharCount());
+
+            copy = copy;
+            CPPUNIT_ASSERT_EQUAL(5, copy.CharCount());
+        }
+
+
+        void setUp()
+        {}
+
+
+        void tearDown()
+        {}
+
+    private:
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTLayoutResultTest);
+
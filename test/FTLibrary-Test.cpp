@@ -10,6 +10,7 @@ class FTLibraryTest : public CppUnit::TestCase
     CPPUNIT_TEST_SUITE(FTLibraryTest);
         CPPUNIT_TEST(testConstructor);
         CPPUNIT_TEST(testError);
+        CPPUNIT_TEST(testMutex);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -36,6 +37,18 @@ class FTLibraryTest : public CppUnit::TestCase
         }
 
 
+        void testMutex()
+        {
+            const FTLibrary& library = FTLibrary::Instance();
+
+            CPPUNIT_ASSERT(&library.Mutex() == &FTLibrary::Instance().Mutex());
+
+            // The lock is recursive: taking it twice must not deadlock.
+            FTMutexLock outer(library.Mutex());
+            FTMutexLock inner(library.Mutex());
+        }
+
+
         void setUp()
         {}
 
@@ -0,0 +1,155 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+
+#include "FTLineBreak.h"
+
+
+class FTLineBreakTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTLineBreakTest);
+        CPPUNIT_TEST(testClassify);
+        CPPUNIT_TEST(testSpaces);
+        CPPUNIT_TEST(testPunctuation);
+        CPPUNIT_TEST(testIdeographs);
+        CPPUNIT_TEST(testHardBreaks);
+        CPPUNIT_TEST(testCombiningMarks);
+        CPPUNIT_TEST(testRegionalIndicators);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTLineBreakTest() : CppUnit::TestCase("FTLineBreak Test")
+        {}
+
+        FTLineBreakTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+
+        void testClassify()
+        {
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::AL, FTLineBreak::Classify('a'));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::SP, FTLineBreak::Classify(' '));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::LF, FTLineBreak::Classify('\n'));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::HY, FTLineBreak::Classify('-'));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::NU, FTLineBreak::Classify('7'));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::OP, FTLineBreak::Classify('('));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::GL, FTLineBreak::Classify(0xa0));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::CM, FTLineBreak::Classify(0x301));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::HL, FTLineBreak::Classify(0x5d0));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::ZW, FTLineBreak::Classify(0x200b));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::BK, FTLineBreak::Classify(0x2028));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::ID, FTLineBreak::Classify(0x6f22));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::CL, FTLineBreak::Classify(0x3002));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::H2, FTLineBreak::Classify(0xac00));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::H3, FTLineBreak::Classify(0xac01));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::ID, FTLineBreak::Classify(0x20000));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::RI, FTLineBreak::Classify(0x1f1eb));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::CM, FTLineBreak::Classify(0xe0100));
+            CPPUNIT_ASSERT_EQUAL(FTLineBreak::AL, FTLineBreak::Classify(0x10fffd));
+        }
+
+
+        void testSpaces()
+        {
+            // Breaks go after the spaces, never before them, and not after
+            // the spaces starting a paragraph
+            CPPUNIT_ASSERT_EQUAL(std::string("^^^_^^"), Breaks("ab  cd"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^^^"), Breaks(" ab"));
+        }
+
+
+        void testPunctuation()
+        {
+            // After a hyphen or a slash, not before a closing bracket
+            CPPUNIT_ASSERT_EQUAL(std::string("^^_^^"), Breaks("ab-cd"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^_^"), Breaks("a/b"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^^^^_^"), Breaks("(ab) c"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^^^^"), Breaks("-123"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^^^_^"), Breaks("ab, c"));
+        }
+
+
+        void testIdeographs()
+        {
+            // Between ideographs, but not before a full stop
+            unsigned int text[] = { 0x6f22, 0x5b57, 0x3002, 0x6f22 };
+            unsigned char breaks[4];
+            FTLineBreak::Find(text, 4, breaks);
+
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::ALLOWED, (int)breaks[0]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[1]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::ALLOWED, (int)breaks[2]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[3]);
+        }
+
+
+        void testHardBreaks()
+        {
+            CPPUNIT_ASSERT_EQUAL(std::string("^!^!"), Breaks("a\nb\n"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^^!^"), Breaks("a\r\nb"));
+            CPPUNIT_ASSERT_EQUAL(std::string("^!^"), Breaks("a\rb"));
+        }
+
+
+        void testCombiningMarks()
+        {
+            // A mark stays with its base, and is a letter after a space
+            unsigned int text[] = { 'a', 0x301, ' ', 0x301, 'b' };
+            unsigned char breaks[5];
+            FTLineBreak::Find(text, 5, breaks);
+
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[0]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[1]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::ALLOWED, (int)breaks[2]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[3]);
+        }
+
+
+        void testRegionalIndicators()
+        {
+            // Flags are pairs of regional indicators
+            unsigned int text[] = { 0x1f1eb, 0x1f1f7, 0x1f1e9, 0x1f1ea };
+            unsigned char breaks[4];
+            FTLineBreak::Find(text, 4, breaks);
+
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[0]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::ALLOWED, (int)breaks[1]);
+            CPPUNIT_ASSERT_EQUAL((int)FTLineBreak::PROHIBITED, (int)breaks[2]);
+        }
+
+
+        void setUp()
+        {}
+
+
+        void tearDown()
+        {}
+
+    private:
+        /* Describe the breaks of an ASCII string: '_' where a break is
+         * allowed, '^' where it is not and '!' where it is mandatory. */
+        std::string Breaks(const char *string)
+        {
+            unsigned int text[64];
+            unsigned char breaks[64];
+            int count = 0;
+
+            for(; string[count]; count++)
+            {
+                text[count] = (unsigned char)string[count];
+            }
+
+            FTLineBreak::Find(text, count, breaks);
+
+            std::string result;
+            for(int i = 0; i < count; i++)
+            {
+                result += "^_!"[breaks[i]];
+            }
+
+            return result;
+        }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTLineBreakTest);
+
@@ -13,6 +13,7 @@ class FTListTest : public CppUnit::TestCase
         CPPUNIT_TEST(testPushBack);
         CPPUNIT_TEST(testGetBack);
         CPPUNIT_TEST(testGetFront);
+        CPPUNIT_TEST(testStableItems);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -67,6 +68,26 @@ class FTListTest : public CppUnit::TestCase
         }
 
 
+        void testStableItems()
+        {
+            FTList<int> listOfIntegers;
+            listOfIntegers.reserve(4);
+
+            listOfIntegers.push_back(0);
+            const int *first = &listOfIntegers.front();
+
+            for(int i = 1; i < 1000; i++)
+            {
+                listOfIntegers.emplace_back() = i;
+            }
+
+            CPPUNIT_ASSERT(listOfIntegers.size() == 1000);
+            CPPUNIT_ASSERT(&listOfIntegers.front() == first);
+            CPPUNIT_ASSERT(listOfIntegers.front() == 0);
+            CPPUNIT_ASSERT(listOfIntegers.back() == 999);
+        }
+
+
         void setUp()
         {}
 
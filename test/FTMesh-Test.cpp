@@ -32,6 +32,7 @@ class FTMeshTest : public CppUnit::TestCase
         CPPUNIT_TEST(testGetTesselation);
         CPPUNIT_TEST(testAddPoint);
         CPPUNIT_TEST(testTooManyPoints);
+        CPPUNIT_TEST(testSharedPoints);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -132,6 +133,39 @@ class FTMeshTest : public CppUnit::TestCase
             CPPUNIT_ASSERT(*testOutput == static_cast<const FTGL_DOUBLE*>(mesh.TempPointList().front()));
         }
 
+        void testSharedPoints()
+        {
+            FTGL_DOUBLE points[][3] =
+            {
+                { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 10, 11, 12 }
+            };
+
+            FTMesh mesh;
+            mesh.Reserve(2);
+
+            ftglBegin(GL_TRIANGLE_FAN, &mesh);
+            ftglVertex(points[0], &mesh);
+            ftglVertex(points[1], &mesh);
+            ftglVertex(points[2], &mesh);
+            ftglEnd(&mesh);
+
+            ftglBegin(GL_TRIANGLES, &mesh);
+            for(unsigned int x = 0; x < 300; ++x)
+            {
+                ftglVertex(points[x % 4], &mesh);
+            }
+            ftglEnd(&mesh);
+
+            const FTTesselation* fan = mesh.Tesselation(0);
+            const FTTesselation* triangles = mesh.Tesselation(1);
+
+            CPPUNIT_ASSERT(fan->PointCount() == 3);
+            CPPUNIT_ASSERT(fan->Point(2) == FTPoint(7, 8, 9));
+            CPPUNIT_ASSERT(triangles->PointCount() == 300);
+            CPPUNIT_ASSERT(triangles->Point(0) == FTPoint(1, 2, 3));
+            CPPUNIT_ASSERT(triangles->Point(299) == FTPoint(10, 11, 12));
+        }
+
         void setUp()
         {}
 
@@ -0,0 +1,136 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <assert.h>
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+#include "FTPointf.h"
+
+
+class FTPointfTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTPointfTest);
+        CPPUNIT_TEST(testSize);
+        CPPUNIT_TEST(testConstructor);
+        CPPUNIT_TEST(testConversion);
+        CPPUNIT_TEST(testOperatorPlus);
+        CPPUNIT_TEST(testOperatorMinus);
+        CPPUNIT_TEST(testOperatorMultiply);
+        CPPUNIT_TEST(testSetters);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTPointfTest() : CppUnit::TestCase("FTPointf Test")
+        {}
+
+        FTPointfTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        void testSize()
+        {
+            CPPUNIT_ASSERT_EQUAL(16, (int)sizeof(FTPointf));
+            CPPUNIT_ASSERT(sizeof(FTPointf) < sizeof(FTPoint));
+        }
+
+        void testConstructor()
+        {
+            FTPointf point;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, point.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, point.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, point.Zf(), 0.0001);
+
+            FTPointf point2(1.0f, 2.0f, 3.0f);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0f, point2.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, point2.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0f, point2.Zf(), 0.0001);
+
+            const float *values = point2.Values();
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0f, values[0], 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, values[1], 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0f, values[2], 0.0001);
+        }
+
+        void testConversion()
+        {
+            FTPointf point(FTPoint(1.5, -2.25, 4.0));
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5f, point.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.25f, point.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0f, point.Zf(), 0.0001);
+
+            FTPoint back = point;
+
+            CPPUNIT_ASSERT(back == FTPoint(1.5, -2.25, 4.0));
+        }
+
+        void testOperatorPlus()
+        {
+            FTPointf point1(1.0f, 2.0f, 3.0f);
+            FTPointf point2(1.0f, 2.0f, 3.0f);
+
+            FTPointf point3 = point1 + point2;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, point3.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0f, point3.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0f, point3.Zf(), 0.0001);
+
+            point1 += point2;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, point1.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0f, point1.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0f, point1.Zf(), 0.0001);
+        }
+
+        void testOperatorMinus()
+        {
+            FTPointf point1(1.0f, 2.0f, 3.0f);
+            FTPointf point2(0.5f, 2.0f, 4.0f);
+
+            FTPointf point3 = point1 - point2;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5f, point3.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, point3.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0f, point3.Zf(), 0.0001);
+
+            point1 -= point2;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5f, point1.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0f, point1.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0f, point1.Zf(), 0.0001);
+        }
+
+        void testOperatorMultiply()
+        {
+            FTPointf point = FTPointf(1.0f, 2.0f, 3.0f) * 2.0f;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, point.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0f, point.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0f, point.Zf(), 0.0001);
+        }
+
+        void testSetters()
+        {
+            FTPointf point;
+
+            point.X(1.0f);
+            point.Y(2.0f);
+            point.Z(3.0f);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0f, point.Xf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0f, point.Yf(), 0.0001);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0f, point.Zf(), 0.0001);
+        }
+
+        void setUp()
+        {}
+
+        void tearDown()
+        {}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTPointfTest);
@@ -18,6 +18,7 @@ class FTPolygonFontTest : public CppUnit::TestCase
         CPPUNIT_TEST(testRender);
         CPPUNIT_TEST(testBadDisplayList);
         CPPUNIT_TEST(testGoodDisplayList);
+        CPPUNIT_TEST(testCoreBackend);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -98,6 +99,34 @@ class FTPolygonFontTest : public CppUnit::TestCase
             delete polygonFont;
         }
 
+        void testCoreBackend()
+        {
+            buildGLContext();
+
+            FTPolygonFont* polygonFont =
+                new FTPolygonFont(FONT_FILE, FTGL::BACKEND_CORE_PROFILE);
+            CPPUNIT_ASSERT_EQUAL(polygonFont->Error(), 0);
+            CPPUNIT_ASSERT_EQUAL(FTGL::BACKEND_CORE_PROFILE,
+                                 polygonFont->Backend());
+            polygonFont->FaceSize(18);
+
+            float advance = polygonFont->Advance(GOOD_ASCII_TEST_STRING);
+            FTPoint end = polygonFont->Render(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(advance, end.X(), 0.01);
+
+            // The core profile backend never builds display lists, so it
+            // can be used while the caller compiles one
+            int glList = glGenLists(1);
+            glNewList(glList, GL_COMPILE);
+
+                polygonFont->Render(GOOD_ASCII_TEST_STRING);
+
+            glEndList();
+
+            CPPUNIT_ASSERT_EQUAL(GL_NO_ERROR, (int)glGetError());
+            delete polygonFont;
+        }
+
         void setUp()
         {}
 
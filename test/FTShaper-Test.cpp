@@ -0,0 +1,321 @@
+#include "cppunit/extensions/HelperMacros.h"
+#include "cppunit/TestCaller.h"
+#include "cppunit/TestCase.h"
+#include "cppunit/TestSuite.h"
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+
+
+/* Maps each character to its glyph, ten pixels wide, and "fi" to the glyph
+ * of 'X'. Right to left runs come back reversed. */
+class TestShaper : public FTShaper
+{
+    public:
+        TestShaper()
+        :   calls(0),
+            runs(0),
+            glyphsPerChar(1),
+            fail(false)
+        {}
+
+        int Shape(FT_Face face, const unsigned int *text, const int count,
+                  const bool rightToLeft, FTShapedGlyph *glyphs,
+                  const int maxGlyphs)
+        {
+            calls++;
+            if(fail)
+            {
+                return -1;
+            }
+
+            if(runs < 4)
+            {
+                runText[runs] = text[0];
+                runCount[runs] = count;
+                runRTL[runs] = rightToLeft;
+            }
+            runs++;
+
+            FTShapedGlyph run[64];
+            int n = 0;
+
+            for(int i = 0; i < count; i++)
+            {
+                unsigned int c = text[i];
+                if(c == 'f' && i + 1 < count && text[i + 1] == 'i')
+                {
+                    c = 'X';
+                }
+
+                for(int j = 0; j < glyphsPerChar; j++, n++)
+                {
+                    run[n].index = FT_Get_Char_Index(face, c);
+                    run[n].cluster = i;
+                    run[n].advance = FTPoint(10.0, 0.0);
+                    run[n].offset = FTPoint(0.0, 2.0);
+                }
+
+                if(c == 'X')
+                {
+                    i++;
+                }
+            }
+
+            for(int i = 0; i < n && n <= maxGlyphs; i++)
+            {
+                glyphs[i] = run[rightToLeft ? n - 1 - i : i];
+            }
+
+            return n;
+        }
+
+        int calls;
+        int runs;
+        unsigned int runText[4];
+        int runCount[4];
+        bool runRTL[4];
+        int glyphsPerChar;
+        bool fail;
+};
+
+
+class FTShaperTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTShaperTest);
+        CPPUNIT_TEST(testAdvance);
+        CPPUNIT_TEST(testBoundingBox);
+        CPPUNIT_TEST(testCache);
+        CPPUNIT_TEST(testBidiRuns);
+        CPPUNIT_TEST(testLargeRun);
+        CPPUNIT_TEST(testFallback);
+        CPPUNIT_TEST(testRender);
+        CPPUNIT_TEST(testLayout);
+        CPPUNIT_TEST(testHarfBuzz);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTShaperTest() : CppUnit::TestCase("FTShaper Test")
+        {}
+
+        FTShaperTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+
+        void testAdvance()
+        {
+            CPPUNIT_ASSERT(testFont->Shaper() == &shaper);
+
+            // "fi" is a single glyph
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(40.0, testFont->Advance("afib!"),
+                                         0.01);
+
+            // Spacing only goes between clusters
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(43.0,
+                testFont->Advance("afib!", -1, FTPoint(1.0, 0.0)), 0.01);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, testFont->Advance("afib!", 3),
+                                         0.01);
+        }
+
+
+        void testBoundingBox()
+        {
+            FTPixmapFont plainFont(GOOD_FONT_FILE);
+            plainFont.FaceSize(FONT_POINT_SIZE);
+
+            // The glyph is moved by its offset
+            FTBBox plain = plainFont.BBox("a");
+            FTBBox shaped = testFont->BBox("a");
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(plain.Lower().X(),
+                                         shaped.Lower().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(plain.Lower().Y() + 2.0,
+                                         shaped.Lower().Y(), 0.01);
+
+            // The second glyph starts after the shaped advance
+            FTBBox second = plainFont.BBox("X");
+            FTBBox shapedPair = testFont->BBox("aX");
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(second.Upper().X() + 10.0,
+                                         shapedPair.Upper().X(), 0.01);
+        }
+
+
+        void testCache()
+        {
+            testFont->Advance("hello");
+            testFont->BBox("hello");
+            testFont->Advance("hello");
+            CPPUNIT_ASSERT_EQUAL(1, shaper.calls);
+
+            // The glyphs depend on the size
+            testFont->FaceSize(FONT_POINT_SIZE + 1);
+            testFont->Advance("hello");
+            CPPUNIT_ASSERT_EQUAL(2, shaper.calls);
+
+            testFont->Shaper(&shaper);
+            testFont->Advance("hello");
+            CPPUNIT_ASSERT_EQUAL(3, shaper.calls);
+        }
+
+
+        void testBidiRuns()
+        {
+            // "ab " then two Hebrew letters, displayed to the right
+            const wchar_t mixed[] = { 'a', 'b', ' ', 0x5d0, 0x5d1, 0 };
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0, testFont->Advance(mixed), 0.01);
+            CPPUNIT_ASSERT_EQUAL(2, shaper.runs);
+
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', shaper.runText[0]);
+            CPPUNIT_ASSERT_EQUAL(3, shaper.runCount[0]);
+            CPPUNIT_ASSERT(!shaper.runRTL[0]);
+
+            CPPUNIT_ASSERT_EQUAL((unsigned int)0x5d0, shaper.runText[1]);
+            CPPUNIT_ASSERT_EQUAL(2, shaper.runCount[1]);
+            CPPUNIT_ASSERT(shaper.runRTL[1]);
+
+            // Without a right to left letter, the string is a single run
+            testFont->Advance("abc 123");
+            CPPUNIT_ASSERT_EQUAL(3, shaper.runs);
+        }
+
+
+        void testLargeRun()
+        {
+            // The font asks again with room for every glyph
+            shaper.glyphsPerChar = 3;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(60.0, testFont->Advance("ab"), 0.01);
+            CPPUNIT_ASSERT_EQUAL(2, shaper.calls);
+        }
+
+
+        void testFallback()
+        {
+            FTPixmapFont plainFont(GOOD_FONT_FILE);
+            plainFont.FaceSize(FONT_POINT_SIZE);
+
+            shaper.fail = true;
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(plainFont.Advance(GOOD_ASCII_TEST_STRING),
+                testFont->Advance(GOOD_ASCII_TEST_STRING), 0.01);
+
+            // A string that could not be shaped is not tried again
+            testFont->Advance(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT_EQUAL(1, shaper.calls);
+
+            testFont->Shaper(NULL);
+            CPPUNIT_ASSERT(testFont->Shaper() == NULL);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(plainFont.Advance(GOOD_ASCII_TEST_STRING),
+                testFont->Advance(GOOD_ASCII_TEST_STRING), 0.01);
+        }
+
+
+        void testRender()
+        {
+            FTPoint end = testFont->Render("afib!", -1, FTPoint(5.0, 0.0));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(45.0, end.X(), 0.01);
+            CPPUNIT_ASSERT_EQUAL(testFont->Error(), 0);
+
+            // Strings in display order are drawn one character at a time
+            int calls = shaper.calls;
+            testFont->Render("abc", -1, FTPoint(), FTPoint(),
+                             FTGL::RENDER_ALL | FTGL::RENDER_VISUAL_ORDER);
+            CPPUNIT_ASSERT_EQUAL(calls, shaper.calls);
+        }
+
+
+        void testLayout()
+        {
+            FTSimpleLayout layout;
+            layout.SetFont(testFont);
+            layout.SetLineLength(1000.0f);
+
+            // The advance of "fi" goes to the 'f', and the line is measured
+            // by its glyphs
+            FTLayoutResult result = layout.Layout("afib!");
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, result.CharPosition(1).X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, result.CharPosition(2).X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, result.CharPosition(3).X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(40.0, result.CharPosition(5).X(),
+                                         0.01);
+
+            FTBBox shaped = testFont->BBox("afib!");
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(shaped.Upper().X(),
+                                         result.BBox().Upper().X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(shaped.Lower().Y(),
+                                         result.BBox().Lower().Y(), 0.01);
+
+            // Drawing the result does not shape it again
+            int calls = shaper.calls;
+            result.Render();
+            CPPUNIT_ASSERT_EQUAL(calls, shaper.calls);
+            CPPUNIT_ASSERT_EQUAL(testFont->Error(), 0);
+
+            // Each run of a line is shaped in its own direction
+            const wchar_t mixed[] = { 'a', 'b', ' ', 0x5d0, 0x5d1, 0 };
+            shaper.runs = 0;
+            result = layout.Layout(mixed);
+
+            CPPUNIT_ASSERT_EQUAL((unsigned int)0x5d0, shaper.runText[1]);
+            CPPUNIT_ASSERT_EQUAL(2, shaper.runCount[1]);
+            CPPUNIT_ASSERT(shaper.runRTL[1]);
+
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(40.0, result.CharPosition(3).X(),
+                                         0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, result.CharPosition(4).X(),
+                                         0.01);
+        }
+
+
+        void testHarfBuzz()
+        {
+            FTPixmapFont plainFont(GOOD_FONT_FILE);
+            plainFont.FaceSize(FONT_POINT_SIZE);
+
+            FTHarfBuzzShaper harfBuzz;
+            testFont->Shaper(&harfBuzz);
+
+            float advance = testFont->Advance(GOOD_ASCII_TEST_STRING);
+
+            if(FTHarfBuzzShaper::Available())
+            {
+                CPPUNIT_ASSERT(advance > 0.0f);
+            }
+            else
+            {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(plainFont.Advance(GOOD_ASCII_TEST_STRING),
+                                             advance, 0.01);
+            }
+
+            testFont->Shaper(NULL);
+        }
+
+
+        void setUp()
+        {
+            shaper = TestShaper();
+            testFont = new FTPixmapFont(GOOD_FONT_FILE);
+            testFont->FaceSize(FONT_POINT_SIZE);
+            testFont->Shaper(&shaper);
+        }
+
+
+        void tearDown()
+        {
+            delete testFont;
+        }
+
+    private:
+        FTPixmapFont* testFont;
+        TestShaper shaper;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTShaperTest);
+
@@ -0,0 +1,155 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <assert.h>
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+#include "FTInternals.h"
+
+extern void buildGLContext();
+
+class FTStatsTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTStatsTest);
+        CPPUNIT_TEST(testGlyphCache);
+        CPPUNIT_TEST(testReset);
+        CPPUNIT_TEST(testGlobal);
+        CPPUNIT_TEST(testRender);
+        CPPUNIT_TEST(testUnknownStatistic);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTStatsTest() : CppUnit::TestCase("FTStats Test")
+        {
+        }
+
+        FTStatsTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        ~FTStatsTest()
+        {
+        }
+
+        void testGlyphCache()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            font->Advance("abca");
+
+            CPPUNIT_ASSERT_EQUAL(3, Get(font, FTGL::STAT_GLYPH_MISSES));
+            CPPUNIT_ASSERT_EQUAL(3, Get(font, FTGL::STAT_GLYPH_LOADS));
+            CPPUNIT_ASSERT_EQUAL(3, Get(font, FTGL::STAT_GLYPH_RASTERS));
+            CPPUNIT_ASSERT(Get(font, FTGL::STAT_GLYPH_HITS) >= 1);
+
+            int hits = Get(font, FTGL::STAT_GLYPH_HITS);
+            font->Advance("abca");
+
+            CPPUNIT_ASSERT_EQUAL(3, Get(font, FTGL::STAT_GLYPH_MISSES));
+            CPPUNIT_ASSERT_EQUAL(3, Get(font, FTGL::STAT_GLYPH_LOADS));
+            CPPUNIT_ASSERT(Get(font, FTGL::STAT_GLYPH_HITS) >= hits + 4);
+
+            delete font;
+        }
+
+        void testReset()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            font->Advance("ab");
+            font->ResetStatistics();
+
+            CPPUNIT_ASSERT_EQUAL(0, Get(font, FTGL::STAT_GLYPH_MISSES));
+            CPPUNIT_ASSERT_EQUAL(0, Get(font, FTGL::STAT_GLYPH_HITS));
+            CPPUNIT_ASSERT_EQUAL(0, Get(font, FTGL::STAT_GLYPH_LOAD_TIME));
+
+            font->Advance("ab");
+
+            CPPUNIT_ASSERT_EQUAL(0, Get(font, FTGL::STAT_GLYPH_MISSES));
+            CPPUNIT_ASSERT(Get(font, FTGL::STAT_GLYPH_HITS) >= 2);
+
+            delete font;
+        }
+
+        void testGlobal()
+        {
+            FTFont::ResetGlobalStatistics();
+            CPPUNIT_ASSERT_EQUAL(0, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+            font->Advance("xyz");
+
+            FTBitmapFont* other = new FTBitmapFont(FONT_FILE);
+            other->FaceSize(18);
+            other->Advance("xy");
+
+            CPPUNIT_ASSERT_EQUAL(5, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+
+            // Resetting a font leaves the totals alone
+            font->ResetStatistics();
+            CPPUNIT_ASSERT_EQUAL(5, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+
+            // Destroyed fonts still count
+            delete font;
+            CPPUNIT_ASSERT_EQUAL(5, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+
+            // Resetting the totals leaves the fonts alone
+            FTFont::ResetGlobalStatistics();
+            CPPUNIT_ASSERT_EQUAL(0, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+            CPPUNIT_ASSERT_EQUAL(2, Get(other, FTGL::STAT_GLYPH_MISSES));
+
+            other->Advance("xyw");
+            CPPUNIT_ASSERT_EQUAL(1, GetGlobal(FTGL::STAT_GLYPH_MISSES));
+
+            delete other;
+        }
+
+        void testRender()
+        {
+            buildGLContext();
+
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            font->Render(GOOD_ASCII_TEST_STRING);
+            font->RenderUTF8(GOOD_ASCII_TEST_STRING);
+
+            CPPUNIT_ASSERT_EQUAL(2, Get(font, FTGL::STAT_RENDER_CALLS));
+
+            delete font;
+        }
+
+        void testUnknownStatistic()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+
+            CPPUNIT_ASSERT_EQUAL(0, Get(font, (FTGL::Statistic)1000));
+            CPPUNIT_ASSERT_EQUAL(0, GetGlobal((FTGL::Statistic)-1));
+
+            delete font;
+        }
+
+        void setUp()
+        {}
+
+        void tearDown()
+        {}
+
+    private:
+        int Get(FTFont* font, FTGL::Statistic which)
+        {
+            return (int)font->GetStatistic(which);
+        }
+
+        int GetGlobal(FTGL::Statistic which)
+        {
+            return (int)FTFont::GetGlobalStatistic(which);
+        }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTStatsTest);
+
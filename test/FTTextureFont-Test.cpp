@@ -18,6 +18,8 @@ class FTTextureFontTest : public CppUnit::TestCase
         CPPUNIT_TEST(testResizeBug);
         CPPUNIT_TEST(testRender);
         CPPUNIT_TEST(testDisplayList);
+        CPPUNIT_TEST(testBatch);
+        CPPUNIT_TEST(testCoreBackend);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -94,6 +96,80 @@ class FTTextureFontTest : public CppUnit::TestCase
             delete textureFont;
         }
 
+        void testBatch()
+        {
+            buildGLContext();
+
+            FTTextureFont* textureFont = new FTTextureFont(FONT_FILE);
+            textureFont->FaceSize(18);
+
+            FTPoint expected = textureFont->Render(GOOD_ASCII_TEST_STRING);
+
+            textureFont->BeginBatch();
+
+            // Queued strings advance the pen as if they were drawn
+            FTPoint queued = textureFont->Render(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.X(), queued.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.Y(), queued.Y(), 0.01);
+
+            textureFont->Render(GOOD_UNICODE_TEST_STRING, -1, FTPoint(0, 20));
+
+            // Resizing draws what was queued against the old textures
+            textureFont->FaceSize(24);
+            textureFont->Render(GOOD_ASCII_TEST_STRING, -1, FTPoint(0, 40));
+
+            textureFont->EndBatch();
+            CPPUNIT_ASSERT_EQUAL(GL_NO_ERROR, (int)glGetError());
+
+            // Ending a batch that was never started does nothing
+            textureFont->EndBatch();
+            CPPUNIT_ASSERT_EQUAL(textureFont->Error(), 0);
+            CPPUNIT_ASSERT_EQUAL(GL_NO_ERROR, (int)glGetError());
+            delete textureFont;
+        }
+
+        void testCoreBackend()
+        {
+            buildGLContext();
+
+            FTTextureFont* textureFont =
+                new FTTextureFont(FONT_FILE, FTGL::BACKEND_CORE_PROFILE);
+            CPPUNIT_ASSERT_EQUAL(textureFont->Error(), 0);
+            CPPUNIT_ASSERT_EQUAL(FTGL::BACKEND_CORE_PROFILE,
+                                 textureFont->Backend());
+
+            FTTextureFont* fixedFont = new FTTextureFont(FONT_FILE);
+            CPPUNIT_ASSERT_EQUAL(FTGL::BACKEND_FIXED_FUNCTION,
+                                 fixedFont->Backend());
+
+            textureFont->FaceSize(18);
+            fixedFont->FaceSize(18);
+
+            const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0,
+                                         0, 0, 1, 0, 0, 0, 0, 1 };
+            textureFont->Transform(identity);
+            textureFont->Color(1.0f, 0.5f, 0.0f);
+
+            // Both backends lay text out the same way
+            FTPoint expected = fixedFont->Render(GOOD_ASCII_TEST_STRING);
+            FTPoint end = textureFont->Render(GOOD_ASCII_TEST_STRING);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.X(), end.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.Y(), end.Y(), 0.01);
+
+            textureFont->BeginBatch();
+            textureFont->Render(GOOD_ASCII_TEST_STRING, -1, FTPoint(0, 20));
+            textureFont->EndBatch();
+
+            // Display lists cannot be turned back on
+            textureFont->UseDisplayList(true);
+            textureFont->Render(GOOD_ASCII_TEST_STRING);
+
+            CPPUNIT_ASSERT_EQUAL(textureFont->Error(), 0);
+            CPPUNIT_ASSERT_EQUAL(GL_NO_ERROR, (int)glGetError());
+            delete fixedFont;
+            delete textureFont;
+        }
+
         void setUp()
         {}
 
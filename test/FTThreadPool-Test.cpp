@@ -0,0 +1,98 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+
+#include "FTThreadPool.h"
+
+
+static const int TASK_COUNT = 1000;
+
+
+static void CountTask(void *data, int index)
+{
+    // Every index is handed out exactly once, so no locking is needed
+    static_cast<int *>(data)[index]++;
+}
+
+
+class FTThreadPoolTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTThreadPoolTest);
+        CPPUNIT_TEST(testInstance);
+        CPPUNIT_TEST(testRun);
+        CPPUNIT_TEST(testNoWorkers);
+        CPPUNIT_TEST(testEmptyBatch);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTThreadPoolTest() : CppUnit::TestCase("FTThreadPool Test")
+        {}
+
+        FTThreadPoolTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        void testInstance()
+        {
+            FTThreadPool& pool1 = FTThreadPool::Instance();
+            FTThreadPool& pool2 = FTThreadPool::Instance();
+
+            CPPUNIT_ASSERT(&pool1 == &pool2);
+            CPPUNIT_ASSERT(pool1.ThreadCount() >= 1);
+        }
+
+
+        void testRun()
+        {
+            FTThreadPool pool(3);
+            int counts[TASK_COUNT] = { 0 };
+
+            // Run several batches to make sure the workers go back to sleep
+            // and pick up the next one.
+            for(int n = 0; n < 4; n++)
+            {
+                pool.Run(CountTask, counts, TASK_COUNT);
+            }
+
+            for(int i = 0; i < TASK_COUNT; i++)
+            {
+                CPPUNIT_ASSERT(counts[i] == 4);
+            }
+        }
+
+
+        void testNoWorkers()
+        {
+            FTThreadPool pool(0);
+            int counts[TASK_COUNT] = { 0 };
+
+            CPPUNIT_ASSERT(pool.ThreadCount() == 1);
+
+            pool.Run(CountTask, counts, TASK_COUNT);
+
+            for(int i = 0; i < TASK_COUNT; i++)
+            {
+                CPPUNIT_ASSERT(counts[i] == 1);
+            }
+        }
+
+
+        void testEmptyBatch()
+        {
+            FTThreadPool pool(2);
+
+            pool.Run(CountTask, NULL, 0);
+        }
+
+
+        void setUp()
+        {}
+
+
+        void tearDown()
+        {}
+
+    private:
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTThreadPoolTest);
+
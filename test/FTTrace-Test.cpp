@@ -0,0 +1,246 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <assert.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "Fontdefs.h"
+
+#include "FTGL/ftgl.h"
+#include "FTInternals.h"
+
+extern void buildGLContext();
+
+static void Record(const FTTraceEvent *event, void *data)
+{
+    static_cast<std::vector<FTTraceEvent> *>(data)->push_back(*event);
+}
+
+class FTTraceTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTTraceTest);
+        CPPUNIT_TEST(testGlyphCreation);
+        CPPUNIT_TEST(testCachedGlyph);
+        CPPUNIT_TEST(testRender);
+        CPPUNIT_TEST(testNesting);
+        CPPUNIT_TEST(testChromeTrace);
+        CPPUNIT_TEST(testChromeTraceBadFile);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTTraceTest() : CppUnit::TestCase("FTTrace Test")
+        {
+        }
+
+        FTTraceTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+        ~FTTraceTest()
+        {
+        }
+
+        void testGlyphCreation()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            std::vector<FTTraceEvent> events;
+            bool traced = FTTrace::SetCallback(Record, &events);
+            CPPUNIT_ASSERT_EQUAL(FTTrace::Available(), traced);
+
+            font->Advance("a");
+            FTTrace::SetCallback(0);
+
+            if(!traced)
+            {
+                CPPUNIT_ASSERT(events.empty());
+                delete font;
+                return;
+            }
+
+            CPPUNIT_ASSERT_EQUAL(8, (int)events.size());
+
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_GLYPH, events[0].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_LOAD, events[1].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_LOAD, events[2].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_MAKE_GLYPH, events[3].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_RASTERISE, events[4].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_RASTERISE, events[5].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_MAKE_GLYPH, events[6].phase);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_GLYPH, events[7].phase);
+
+            // Nested steps know the font and glyph of the enclosing one
+            for(size_t i = 0; i < events.size(); i++)
+            {
+                CPPUNIT_ASSERT(events[i].font == font);
+                CPPUNIT_ASSERT_EQUAL((unsigned int)'a', events[i].character);
+                CPPUNIT_ASSERT_EQUAL(events[0].glyph, events[i].glyph);
+                CPPUNIT_ASSERT_EQUAL(events[0].thread, events[i].thread);
+            }
+
+            CPPUNIT_ASSERT(events[0].glyph != 0);
+
+            delete font;
+        }
+
+        void testCachedGlyph()
+        {
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+            font->Advance("b");
+
+            std::vector<FTTraceEvent> events;
+            FTTrace::SetCallback(Record, &events);
+
+            font->Advance("b");
+            FTTrace::SetCallback(0);
+
+            CPPUNIT_ASSERT(events.empty());
+
+            delete font;
+        }
+
+        void testRender()
+        {
+            buildGLContext();
+
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+            font->Advance("c");
+
+            std::vector<FTTraceEvent> events;
+            bool traced = FTTrace::SetCallback(Record, &events);
+
+            font->Render("c");
+            FTTrace::SetCallback(0);
+
+            if(!traced)
+            {
+                CPPUNIT_ASSERT(events.empty());
+                delete font;
+                return;
+            }
+
+            CPPUNIT_ASSERT_EQUAL(2, (int)events.size());
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_RENDER, events[0].phase);
+            CPPUNIT_ASSERT_EQUAL(1, events[0].begin);
+            CPPUNIT_ASSERT_EQUAL((int)FTGL::TRACE_RENDER, events[1].phase);
+            CPPUNIT_ASSERT_EQUAL(0, events[1].begin);
+            CPPUNIT_ASSERT(events[0].font == font);
+
+            delete font;
+        }
+
+        void testNesting()
+        {
+            buildGLContext();
+
+            FTPolygonFont* font = new FTPolygonFont(FONT_FILE);
+            font->FaceSize(18);
+
+            std::vector<FTTraceEvent> events;
+            FTTrace::SetCallback(Record, &events);
+
+            font->Render(GOOD_ASCII_TEST_STRING);
+            FTTrace::SetCallback(0);
+
+            // Every step ends, innermost first, and time goes forward
+            std::vector<int> open;
+            for(size_t i = 0; i < events.size(); i++)
+            {
+                if(i > 0)
+                {
+                    CPPUNIT_ASSERT(events[i].time >= events[i - 1].time);
+                }
+
+                if(events[i].begin)
+                {
+                    open.push_back(events[i].phase);
+                }
+                else
+                {
+                    CPPUNIT_ASSERT(!open.empty());
+                    CPPUNIT_ASSERT_EQUAL(open.back(), events[i].phase);
+                    open.pop_back();
+                }
+            }
+
+            CPPUNIT_ASSERT(open.empty());
+
+            delete font;
+        }
+
+        void testChromeTrace()
+        {
+            const char *fileName = "FTTrace-Test.json";
+
+            FTPixmapFont* font = new FTPixmapFont(FONT_FILE);
+            font->FaceSize(18);
+
+            FTChromeTrace* trace = new FTChromeTrace(fileName);
+
+            // Without tracing, there is nothing to write
+            if(!FTTrace::Available())
+            {
+                CPPUNIT_ASSERT(trace->Error() != 0);
+                CPPUNIT_ASSERT_EQUAL(0, FTGL::ftglStartChromeTrace(fileName));
+                delete trace;
+
+                CPPUNIT_ASSERT(fopen(fileName, "r") == NULL);
+                delete font;
+                return;
+            }
+
+            CPPUNIT_ASSERT_EQUAL(0, trace->Error());
+
+            font->Advance("d");
+            trace->Stop();
+            CPPUNIT_ASSERT_EQUAL(0, trace->Error());
+
+            // Nothing is written once the trace has stopped
+            font->Advance("e");
+            delete trace;
+
+            std::string json;
+            FILE *file = fopen(fileName, "r");
+            CPPUNIT_ASSERT(file != NULL);
+            for(int c = fgetc(file); c != EOF; c = fgetc(file))
+            {
+                json += (char)c;
+            }
+            fclose(file);
+            remove(fileName);
+
+            CPPUNIT_ASSERT_EQUAL(0, (int)json.find("{\"traceEvents\":["));
+            CPPUNIT_ASSERT_EQUAL(json.size() - 2, json.rfind("}\n"));
+
+            CPPUNIT_ASSERT(json.find("\"name\":\"glyph\"")
+                           != std::string::npos);
+            CPPUNIT_ASSERT(json.find("\"character\":100")
+                           != std::string::npos);
+            CPPUNIT_ASSERT(json.find("\"character\":101")
+                           == std::string::npos);
+
+            delete font;
+        }
+
+        void testChromeTraceBadFile()
+        {
+            FTChromeTrace trace("/non/existent/directory/trace.json");
+            CPPUNIT_ASSERT(trace.Error() != 0);
+
+            trace.Stop();
+            CPPUNIT_ASSERT(trace.Error() != 0);
+        }
+
+        void setUp()
+        {}
+
+        void tearDown()
+        {}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTTraceTest);
@@ -0,0 +1,202 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+
+#include "FTUnicode.h"
+
+
+class FTUnicodeTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(FTUnicodeTest);
+        CPPUNIT_TEST(testStringItr);
+        CPPUNIT_TEST(testDecodeASCII);
+        CPPUNIT_TEST(testDecodeLength);
+        CPPUNIT_TEST(testDecodeUTF8);
+        CPPUNIT_TEST(testDecodeInvalidUTF8);
+        CPPUNIT_TEST(testDecodeWide);
+        CPPUNIT_TEST(testDecodeNull);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        FTUnicodeTest() : CppUnit::TestCase("FTUnicode Test")
+        {}
+
+        FTUnicodeTest(const std::string& name) : CppUnit::TestCase(name) {}
+
+
+        void testStringItr()
+        {
+            // Plain chars are signed on most platforms
+            const char *utf8 = "\xc3\xa9\xe2\x82\xac";
+            FTUnicodeStringItr<char> itr(utf8);
+
+            CPPUNIT_ASSERT_EQUAL(0xe9u, *itr++);
+            CPPUNIT_ASSERT_EQUAL(0x20acu, *itr++);
+            CPPUNIT_ASSERT_EQUAL(0u, *itr);
+
+            const unsigned short utf16[] = { 0xd83d, 0xde00, 'a', 0 };
+            FTUnicodeStringItr<unsigned short> itr16(utf16);
+
+            CPPUNIT_ASSERT_EQUAL(0x1f600u, *itr16++);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', *itr16++);
+            CPPUNIT_ASSERT_EQUAL(0u, *itr16);
+        }
+
+
+        void testDecodeASCII()
+        {
+            const char *text = "The quick brown fox jumps over the lazy dog";
+            FTUnicodeDecoder decoder;
+
+            int count = decoder.Decode((const unsigned char *)text, -1);
+
+            CPPUNIT_ASSERT_EQUAL(43, count);
+            CPPUNIT_ASSERT_EQUAL(count, decoder.Count());
+
+            for(int i = 0; i < count; i++)
+            {
+                CPPUNIT_ASSERT_EQUAL((unsigned int)text[i], decoder.Chars()[i]);
+            }
+
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[count]);
+
+            // The buffer grows for long strings
+            std::string longText(5000, 'x');
+            longText += "\xc3\xa9";
+            count = decoder.Decode((const unsigned char *)longText.c_str(), -1);
+
+            CPPUNIT_ASSERT_EQUAL(5001, count);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'x', decoder.Chars()[4999]);
+            CPPUNIT_ASSERT_EQUAL(0xe9u, decoder.Chars()[5000]);
+        }
+
+
+        void testDecodeLength()
+        {
+            FTUnicodeDecoder decoder;
+
+            // The character after the last one is kept for kerning
+            int count = decoder.Decode((const unsigned char *)"abcdef", 3);
+            CPPUNIT_ASSERT_EQUAL(3, count);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'c', decoder.Chars()[2]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'d', decoder.Chars()[3]);
+
+            // The length counts characters, not bytes
+            count = decoder.Decode((const unsigned char *)"\xc3\xa9\xc3\xa8z",
+                                   1);
+            CPPUNIT_ASSERT_EQUAL(1, count);
+            CPPUNIT_ASSERT_EQUAL(0xe9u, decoder.Chars()[0]);
+            CPPUNIT_ASSERT_EQUAL(0xe8u, decoder.Chars()[1]);
+
+            count = decoder.Decode((const unsigned char *)"abc", 3);
+            CPPUNIT_ASSERT_EQUAL(3, count);
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[3]);
+
+            count = decoder.Decode((const unsigned char *)"abc", 0);
+            CPPUNIT_ASSERT_EQUAL(0, count);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', decoder.Chars()[0]);
+        }
+
+
+        void testDecodeUTF8()
+        {
+            const char *text = "a\xc3\xa9" "0123456789abcdefghij"
+                               "\xe2\x82\xac\xf0\x9f\x98\x80z";
+            FTUnicodeDecoder decoder;
+
+            int count = decoder.Decode((const unsigned char *)text, -1);
+
+            CPPUNIT_ASSERT_EQUAL(25, count);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', decoder.Chars()[0]);
+            CPPUNIT_ASSERT_EQUAL(0xe9u, decoder.Chars()[1]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'0', decoder.Chars()[2]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'j', decoder.Chars()[21]);
+            CPPUNIT_ASSERT_EQUAL(0x20acu, decoder.Chars()[22]);
+            CPPUNIT_ASSERT_EQUAL(0x1f600u, decoder.Chars()[23]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'z', decoder.Chars()[24]);
+
+            // Same text, with a length
+            CPPUNIT_ASSERT_EQUAL(24, decoder.Decode((const unsigned char *)text,
+                                                    24));
+            CPPUNIT_ASSERT_EQUAL(0x1f600u, decoder.Chars()[23]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'z', decoder.Chars()[24]);
+        }
+
+
+        void testDecodeInvalidUTF8()
+        {
+            FTUnicodeDecoder decoder;
+
+            // Overlong slash, lone continuation byte, encoded surrogate
+            const char *text = "\xc0\xaf" "a\x80" "b\xed\xa0\x80";
+            int count = decoder.Decode((const unsigned char *)text, -1);
+
+            CPPUNIT_ASSERT_EQUAL(8, count);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[0]);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[1]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'a', decoder.Chars()[2]);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[3]);
+            CPPUNIT_ASSERT_EQUAL((unsigned int)'b', decoder.Chars()[4]);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[5]);
+
+            // A truncated sequence does not swallow the terminator
+            count = decoder.Decode((const unsigned char *)"x\xe2\x82", -1);
+            CPPUNIT_ASSERT_EQUAL(3, count);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[1]);
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[3]);
+
+            count = decoder.Decode((const unsigned char *)"x\xe2", 2);
+            CPPUNIT_ASSERT_EQUAL(2, count);
+            CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[1]);
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[2]);
+        }
+
+
+        void testDecodeWide()
+        {
+            FTUnicodeDecoder decoder;
+            wchar_t text[] = { 'a', 0xe9, 0x20ac, 0 };
+
+            CPPUNIT_ASSERT_EQUAL(3, decoder.Decode(text, -1));
+            CPPUNIT_ASSERT_EQUAL(0xe9u, decoder.Chars()[1]);
+            CPPUNIT_ASSERT_EQUAL(0x20acu, decoder.Chars()[2]);
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[3]);
+
+            CPPUNIT_ASSERT_EQUAL(1, decoder.Decode(text, 1));
+            CPPUNIT_ASSERT_EQUAL(0xe9u, decoder.Chars()[1]);
+
+            if(sizeof(wchar_t) == 2)
+            {
+                wchar_t pair[] = { 0xd83d, 0xde00, 0xdc00, 'a', 0 };
+
+                CPPUNIT_ASSERT_EQUAL(3, decoder.Decode(pair, -1));
+                CPPUNIT_ASSERT_EQUAL(0x1f600u, decoder.Chars()[0]);
+                CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[1]);
+                CPPUNIT_ASSERT_EQUAL((unsigned int)'a', decoder.Chars()[2]);
+            }
+            else
+            {
+                wchar_t wide[] = { 0x1f600, (wchar_t)0x110000, 0xd800, 0 };
+
+                CPPUNIT_ASSERT_EQUAL(3, decoder.Decode(wide, -1));
+                CPPUNIT_ASSERT_EQUAL(0x1f600u, decoder.Chars()[0]);
+                CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[1]);
+                CPPUNIT_ASSERT_EQUAL(0xfffdu, decoder.Chars()[2]);
+            }
+        }
+
+
+        void testDecodeNull()
+        {
+            FTUnicodeDecoder decoder;
+
+            CPPUNIT_ASSERT_EQUAL(0, decoder.Decode((const unsigned char *)0, -1));
+            CPPUNIT_ASSERT_EQUAL(0, decoder.Decode((const wchar_t *)0, 5));
+            CPPUNIT_ASSERT_EQUAL(0, decoder.Decode((const unsigned char *)"", -1));
+            CPPUNIT_ASSERT_EQUAL(0u, decoder.Chars()[0]);
+        }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FTUnicodeTest);
+
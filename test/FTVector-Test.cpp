@@ -13,6 +13,9 @@ class FTVectorTest : public CppUnit::TestCase
         CPPUNIT_TEST(testReserve);
         CPPUNIT_TEST(testPushBack);
         CPPUNIT_TEST(testOperatorSquareBrackets);
+        CPPUNIT_TEST(testCopy);
+        CPPUNIT_TEST(testSwap);
+        CPPUNIT_TEST(testEmplaceBack);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -36,9 +39,20 @@ class FTVectorTest : public CppUnit::TestCase
             FTVector<float> floatVector;
 
             floatVector.reserve(128);
-            CPPUNIT_ASSERT(floatVector.capacity() == 256);
+            CPPUNIT_ASSERT(floatVector.capacity() == 128);
             CPPUNIT_ASSERT(floatVector.empty());
             CPPUNIT_ASSERT(floatVector.size() == 0);
+
+            floatVector.reserve(100);
+            CPPUNIT_ASSERT(floatVector.capacity() == 128);
+
+            for(int i = 0; i < 129; i++)
+            {
+                floatVector.push_back(i);
+            }
+
+            CPPUNIT_ASSERT(floatVector.capacity() == 256);
+            CPPUNIT_ASSERT(floatVector[128] == 128);
         }
 
 
@@ -72,6 +86,61 @@ class FTVectorTest : public CppUnit::TestCase
         }
 
 
+        void testCopy()
+        {
+            FTVector<int> integerVector;
+
+            integerVector.push_back(1);
+            integerVector.push_back(2);
+
+            FTVector<int> copy(integerVector);
+            copy[0] = 5;
+
+            CPPUNIT_ASSERT(copy.size() == 2);
+            CPPUNIT_ASSERT(copy[1] == 2);
+            CPPUNIT_ASSERT(integerVector[0] == 1);
+
+            copy = copy;
+            CPPUNIT_ASSERT(copy.size() == 2);
+            CPPUNIT_ASSERT(copy[0] == 5);
+        }
+
+
+        void testSwap()
+        {
+            FTVector<int> integerVector;
+            FTVector<int> other;
+
+            integerVector.push_back(1);
+            integerVector.push_back(2);
+            const int *items = &integerVector[0];
+
+            other.swap(integerVector);
+
+            CPPUNIT_ASSERT(integerVector.empty());
+            CPPUNIT_ASSERT(integerVector.capacity() == 0);
+            CPPUNIT_ASSERT(other.size() == 2);
+            CPPUNIT_ASSERT(&other[0] == items);
+            CPPUNIT_ASSERT(other[1] == 2);
+        }
+
+
+        void testEmplaceBack()
+        {
+            FTVector<int> integerVector;
+
+            integerVector.push_back(7);
+            integerVector.resize(0, 0);
+
+            int& item = integerVector.emplace_back();
+            CPPUNIT_ASSERT(item == 0);
+
+            item = 3;
+            CPPUNIT_ASSERT(integerVector.size() == 1);
+            CPPUNIT_ASSERT(integerVector[0] == 3);
+        }
+
+
         void setUp()
         {}
 
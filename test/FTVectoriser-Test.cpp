@@ -265,6 +265,7 @@ class FTVectoriserTest : public CppUnit::TestCase
         CPPUNIT_TEST(testGetOutline);
         CPPUNIT_TEST(testGetMesh);
         CPPUNIT_TEST(testMakeMesh);
+        CPPUNIT_TEST(testMeshReuse);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -423,6 +424,35 @@ class FTVectoriserTest : public CppUnit::TestCase
         }
 
 
+        void testMeshReuse()
+        {
+            setUpFreetype(SIMPLE_CHARACTER_INDEX);
+
+            FTVectoriser vectoriser(face->glyph);
+            const FTContour* contour = vectoriser.Contour(0);
+
+            vectoriser.MakeMesh(FTGL_FRONT_FACING, 1, 0.0f);
+            const FTMesh* mesh = vectoriser.GetMesh();
+
+            // Zero outsets are the outline itself
+            CPPUNIT_ASSERT(&contour->FrontPoint(0) == &contour->Point(0));
+            vectoriser.MakeMesh(FTGL_FRONT_FACING, 2, 0.0f);
+            CPPUNIT_ASSERT(vectoriser.GetMesh() == mesh);
+            vectoriser.MakeMesh(FTGL_FRONT_FACING);
+            CPPUNIT_ASSERT(vectoriser.GetMesh() == mesh);
+
+            // Front and back points of the same size share a mesh
+            vectoriser.MakeMesh(FTGL_FRONT_FACING, 1, 2.0f);
+            mesh = vectoriser.GetMesh();
+            CPPUNIT_ASSERT(contour->FrontPoint(0) != contour->Point(0));
+            vectoriser.MakeMesh(FTGL_FRONT_FACING, 2, 2.0f);
+            CPPUNIT_ASSERT(vectoriser.GetMesh() == mesh);
+            CPPUNIT_ASSERT(contour->BackPoint(0) == contour->FrontPoint(0));
+
+            tearDownFreetype();
+        }
+
+
         void setUp()
         {}
 
@@ -3,15 +3,32 @@
 #include <cppunit/TestCase.h>
 #include <cppunit/TestSuite.h>
 
+#include <string.h>
+#include <string>
+
 #include "Fontdefs.h"
 #include "FTGL/ftgl.h"
 
 static const int SCRIPT = 2; // arabic
 
+static bool SameBox(const FTBBox &a, const FTBBox &b)
+{
+    return a.Lower() == b.Lower() && a.Upper() == b.Upper();
+}
+
 class FTLayoutTest : public CppUnit::TestCase
 {
     CPPUNIT_TEST_SUITE(FTLayoutTest);
         CPPUNIT_TEST(testConstructor);
+        CPPUNIT_TEST(testLineBreaks);
+        CPPUNIT_TEST(testCharPosition);
+        CPPUNIT_TEST(testCharIndex);
+        CPPUNIT_TEST(testEdit);
+        CPPUNIT_TEST(testOptimalBreaks);
+        CPPUNIT_TEST(testBreakOpportunities);
+        CPPUNIT_TEST(testBidi);
+        CPPUNIT_TEST(testUnicodeStrings);
+        CPPUNIT_TEST(testFontChange);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -23,6 +40,329 @@ class FTLayoutTest : public CppUnit::TestCase
         void testConstructor()
         {}
 
+
+        void testLineBreaks()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(1000.0f);
+
+            const char *text = "one\ntwo\n\nthree";
+
+            CPPUNIT_ASSERT_EQUAL(1, layout.LineCount("one two three"));
+            CPPUNIT_ASSERT_EQUAL(4, layout.LineCount(text));
+            CPPUNIT_ASSERT_EQUAL(4, layout.LineStart(text, -1, 1));
+            CPPUNIT_ASSERT_EQUAL(8, layout.LineStart(text, -1, 2));
+            CPPUNIT_ASSERT_EQUAL(9, layout.LineStart(text, -1, 3));
+            CPPUNIT_ASSERT_EQUAL(-1, layout.LineStart(text, -1, 4));
+
+            // Break at the spaces once the line gets too short
+            layout.SetLineLength(font.Advance("one two") + 1.0f);
+            CPPUNIT_ASSERT_EQUAL(2, layout.LineCount("one two three"));
+            CPPUNIT_ASSERT_EQUAL(8, layout.LineStart("one two three", -1, 1));
+
+            CPPUNIT_ASSERT_EQUAL(2, layout.LineCount(L"one two three"));
+            CPPUNIT_ASSERT_EQUAL(8, layout.LineStart(L"one two three", -1, 1));
+        }
+
+
+        void testCharPosition()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(1000.0f);
+
+            FTPoint origin(10.0f, 20.0f);
+            FTPoint first = layout.CharPosition("ab\ncd", -1, 0, origin);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, first.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, first.Y(), 0.01);
+
+            FTPoint second = layout.CharPosition("ab\ncd", -1, 1, origin);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0 + font.Advance("a"), second.X(),
+                                         0.01);
+
+            FTPoint third = layout.CharPosition("ab\ncd", -1, 3, origin);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, third.X(), 0.01);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0 - font.LineHeight(), third.Y(),
+                                         0.01);
+
+            layout.SetAlignment(FTGL::ALIGN_RIGHT);
+            FTPoint right = layout.CharPosition("ab", -1, 2);
+            CPPUNIT_ASSERT(right.X() > 900.0);
+        }
+
+
+        void testCharIndex()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(font.Advance("hello world") + 1.0f);
+
+            const char *text = "hello world foo bar\nbaz";
+            int length = (int)strlen(text);
+
+            for(int i = 0; i < length; i++)
+            {
+                FTPoint pos = layout.CharPosition(text, -1, i);
+                pos += FTPoint(0.5f, 2.0f);
+                CPPUNIT_ASSERT_EQUAL(i, layout.CharIndex(text, -1, pos));
+            }
+
+            // Past the end of a line, and past the end of the text
+            FTPoint lineEnd(1000.0f, -font.LineHeight());
+            FTPoint textEnd(1000.0f, -1000.0f);
+            CPPUNIT_ASSERT_EQUAL(19, layout.CharIndex(text, -1, lineEnd));
+            CPPUNIT_ASSERT_EQUAL(length, layout.CharIndex(text, -1, textEnd));
+        }
+
+
+        void testEdit()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout edited, fresh;
+            edited.SetFont(&font);
+            fresh.SetFont(&font);
+            edited.SetLineLength(150.0f);
+            fresh.SetLineLength(150.0f);
+
+            std::string text = "The quick brown fox\njumps over the lazy dog\n"
+                               "\nPack my box with five dozen liquor jugs";
+            edited.LineCount(text.c_str());
+
+            const char *inserts[] = { "x", " ", "\n", "several words " };
+
+            for(unsigned int i = 0; i < 40; i++)
+            {
+                size_t pos = (i * 37) % text.size();
+
+                if(i % 5 == 4)
+                {
+                    text.erase(pos, 1);
+                }
+                else
+                {
+                    text.insert(pos, inserts[i % 4]);
+                }
+
+                int lines = fresh.LineCount(text.c_str());
+                CPPUNIT_ASSERT_EQUAL(lines, edited.LineCount(text.c_str()));
+
+                for(int l = 0; l < lines; l++)
+                {
+                    CPPUNIT_ASSERT_EQUAL(fresh.LineStart(text.c_str(), -1, l),
+                                         edited.LineStart(text.c_str(), -1, l));
+                }
+
+                FTBBox box1 = fresh.BBox(text.c_str());
+                FTBBox box2 = edited.BBox(text.c_str());
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(box1.Upper().X(),
+                                             box2.Upper().X(), 0.01);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(box1.Lower().Y(),
+                                             box2.Lower().Y(), 0.01);
+            }
+        }
+
+
+        void testOptimalBreaks()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(14);
+
+            FTSimpleLayout greedy, optimal;
+            greedy.SetFont(&font);
+            optimal.SetFont(&font);
+            greedy.SetLineLength(220.0f);
+            optimal.SetLineLength(220.0f);
+            optimal.SetBreakMode(FTGL::BREAK_OPTIMAL);
+
+            CPPUNIT_ASSERT_EQUAL(FTGL::BREAK_GREEDY, greedy.GetBreakMode());
+            CPPUNIT_ASSERT_EQUAL(FTGL::BREAK_OPTIMAL, optimal.GetBreakMode());
+
+            const char *text = "In olden times when wishing still helped "
+                               "one, there lived a king whose daughters "
+                               "were all beautiful, but the youngest was "
+                               "so beautiful that the sun itself was "
+                               "astonished whenever it shone in her face.";
+
+            FTLayoutResult first = greedy.Layout(text);
+            FTLayoutResult second = optimal.Layout(text);
+
+            CPPUNIT_ASSERT_EQUAL(first.LineCount(), second.LineCount());
+
+            // The optimal breaks leave less uneven space at the end of the
+            // lines, last line excepted
+            double greedySpace = 0.0, optimalSpace = 0.0;
+
+            for(int i = 0; i + 1 < first.LineCount(); i++)
+            {
+                double a = 220.0 - first.LineBBox(i).Upper().X();
+                double b = 220.0 - second.LineBBox(i).Upper().X();
+
+                greedySpace += a * a;
+                optimalSpace += b * b;
+            }
+
+            CPPUNIT_ASSERT(optimalSpace < greedySpace);
+
+            // Words that do not fit on a line are broken as before
+            const char *longWord = "a veryveryveryveryveryverylongword\nb c";
+            greedy.SetLineLength(60.0f);
+            optimal.SetLineLength(60.0f);
+
+            int lines = greedy.LineCount(longWord);
+            CPPUNIT_ASSERT_EQUAL(lines, optimal.LineCount(longWord));
+
+            for(int i = 0; i < lines; i++)
+            {
+                CPPUNIT_ASSERT_EQUAL(greedy.LineStart(longWord, -1, i),
+                                     optimal.LineStart(longWord, -1, i));
+            }
+        }
+
+
+        void testBreakOpportunities()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(font.Advance("alpha-beta") - 1.0f);
+
+            // Break after the hyphens rather than inside the words
+            const char *text = "alpha-beta-gamma";
+            CPPUNIT_ASSERT_EQUAL(3, layout.LineCount(text));
+            CPPUNIT_ASSERT_EQUAL(6, layout.LineStart(text, -1, 1));
+            CPPUNIT_ASSERT_EQUAL(11, layout.LineStart(text, -1, 2));
+
+            layout.SetBreakMode(FTGL::BREAK_OPTIMAL);
+            CPPUNIT_ASSERT_EQUAL(3, layout.LineCount(text));
+            CPPUNIT_ASSERT_EQUAL(6, layout.LineStart(text, -1, 1));
+
+            // Unicode line separators break lines too
+            layout.SetBreakMode(FTGL::BREAK_GREEDY);
+            const wchar_t separated[] = { 'a', 0x2028, 'b', 0 };
+            CPPUNIT_ASSERT_EQUAL(2, layout.LineCount(separated));
+            CPPUNIT_ASSERT_EQUAL(2, layout.LineStart(separated, -1, 1));
+        }
+
+
+        void testBidi()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(500.0f);
+
+            // The Hebrew word is drawn from right to left within the line
+            const wchar_t text[] = { 'a', 'b', ' ', 0x5d0, 0x5d1, 0x5d2,
+                                     ' ', 'c', 'd', 0 };
+
+            float a = layout.CharPosition(text, -1, 0).Xf();
+            float alef = layout.CharPosition(text, -1, 3).Xf();
+            float bet = layout.CharPosition(text, -1, 4).Xf();
+            float gimel = layout.CharPosition(text, -1, 5).Xf();
+            float c = layout.CharPosition(text, -1, 7).Xf();
+
+            CPPUNIT_ASSERT(a < gimel);
+            CPPUNIT_ASSERT(gimel < bet);
+            CPPUNIT_ASSERT(bet < alef);
+            CPPUNIT_ASSERT(alef < c);
+
+            FTPoint point = layout.CharPosition(text, -1, 4) + FTPoint(1, 1);
+            CPPUNIT_ASSERT_EQUAL(4, layout.CharIndex(text, -1, point));
+
+            // A right to left paragraph keeps its words in reading order
+            const wchar_t hebrew[] = { 0x5d0, ' ', 0x5d1, 0 };
+            CPPUNIT_ASSERT(layout.CharPosition(hebrew, -1, 2).Xf()
+                            < layout.CharPosition(hebrew, -1, 0).Xf());
+
+            // Editing the string resolves the changed paragraph again
+            const wchar_t edited[] = { 'a', 'b', ' ', 'x', 'y', 'z',
+                                       ' ', 'c', 'd', 0 };
+            CPPUNIT_ASSERT(layout.CharPosition(edited, -1, 3).Xf()
+                            < layout.CharPosition(edited, -1, 4).Xf());
+        }
+
+
+        void testUnicodeStrings()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(80.0f);
+
+            const char *text = "one two three four";
+            const unsigned short utf16[] = { 'o', 'n', 'e', ' ', 't', 'w',
+                                             'o', ' ', 't', 'h', 'r', 'e',
+                                             'e', ' ', 'f', 'o', 'u', 'r' };
+            FTBBox expected = layout.BBox(text);
+
+            CPPUNIT_ASSERT(SameBox(layout.BBoxUTF8(text), expected));
+            CPPUNIT_ASSERT(SameBox(layout.BBoxUTF16(utf16, 18), expected));
+
+            // Only the given number of code units is laid out
+            FTBBox prefix = layout.BBox("one two");
+            CPPUNIT_ASSERT(SameBox(layout.BBoxUTF8(text, 7), prefix));
+            CPPUNIT_ASSERT(SameBox(layout.BBoxUTF16(utf16, 7), prefix));
+
+#ifdef FTGL_HAS_UNICODE_CHARS
+            CPPUNIT_ASSERT(SameBox(layout.BBox(u"one two three four"),
+                                   expected));
+            CPPUNIT_ASSERT(SameBox(layout.BBox(U"one two three four"),
+                                   expected));
+#endif
+#ifdef FTGL_HAS_STRING_VIEW
+            std::string_view view(text, 7);
+            CPPUNIT_ASSERT(SameBox(layout.BBox(view), prefix));
+#endif
+        }
+
+
+        void testFontChange()
+        {
+            FTPixmapFont font(FONT_FILE);
+            font.FaceSize(18);
+
+            FTSimpleLayout layout;
+            layout.SetFont(&font);
+            layout.SetLineLength(2000.0f);
+
+            const char *text = "The quick brown fox jumps over the lazy dog";
+            FTBBox before = layout.BBox(text);
+
+            // Same font and point size, but twice the resolution
+            font.FaceSize(18, 144);
+
+            FTSimpleLayout fresh;
+            fresh.SetFont(&font);
+            fresh.SetLineLength(2000.0f);
+
+            FTBBox after = layout.BBox(text);
+            CPPUNIT_ASSERT(after.Upper().X() > before.Upper().X() * 1.5);
+            CPPUNIT_ASSERT(SameBox(after, fresh.BBox(text)));
+            CPPUNIT_ASSERT_EQUAL(fresh.LineCount(text), layout.LineCount(text));
+
+            font.GlyphLoadFlags(FT_LOAD_NO_HINTING);
+            CPPUNIT_ASSERT(SameBox(layout.BBox(text), fresh.BBox(text)));
+        }
+
+
         void setUp()
         {}
 